@@ -0,0 +1,187 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include "Ocp1DataTypes.h"
+#include "Ocp1Property.h"
+
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// Converting the float arrays of three typical bulk payloads between OCP.1
+// byte order and native values: the positions of 128 sound objects (decode),
+// the 6-DOF aiming and position of 64 speakers (encode) and a 128 x 64 matrix
+// of crosspoint gains (decode).  Compares the one-value DataTo/DataFrom
+// helpers, a scalar ReadUint32() / WriteUint32() loop and the batch codecs.
+// Also decodes the multi-channel values of one GetValue response: an
+// OcaList<OcaFloat32> of 64 output levels and an OcaBitstring of 128 mute flags.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numPositions   = 128;
+constexpr int numSpeakers    = 64;
+constexpr int numCrosspoints = 128 * 64;
+
+/** Runs fn numFrames times and reports time and allocations per frame. */
+void measure(const char* variant, int numFrames, const std::function<float()>& fn)
+{
+    float checksum = 0.0f;
+    const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+    NanoOcp1Benchmarks::Stopwatch sw;
+    for (int i = 0; i < numFrames; ++i)
+        checksum += fn();
+    const auto seconds = sw.elapsedSeconds();
+    const auto allocations = NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore;
+    NanoOcp1Benchmarks::report(variant, "allocations/frame", static_cast<double>(allocations) / numFrames, "");
+    NanoOcp1Benchmarks::report(variant, "time/frame", seconds / numFrames * 1e9, "ns");
+    if (checksum == 1.0f)
+        std::printf("  (checksum %f)\n", checksum);
+}
+
+/** Returns count big-endian floats, built with the one-value helper. */
+ByteVector makeFloatData(int count)
+{
+    ByteVector data;
+    for (int i = 0; i < count; ++i)
+    {
+        const auto value = DataFromFloat(0.001f * static_cast<float>(i));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+    return data;
+}
+
+/** Decodes a float array three ways; shared by the position and matrix cases. */
+void measureDecode(const char* title, int count, int numFrames)
+{
+    const auto data = makeFloatData(count);
+    std::vector<float> values(static_cast<std::size_t>(count));
+
+    std::printf("  %s\n", title);
+    measure("DataToFloat per value", numFrames, [&]() {
+        // As Variant::ToPosition() did: one ByteVector per coordinate.
+        for (int i = 0; i < count; ++i)
+            values[i] = DataToFloat(ByteVector(data.data() + 4 * i, data.data() + 4 * i + 4));
+        return values[count - 1];
+    });
+    measure("ReadUint32 per value", numFrames, [&]() {
+        for (int i = 0; i < count; ++i)
+        {
+            const auto intValue = ReadUint32(data.data() + 4 * i);
+            std::memcpy(&values[i], &intValue, sizeof(float));
+        }
+        return values[count - 1];
+    });
+    measure("ReadFloat32Array", numFrames, [&]() {
+        ReadFloat32Array(data, values.data(), values.size());
+        return values[count - 1];
+    });
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(BatchCodecFloatArrays)
+{
+    measureDecode("Decode 128 positions (384 floats)", 3 * numPositions, 200000);
+
+    std::vector<float> blobs(6 * numSpeakers);
+    for (std::size_t i = 0; i < blobs.size(); ++i)
+        blobs[i] = 0.5f * static_cast<float>(i);
+    ByteVector frame(4 * blobs.size());
+
+    std::printf("  Encode 64 speaker 6-DOF blobs (384 floats)\n");
+    measure("DataFromFloat per value", 200000, [&]() {
+        ByteVector out;
+        for (const auto value : blobs)
+        {
+            const auto bytes = DataFromFloat(value);
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+        return static_cast<float>(out[5]);
+    });
+    measure("DataFromAimingAndPosition", 200000, [&]() {
+        ByteVector out;
+        for (int s = 0; s < numSpeakers; ++s)
+        {
+            const auto* b = &blobs[6 * s];
+            const auto bytes = DataFromAimingAndPosition(b[0], b[1], b[2], b[3], b[4], b[5]);
+            out.insert(out.end(), bytes.begin(), bytes.end());
+        }
+        return static_cast<float>(out[5]);
+    });
+    measure("WriteUint32 per value", 200000, [&]() {
+        for (std::size_t i = 0; i < blobs.size(); ++i)
+        {
+            std::uint32_t intValue;
+            std::memcpy(&intValue, &blobs[i], sizeof(intValue));
+            WriteUint32(frame.data() + 4 * i, intValue);
+        }
+        return static_cast<float>(frame[5]);
+    });
+    measure("WriteFloat32Array", 200000, [&]() {
+        WriteFloat32Array(frame.data(), blobs.data(), blobs.size());
+        return static_cast<float>(frame[5]);
+    });
+
+    measureDecode("Decode 128 x 64 matrix gains (8192 floats)", numCrosspoints, 10000);
+}
+
+
+NANOOCP1_BENCHMARK(BatchCodecListsAndBitStrings)
+{
+    constexpr int numChannels = 64;
+    const auto levels = makeFloatData(numChannels);
+    ByteVector list = DataFromUint16(numChannels);
+    list.insert(list.end(), levels.begin(), levels.end());
+    std::vector<float> values;
+
+    std::printf("  Decode a list of 64 levels\n");
+    measure("DataToFloat per channel", 200000, [&]() {
+        // As the values of 64 separate GetValue responses would be decoded.
+        values.resize(numChannels);
+        for (int i = 0; i < numChannels; ++i)
+            values[i] = DataToFloat(ByteSpan(levels).subspan(4 * i, 4));
+        return values[numChannels - 1];
+    });
+    measure("vector<float> codec", 200000, [&]() {
+        Ocp1ValueCodec<std::vector<float>>::Decode(list, values);
+        return values[numChannels - 1];
+    });
+
+    constexpr int numFlags = 128;
+    std::vector<bool> flags(numFlags);
+    for (int i = 0; i < numFlags; ++i)
+        flags[i] = (i % 3) == 0;
+    const auto bitString = DataFromBitString(flags);
+    BitString bits;
+
+    std::printf("  Decode a bit string of 128 mute flags\n");
+    measure("DataToBitString", 200000, [&]() {
+        const auto decoded = DataToBitString(bitString);
+        return decoded[numFlags - 1] ? 1.0f : 0.0f;
+    });
+    measure("BitString codec", 200000, [&]() {
+        Ocp1ValueCodec<BitString>::Decode(bitString, bits);
+        return static_cast<float>(bits.bits[numFlags - 1]);
+    });
+}
@@ -0,0 +1,196 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Initial sync of a 128 x 64 DS100 object set (one MatrixNode_Gain per
+// crosspoint): an AddSubscription and a GetValue command per object, sent back
+// to back as Ocp1Controller does after connecting.  A fake device on the other
+// end of a loopback connection answers every command.  Compares one
+// sendMessage() per command with an Ocp1Connection::SendBatch; "send" is the
+// time until the sending thread is free again, "sync" the time until the last
+// response has arrived.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numInputs  = 128;
+constexpr int numOutputs = 64;
+constexpr int numCycles  = 5;
+
+/** Answers every command it reads with a Response, one write per read. */
+struct FakeDevice
+{
+    std::unique_ptr<NanoSocket> socket;
+    std::thread                 thread;
+
+    void start()
+    {
+        thread = std::thread([this]() {
+            const auto value = DataFromFloat(-6.0f);
+            Ocp1FrameReader reader;
+            ByteVector replies;
+            while (true)
+            {
+                auto n = socket->read(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()), false);
+                if (n <= 0)
+                    return;
+                reader.commitWrite(static_cast<std::size_t>(n));
+
+                replies.clear();
+                ByteSpan frame;
+                while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+                {
+                    // Command layout after the 10-byte header: size, handle, target ONo, ...
+                    // AddSubscription targets the subscription manager (ONo 4).
+                    const auto handle = ReadUint32(frame.data() + 14);
+                    const auto isGet  = ReadUint32(frame.data() + 18) != 4;
+                    const auto reply  = isGet ? Ocp1Response(handle, 0, 1, value).GetSerializedData()
+                                              : Ocp1Response(handle, 0, 0, {}).GetSerializedData();
+                    replies.insert(replies.end(), reply.begin(), reply.end());
+                }
+                if (!replies.empty() && socket->write(replies.data(), static_cast<int>(replies.size())) <= 0)
+                    return;
+            }
+        });
+    }
+
+    void stop()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+};
+
+std::vector<ByteVector> makeSyncCommands()
+{
+    std::vector<ByteVector> commands;
+    commands.reserve(2 * numInputs * numOutputs);
+    for (int pass = 0; pass < 2; ++pass)
+        for (std::uint32_t in = 1; in <= numInputs; ++in)
+            for (std::uint32_t out = 1; out <= numOutputs; ++out)
+            {
+                const DS100::dbOcaObjectDef_MatrixNode_Gain def(in, out);
+                std::uint32_t handle{0};
+                commands.push_back(Ocp1CommandResponseRequired(
+                    pass == 0 ? def.AddSubscriptionCommand() : def.GetValueCommand(), handle).GetSerializedData());
+            }
+    return commands;
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(BatchSendInitialSync)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    NanoOcp1Client client(/*callbacksOnMessageThread=*/false);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::size_t             responses = 0;
+    client.onDataReceived = [&](const ByteVector&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++responses;
+        cv.notify_all();
+        return true;
+    };
+
+    FakeDevice device;
+    if (!client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+    for (int i = 0; i < 20 && !device.socket; ++i)
+        device.socket.reset(listener.waitForNextConnection());
+    if (!device.socket)
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+    device.start();
+
+    auto runSync = [&](const char* variant, const std::function<bool(std::vector<ByteVector>&&)>& send) {
+        double sendTotal = 0.0, syncTotal = 0.0;
+        for (int cycle = 0; cycle < numCycles; ++cycle)
+        {
+            auto commands = makeSyncCommands();
+            const auto expected = commands.size();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                responses = 0;
+            }
+
+            NanoOcp1Benchmarks::Stopwatch sw;
+            if (!send(std::move(commands)))
+            {
+                std::printf("  %s: send failed\n", variant);
+                return;
+            }
+            sendTotal += sw.elapsedSeconds();
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!cv.wait_for(lock, std::chrono::seconds(10), [&]() { return responses >= expected; }))
+            {
+                std::printf("  %s: responses missing\n", variant);
+                return;
+            }
+            syncTotal += sw.elapsedSeconds();
+        }
+
+        NanoOcp1Benchmarks::report(variant, "send", sendTotal / numCycles * 1e3, "ms");
+        NanoOcp1Benchmarks::report(variant, "sync", syncTotal / numCycles * 1e3, "ms");
+    };
+
+    runSync("sendMessage per command", [&](std::vector<ByteVector>&& commands) {
+        bool ok = true;
+        for (const auto& command : commands)
+            ok = client.sendData(command) && ok;
+        return ok;
+    });
+
+    runSync("SendBatch", [&](std::vector<ByteVector>&& commands) {
+        Ocp1Connection::SendBatch batch(client);
+        for (auto& command : commands)
+            batch.add(std::move(command));
+        return batch.flush();
+    });
+
+    client.disconnect(1000, Ocp1Connection::Notify::no);
+    device.stop();
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal self-registering benchmark harness (no external dependencies).
+ *
+ * Each benchmark is a function defined with NANOOCP1_BENCHMARK(Name) that does
+ * its own setup, measures with Stopwatch and prints its figures via report().
+ * NanoOcp1Benchmarks runs all of them, or only those whose name contains the
+ * first command-line argument.
+ */
+namespace NanoOcp1Benchmarks
+{
+
+struct Benchmark
+{
+    std::string           name;
+    std::function<void()> run;
+};
+
+inline std::vector<Benchmark>& getRegistry()
+{
+    static std::vector<Benchmark> registry;
+    return registry;
+}
+
+struct Registrar
+{
+    Registrar(const char* name, std::function<void()> fn)
+    {
+        getRegistry().push_back({ name, std::move(fn) });
+    }
+};
+
+/** Wall-clock timer started on construction. */
+class Stopwatch
+{
+public:
+    Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+    double elapsedSeconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Number of global operator new calls so far, on any thread.  Takes the
+ * difference around a measured loop to count its heap allocations.
+ */
+long long getAllocationCount() noexcept;
+
+/** Prints one result line: "  <variant>  <metric> = <value> <unit>". */
+inline void report(const std::string& variant, const std::string& metric, double value, const std::string& unit)
+{
+    std::printf("  %-28s %-22s %14.3f %s\n", variant.c_str(), metric.c_str(), value, unit.c_str());
+}
+
+} // namespace NanoOcp1Benchmarks
+
+#define NANOOCP1_BENCHMARK(name)                                                        \
+    static void name();                                                                 \
+    static NanoOcp1Benchmarks::Registrar name##Registrar(#name, &name);                 \
+    static void name()
@@ -0,0 +1,130 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1Message.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Delivery cost of a DS100 level-meter notification storm, from the read
+// thread to the value on the dispatcher thread (callbacksOnMessageThread =
+// true).  Compares onDataReceived plus UnmarshalOcp1Message() — a ByteVector per
+// frame and another for its parameter data — with onFrameReceived plus
+// ParseNotification(), which reads the value where recv() put it.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numFrames      = 100000;
+constexpr int framesPerWrite = 64;
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(DeliveryNotificationStorm)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    const auto frame = Ocp1Notification(0x10000001, 4, 1, 1, DataFromFloat(-42.0f)).GetSerializedData();
+    ByteVector burst;
+    for (int i = 0; i < framesPerWrite; ++i)
+        burst.insert(burst.end(), frame.begin(), frame.end());
+
+    auto runStorm = [&](const char* variant, const std::function<void(NanoOcp1Client&, std::function<void(float)>)>& install) {
+        NanoOcp1Client client(/*callbacksOnMessageThread=*/true);
+
+        std::mutex              mutex;
+        std::condition_variable cv;
+        int                     received = 0;
+        float                   sum      = 0.0f;
+        install(client, [&](float value) {
+            sum += value;
+            if (++received == numFrames)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
+            }
+        });
+
+        if (!client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+        {
+            std::printf("  %s: loopback setup failed\n", variant);
+            return;
+        }
+        std::unique_ptr<NanoSocket> peer;
+        for (int i = 0; i < 20 && !peer; ++i)
+            peer.reset(listener.waitForNextConnection());
+        if (!peer)
+        {
+            std::printf("  %s: loopback setup failed\n", variant);
+            return;
+        }
+
+        NanoOcp1Benchmarks::Stopwatch sw;
+        for (int sent = 0; sent < numFrames; sent += framesPerWrite)
+            if (peer->write(burst.data(), static_cast<int>(burst.size())) <= 0)
+                break;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cv.wait_for(lock, std::chrono::seconds(30), [&]() { return received >= numFrames; }))
+            std::printf("  %s: frames missing\n", variant);
+        else
+            NanoOcp1Benchmarks::report(variant, "throughput", numFrames / sw.elapsedSeconds() / 1e6, "Mframes/s");
+        lock.unlock();
+
+        client.disconnect(1000, Ocp1Connection::Notify::no);
+    };
+
+    runStorm("onDataReceived", [](NanoOcp1Client& client, std::function<void(float)> onValue) {
+        client.onDataReceived = [onValue](const ByteVector& data) {
+            auto msg = Ocp1Message::UnmarshalOcp1Message(data);
+            if (!msg || msg->GetMessageType() != Ocp1Message::Notification)
+                return false;
+            onValue(DataToFloat(static_cast<Ocp1Notification*>(msg.get())->GetParameterData()));
+            return true;
+        };
+    });
+
+    runStorm("onFrameReceived", [](NanoOcp1Client& client, std::function<void(float)> onValue) {
+        client.onFrameReceived = [onValue](const Ocp1SharedFrame& frame) {
+            Ocp1NotificationView notif;
+            if (!Ocp1Message::ParseNotification(frame, notif))
+                return false;
+            if (notif.parameterData.size() < sizeof(float))
+                return false;
+            const auto bits = ReadUint32(notif.parameterData.data());
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            onValue(value);
+            return true;
+        };
+    });
+}
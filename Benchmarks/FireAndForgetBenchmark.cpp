@@ -0,0 +1,190 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "Ocp1Controller.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// A tracking system streaming positions of 128 sound objects through
+// Ocp1Controller::setValue() to a fake device on a loopback connection, once
+// as acknowledged CommandResponseRequired and once as fire-and-forget Command
+// (SetValueMode::FireAndForget).  The device answers every
+// CommandResponseRequired with a Response, as a DS100 does.  "wire" counts the
+// bytes in both directions per SetValue, "CPU" the process CPU time per
+// SetValue — including the fake device's, as on a real network the device
+// would only take the sending of responses off this host.  Each run lasts until
+// the device has read every command and, with acknowledgements, the controller
+// has matched every response.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numObjects = 128;
+constexpr int numCycles  = 500;
+
+/** Exposes the pending SetValue bookkeeping, to wait for the last response. */
+class StreamingController : public Ocp1Controller
+{
+public:
+    using Ocp1Controller::Ocp1Controller;
+    using Ocp1Controller::hasPendingSetValues;
+};
+
+/** Reads commands, counting them and all bytes, and answers those that require it. */
+struct FakeDevice
+{
+    std::unique_ptr<NanoSocket> socket;
+    std::thread                 thread;
+    std::atomic<long long>      commands{ 0 };
+    std::atomic<long long>      bytes{ 0 };
+
+    void start()
+    {
+        thread = std::thread([this]() {
+            Ocp1FrameReader reader;
+            ByteVector replies;
+            while (true)
+            {
+                const auto n = socket->read(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()), false);
+                if (n <= 0)
+                    return;
+                reader.commitWrite(static_cast<std::size_t>(n));
+                bytes.fetch_add(n, std::memory_order_relaxed);
+
+                replies.clear();
+                ByteSpan frame;
+                Ocp1CommandView command;
+                while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+                {
+                    if (!Ocp1Message::ParseCommand(frame, command))
+                        continue;
+                    commands.fetch_add(1, std::memory_order_relaxed);
+                    if (command.responseRequired)
+                    {
+                        const auto reply = Ocp1Response(command.handle, 0, 0, {}).GetSerializedData();
+                        replies.insert(replies.end(), reply.begin(), reply.end());
+                    }
+                }
+                if (!replies.empty())
+                {
+                    if (socket->write(replies.data(), static_cast<int>(replies.size())) <= 0)
+                        return;
+                    bytes.fetch_add(static_cast<long long>(replies.size()), std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    void stop()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+};
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(FireAndForgetPositionStream)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    StreamingController controller(/*callbacksOnMessageThread=*/false);
+    std::atomic<bool> connected{ false };
+    controller.onStateChanged = [&](Ocp1Controller::State state) {
+        connected = (state == Ocp1Controller::State::Connected);
+    };
+    controller.connect("127.0.0.1", listener.getBoundPort());
+
+    FakeDevice device;
+    for (int i = 0; i < 20 && !device.socket; ++i)
+        device.socket.reset(listener.waitForNextConnection());
+    if (!device.socket)
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+    device.start();
+    for (int i = 0; i < 200 && !connected; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!connected)
+    {
+        std::printf("  controller did not connect\n");
+        return;
+    }
+
+    std::vector<DS100::dbOcaObjectDef_CoordinateMapping_Source_Position> defs;
+    defs.reserve(numObjects);
+    for (std::uint32_t object = 1; object <= numObjects; ++object)
+        defs.emplace_back(1, object);
+
+    auto runStream = [&](const char* variant, Ocp1Controller::SetValueMode mode) {
+        controller.setSetValueMode(mode);
+        const auto commandsBefore = device.commands.load();
+        const auto bytesBefore    = device.bytes.load();
+        const auto cpuStart       = std::clock();
+        NanoOcp1Benchmarks::Stopwatch sw;
+
+        for (int cycle = 0; cycle < numCycles; ++cycle)
+        {
+            const auto x = static_cast<float>(cycle) / numCycles;
+            for (const auto& def : defs)
+                if (!controller.setValue(def, Variant(x, 0.5f, 0.0f)))
+                {
+                    std::printf("  %s: send failed\n", variant);
+                    return;
+                }
+        }
+
+        const long long sent = static_cast<long long>(numCycles) * numObjects;
+        while (device.commands.load() - commandsBefore < sent || controller.hasPendingSetValues())
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+        const auto seconds    = sw.elapsedSeconds();
+        const auto cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const auto wireBytes  = static_cast<double>(device.bytes.load() - bytesBefore);
+
+        NanoOcp1Benchmarks::report(variant, "wire", wireBytes / sent, "bytes/SetValue");
+        NanoOcp1Benchmarks::report(variant, "CPU", cpuSeconds / sent * 1e9, "ns/SetValue");
+        NanoOcp1Benchmarks::report(variant, "time", seconds / sent * 1e9, "ns/SetValue");
+    };
+
+    runStream("CommandResponseRequired", Ocp1Controller::SetValueMode::Acknowledged);
+    runStream("Command (fire-and-forget)", Ocp1Controller::SetValueMode::FireAndForget);
+
+    controller.disconnect();
+    device.stop();
+}
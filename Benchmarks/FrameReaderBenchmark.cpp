@@ -0,0 +1,209 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+#include "internal/NanoSocket.h"
+
+#include <memory>
+#include <thread>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+  #include <sys/socket.h>
+#endif
+
+// Receive-path cost of a DS100 level-meter notification storm: many ~42-byte
+// Notification frames written back-to-back over loopback TCP.  Compares the
+// former Ocp1Connection read loop (one recv() for the header, one for the body,
+// one ByteVector per frame) with Ocp1FrameReader (one recv() for whatever is
+// buffered, frames sliced out in place).  recv() calls are counted at the call
+// site, so "recv/frame" is the syscall count per frame; allocations are counted
+// by the global operator new from the start of the read loop.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numFrames      = 200000;
+constexpr int framesPerWrite = 64;
+
+struct Loopback
+{
+    NanoSocket                  listener;
+    std::unique_ptr<NanoSocket> reader;
+    std::unique_ptr<NanoSocket> writer;
+
+    bool open()
+    {
+        if (!listener.createListener(0, "127.0.0.1"))
+            return false;
+
+        reader = std::make_unique<NanoSocket>();
+        if (!reader->connect("127.0.0.1", listener.getBoundPort(), 1000))
+            return false;
+
+        for (int i = 0; i < 20 && !writer; ++i)
+            writer.reset(listener.waitForNextConnection());
+        return writer != nullptr;
+    }
+};
+
+ByteVector makeStorm()
+{
+    // Level meter value: one float, as sent by a subscribed DS100 meter object.
+    const auto frame = Ocp1Notification(0x10000001, 4, 1, 1, DataFromFloat(-42.0f)).GetSerializedData();
+
+    ByteVector storm;
+    storm.reserve(frame.size() * numFrames);
+    for (int i = 0; i < numFrames; ++i)
+        storm.insert(storm.end(), frame.begin(), frame.end());
+    return storm;
+}
+
+std::thread startWriter(NanoSocket& writer, const ByteVector& storm, std::size_t frameSize)
+{
+    return std::thread([&writer, &storm, frameSize]() {
+        const auto chunk = frameSize * framesPerWrite;
+        std::size_t offset = 0;
+        while (offset < storm.size())
+        {
+            const auto n = writer.write(storm.data() + offset,
+                                        static_cast<int>(std::min(chunk, storm.size() - offset)));
+            if (n <= 0)
+                return;
+            offset += static_cast<std::size_t>(n);
+        }
+    });
+}
+
+struct RecvCounter
+{
+    NanoSocketHandle handle;
+    long long        calls{ 0 };
+
+    int operator()(std::uint8_t* data, std::size_t size)
+    {
+        ++calls;
+        return static_cast<int>(::recv(handle, reinterpret_cast<char*>(data), static_cast<int>(size), 0));
+    }
+};
+
+void printResults(const char* variant, int frames, long long recvCalls, long long allocations, double seconds)
+{
+    NanoOcp1Benchmarks::report(variant, "recv/frame", static_cast<double>(recvCalls) / frames, "");
+    NanoOcp1Benchmarks::report(variant, "allocations/frame", static_cast<double>(allocations) / frames, "");
+    NanoOcp1Benchmarks::report(variant, "throughput", frames / seconds / 1e6, "Mframes/s");
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(FrameReaderNotificationStorm)
+{
+    const auto storm     = makeStorm();
+    const auto frameSize = storm.size() / numFrames;
+
+    // ── Former read loop: exact header read, then exact body read ─────────────
+    {
+        Loopback lb;
+        if (!lb.open())
+        {
+            std::printf("  loopback setup failed\n");
+            return;
+        }
+        auto writerThread = startWriter(*lb.writer, storm, frameSize);
+
+        RecvCounter recvCounted{ lb.reader->getHandle() };
+        auto readExact = [&recvCounted](std::uint8_t* data, std::size_t size) {
+            std::size_t done = 0;
+            while (done < size)
+            {
+                auto n = recvCounted(data + done, size - done);
+                if (n <= 0)
+                    return false;
+                done += static_cast<std::size_t>(n);
+            }
+            return true;
+        };
+
+        int frames = 0;
+        std::size_t checksum = 0;
+        const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+        NanoOcp1Benchmarks::Stopwatch sw;
+        while (frames < numFrames)
+        {
+            ByteVector messageData(Ocp1Header::Ocp1HeaderSize);
+            if (!readExact(messageData.data(), Ocp1Header::Ocp1HeaderSize))
+                break;
+            messageData.resize(static_cast<std::size_t>(ReadUint32(messageData.data() + 3)) + 1);
+            if (!readExact(messageData.data() + Ocp1Header::Ocp1HeaderSize,
+                           messageData.size() - Ocp1Header::Ocp1HeaderSize))
+                break;
+            checksum += messageData.back();
+            ++frames;
+        }
+        const auto seconds = sw.elapsedSeconds();
+        const auto allocations = NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore;
+        writerThread.join();
+
+        printResults("header+body recv", frames, recvCounted.calls, allocations, seconds);
+        (void)checksum;
+    }
+
+    // ── Ocp1FrameReader: drain what is buffered, slice frames in place ────────
+    {
+        Loopback lb;
+        if (!lb.open())
+        {
+            std::printf("  loopback setup failed\n");
+            return;
+        }
+        auto writerThread = startWriter(*lb.writer, storm, frameSize);
+
+        RecvCounter recvCounted{ lb.reader->getHandle() };
+        Ocp1FrameReader reader;
+
+        int frames = 0;
+        std::size_t checksum = 0;
+        const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+        NanoOcp1Benchmarks::Stopwatch sw;
+        while (frames < numFrames)
+        {
+            auto n = recvCounted(reader.getWriteBuffer(), reader.getWritableSize());
+            if (n <= 0)
+                break;
+            reader.commitWrite(static_cast<std::size_t>(n));
+
+            ByteSpan frame;
+            while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+            {
+                checksum += frame[frame.size() - 1];
+                ++frames;
+            }
+        }
+        const auto seconds = sw.elapsedSeconds();
+        const auto allocations = NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore;
+        writerThread.join();
+
+        printResults("Ocp1FrameReader", frames, recvCounted.calls, allocations, seconds);
+        (void)checksum;
+    }
+}
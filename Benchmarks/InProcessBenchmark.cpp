@@ -0,0 +1,124 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1Message.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// A controller syncing against a simulated device: bursts of GetValue commands
+// from a NanoOcp1Client, each answered by a NanoOcp1Server with a Response.
+// Compares a TCP loopback connection with Ocp1ConnectionServer::connectInProcess(),
+// which runs the same two connections over a NanoPipe.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numCommands = 20000;
+constexpr int numCycles   = 5;
+
+std::vector<ByteVector> makeCommands()
+{
+    std::vector<ByteVector> commands;
+    commands.reserve(numCommands);
+    for (std::uint32_t i = 0; i < numCommands; ++i)
+    {
+        std::uint32_t handle{0};
+        commands.push_back(Ocp1CommandResponseRequired(
+            Ocp1CommandDefinition(0x10000000 + i, 0, 4, 1).GetValueCommand(), handle).GetSerializedData());
+    }
+    return commands;
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(InProcessCommandRoundTrip)
+{
+    const auto commands = makeCommands();
+    const auto response = Ocp1Response(1, 0, 1, DataFromFloat(-6.0f)).GetSerializedData();
+
+    auto runSync = [&](const char* variant, const std::function<bool(NanoOcp1Server&, NanoOcp1Client&)>& connect) {
+        NanoOcp1Server server("127.0.0.1", 0, /*callbacksOnMessageThread=*/false);
+        server.onDataReceived = [&](const ByteVector&) { return server.sendData(response); };
+
+        NanoOcp1Client          client(/*callbacksOnMessageThread=*/false);
+        std::mutex              mutex;
+        std::condition_variable cv;
+        int                     responses = 0;
+        client.onDataReceived = [&](const ByteVector&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++responses == numCommands)
+                cv.notify_all();
+            return true;
+        };
+
+        if (!connect(server, client))
+        {
+            std::printf("  %s: setup failed\n", variant);
+            return;
+        }
+
+        double total = 0.0;
+        for (int cycle = 0; cycle < numCycles; ++cycle)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                responses = 0;
+            }
+
+            NanoOcp1Benchmarks::Stopwatch sw;
+            if (!client.sendMessages(commands))
+            {
+                std::printf("  %s: send failed\n", variant);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!cv.wait_for(lock, std::chrono::seconds(10), [&]() { return responses >= numCommands; }))
+            {
+                std::printf("  %s: responses missing\n", variant);
+                return;
+            }
+            total += sw.elapsedSeconds();
+        }
+
+        NanoOcp1Benchmarks::report(variant, "sync", total / numCycles * 1e3, "ms");
+        NanoOcp1Benchmarks::report(variant, "round trips", numCommands * numCycles / total / 1e3, "k/s");
+
+        client.disconnect(1000, Ocp1Connection::Notify::no);
+        server.stop();
+        server.Ocp1ConnectionServer::stop();
+    };
+
+    runSync("TCP loopback", [](NanoOcp1Server& server, NanoOcp1Client& client) {
+        return server.start() && client.connectToSocket("127.0.0.1", server.getBoundPort(), 1000);
+    });
+
+    runSync("NanoPipe", [](NanoOcp1Server& server, NanoOcp1Client& client) {
+        return server.connectInProcess(client);
+    });
+}
@@ -0,0 +1,166 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1Message.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Level meters of all 128 DS100 matrix inputs, one notification per PDU as the
+// device sends them, in the classic Notification format and in the compact
+// AES70-2023 Notification2.  "wire" is the bytes per notification, "parse" the
+// time ParseNotification() takes per notification on an in-memory stream, and
+// "throughput" the notifications per second through a loopback connection into
+// NanoOcp1Client::onFrameReceived, as in DeliveryNotificationStorm.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numChannels    = 128;
+constexpr int numFrames      = 128000;
+constexpr int framesPerWrite = 64;
+constexpr int numParseRounds = 20;
+
+/** One round of level meter updates for every channel, in the given format. */
+ByteVector makeLevelMeterRound(bool compact)
+{
+    ByteVector round;
+    for (std::uint32_t channel = 1; channel <= numChannels; ++channel)
+    {
+        const DS100::dbOcaObjectDef_MatrixInput_LevelMeterIn def(channel);
+        const auto value = DataFromFloat(-60.0f + static_cast<float>(channel) * 0.25f);
+        const auto frame = compact
+            ? Ocp1Notification2(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex, 1, value).GetSerializedData()
+            : Ocp1Notification(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex, 1, value).GetSerializedData();
+        round.insert(round.end(), frame.begin(), frame.end());
+    }
+    return round;
+}
+
+float readFloat(const Ocp1NotificationView& notif)
+{
+    const auto bits = ReadUint32(notif.parameterData.data());
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(NotificationFormatLevelMeters)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    for (const bool compact : { false, true })
+    {
+        const char* variant = compact ? "Notification2" : "Notification";
+        const auto round = makeLevelMeterRound(compact);
+        NanoOcp1Benchmarks::report(variant, "wire", static_cast<double>(round.size()) / numChannels, "bytes");
+
+        // In memory: split the stream at each frame's size field and parse it.
+        {
+            float sum = 0.0f;
+            NanoOcp1Benchmarks::Stopwatch sw;
+            for (int r = 0; r < numParseRounds * numFrames / numChannels; ++r)
+            {
+                for (std::size_t offset = 0; offset < round.size();)
+                {
+                    const auto size = static_cast<std::size_t>(ReadUint32(round.data() + offset + 3)) + 1;
+                    Ocp1NotificationView notif;
+                    if (Ocp1Message::ParseNotification(ByteSpan(round.data() + offset, size), notif))
+                        sum += readFloat(notif);
+                    offset += size;
+                }
+            }
+            const auto seconds = sw.elapsedSeconds();
+            if (sum == 0.0f)
+                std::printf("  %s: no values parsed\n", variant);
+            NanoOcp1Benchmarks::report(variant, "parse", seconds / (numParseRounds * numFrames) * 1e9, "ns");
+        }
+
+        // Over loopback, read and parsed by a client.
+        NanoOcp1Client client(/*callbacksOnMessageThread=*/true);
+        std::mutex              mutex;
+        std::condition_variable cv;
+        int                     received = 0;
+        float                   sum      = 0.0f;
+        client.onFrameReceived = [&](const Ocp1SharedFrame& frame) {
+            Ocp1NotificationView notif;
+            if (!Ocp1Message::ParseNotification(frame, notif) || notif.parameterData.size() < sizeof(float))
+                return false;
+            sum += readFloat(notif);
+            if (++received == numFrames)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
+            }
+            return true;
+        };
+
+        if (!client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+        {
+            std::printf("  %s: loopback setup failed\n", variant);
+            continue;
+        }
+        std::unique_ptr<NanoSocket> peer;
+        for (int i = 0; i < 20 && !peer; ++i)
+            peer.reset(listener.waitForNextConnection());
+        if (!peer)
+        {
+            std::printf("  %s: loopback setup failed\n", variant);
+            continue;
+        }
+
+        // Writes of framesPerWrite notifications, cycling through the channels.
+        const auto frameSize = round.size() / numChannels;
+        const auto writeSize = frameSize * framesPerWrite;
+        NanoOcp1Benchmarks::Stopwatch sw;
+        for (int sent = 0; sent < numFrames; sent += framesPerWrite)
+        {
+            const auto offset = (static_cast<std::size_t>(sent) * frameSize) % round.size();
+            if (peer->write(round.data() + offset, static_cast<int>(writeSize)) <= 0)
+                break;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!cv.wait_for(lock, std::chrono::seconds(30), [&]() { return received >= numFrames; }))
+            std::printf("  %s: frames missing\n", variant);
+        else
+            NanoOcp1Benchmarks::report(variant, "throughput", numFrames / sw.elapsedSeconds() / 1e6, "Mframes/s");
+        lock.unlock();
+
+        client.disconnect(1000, Ocp1Connection::Notify::no);
+    }
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1Property.h"
+#include "Variant.h"
+
+#include <array>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Decoding and encoding the values of three DS100 properties — a gain (float),
+// a sound object position (3 floats) and a channel name (string) — through a
+// Variant, as a ValueCallback and setValue(def, Variant) do, and through
+// Ocp1Property<T>.  The Variant decode starts from the parameter data in the
+// receive buffer, like a trackObjectView() callback.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numValues = 1000000;
+
+/** Measures fn(i) for i in [0, numValues) and reports time and allocations per value. */
+void measure(const char* variant, const std::function<std::size_t(int)>& fn)
+{
+    std::size_t checksum = 0;
+    const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+    NanoOcp1Benchmarks::Stopwatch sw;
+    for (int i = 0; i < numValues; ++i)
+        checksum += fn(i);
+    const auto seconds = sw.elapsedSeconds();
+    const auto allocations = NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore;
+    NanoOcp1Benchmarks::report(variant, "allocations/value", static_cast<double>(allocations) / numValues, "");
+    NanoOcp1Benchmarks::report(variant, "time/value", seconds / numValues * 1e9, "ns");
+    (void)checksum;
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(PropertyDecodeEncode)
+{
+    const DS100::dbOcaObjectDef_MatrixInput_Gain gainDef(1);
+    const DS100::dbOcaObjectDef_Positioning_Source_Position positionDef(1);
+    const DS100::dbOcaObjectDef_Fixed_SerNr nameDef;
+    const Ocp1Property<float> gain(gainDef);
+    const Ocp1Property<Position3> position(positionDef);
+    const Ocp1Property<std::string_view> name(nameDef);
+
+    const auto gainData     = DataFromFloat(-6.0f);
+    const auto positionData = DataFromPosition(0.25f, 0.5f, 0.0f);
+    const auto nameData     = DataFromString("Soundscape Main Room");
+    const ByteSpan gainSpan(gainData), positionSpan(positionData), nameSpan(nameData);
+
+    std::array<std::uint8_t, 64> buffer{};
+
+    std::printf("  Decode gain (float)\n");
+    measure("Variant", [&](int) {
+        return static_cast<std::size_t>(Variant(gainSpan, gainDef.GetDataType()).ToFloat() < 0.0f);
+    });
+    measure("Ocp1Property<float>", [&](int) {
+        float value{};
+        return static_cast<std::size_t>(gain.Decode(gainSpan, value) && value < 0.0f);
+    });
+
+    std::printf("  Decode position (3 x float)\n");
+    measure("Variant", [&](int) {
+        return static_cast<std::size_t>(Variant(positionSpan, positionDef.GetDataType()).ToPosition()[1] > 0.0f);
+    });
+    measure("Ocp1Property<Position3>", [&](int) {
+        Position3 value;
+        return static_cast<std::size_t>(position.Decode(positionSpan, value) && value.y > 0.0f);
+    });
+
+    std::printf("  Decode name (string)\n");
+    measure("Variant", [&](int) {
+        return Variant(nameSpan, nameDef.GetDataType()).ToStringView().size();
+    });
+    measure("Ocp1Property<string_view>", [&](int) {
+        std::string_view value;
+        return name.Decode(nameSpan, value) ? value.size() : 0;
+    });
+
+    // A notification that repeats the previous value, as the receiver of a
+    // RemoteObject sees it: eager decoding versus Variant::Lazy().
+    std::printf("  Detect repeated position\n");
+    const auto previous     = Variant(positionSpan, positionDef.GetDataType());
+    const auto previousLazy = Variant::Lazy(positionSpan, positionDef.GetDataType());
+    measure("Variant", [&](int) {
+        return static_cast<std::size_t>(Variant(positionSpan, positionDef.GetDataType()) == previous);
+    });
+    measure("Variant::Lazy", [&](int) {
+        return static_cast<std::size_t>(Variant::Lazy(positionSpan, positionDef.GetDataType()) == previousLazy);
+    });
+
+    std::printf("  Encode position (3 x float)\n");
+    measure("Variant", [&](int i) {
+        return Variant(0.25f, static_cast<float>(i & 1), 0.0f).ToParamData(positionDef.GetDataType()).size();
+    });
+    measure("Ocp1Property<Position3>", [&](int i) {
+        return position.Encode({ 0.25f, static_cast<float>(i & 1), 0.0f }, buffer.data(), buffer.size());
+    });
+}
@@ -0,0 +1,134 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1Message.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Level-meter notification storm from 16 devices into 16 reactor-mode
+// clients sharing one NanoReactor, compared across its backends: readiness
+// (epoll) versus io_uring with multishot receive into a provided buffer ring.
+// "CPU" is process CPU time per frame, so it includes the writing side, which
+// is the same for both.  io_uring needs NANOOCP1_USE_IO_URING; without it, or
+// on a kernel that lacks the features, that variant reports its fallback.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numConnections = 16;
+constexpr int numRounds      = 2000;
+constexpr int framesPerWrite = 16;
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(ReactorBackendNotificationStorm)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    const auto frame = Ocp1Notification(0x10000001, 4, 1, 1, DataFromFloat(-42.0f)).GetSerializedData();
+    ByteVector burst;
+    for (int i = 0; i < framesPerWrite; ++i)
+        burst.insert(burst.end(), frame.begin(), frame.end());
+
+    auto runStorm = [&](const char* variant, NanoReactor::BackendType type) {
+        auto reactor = std::make_shared<NanoReactor>(ThreadPriority::normal, type);
+        const std::string name = std::string(variant) + " (" + reactor->getBackendName() + ")";
+
+        constexpr auto expected = static_cast<long>(numConnections) * numRounds * framesPerWrite;
+        std::atomic<long>       received{ 0 };
+        std::mutex              mutex;
+        std::condition_variable cv;
+
+        std::vector<std::unique_ptr<NanoOcp1Client>> clients;
+        std::vector<std::unique_ptr<NanoSocket>>      devices;
+        for (int i = 0; i < numConnections; ++i)
+        {
+            clients.push_back(std::make_unique<NanoOcp1Client>("127.0.0.1", listener.getBoundPort(), reactor,
+                                                               /*callbacksOnMessageThread=*/false));
+            clients.back()->onFrameReceived = [&](const Ocp1SharedFrame&) {
+                if (received.fetch_add(1, std::memory_order_relaxed) + 1 == expected)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    cv.notify_all();
+                }
+                return true;
+            };
+            if (!clients.back()->connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+            {
+                std::printf("  %s: loopback setup failed\n", name.c_str());
+                return;
+            }
+            std::unique_ptr<NanoSocket> device;
+            for (int attempt = 0; attempt < 20 && !device; ++attempt)
+                device.reset(listener.waitForNextConnection());
+            if (!device)
+            {
+                std::printf("  %s: loopback setup failed\n", name.c_str());
+                return;
+            }
+            devices.push_back(std::move(device));
+        }
+
+        const auto cpuStart = std::clock();
+        NanoOcp1Benchmarks::Stopwatch sw;
+        for (int round = 0; round < numRounds; ++round)
+            for (auto& device : devices)
+                if (device->write(burst.data(), static_cast<int>(burst.size())) != static_cast<int>(burst.size()))
+                {
+                    std::printf("  %s: write failed\n", name.c_str());
+                    return;
+                }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!cv.wait_for(lock, std::chrono::seconds(30), [&]() { return received.load() >= expected; }))
+            {
+                std::printf("  %s: frames missing\n", name.c_str());
+                return;
+            }
+        }
+        const auto seconds    = sw.elapsedSeconds();
+        const auto cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        NanoOcp1Benchmarks::report(name, "throughput", expected / seconds / 1e3, "kframes/s");
+        NanoOcp1Benchmarks::report(name, "CPU", cpuSeconds / expected * 1e9, "ns/frame");
+
+        for (auto& client : clients)
+            client->disconnect(1000, Ocp1Connection::Notify::no);
+    };
+
+    runStorm("Readiness", NanoReactor::BackendType::Readiness);
+    runStorm("IoUring", NanoReactor::BackendType::IoUring);
+}
@@ -0,0 +1,237 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+
+// Serializing the messages of a position stream: a SetValue per sound object
+// position (CommandResponseRequired with a 12-byte blob), plus the Notification
+// and Response a device sends back.  Compares GetSerializedData(), which returns
+// a new ByteVector per message, with SerializeInto() into a reused buffer.  The
+// send part streams 128 positions per cycle to a device on a loopback
+// connection that only reads, and counts heap allocations per message sent.
+// The prepared part compares the whole setValue() path — SetValueCommand(),
+// Ocp1CommandResponseRequired, GetSerializedData() — with an
+// Ocp1PreparedCommand per object that only patches handle, sizes and value.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numMessages   = 1000000;
+constexpr int numObjects    = 128;
+constexpr int numSendCycles = 2000;
+
+void reportSerialize(const char* variant, long long allocations, double seconds)
+{
+    NanoOcp1Benchmarks::report(variant, "allocations/message", static_cast<double>(allocations) / numMessages, "");
+    NanoOcp1Benchmarks::report(variant, "time/message", seconds / numMessages * 1e9, "ns");
+}
+
+/** Measures fn(i) for i in [0, numMessages). */
+void measure(const char* variant, const std::function<std::size_t(int)>& fn)
+{
+    std::size_t checksum = 0;
+    const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+    NanoOcp1Benchmarks::Stopwatch sw;
+    for (int i = 0; i < numMessages; ++i)
+        checksum += fn(i);
+    const auto seconds = sw.elapsedSeconds();
+    reportSerialize(variant, NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore, seconds);
+    (void)checksum;
+}
+
+/** Writes a position as three big-endian floats, as DataFromPosition() does. */
+void writePosition(std::uint8_t* dst, float x, float y, float z)
+{
+    for (const float coordinate : { x, y, z })
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &coordinate, sizeof(bits));
+        WriteUint32(dst, bits);
+        dst += sizeof(bits);
+    }
+}
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(SerializeMessages)
+{
+    const DS100::dbOcaObjectDef_CoordinateMapping_Source_Position def(1, 1);
+    std::uint32_t handle{0};
+    Ocp1CommandResponseRequired setValue(def.SetValueCommand(Variant(0.25f, 0.5f, 0.0f)), handle);
+    Ocp1Notification notification(def.m_targetOno, 4, 1, 1, DataFromPosition(0.25f, 0.5f, 0.0f));
+    Ocp1Response response(handle, 0, 1, DataFromFloat(-6.0f));
+
+    std::array<std::uint8_t, 256> buffer{};
+
+    std::printf("  SetValue (position)\n");
+    measure("GetSerializedData", [&](int i) {
+        setValue.SetHandle(static_cast<std::uint32_t>(i));
+        return setValue.GetSerializedData().back();
+    });
+    measure("SerializeInto", [&](int i) {
+        setValue.SetHandle(static_cast<std::uint32_t>(i));
+        return buffer[setValue.SerializeInto(buffer.data(), buffer.size()) - 1];
+    });
+
+    std::printf("  Notification (position)\n");
+    measure("GetSerializedData", [&](int) { return notification.GetSerializedData().back(); });
+    measure("SerializeInto", [&](int) {
+        return buffer[notification.SerializeInto(buffer.data(), buffer.size()) - 1];
+    });
+
+    std::printf("  Response (float)\n");
+    measure("GetSerializedData", [&](int) { return response.GetSerializedData().back(); });
+    measure("SerializeInto", [&](int) {
+        return buffer[response.SerializeInto(buffer.data(), buffer.size()) - 1];
+    });
+}
+
+
+NANOOCP1_BENCHMARK(SerializePreparedSetValue)
+{
+    std::vector<DS100::dbOcaObjectDef_CoordinateMapping_Source_Position> defs;
+    std::vector<Ocp1PreparedCommand> prepared;
+    defs.reserve(numObjects);
+    prepared.reserve(numObjects);
+    for (std::uint32_t object = 1; object <= numObjects; ++object)
+    {
+        defs.emplace_back(1, object);
+        prepared.push_back(Ocp1PreparedCommand::SetValue(defs.back()));
+    }
+
+    Ocp1HandleAllocator handles;
+    std::array<std::uint8_t, 256> buffer{};
+
+    std::printf("  SetValue (position), %d objects round robin\n", numObjects);
+    measure("SetValueCommand + GetSerializedData", [&](int i) {
+        const auto x = static_cast<float>(i & 0xff) / 256.0f;
+        std::uint32_t handle{0};
+        return Ocp1CommandResponseRequired(defs[i % numObjects].SetValueCommand(Variant(x, 0.5f, 0.0f)), handles, handle)
+            .GetSerializedData().back();
+    });
+    measure("Ocp1PreparedCommand::SerializeInto", [&](int i) {
+        const auto x = static_cast<float>(i & 0xff) / 256.0f;
+        std::uint8_t position[12];
+        writePosition(position, x, 0.5f, 0.0f);
+        const auto size = prepared[i % numObjects].SerializeInto(buffer.data(), buffer.size(), handles.next(),
+                                                                  ByteSpan(position, sizeof(position)));
+        return buffer[size - 1];
+    });
+}
+
+
+NANOOCP1_BENCHMARK(SerializeSendPositionStream)
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    NanoOcp1Client client(/*callbacksOnMessageThread=*/false);
+    if (!client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+    std::unique_ptr<NanoSocket> device;
+    for (int i = 0; i < 20 && !device; ++i)
+        device.reset(listener.waitForNextConnection());
+    if (!device)
+    {
+        std::printf("  loopback setup failed\n");
+        return;
+    }
+
+    // Reads and discards everything, so the client's socket never backs up for long.
+    std::atomic<long long> received{ 0 };
+    std::thread reader([&]() {
+        Ocp1FrameReader frames;
+        while (true)
+        {
+            const auto n = device->read(frames.getWriteBuffer(), static_cast<int>(frames.getWritableSize()), false);
+            if (n <= 0)
+                return;
+            frames.commitWrite(static_cast<std::size_t>(n));
+            ByteSpan frame;
+            while (frames.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+                received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    std::vector<Ocp1CommandResponseRequired> commands;
+    commands.reserve(numObjects);
+    for (std::uint32_t object = 1; object <= numObjects; ++object)
+    {
+        const DS100::dbOcaObjectDef_CoordinateMapping_Source_Position def(1, object);
+        std::uint32_t handle{0};
+        commands.emplace_back(def.SetValueCommand(Variant(0.25f, 0.5f, 0.0f)), handle);
+    }
+
+    auto runStream = [&](const char* variant, const std::function<bool(Ocp1CommandResponseRequired&)>& send) {
+        const auto receivedBefore = received.load();
+        const auto allocationsBefore = NanoOcp1Benchmarks::getAllocationCount();
+        NanoOcp1Benchmarks::Stopwatch sw;
+        for (int cycle = 0; cycle < numSendCycles; ++cycle)
+            for (auto& command : commands)
+                if (!send(command))
+                {
+                    std::printf("  %s: send failed\n", variant);
+                    return;
+                }
+        const auto seconds = sw.elapsedSeconds();
+        const auto allocations = NanoOcp1Benchmarks::getAllocationCount() - allocationsBefore;
+
+        const double sent = static_cast<double>(numSendCycles) * numObjects;
+        while (received.load() - receivedBefore < static_cast<long long>(sent))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        NanoOcp1Benchmarks::report(variant, "allocations/message", allocations / sent, "");
+        NanoOcp1Benchmarks::report(variant, "time/message", seconds / sent * 1e9, "ns");
+    };
+
+    runStream("GetSerializedData", [&](Ocp1CommandResponseRequired& command) {
+        return client.sendData(command.GetSerializedData());
+    });
+
+    std::array<std::uint8_t, 256> buffer{};
+    runStream("SerializeInto", [&](Ocp1CommandResponseRequired& command) {
+        const auto size = command.SerializeInto(buffer.data(), buffer.size());
+        return client.sendMessage(ByteSpan(buffer.data(), size));
+    });
+
+    client.disconnect(1000, Ocp1Connection::Notify::no);
+    reader.join();
+}
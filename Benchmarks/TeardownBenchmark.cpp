@@ -0,0 +1,112 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include "NanoOcp1.h"
+
+#include <memory>
+
+// How long an idle connection takes to tear down: disconnect() on a connected
+// client whose read thread is waiting for data, and Ocp1ConnectionServer::stop()
+// on an accept loop waiting for clients.  Both threads have to notice the stop
+// request while blocked, so this measures wake-up latency rather than I/O.
+
+namespace
+{
+
+using namespace NanoOcp1;
+
+constexpr int numCycles = 50;
+
+struct IdleClient : public Ocp1Connection
+{
+    IdleClient() : Ocp1Connection(false) {}
+    ~IdleClient() override { disconnect(1000, Notify::no); }
+
+    void connectionMade() override {}
+    void connectionLost() override {}
+    void messageReceived(const ByteVector&) override {}
+};
+
+struct IdleServer : public Ocp1ConnectionServer
+{
+    ~IdleServer() override { stop(); }
+
+    Ocp1Connection* createConnectionObject() override { return nullptr; }
+};
+
+} // namespace
+
+
+NANOOCP1_BENCHMARK(TeardownLatency)
+{
+    // ── Ocp1Connection::disconnect() with an idle read thread ─────────────────
+    {
+        NanoSocket listener;
+        if (!listener.createListener(0, "127.0.0.1"))
+        {
+            std::printf("  loopback setup failed\n");
+            return;
+        }
+
+        IdleClient client;
+        double total = 0.0, worst = 0.0;
+        int cycles = 0;
+        for (int i = 0; i < numCycles; ++i)
+        {
+            if (!client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000))
+                break;
+            std::unique_ptr<NanoSocket> peer(listener.waitForNextConnection());
+
+            NanoOcp1Benchmarks::Stopwatch sw;
+            client.disconnect(1000, Ocp1Connection::Notify::no);
+            const auto ms = sw.elapsedSeconds() * 1e3;
+
+            total += ms;
+            worst  = std::max(worst, ms);
+            ++cycles;
+        }
+
+        NanoOcp1Benchmarks::report("Ocp1Connection::disconnect", "mean", total / std::max(cycles, 1), "ms");
+        NanoOcp1Benchmarks::report("Ocp1Connection::disconnect", "worst", worst, "ms");
+    }
+
+    // ── Ocp1ConnectionServer::stop() with an idle accept loop ─────────────────
+    {
+        IdleServer server;
+        double total = 0.0, worst = 0.0;
+        int cycles = 0;
+        for (int i = 0; i < numCycles; ++i)
+        {
+            if (!server.beginWaitingForSocket(0, "127.0.0.1"))
+                break;
+
+            NanoOcp1Benchmarks::Stopwatch sw;
+            server.stop();
+            const auto ms = sw.elapsedSeconds() * 1e3;
+
+            total += ms;
+            worst  = std::max(worst, ms);
+            ++cycles;
+        }
+
+        NanoOcp1Benchmarks::report("Ocp1ConnectionServer::stop", "mean", total / std::max(cycles, 1), "ms");
+        NanoOcp1Benchmarks::report("Ocp1ConnectionServer::stop", "worst", worst, "ms");
+    }
+}
@@ -0,0 +1,48 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <string>
+
+
+int main(int argc, char* argv[])
+{
+    const std::string filter = argc > 1 ? argv[1] : std::string{};
+
+    int ran = 0;
+    for (const auto& benchmark : NanoOcp1Benchmarks::getRegistry())
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        std::printf("%s\n", benchmark.name.c_str());
+        benchmark.run();
+        std::printf("\n");
+        ++ran;
+    }
+
+    if (ran == 0)
+    {
+        std::fprintf(stderr, "No benchmark matches \"%s\".\n", filter.c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -18,6 +18,11 @@
 
 #include "NanoOcp1.h"
 
+#include "Ocp1Message.h"
+
+#include <algorithm>
+#include <cmath>
+
 
 namespace NanoOcp1
 {
@@ -77,6 +82,14 @@ NanoOcp1Client::NanoOcp1Client(const std::string& address, int port,
 {
 }
 
+NanoOcp1Client::NanoOcp1Client(const std::string& address, int port,
+                               std::shared_ptr<NanoReactor> reactor,
+                               bool callbacksOnMessageThread)
+    : NanoOcp1Base(address, port),
+      Ocp1Connection(std::move(reactor), callbacksOnMessageThread)
+{
+}
+
 NanoOcp1Client::~NanoOcp1Client()
 {
     m_running = false;
@@ -90,12 +103,10 @@ bool NanoOcp1Client::start()
 {
     m_running = true;
 
-    if (connectToSocket(getAddress(), getPort(), 50))
-        return true; // connection immediately established
-    else
-        startTimer(500); // start trying to establish connection
-
-    return false;
+    // The timer retries if the attempt has not succeeded by the next tick;
+    // connectionMade() stops it.
+    restartReconnectTimer();
+    return connectToSocketAsync(getAddress(), getPort(), getReconnectPolicy().connectTimeoutMs);
 }
 
 bool NanoOcp1Client::stop()
@@ -103,6 +114,10 @@ bool NanoOcp1Client::stop()
     m_running = false;
 
     stopTimer();
+    {
+        std::lock_guard<std::mutex> lock(m_reconnectMutex);
+        m_reconnectDelayMs = 0;
+    }
 
     disconnect(1000);
 
@@ -125,9 +140,67 @@ bool NanoOcp1Client::sendData(const ByteVector& data)
     return Ocp1Connection::sendMessage(data);
 }
 
+void NanoOcp1Client::setReconnectPolicy(const ReconnectPolicy& policy)
+{
+    std::lock_guard<std::mutex> lock(m_reconnectMutex);
+    m_reconnectPolicy = policy;
+}
+
+ReconnectPolicy NanoOcp1Client::getReconnectPolicy() const
+{
+    std::lock_guard<std::mutex> lock(m_reconnectMutex);
+    return m_reconnectPolicy;
+}
+
+int NanoOcp1Client::getReconnectDelayMs() const
+{
+    std::lock_guard<std::mutex> lock(m_reconnectMutex);
+    return m_reconnectDelayMs;
+}
+
+int NanoOcp1Client::nextReconnectDelayMs()
+{
+    const auto& policy = m_reconnectPolicy;
+
+    auto delay = static_cast<double>(policy.firstRetryMs);
+    if (m_reconnectAttempt > 0)
+    {
+        const auto recentlySeen = m_deviceSeen
+            && std::chrono::steady_clock::now() - m_deviceLastSeen < std::chrono::milliseconds(policy.recentlySeenMs);
+        const auto maxInterval  = recentlySeen ? policy.initialIntervalMs
+                                               : std::max(policy.initialIntervalMs, policy.maxIntervalMs);
+        delay = policy.initialIntervalMs * std::pow(std::max(policy.multiplier, 1.0), m_reconnectAttempt - 1);
+        delay = std::min(delay, static_cast<double>(maxInterval));
+    }
+
+    std::uniform_real_distribution<double> fraction(0.0, 1.0);
+    delay *= 1.0 - std::clamp(policy.jitter, 0.0, 1.0) * fraction(m_jitterRandom);
+
+    m_reconnectAttempt = std::min(m_reconnectAttempt + 1, 64); // far beyond any maxIntervalMs
+    m_reconnectDelayMs = std::max(1, static_cast<int>(delay));
+    return m_reconnectDelayMs;
+}
+
+void NanoOcp1Client::restartReconnectTimer()
+{
+    int delay = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_reconnectMutex);
+        m_reconnectAttempt = 0;
+        delay = nextReconnectDelayMs();
+    }
+    startTimer(delay);
+}
+
 void NanoOcp1Client::connectionMade()
 {
     stopTimer();
+    {
+        std::lock_guard<std::mutex> lock(m_reconnectMutex);
+        m_deviceSeen       = true;
+        m_deviceLastSeen   = std::chrono::steady_clock::now();
+        m_reconnectDelayMs = 0;
+    }
 
     if (onConnectionEstablished)
         onConnectionEstablished();
@@ -135,11 +208,16 @@ void NanoOcp1Client::connectionMade()
 
 void NanoOcp1Client::connectionLost()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_reconnectMutex);
+        m_deviceLastSeen = std::chrono::steady_clock::now();
+    }
+
     if (onConnectionLost)
         onConnectionLost();
 
     if (m_running)
-        startTimer(500); // start trying to reestablish connection
+        restartReconnectTimer(); // start trying to reestablish connection
 }
 
 void NanoOcp1Client::messageReceived(const ByteVector& message)
@@ -147,6 +225,20 @@ void NanoOcp1Client::messageReceived(const ByteVector& message)
     processReceivedData(message);
 }
 
+void NanoOcp1Client::frameReceived(const Ocp1SharedFrame& frame)
+{
+    if (onFrameReceived)
+        onFrameReceived(frame);
+    else
+        Ocp1Connection::frameReceived(frame);
+}
+
+void NanoOcp1Client::sendBackpressureChanged(bool backpressured)
+{
+    if (onSendBackpressureChanged)
+        onSendBackpressureChanged(backpressured);
+}
+
 void NanoOcp1Client::timerCallback()
 {
     // Do NOT call stopTimer() here on success. connectToSocket() already routes
@@ -162,8 +254,236 @@ void NanoOcp1Client::timerCallback()
     // never release until this thread returns. So leave stopping the timer
     // solely to connectionMade(), and just avoid redialling an already-live
     // connection while that callback is in flight.
+    // connectToSocketAsync() does not block this thread, and leaves an attempt
+    // that is still within its timeout alone.  For the same reason the next
+    // delay is set with setTimerInterval(), which unlike startTimer() does not
+    // contend with a concurrent stopTimer().
+    if (!isConnected())
+    {
+        connectToSocketAsync(getAddress(), getPort(), getReconnectPolicy().connectTimeoutMs);
+
+        int delay = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_reconnectMutex);
+            delay = nextReconnectDelayMs();
+        }
+        setTimerInterval(delay);
+    }
+}
+
+//==============================================================================
+NanoOcp1DatagramClient::NanoOcp1DatagramClient(const std::string& address, int port,
+                                               bool callbacksOnMessageThread,
+                                               ThreadPriority threadPriority)
+    : NanoOcp1Base(address, port),
+      Ocp1Connection(callbacksOnMessageThread, threadPriority)
+{
+}
+
+NanoOcp1DatagramClient::NanoOcp1DatagramClient(const std::string& address, int port,
+                                               std::shared_ptr<NanoReactor> reactor,
+                                               bool callbacksOnMessageThread)
+    : NanoOcp1Base(address, port),
+      Ocp1Connection(std::move(reactor), callbacksOnMessageThread)
+{
+}
+
+NanoOcp1DatagramClient::~NanoOcp1DatagramClient()
+{
+    m_running = false;
+    stopTimer();
+
+    // See comment in Ocp1Connection destructor.
+    disconnect(4000, Notify::no);
+}
+
+void NanoOcp1DatagramClient::setDatagramPolicy(const DatagramPolicy& policy)
+{
+    std::lock_guard<std::mutex> lock(m_policyMutex);
+    m_policy = policy;
+}
+
+DatagramPolicy NanoOcp1DatagramClient::getDatagramPolicy() const
+{
+    std::lock_guard<std::mutex> lock(m_policyMutex);
+    return m_policy;
+}
+
+bool NanoOcp1DatagramClient::start()
+{
+    stopTimer();
+    m_running = true;
+
+    const auto ok = openTransport();
+
+    // The tick serves retransmissions, which are due far more often than KeepAlives.
+    const auto policy = getDatagramPolicy();
+    startTimer(std::max(5, std::min(policy.retransmitTimeoutMs, policy.keepAliveIntervalMs) / 2));
+    return ok;
+}
+
+bool NanoOcp1DatagramClient::stop()
+{
+    m_running = false;
+
+    stopTimer();
+    disconnect(1000, Notify::no);
+    setPeerAlive(false);
+
+    return true;
+}
+
+bool NanoOcp1DatagramClient::isRunning() const
+{
+    return m_running;
+}
+
+bool NanoOcp1DatagramClient::isPeerAlive() const
+{
+    return m_peerAlive;
+}
+
+Ocp1DatagramTransport::Stats NanoOcp1DatagramClient::getDatagramStats() const
+{
+    // Only ever connected to an Ocp1DatagramTransport, see openTransport().
+    Ocp1DatagramTransport::Stats stats;
+    withTransport([&stats](NanoTransport& transport) {
+        stats = static_cast<Ocp1DatagramTransport&>(transport).getStats();
+    });
+    return stats;
+}
+
+bool NanoOcp1DatagramClient::sendData(const ByteVector& data)
+{
     if (!isConnected())
-        connectToSocket(getAddress(), getPort(), 50);
+        return false;
+
+    return Ocp1Connection::sendMessage(data);
+}
+
+bool NanoOcp1DatagramClient::openTransport()
+{
+    auto socket = std::make_unique<NanoDatagramSocket>();
+    if (!socket->connect(getAddress(), getPort()))
+        return false;
+
+    if (!connectToTransport(std::make_unique<Ocp1DatagramTransport>(std::move(socket), getDatagramPolicy())))
+        return false;
+
+    // Announce the heartbeat at once: the device need not wait an interval to
+    // learn about this client.
+    sendKeepAlive();
+    return true;
+}
+
+void NanoOcp1DatagramClient::sendKeepAlive()
+{
+    // The 16-bit form in seconds is the one every device understands; the
+    // 32-bit form in milliseconds is only used for intervals it cannot express.
+    const auto intervalMs = getDatagramPolicy().keepAliveIntervalMs;
+    auto       keepAlive  = intervalMs % 1000 == 0 && intervalMs / 1000 <= 0xffff
+                          ? Ocp1KeepAlive(static_cast<std::uint16_t>(intervalMs / 1000))
+                          : Ocp1KeepAlive(static_cast<std::uint32_t>(intervalMs));
+    sendMessage(keepAlive.GetSerializedData());
+    m_lastKeepAliveSent = std::chrono::steady_clock::now();
+}
+
+void NanoOcp1DatagramClient::setPeerAlive(bool alive)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_livenessMutex);
+        if (m_peerAlive.exchange(alive) == alive)
+            return;
+
+        // Another thread is in a callback: it reports this change when it returns,
+        // so the callbacks stay in order and never run concurrently.
+        if (m_notifyingLiveness)
+            return;
+        m_notifyingLiveness = true;
+    }
+
+    // Callbacks run without the lock, so they may call back into the client,
+    // e.g. stop().  Report until the last reported state is the current one.
+    auto reported = !alive;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_livenessMutex);
+            if (m_peerAlive == reported)
+            {
+                m_notifyingLiveness = false;
+                return;
+            }
+            reported = m_peerAlive;
+        }
+
+        if (reported && onConnectionEstablished)
+            onConnectionEstablished();
+        else if (!reported && onConnectionLost)
+            onConnectionLost();
+    }
+}
+
+void NanoOcp1DatagramClient::connectionMade()
+{
+    // The socket is open; whether anybody listens is up to the KeepAlives.
+}
+
+void NanoOcp1DatagramClient::connectionLost()
+{
+    // The socket failed; the timer reopens it.
+    setPeerAlive(false);
+}
+
+void NanoOcp1DatagramClient::messageReceived(const ByteVector& message)
+{
+    processReceivedData(message);
+}
+
+void NanoOcp1DatagramClient::frameReceived(const Ocp1SharedFrame& frame)
+{
+    if (m_running)
+        setPeerAlive(true);
+
+    if (onFrameReceived)
+        onFrameReceived(frame);
+    else
+        Ocp1Connection::frameReceived(frame);
+}
+
+void NanoOcp1DatagramClient::sendBackpressureChanged(bool backpressured)
+{
+    if (onSendBackpressureChanged)
+        onSendBackpressureChanged(backpressured);
+}
+
+void NanoOcp1DatagramClient::timerCallback()
+{
+    if (!m_running)
+        return;
+
+    if (!isConnected())
+    {
+        openTransport();
+        return;
+    }
+
+    const auto policy = getDatagramPolicy();
+    const auto now    = std::chrono::steady_clock::now();
+
+    std::chrono::steady_clock::time_point lastReceive;
+    withTransport([&lastReceive](NanoTransport& transport) {
+        auto& datagrams = static_cast<Ocp1DatagramTransport&>(transport);
+        datagrams.retransmitDue();
+        lastReceive = datagrams.getLastReceiveTime();
+    });
+
+    if (now - m_lastKeepAliveSent >= std::chrono::milliseconds(policy.keepAliveIntervalMs))
+        sendKeepAlive();
+
+    const auto silence = std::chrono::milliseconds(policy.keepAliveIntervalMs) * std::max(1, policy.missedKeepAlives);
+    if (m_peerAlive && now - lastReceive >= silence)
+        setPeerAlive(false);
 }
 
 //==============================================================================
@@ -212,11 +532,99 @@ bool NanoOcp1Server::sendData(const ByteVector& data)
     return m_activeConnection->sendData(data);
 }
 
+bool NanoOcp1Server::getAppliedSocketOptions(SocketOptions& applied) const
+{
+    if (!m_activeConnection)
+        return false;
+
+    return m_activeConnection->getAppliedSocketOptions(applied);
+}
+
+bool NanoOcp1Server::usesCompactNotifications() const
+{
+    const auto format = m_notificationFormat.load();
+    return format == NotificationFormat::Compact
+        || (format == NotificationFormat::Auto && m_peerWantsCompactNotifications.load(std::memory_order_relaxed));
+}
+
+bool NanoOcp1Server::sendNotification(const Ocp1Notification& notification)
+{
+    if (!m_activeConnection)
+        return false;
+
+    const auto type = usesCompactNotifications() ? Ocp1Message::Notification2 : Ocp1Message::Notification;
+    if (notification.GetMessageType() == type)
+    {
+        ByteVector data(notification.GetSerializedSize());
+        notification.SerializeInto(data.data(), data.size());
+        return m_activeConnection->sendData(data);
+    }
+
+    const auto parameterData = notification.GetParameterData();
+    if (type == Ocp1Message::Notification2)
+        return m_activeConnection->sendData(Ocp1Notification2(notification.GetEmitterOno(),
+            notification.GetEmitterPropertyDefLevel(), notification.GetEmitterPropertyIndex(),
+            notification.GetParamCount(), parameterData).GetSerializedData());
+
+    return m_activeConnection->sendData(Ocp1Notification(notification.GetEmitterOno(),
+        notification.GetEmitterPropertyDefLevel(), notification.GetEmitterPropertyIndex(),
+        notification.GetParamCount(), parameterData).GetSerializedData());
+}
+
+namespace
+{
+
+/** Returns true if the frame carries an AddSubscription2 or AddPropertyChangeSubscription2 command. */
+bool requestsCompactNotifications(ByteSpan frame)
+{
+    Ocp1Message::MessageType type;
+    if (!Ocp1Message::PeekMessageType(frame, type)
+        || (type != Ocp1Message::Command && type != Ocp1Message::CommandResponseRequired))
+        return false;
+
+    Ocp1PduReader pdu(frame);
+    Ocp1CommandView command;
+    while (pdu.Next(command))
+    {
+        if (command.targetOno == 0x00000004             // OcaSubscriptionManager
+            && command.methodDefLevel == 3
+            && (command.methodIndex == 8 || command.methodIndex == 10))
+            return true;
+    }
+    return false;
+}
+
+/** Peer of NanoOcp1Server: a NanoOcp1Client that watches for subscriptions asking for Notification2. */
+class NanoOcp1ServerPeer : public NanoOcp1Client
+{
+public:
+    NanoOcp1ServerPeer(bool callbacksOnMessageThread, ThreadPriority threadPriority, std::atomic<bool>& wantsCompact)
+        : NanoOcp1Client(callbacksOnMessageThread, threadPriority), m_wantsCompact(wantsCompact)
+    {
+    }
+
+    void frameReceived(const Ocp1SharedFrame& frame) override
+    {
+        if (!m_wantsCompact.load(std::memory_order_relaxed) && requestsCompactNotifications(frame))
+            m_wantsCompact.store(true, std::memory_order_relaxed);
+
+        NanoOcp1Client::frameReceived(frame);
+    }
+
+private:
+    std::atomic<bool>& m_wantsCompact;
+};
+
+} // namespace
+
 Ocp1Connection* NanoOcp1Server::createConnectionObject()
 {
-    m_activeConnection = std::make_unique<NanoOcp1Client>(
-        m_callbacksOnMessageThread, m_threadPriority);
+    m_peerWantsCompactNotifications = false;
+    m_activeConnection = std::make_unique<NanoOcp1ServerPeer>(
+        m_callbacksOnMessageThread, m_threadPriority, m_peerWantsCompactNotifications);
     m_activeConnection->onDataReceived = this->onDataReceived;
+    m_activeConnection->onFrameReceived = this->onFrameReceived;
+    m_activeConnection->onSendBackpressureChanged = this->onSendBackpressureChanged;
 
     return m_activeConnection.get();
 }
@@ -18,13 +18,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 
 #include "Ocp1Connection.h"
 #include "Ocp1ConnectionServer.h"
 #include "Ocp1DataTypes.h"
+#include "Ocp1DatagramTransport.h"
 #include "internal/NanoTimer.h"
 
 
@@ -50,18 +55,22 @@
  * | **AddSubscription** | Command that registers interest in a property: the device will send Notifications whenever that property changes. |
  *
  * ## Threading model
- * `NanoOcp1Client` runs its socket I/O on a dedicated `Ocp1Connection::ConnectionThread`.
- * All three callbacks (`onDataReceived`, `onConnectionEstablished`, `onConnectionLost`)
- * fire on the socket thread when `callbacksOnMessageThread = false`. When it is `true`
+ * `NanoOcp1Client` runs its socket I/O on a dedicated `Ocp1Connection::ConnectionThread`,
+ * or — when constructed with a `NanoReactor` — on that reactor's single I/O thread,
+ * shared with every other connection attached to it.
+ * All three callbacks (`onDataReceived` or `onFrameReceived`, `onConnectionEstablished`,
+ * `onConnectionLost`) fire on the socket thread when `callbacksOnMessageThread = false`. When it is `true`
  * (the default), they are instead posted to a dedicated `NanoAsyncDispatcher` worker
  * thread — see `Ocp1Connection`'s constructor documentation.
  *
  * ## File map
  * | Header | Contents |
  * |---|---|
- * | `NanoOcp1.h` | `NanoOcp1Client`, `NanoOcp1Server`, `NanoOcp1Base` |
+ * | `NanoOcp1.h` | `NanoOcp1Client`, `NanoOcp1DatagramClient`, `NanoOcp1Server`, `NanoOcp1Base` |
  * | `Ocp1Connection.h` | Raw TCP socket management (abstract) |
+ * | `Ocp1DatagramTransport.h` | OCP.1 over UDP: framing and retransmission, `DatagramPolicy` |
  * | `Ocp1ConnectionServer.h` | Accept-loop server |
+ * | `internal/NanoReactor.h` | Shared epoll/poll event loop for many connections |
  * | `Ocp1Message.h` | Message structs and factory; `Ocp1CommandDefinition` |
  * | `Ocp1DataTypes.h` | `ByteVector`, `Ocp1DataType`, marshal/unmarshal helpers |
  * | `Variant.h` | Type-erased OCA value with marshal/unmarshal |
@@ -71,6 +80,8 @@
 namespace NanoOcp1
 {
 
+class Ocp1Notification;
+
 /**
  * @class NanoOcp1Base
  * @brief Abstract base class shared by `NanoOcp1Client` and `NanoOcp1Server`.
@@ -121,6 +132,16 @@ public:
      */
     std::function<bool(const ByteVector&)> onDataReceived;
 
+    /**
+     * @brief Zero-copy alternative to `onDataReceived`: fired with each complete
+     * OCP.1 frame as it sits in the receive buffer.
+     *
+     * Parse the bytes in place, e.g. with `Ocp1Message::ParseNotification()`; copy
+     * the `Ocp1SharedFrame` to keep the frame beyond the call.  When set,
+     * `onDataReceived` is not called.
+     */
+    std::function<bool(const Ocp1SharedFrame&)> onFrameReceived;
+
     /**
      * @brief Fired once after a successful TCP connection is established.
      */
@@ -131,6 +152,14 @@ public:
      */
     std::function<void()> onConnectionLost;
 
+    /**
+     * @brief Fired when the outbound queue crosses its high-water mark (true) and
+     * again once it has drained to the low-water mark (false).  Senders of
+     * high-rate updates (e.g. position streams) should skip or merge updates while
+     * it is on.  See `Ocp1Connection::setSendWaterMarks()`.
+     */
+    std::function<void(bool)> onSendBackpressureChanged;
+
 protected:
     //==============================================================================
     /**
@@ -145,15 +174,40 @@ private:
     int         m_port{ 0 }; ///< Target TCP port number.
 };
 
+/**
+ * @struct ReconnectPolicy
+ * @brief How often `NanoOcp1Client` retries while it cannot connect.
+ *
+ * After `start()` or a lost connection the client tries at once, retries
+ * after `firstRetryMs`, then after `initialIntervalMs`, growing by `multiplier`
+ * per attempt up to `maxIntervalMs`.  A device that was connected less than
+ * `recentlySeenMs` ago is most likely just rebooting, so its interval stays at
+ * `initialIntervalMs` meanwhile.  Every delay is shortened by a random
+ * fraction of up to `jitter`, so that many controllers losing the same devices
+ * at once (e.g. amplifiers after a power cycle) do not retry in lockstep.
+ */
+struct ReconnectPolicy
+{
+    int    firstRetryMs{ 50 };        ///< Delay of the first retry.
+    int    initialIntervalMs{ 500 };  ///< Delay of the second retry, the start of the backoff.
+    double multiplier{ 2.0 };         ///< Growth of the interval per further attempt.
+    int    maxIntervalMs{ 30000 };    ///< Upper bound of the interval.
+    double jitter{ 0.5 };             ///< 0 = exact delays, 1 = anywhere between 0 and the delay.
+    int    recentlySeenMs{ 10000 };   ///< Backoff is held at `initialIntervalMs` this long after a connection.
+    int    connectTimeoutMs{ 400 };   ///< Time an attempt may take before it counts as failed.
+};
+
 /**
  * @class NanoOcp1Client
  * @brief OCP.1 TCP client with automatic reconnection.
  *
  * Inherits socket I/O from `Ocp1Connection` and reconnect timing from `NanoTimer`.
- * When `start()` is called, a timer fires periodically and attempts
- * `connectToSocket()` until it succeeds.  Once connected, `connectionMade()` calls
- * `onConnectionEstablished`.  On disconnect (detected by the read thread),
- * `connectionLost()` calls `onConnectionLost` and the timer resumes retrying.
+ * When `start()` is called, a timer starts `connectToSocketAsync()` attempts,
+ * spaced as set by a `ReconnectPolicy`, until one succeeds; the timer thread
+ * never waits for a handshake.  `getConnectStats()` counts the attempts.  Once
+ * connected, `connectionMade()` calls `onConnectionEstablished`.  On disconnect
+ * (detected by the read thread), `connectionLost()` calls `onConnectionLost` and
+ * the timer resumes retrying.
  */
 class NanoOcp1Client : public NanoOcp1Base, public Ocp1Connection, public NanoTimer
 {
@@ -181,12 +235,40 @@ public:
     NanoOcp1Client(const std::string& address, int port,
                    bool callbacksOnMessageThread,
                    ThreadPriority threadPriority = ThreadPriority::normal);
+
+    /**
+     * @brief Constructs a client whose socket I/O runs on a shared `NanoReactor`
+     *        instead of a dedicated read thread.
+     * @param address               IP address or hostname of the OCA device.
+     * @param port                  TCP port number (DS100 default: 50014).
+     * @param reactor               Event loop shared with other connections.
+     * @param callbacksOnMessageThread  See `Ocp1Connection`'s reactor constructor.
+     */
+    NanoOcp1Client(const std::string& address, int port,
+                   std::shared_ptr<NanoReactor> reactor,
+                   bool callbacksOnMessageThread = true);
     ~NanoOcp1Client() override;
 
     //==============================================================================
+    /** Default `ReconnectPolicy::initialIntervalMs`. */
+    static constexpr int ReconnectIntervalMs = 500;
+    /** Default `ReconnectPolicy::connectTimeoutMs`. */
+    static constexpr int ConnectTimeoutMs = 400;
+
+    /** @brief Sets the retry timing; takes effect with the next retry. */
+    void setReconnectPolicy(const ReconnectPolicy& policy);
+
+    /** @brief Returns the policy set with `setReconnectPolicy()`. */
+    ReconnectPolicy getReconnectPolicy() const;
+
+    /** @brief Returns the delay before the next retry, 0 while connected or stopped. */
+    int getReconnectDelayMs() const;
+
     /**
      * @brief Starts the reconnect timer and begins attempting to connect.
-     * @return True always; actual connection success is signalled via `onConnectionEstablished`.
+     * @return False if the first attempt could not be started (e.g. the host does not
+     *         resolve); the timer keeps retrying regardless.  Connection success is
+     *         signalled via `onConnectionEstablished`.
      */
     bool start() override;
 
@@ -202,6 +284,7 @@ public:
     //==============================================================================
     /**
      * @brief Sends serialized OCP.1 bytes over the active TCP connection.
+     * Does not block; see `Ocp1Connection::sendMessage()`.
      */
     bool sendData(const ByteVector& data) override;
 
@@ -212,15 +295,141 @@ public:
     void connectionLost() override;
     /** @brief Called by `Ocp1Connection` for each received OCP.1 frame — invokes `onDataReceived`. */
     void messageReceived(const ByteVector& message) override;
+    /** @brief Called by `Ocp1Connection` before `messageReceived()` — invokes `onFrameReceived` if set. */
+    void frameReceived(const Ocp1SharedFrame& frame) override;
+    /** @brief Called by `Ocp1Connection` on send queue water-mark crossings — invokes `onSendBackpressureChanged`. */
+    void sendBackpressureChanged(bool backpressured) override;
 
 protected:
     //==============================================================================
-    /** @brief Timer callback — attempts `connectToSocket()` when not yet connected. */
+    /** @brief Timer callback — starts `connectToSocketAsync()` when not yet connected. */
     void timerCallback() override;
 
 private:
     //==============================================================================
+    int  nextReconnectDelayMs(); ///< m_reconnectMutex held.
+    void restartReconnectTimer();
+
     bool m_running{ false }; ///< Set true by start(), false by stop().
+
+    mutable std::mutex                    m_reconnectMutex;
+    ReconnectPolicy                       m_reconnectPolicy;
+    int                                   m_reconnectAttempt{ 0 };   ///< Retries since the last start or loss.
+    int                                   m_reconnectDelayMs{ 0 };   ///< Delay of the retry scheduled last.
+    bool                                  m_deviceSeen{ false };
+    std::chrono::steady_clock::time_point m_deviceLastSeen;
+    std::minstd_rand                      m_jitterRandom{ std::random_device{}() };
+};
+
+/**
+ * @class NanoOcp1DatagramClient
+ * @brief OCP.1 UDP client for low-latency traffic such as level meters.
+ *
+ * Runs an `Ocp1Connection` over an `Ocp1DatagramTransport`, so a large
+ * response on a TCP connection to the same device cannot hold up the
+ * notifications sent over this one.  UDP has no handshake: `start()` opens the
+ * socket and sends a KeepAlive at once and then every
+ * `DatagramPolicy::keepAliveIntervalMs`.  `onConnectionEstablished` fires with
+ * the first datagram from the device, `onConnectionLost` once it has been
+ * silent for `DatagramPolicy::missedKeepAlives` intervals; both fire again as
+ * the device comes and goes, while the client keeps sending KeepAlives.
+ * Commands sent with `Ocp1CommandResponseRequired` are retransmitted until
+ * answered, as the policy says.
+ *
+ * A timer thread drives KeepAlives, retransmissions and liveness; it also
+ * fires `onConnectionLost` and reopens the socket should it fail.
+ */
+class NanoOcp1DatagramClient : public NanoOcp1Base, public Ocp1Connection, private NanoTimer
+{
+public:
+    //==============================================================================
+    /**
+     * @param address               IP address or hostname of the OCA device.
+     * @param port                  UDP port of the device.
+     * @param callbacksOnMessageThread  See `Ocp1Connection`'s constructor.
+     * @param threadPriority            OS thread priority for the socket I/O thread.
+     */
+    NanoOcp1DatagramClient(const std::string& address, int port,
+                           bool callbacksOnMessageThread = true,
+                           ThreadPriority threadPriority = ThreadPriority::normal);
+
+    /**
+     * @brief Constructs a client whose socket I/O runs on a shared `NanoReactor`.
+     * @param address               IP address or hostname of the OCA device.
+     * @param port                  UDP port of the device.
+     * @param reactor               Event loop shared with other connections.
+     * @param callbacksOnMessageThread  See `Ocp1Connection`'s reactor constructor.
+     */
+    NanoOcp1DatagramClient(const std::string& address, int port,
+                           std::shared_ptr<NanoReactor> reactor,
+                           bool callbacksOnMessageThread = true);
+    ~NanoOcp1DatagramClient() override;
+
+    //==============================================================================
+    /** @brief Sets the KeepAlive and retransmission timing; takes effect with the next `start()`. */
+    void setDatagramPolicy(const DatagramPolicy& policy);
+
+    /** @brief Returns the policy set with `setDatagramPolicy()`. */
+    DatagramPolicy getDatagramPolicy() const;
+
+    /**
+     * @brief Opens the socket and starts sending KeepAlives.
+     * @return False if the socket could not be opened (e.g. the host does not
+     *         resolve); the timer keeps retrying regardless.
+     */
+    bool start() override;
+
+    /** @brief Stops the timer and closes the socket.  @return True always. */
+    bool stop() override;
+
+    /** @brief Returns true if `start()` has been called and `stop()` has not. */
+    bool isRunning() const;
+
+    /** @brief Returns true while the device is sending, see the class description. */
+    bool isPeerAlive() const;
+
+    /** @brief Returns the transport counters, or all zero while the socket is closed. */
+    Ocp1DatagramTransport::Stats getDatagramStats() const;
+
+    //==============================================================================
+    /**
+     * @brief Sends serialized OCP.1 bytes as one datagram.  Works as soon as the
+     * socket is open, whether or not the device has answered yet.
+     */
+    bool sendData(const ByteVector& data) override;
+
+    //==============================================================================
+    /** @brief The socket is open — the device is only known to be there once it sends. */
+    void connectionMade() override;
+    /** @brief The socket failed — invokes `onConnectionLost` if the device was alive. */
+    void connectionLost() override;
+    /** @brief Called by `Ocp1Connection` for each received OCP.1 frame — invokes `onDataReceived`. */
+    void messageReceived(const ByteVector& message) override;
+    /** @brief Marks the device alive, then invokes `onFrameReceived` if set. */
+    void frameReceived(const Ocp1SharedFrame& frame) override;
+    /** @brief Called by `Ocp1Connection` on send queue water-mark crossings — invokes `onSendBackpressureChanged`. */
+    void sendBackpressureChanged(bool backpressured) override;
+
+protected:
+    //==============================================================================
+    /** @brief Timer callback — KeepAlives, retransmissions, liveness and reopening the socket. */
+    void timerCallback() override;
+
+private:
+    //==============================================================================
+    bool openTransport();
+    void sendKeepAlive();
+    void setPeerAlive(bool alive);
+
+    std::atomic<bool>  m_running{ false };
+    std::atomic<bool>  m_peerAlive{ false };
+    std::mutex         m_livenessMutex;   ///< Guards liveness transitions; not held during callbacks.
+    bool               m_notifyingLiveness{ false }; ///< A thread is calling the liveness callbacks.
+
+    mutable std::mutex m_policyMutex;
+    DatagramPolicy     m_policy;
+
+    std::chrono::steady_clock::time_point m_lastKeepAliveSent; ///< Used by start() and the timer only.
 };
 
 /**
@@ -233,6 +442,11 @@ private:
  * available and behave identically to `NanoOcp1Client`.
  *
  * Only one simultaneous connection is supported.
+ *
+ * `sendNotification()` sends property changes in the format the peer asked for:
+ * the compact AES70-2023 Notification2 once it has subscribed with
+ * AddSubscription2 or AddPropertyChangeSubscription2, the classic Notification
+ * otherwise (see `setNotificationFormat()`).
  */
 class NanoOcp1Server : public NanoOcp1Base, public Ocp1ConnectionServer
 {
@@ -279,6 +493,41 @@ public:
      */
     bool sendData(const ByteVector& data) override;
 
+    /**
+     * @brief Reports the socket options in effect on the connected peer's socket
+     *        (see `setSocketOptions()` and `Ocp1Connection::getAppliedSocketOptions()`).
+     * @return False if no peer is connected.
+     */
+    bool getAppliedSocketOptions(SocketOptions& applied) const;
+
+    //==============================================================================
+    /** @brief Wire format used by `sendNotification()`. */
+    enum class NotificationFormat
+    {
+        Auto,       ///< Notification2 once the peer subscribed with a "2" method, Notification before.
+        Legacy,     ///< Always the classic Notification.
+        Compact     ///< Always Notification2.
+    };
+
+    /** @brief Selects the notification format; defaults to Auto.  May be changed at any time. */
+    void setNotificationFormat(NotificationFormat format) { m_notificationFormat = format; }
+    NotificationFormat getNotificationFormat() const { return m_notificationFormat; }
+
+    /**
+     * @brief Returns true if `sendNotification()` currently sends Notification2,
+     *        i.e. the format is Compact, or Auto and the connected peer has
+     *        subscribed with AddSubscription2 or AddPropertyChangeSubscription2.
+     */
+    bool usesCompactNotifications() const;
+
+    /**
+     * @brief Sends a property change to the connected peer, converted to
+     *        Notification2 or the classic Notification as `usesCompactNotifications()`
+     *        says.  Accepts either type.
+     * @return False if no peer is connected or the send failed.
+     */
+    bool sendNotification(const Ocp1Notification& notification);
+
 protected:
     //==============================================================================
     /**
@@ -292,6 +541,8 @@ private:
     std::unique_ptr<NanoOcp1Client> m_activeConnection;     ///< The currently connected peer.
     bool           m_callbacksOnMessageThread{ true };      ///< Propagated to the peer client.
     ThreadPriority m_threadPriority;                        ///< Propagated to the peer client.
+    std::atomic<NotificationFormat> m_notificationFormat{ NotificationFormat::Auto };
+    std::atomic<bool> m_peerWantsCompactNotifications{ false }; ///< Set by the peer's frames, reset per connection.
 };
 
 } // namespace NanoOcp1
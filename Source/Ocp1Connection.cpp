@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <iterator>
 #include <mutex>
 #include <shared_mutex>
 
@@ -45,9 +47,52 @@ struct Ocp1Connection::ConnectionThread : public NanoThread
 };
 
 
+// ── ReactorHandler ────────────────────────────────────────────────────────────
+
+struct Ocp1Connection::ReactorHandler : public NanoReactor::Handler
+{
+    explicit ReactorHandler(Ocp1Connection& c) : owner(c) {}
+
+    ReactorHandler(const ReactorHandler&)            = delete;
+    ReactorHandler& operator=(const ReactorHandler&) = delete;
+
+    void handleReadable() override
+    {
+        if (!owner.readAvailableFrames())
+            return;
+
+        // Transports other than sockets signal writability this way, too.
+        bool flush = false;
+        {
+            std::shared_lock<std::shared_mutex> sl(owner.socketLock);
+            flush = owner.socket != nullptr && !owner.socket->isSocket();
+        }
+        if (flush && !owner.flushSendQueue())
+            owner.handleReadFailure();
+    }
+
+    void handleReceived(const std::uint8_t* data, std::size_t size) override
+    {
+        if (size == 0)
+            owner.handleReadFailure();
+        else
+            owner.receiveFrames(data, size);
+    }
+
+    void handleWritable() override
+    {
+        if (!owner.flushSendQueue())
+            owner.handleReadFailure();
+    }
+
+    Ocp1Connection& owner;
+};
+
+
 // ── SafeAction guard ──────────────────────────────────────────────────────────
 // Guards against invoking pure-virtual callbacks after the derived object has
-// been destroyed.
+// been destroyed.  Recursive, because a callback may itself trigger one: e.g.
+// messageReceived() sends, and the send raises sendBackpressureChanged().
 
 class SafeActionImpl
 {
@@ -57,27 +102,27 @@ public:
     template <typename Fn>
     void ifSafe(Fn&& fn)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         if (safe)
             fn(ref);
     }
 
     void setSafe(bool s)
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         safe = s;
     }
 
     bool isSafe()
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::recursive_mutex> lock(mutex);
         return safe;
     }
 
 private:
-    std::mutex      mutex;
-    Ocp1Connection& ref;
-    bool            safe = false;
+    std::recursive_mutex mutex;
+    Ocp1Connection&      ref;
+    bool                 safe = false;
 };
 
 class Ocp1Connection::SafeAction : public SafeActionImpl
@@ -95,9 +140,45 @@ Ocp1Connection::Ocp1Connection(bool callbacksOnMessageThread,
       m_threadPriority(threadPriority)
 {
     thread.reset(new ConnectionThread(*this));
+    threadWakeup = std::make_unique<NanoWakeup>();
+    connector    = std::make_unique<NanoConnector>();
 
     if (useMessageThread)
-        dispatcher = std::make_unique<NanoAsyncDispatcher>();
+        dispatcher = std::make_shared<NanoAsyncDispatcher>();
+}
+
+Ocp1Connection::Ocp1Connection(std::shared_ptr<NanoReactor> sharedReactor,
+                               bool callbacksOnMessageThread)
+    : useMessageThread(callbacksOnMessageThread),
+      safeAction(std::make_shared<SafeAction>(*this)),
+      reactor(std::move(sharedReactor)),
+      m_threadPriority(ThreadPriority::normal)
+{
+    assert(reactor != nullptr);
+
+    if (reactor != nullptr)
+    {
+        reactorHandler = std::make_unique<ReactorHandler>(*this);
+        connector      = std::make_unique<NanoConnector>(reactor, [this](NanoConnector::Status status) {
+            if (status == NanoConnector::Status::Connected)
+                connectCompleted();
+            else if (status == NanoConnector::Status::Failed)
+                connectAttemptFinished(false);
+        });
+
+        if (useMessageThread)
+            dispatcher = reactor->getDispatcher();
+    }
+    else
+    {
+        // Fall back to thread mode rather than leaving the connection without I/O.
+        thread.reset(new ConnectionThread(*this));
+        threadWakeup = std::make_unique<NanoWakeup>();
+        connector    = std::make_unique<NanoConnector>();
+
+        if (useMessageThread)
+            dispatcher = std::make_shared<NanoAsyncDispatcher>();
+    }
 }
 
 Ocp1Connection::~Ocp1Connection()
@@ -124,7 +205,11 @@ bool Ocp1Connection::connectToSocket(const std::string& hostName,
     disconnect(1000);
 
     auto s = std::make_unique<NanoSocket>();
-    if (s->connect(hostName, portNumber, timeOutMillisecs))
+    s->setOptions(getSocketOptions());
+    connectAttemptStarted();
+    const auto connected = s->connect(hostName, portNumber, timeOutMillisecs);
+    connectAttemptFinished(connected);
+    if (connected)
     {
         initialiseWithSocket(std::move(s));
         return true;
@@ -133,23 +218,152 @@ bool Ocp1Connection::connectToSocket(const std::string& hostName,
     return false;
 }
 
-void Ocp1Connection::disconnect(int timeoutMs, Notify notify)
+bool Ocp1Connection::connectToSocketAsync(const std::string& hostName,
+                                          int portNumber,
+                                          int timeOutMillisecs)
 {
-    // Signal exit and close the socket BEFORE joining the thread.
-    // The thread may be blocked in a blocking recv() inside readData(); closing the
-    // socket causes recv() to return -1 so the thread can observe threadShouldExit()
-    // and exit.  NanoThread::stopThread() joins unconditionally, so if the socket
-    // were closed *after* the join the two would deadlock: join waits for recv() to
-    // unblock, recv() waits for the socket to close.
-    thread->signalThreadShouldExit();
+    // An attempt in flight is left alone until its time is up.
+    if (isConnecting() && !connector->hasTimedOut())
+        return true;
 
+    // An attempt whose end went unseen — timed out or cancelled — failed.
+    connectAttemptFinished(false);
+
+    disconnect(1000);
+
+    connectAttemptStarted();
+    if (!connector->start(hostName, portNumber, timeOutMillisecs, fastOpenEnabled, getSocketOptions()))
     {
-        std::shared_lock<std::shared_mutex> sl(socketLock);
-        if (socket != nullptr) socket->close();
+        connectAttemptFinished(false);
+        return false;
+    }
+
+    if (!reactorHandler)
+    {
+        // The read thread waits for the attempts and goes on to read once one
+        // has succeeded; in reactor mode the reactor reports completion.
+        threadWakeup->drain();
+        thread->startThread(m_threadPriority);
+    }
+
+    return true;
+}
+
+bool Ocp1Connection::connectToTransport(std::unique_ptr<NanoTransport> transport)
+{
+    disconnect(1000);
+
+    if (transport == nullptr || !transport->isConnected())
+        return false;
+
+    transport->setOptions(getSocketOptions());
+    initialiseWithSocket(std::move(transport));
+    return true;
+}
+
+bool Ocp1Connection::isConnecting() const
+{
+    // Connected but not yet taken over counts as connecting.
+    const auto status = connector->getStatus();
+    return status == NanoConnector::Status::Connecting || status == NanoConnector::Status::Connected;
+}
+
+Ocp1Connection::ConnectStats Ocp1Connection::getConnectStats() const
+{
+    ConnectStats stats;
+    stats.attempts = connectAttempts.load();
+    stats.failures = connectFailures.load();
+    stats.connects = connectSuccesses.load();
+    return stats;
+}
+
+void Ocp1Connection::connectAttemptStarted()
+{
+    ++connectAttempts;
+    connectOutcomePending = true;
+}
+
+void Ocp1Connection::connectAttemptFinished(bool connected)
+{
+    // Several places may see the end of the same attempt (e.g. a timeout is
+    // noticed both by the read thread and by the next connectToSocketAsync()).
+    if (!connectOutcomePending.exchange(false))
+        return;
+
+    if (connected)
+        ++connectSuccesses;
+    else
+        ++connectFailures;
+}
+
+void Ocp1Connection::setFastOpenEnabled(bool enabled)
+{
+    fastOpenEnabled = enabled;
+}
+
+bool Ocp1Connection::setSocketOptions(const SocketOptions& options)
+{
+    std::unique_lock<std::shared_mutex> lock(socketLock);
+    socketOptions = options;
+    return socket == nullptr || socket->setOptions(options);
+}
+
+SocketOptions Ocp1Connection::getSocketOptions() const
+{
+    std::shared_lock<std::shared_mutex> lock(socketLock);
+    return socketOptions;
+}
+
+bool Ocp1Connection::getAppliedSocketOptions(SocketOptions& applied) const
+{
+    std::shared_lock<std::shared_mutex> lock(socketLock);
+    return socket != nullptr && socket->getAppliedOptions(applied);
+}
+
+void Ocp1Connection::connectCompleted()
+{
+    // Reactor thread, from within the connector's completion.
+    if (auto s = connector->takeSocket())
+    {
+        connectAttemptFinished(true);
+        initialiseWithSocket(std::move(s));
     }
+}
 
-    thread->stopThread(timeoutMs);
+void Ocp1Connection::disconnect(int timeoutMs, Notify notify)
+{
+    if (reactorHandler)
+    {
+        // Reactor mode: stop a pending connect first — a completion in progress
+        // is waited for, so it cannot register the socket behind our back.
+        connector->cancel();
+
+        // Then deregister so the reactor neither runs nor will run
+        // handleReadable() for this connection, and only then close the socket —
+        // the reactor must never see a closed (possibly already reused) fd.
+        reactor->removeHandler(reactorHandler.get());
+        threadIsRunning = false;
+    }
+    else
+    {
+        // Signal exit and wake the thread BEFORE joining it. The thread blocks in
+        // waitUntilReady() on the socket and threadWakeup with no timeout, and
+        // NanoThread::stopThread() joins unconditionally, so without the wake-up
+        // the join would wait for the next incoming byte. The socket stays open
+        // until the thread is gone: the thread never blocks in recv() itself, and
+        // closing the fd under a running poll() risks it being reused meanwhile.
+        thread->signalThreadShouldExit();
+        threadWakeup->signal();
+
+        thread->stopThread(timeoutMs);
+
+        // The thread may have been waiting for a connect; it no longer is.
+        connector->cancel();
+    }
 
+    // Hand whatever is still queued to the kernel if it takes it right away;
+    // disconnect() does not wait for a slow peer.
+    flushSendQueue();
     deleteSocket();
 
     if (notify == Notify::yes)
@@ -161,8 +375,11 @@ void Ocp1Connection::disconnect(int timeoutMs, Notify notify)
 
 void Ocp1Connection::deleteSocket()
 {
-    std::unique_lock<std::shared_mutex> sl(socketLock);
-    socket.reset();
+    {
+        std::unique_lock<std::shared_mutex> sl(socketLock);
+        socket.reset();
+    }
+    clearSendQueue();
 }
 
 bool Ocp1Connection::isConnected() const
@@ -182,33 +399,298 @@ std::string Ocp1Connection::getConnectedHostName() const
 
 // ── Send ──────────────────────────────────────────────────────────────────────
 
-bool Ocp1Connection::sendMessage(const ByteVector& message)
+bool Ocp1Connection::sendMessage(ByteSpan message)
 {
-    return writeData(const_cast<std::uint8_t*>(message.data()),
-                     static_cast<int>(message.size()))
-           == static_cast<int>(message.size());
+    NanoTransport::Buffer buffer{ message.data(), message.size() };
+    return sendBuffers(&buffer, 1);
 }
 
-int Ocp1Connection::writeData(void* data, int dataSize)
+bool Ocp1Connection::sendMessages(const std::vector<ByteVector>& messages)
 {
-    std::shared_lock<std::shared_mutex> sl(socketLock);
-    if (socket != nullptr)
-        return socket->write(data, dataSize);
-    return 0;
+    std::vector<NanoTransport::Buffer> buffers;
+    buffers.reserve(messages.size());
+    for (const auto& message : messages)
+        buffers.push_back({ message.data(), message.size() });
+
+    return sendBuffers(buffers.data(), buffers.size());
+}
+
+void Ocp1Connection::setSendWaterMarks(std::size_t lowWaterMark, std::size_t highWaterMark)
+{
+    std::lock_guard<std::mutex> lk(sendMutex);
+    sendLowWaterMark  = lowWaterMark;
+    sendHighWaterMark = std::max(lowWaterMark, highWaterMark);
+}
+
+std::size_t Ocp1Connection::getSendQueueSize() const
+{
+    std::lock_guard<std::mutex> lk(sendMutex);
+    return sendQueueBytes;
+}
+
+/** Advances buffers past written bytes; returns the index of the first unsent buffer. */
+static std::size_t consumeBuffers(NanoTransport::Buffer* buffers, std::size_t next, std::size_t written)
+{
+    while (written > 0)
+    {
+        const auto consumed = std::min(written, buffers[next].size);
+        buffers[next].data  = static_cast<const std::uint8_t*>(buffers[next].data) + consumed;
+        buffers[next].size -= consumed;
+        written            -= consumed;
+        if (buffers[next].size == 0)
+            ++next;
+    }
+    return next;
+}
+
+bool Ocp1Connection::sendBuffers(NanoTransport::Buffer* buffers, std::size_t numBuffers)
+{
+    bool backpressureStarted = false;
+    {
+        std::shared_lock<std::shared_mutex> sl(socketLock);
+        if (socket == nullptr)
+            return false;
+
+        std::lock_guard<std::mutex> lk(sendMutex);
+
+        // With nothing queued, write straight from the caller's buffers, so the
+        // common case neither copies nor involves the I/O thread.  Anything queued
+        // must go first to keep the byte stream in order.
+        std::size_t next = 0;
+        while (sendQueue.empty())
+        {
+            while (next < numBuffers && buffers[next].size == 0)
+                ++next;
+            if (next == numBuffers)
+                return true;
+
+            const auto count = std::min<std::size_t>(numBuffers - next, NanoTransport::maxGatherBuffers);
+            const auto n     = socket->writeGather(buffers + next, static_cast<int>(count));
+            if (n < 0)
+                return false; // the I/O side notices the failure and reports the loss
+            if (n == 0)
+                break;        // send buffer full
+
+            next = consumeBuffers(buffers, next, static_cast<std::size_t>(n));
+        }
+
+        for (; next < numBuffers; ++next)
+        {
+            if (buffers[next].size == 0)
+                continue;
+            const auto* data = static_cast<const std::uint8_t*>(buffers[next].data);
+            sendQueue.emplace_back(data, data + buffers[next].size);
+            sendQueueBytes += buffers[next].size;
+        }
+
+        enableSendInterest();
+
+        if (!sendBackpressured && sendQueueBytes > sendHighWaterMark)
+        {
+            sendBackpressured   = true;
+            backpressureStarted = true;
+        }
+    }
+
+    if (backpressureStarted)
+        sendBackpressureChangedInt(true);
+    return true;
+}
+
+void Ocp1Connection::enableSendInterest()
+{
+    // sendMutex held.
+    if (sendInterest || sendQueue.empty())
+        return;
+
+    sendInterest = true;
+    if (usesReactorWriteInterest())
+        reactor->setWriteInterest(reactorHandler.get(), true);
+    else if (reactorHandler)
+        return; // the transport signals free space through its handle
+    else
+        threadWakeup->signal(); // make the read thread wait for writability, too
+}
+
+bool Ocp1Connection::usesReactorWriteInterest() const
+{
+    // socketLock held, or the socket otherwise known to stay.  Only sockets
+    // poll writable; other transports report free space as readability.
+    return reactorHandler && socket != nullptr && socket->isSocket();
+}
+
+bool Ocp1Connection::flushSendQueue()
+{
+    bool backpressureEnded = false;
+    {
+        std::shared_lock<std::shared_mutex> sl(socketLock);
+        if (socket == nullptr)
+            return false;
+
+        std::lock_guard<std::mutex> lk(sendMutex);
+
+        NanoTransport::Buffer buffers[NanoTransport::maxGatherBuffers];
+        while (!sendQueue.empty())
+        {
+            std::size_t count = 0;
+            for (auto it = sendQueue.begin(); it != sendQueue.end() && count < std::size(buffers); ++it, ++count)
+                buffers[count] = { it->data(), it->size() };
+            buffers[0].data  = sendQueue.front().data() + sendQueueOffset;
+            buffers[0].size -= sendQueueOffset;
+
+            const auto n = socket->writeGather(buffers, static_cast<int>(count));
+            if (n < 0)
+                return false;
+            if (n == 0)
+                break; // send buffer full: wait for the next writable event
+
+            // Resume mid-message: pop what was sent completely, remember how far
+            // into the new front message the write got.
+            auto written    = static_cast<std::size_t>(n);
+            sendQueueBytes -= written;
+            while (written > 0)
+            {
+                const auto remaining = sendQueue.front().size() - sendQueueOffset;
+                if (written < remaining)
+                {
+                    sendQueueOffset += written;
+                    break;
+                }
+                written        -= remaining;
+                sendQueueOffset = 0;
+                sendQueue.pop_front();
+            }
+        }
+
+        if (sendQueue.empty() && sendInterest)
+        {
+            sendInterest = false;
+            if (usesReactorWriteInterest())
+                reactor->setWriteInterest(reactorHandler.get(), false);
+        }
+
+        if (sendBackpressured && sendQueueBytes <= sendLowWaterMark)
+        {
+            sendBackpressured = false;
+            backpressureEnded = true;
+        }
+    }
+
+    if (backpressureEnded)
+        sendBackpressureChangedInt(false);
+    return true;
+}
+
+void Ocp1Connection::clearSendQueue()
+{
+    bool backpressureEnded = false;
+    {
+        std::lock_guard<std::mutex> lk(sendMutex);
+        sendQueue.clear();
+        sendQueueOffset = 0;
+        sendQueueBytes  = 0;
+        sendInterest    = false;
+        backpressureEnded = sendBackpressured.exchange(false);
+    }
+
+    if (backpressureEnded)
+        sendBackpressureChangedInt(false);
+}
+
+
+// ── SendBatch ─────────────────────────────────────────────────────────────────
+
+Ocp1Connection::SendBatch::SendBatch(Ocp1Connection& connection)
+    : m_connection(connection)
+{
+}
+
+Ocp1Connection::SendBatch::~SendBatch()
+{
+    flush();
+}
+
+void Ocp1Connection::SendBatch::add(ByteVector message)
+{
+    m_pendingBytes += message.size();
+    m_messages.push_back(std::move(message));
+
+    if (m_pendingBytes >= FlushThreshold)
+        flush();
+}
+
+bool Ocp1Connection::SendBatch::flush()
+{
+    if (!m_messages.empty())
+    {
+        m_ok = m_connection.sendMessages(m_messages) && m_ok;
+        m_messages.clear();
+        m_pendingBytes = 0;
+    }
+    return m_ok;
 }
 
 
 // ── Initialise ────────────────────────────────────────────────────────────────
 
 void Ocp1Connection::initialise()
+{
+    if (prepareConnection() && !reactorHandler)
+    {
+        threadWakeup->drain(); // discard a wake-up left over from the last disconnect()
+        thread->startThread(m_threadPriority);
+    }
+}
+
+bool Ocp1Connection::prepareConnection()
 {
     safeAction->setSafe(true);
     threadIsRunning = true;
+    frameReader.reset();
+
+    // Non-blocking before connectionMade(): that callback typically sends, and
+    // sendMessage() relies on writes never blocking.
+    bool nonBlocking = false;
+    {
+        std::shared_lock<std::shared_mutex> sl(socketLock);
+        nonBlocking = socket != nullptr && socket->setNonBlocking(true);
+    }
+
     connectionMadeInt();
-    thread->startThread(m_threadPriority);
+
+    if (!nonBlocking)
+    {
+        handleReadFailure();
+        return false;
+    }
+
+    if (reactorHandler)
+    {
+        bool registered = false;
+        {
+            std::shared_lock<std::shared_mutex> sl(socketLock);
+            if (socket != nullptr)
+                registered = reactor->addHandler(socket->getHandle(), reactorHandler.get(),
+                                                 /*receiveData=*/socket->isSocket() && socket->isStream());
+        }
+
+        if (!registered)
+        {
+            handleReadFailure();
+            return false;
+        }
+
+        // connectionMade() may already have queued data while unregistered.
+        std::shared_lock<std::shared_mutex> sl(socketLock);
+        std::lock_guard<std::mutex> lk(sendMutex);
+        if (sendInterest && usesReactorWriteInterest())
+            reactor->setWriteInterest(reactorHandler.get(), true);
+    }
+
+    return true;
 }
 
-void Ocp1Connection::initialiseWithSocket(std::unique_ptr<NanoSocket> newSocket)
+void Ocp1Connection::initialiseWithSocket(std::unique_ptr<NanoTransport> newSocket)
 {
     // Assign the socket under the exclusive lock, then release before calling
     // initialise().  initialise() fires connectionMadeInt() which triggers the
@@ -238,7 +720,7 @@ void Ocp1Connection::dispatchOrCall(std::function<void(Ocp1Connection&)> fn)
         // this Ocp1Connection is torn down before the task runs — ifSafe() will
         // simply no-op once setSafe(false) has been called.
         auto action = safeAction;
-        dispatcher->post([action, fn]() { action->ifSafe(fn); });
+        dispatcher->post([action, fn = std::move(fn)]() { action->ifSafe(fn); });
     }
     else
     {
@@ -264,113 +746,205 @@ void Ocp1Connection::connectionLostInt()
     }
 }
 
-void Ocp1Connection::deliverDataInt(const ByteVector& data)
+void Ocp1Connection::sendBackpressureChangedInt(bool backpressured)
 {
-    assert(callbackConnectionState);
-    // Copy: when dispatched asynchronously this runs after the caller's local
-    // buffer (see readNextMessage()) has gone out of scope.
-    dispatchOrCall([data](Ocp1Connection& owner) { owner.messageReceived(data); });
+    dispatchOrCall([backpressured](Ocp1Connection& owner) { owner.sendBackpressureChanged(backpressured); });
 }
 
+void Ocp1Connection::sendBackpressureChanged(bool /*backpressured*/)
+{
+}
 
-// ── Read loop ─────────────────────────────────────────────────────────────────
-
-int Ocp1Connection::readData(void* data, int num)
+void Ocp1Connection::frameReceived(const Ocp1SharedFrame& frame)
 {
-    std::shared_lock<std::shared_mutex> sl(socketLock);
-    if (socket != nullptr)
-        return socket->read(data, num, true);
-    assert(false);
-    return -1;
+    // Reuse one buffer so that, once it has grown to the largest frame seen,
+    // delivering a frame no longer allocates.  Calls are serialised by ifSafe().
+    deliveryBuffer.assign(frame.data(), frame.data() + frame.size());
+    messageReceived(deliveryBuffer);
 }
 
-bool Ocp1Connection::readNextMessage()
+void Ocp1Connection::deliverDataInt(const Ocp1SharedFrame& frame)
 {
-    // Read enough data to fit an OCA header.
-    ByteVector messageData(Ocp1Header::Ocp1HeaderSize);
-    auto bytes = readData(messageData.data(), Ocp1Header::Ocp1HeaderSize);
+    assert(callbackConnectionState);
 
-    if (bytes == Ocp1Header::Ocp1HeaderSize)
+    if (useMessageThread && dispatcher)
     {
-        Ocp1Header tmpHeader(messageData);
+        // The shared frame keeps its receive buffer alive and untouched until the
+        // dispatcher has run this, so the payload is not copied.
+        dispatchOrCall([frame](Ocp1Connection& owner) { owner.frameReceived(frame); });
+    }
+    else
+    {
+        safeAction->ifSafe([&frame](Ocp1Connection& owner) { owner.frameReceived(frame); });
+    }
+}
 
-        // Resize to fit the complete OCA message (msgSize does not include the sync byte).
-        messageData.resize(static_cast<size_t>(tmpHeader.GetMessageSize()) + 1);
 
-        auto readPosition = static_cast<int>(Ocp1Header::Ocp1HeaderSize);
-        auto bytesLeft    = static_cast<int>(tmpHeader.GetMessageSize() + 1
-                                              - Ocp1Header::Ocp1HeaderSize);
-        while (bytesLeft > 0)
-        {
-            if (thread->threadShouldExit())
-                return false;
+// ── Read loop ─────────────────────────────────────────────────────────────────
+// Shared by the read thread and the reactor. Reads whatever the kernel has
+// buffered in one call, delivers every complete frame it contains and keeps a
+// trailing partial frame for the next call.
 
-            auto numThisTime = std::min(bytesLeft, 65536);
-            auto bytesIn     = readData(messageData.data() + readPosition, numThisTime);
+bool Ocp1Connection::readAvailableFrames()
+{
+    // A transport may hold data the socket will not signal again (see
+    // NanoTransport::hasBufferedData()): keep reading until it is all through.
+    bool buffered = false;
+    do
+    {
+        auto* writeBuffer = frameReader.getWriteBuffer();
 
-            // A closed or broken connection mid-message (0 = peer closed gracefully,
-            // < 0 = socket error) must be treated the same as a lost connection —
-            // delivering a truncated frame to messageReceived() would be wrong.
-            if (bytesIn <= 0)
+        auto bytes = -1;
+        {
+            std::shared_lock<std::shared_mutex> sl(socketLock);
+            if (socket != nullptr)
             {
-                if (socket != nullptr)
-                    deleteSocket();
-
-                connectionLostInt();
-                return false;
+                bytes = socket->readAvailable(writeBuffer,
+                                              static_cast<int>(frameReader.getWritableSize()));
+                buffered = bytes > 0 && socket->hasBufferedData();
             }
+        }
 
-            readPosition += bytesIn;
-            bytesLeft    -= bytesIn;
+        // The peer performed a graceful close (TCP FIN) or the socket failed. Both
+        // mean the connection is gone and must be reported via connectionLostInt()
+        // so that NanoOcp1Client retries and any dependent state machine
+        // (Ocp1Controller and subclasses) is notified instead of silently going idle.
+        if (bytes < 0)
+        {
+            handleReadFailure();
+            return false;
         }
 
-        deliverDataInt(messageData);
-        return true;
+        frameReader.commitWrite(static_cast<std::size_t>(bytes));
+        if (!deliverBufferedFrames())
+            return false;
+    } while (buffered);
+
+    return true;
+}
+
+bool Ocp1Connection::receiveFrames(const std::uint8_t* data, std::size_t size)
+{
+    // The reactor has received into one of its own buffers (io_uring); the
+    // bytes move into the frame reader so frames can outlive that buffer.
+    while (size > 0)
+    {
+        auto*      writeBuffer = frameReader.getWriteBuffer();
+        const auto chunk       = std::min(size, frameReader.getWritableSize());
+        std::memcpy(writeBuffer, data, chunk);
+        frameReader.commitWrite(chunk);
+        data += chunk;
+        size -= chunk;
+
+        if (!deliverBufferedFrames())
+            return false;
     }
+    return true;
+}
 
-    // bytes == 0: peer performed a graceful close (TCP FIN), typically observed
-    // while idle between messages. bytes < 0: socket error. Both mean the
-    // connection is gone and must be reported via connectionLostInt() so that
-    // NanoOcp1Client retries and any dependent state machine (Ocp1Controller and
-    // subclasses) is notified instead of silently going idle forever.
-    if (bytes <= 0)
+bool Ocp1Connection::deliverBufferedFrames()
+{
+    Ocp1SharedFrame frame;
+    for (;;)
     {
-        if (socket != nullptr)
-            deleteSocket();
+        switch (frameReader.nextFrame(frame))
+        {
+            case Ocp1FrameReader::Status::Frame:
+                deliverDataInt(frame);
+                break;
+            case Ocp1FrameReader::Status::Incomplete:
+                return true;
+            case Ocp1FrameReader::Status::Invalid:
+            default:
+                // Without frame sync there is no way to find the next frame boundary.
+                handleReadFailure();
+                return false;
+        }
+    }
+}
 
-        connectionLostInt();
+void Ocp1Connection::handleReadFailure()
+{
+    if (reactorHandler)
+        reactor->removeHandler(reactorHandler.get());
+
+    deleteSocket();
+    threadIsRunning = false;
+    connectionLostInt();
+}
+
+bool Ocp1Connection::runConnect(int timeoutMs)
+{
+    auto status = NanoConnector::Status::Connecting;
+    while (status == NanoConnector::Status::Connecting && !thread->threadShouldExit())
+    {
+        status = connector->wait(threadWakeup->getHandle(), timeoutMs);
+        threadWakeup->drain();
     }
 
-    return false;
+    if (status == NanoConnector::Status::Failed)
+        connectAttemptFinished(false);
+    if (status != NanoConnector::Status::Connected || thread->threadShouldExit())
+        return false;
+
+    connectAttemptFinished(true);
+
+    {
+        std::unique_lock<std::shared_mutex> sl(socketLock);
+        assert(socket == nullptr);
+        socket = connector->takeSocket();
+    }
+    return prepareConnection();
 }
 
 void Ocp1Connection::runThread()
 {
+    // Fall back to a bounded wait if the wake-up handle could not be created.
+    const auto timeoutMs = threadWakeup->isValid() ? -1 : 100;
+
+    // Started by connectToSocketAsync(): connect first, on this thread.
+    if (connector->getStatus() == NanoConnector::Status::Connecting && !runConnect(timeoutMs))
+        return;
+
     while (!thread->threadShouldExit())
     {
-        if (socket != nullptr)
+        if (socket == nullptr)
+            break;
+
+        bool wantWrite = false;
         {
-            auto ready = socket->waitUntilReady(true, 100);
+            std::lock_guard<std::mutex> lk(sendMutex);
+            wantWrite = sendInterest;
+        }
 
-            if (ready < 0)
-            {
-                deleteSocket();
-                connectionLostInt();
-                break;
-            }
+        const auto events = NanoTransport::readEvent | (wantWrite ? NanoTransport::writeEvent : 0);
+        auto ready = socket->waitForEvents(events, timeoutMs, threadWakeup->getHandle());
 
-            if (ready == 0)
-            {
-                thread->wait(1);
-                continue;
-            }
+        if (ready < 0)
+        {
+            deleteSocket();
+            connectionLostInt();
+            break;
         }
-        else
+
+        if (ready == 0)
+        {
+            // Woken by disconnect() or by newly queued data (or timed out):
+            // re-check threadShouldExit() and the write interest.
+            threadWakeup->drain();
+            continue;
+        }
+
+        if (thread->threadShouldExit())
+            break;
+
+        if ((ready & NanoTransport::writeEvent) != 0 && !flushSendQueue())
         {
+            handleReadFailure();
             break;
         }
 
-        if (thread->threadShouldExit() || !readNextMessage())
+        if ((ready & NanoTransport::readEvent) != 0 && !readAvailableFrames())
             break;
     }
 
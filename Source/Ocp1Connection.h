@@ -19,15 +19,23 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <shared_mutex>
 #include <string>
+#include <vector>
 
 #include "Ocp1DataTypes.h"
+#include "Ocp1FrameReader.h"
+#include "Ocp1HandleAllocator.h"
 #include "internal/NanoAsyncDispatcher.h"
+#include "internal/NanoConnector.h"
+#include "internal/NanoPipe.h"
+#include "internal/NanoReactor.h"
 #include "internal/NanoSocket.h"
 #include "internal/NanoThread.h"
+#include "internal/NanoWakeup.h"
 
 
 namespace NanoOcp1
@@ -45,24 +53,68 @@ class Ocp1ConnectionServer;
  * Delegates three events to pure-virtual overrides:
  * - `connectionMade()` — TCP handshake succeeded.
  * - `connectionLost()` — TCP dropped or disconnected.
- * - `messageReceived()` — a complete OCP.1 frame arrived.
+ * - `messageReceived()` — a complete OCP.1 frame arrived (via `frameReceived()`).
  *
  * `NanoOcp1Client` provides the concrete implementation.
  *
  * ## Message framing
- * `readNextMessage()` reads from the socket, checks the OCP.1 sync byte (0x3b),
- * reads the 10-byte header to determine total message size, then reads the
- * remaining bytes.  The complete frame is passed as a `ByteVector` to
- * `messageReceived()`.  `Ocp1Message::UnmarshalOcp1Message()` then parses it into
- * a typed message object.
+ * `readAvailableFrames()` reads whatever the socket has buffered in a single call
+ * into an `Ocp1FrameReader`, which checks the OCP.1 sync byte (0x3b) and uses the
+ * 10-byte header of each frame to find its end.  Every complete frame is passed as
+ * an `Ocp1SharedFrame` to `frameReceived()`; a trailing partial frame is kept for
+ * the next read.  The frame references the receive buffer directly, also when it
+ * is posted to the dispatcher thread, so delivery copies no payload.  The default
+ * `frameReceived()` copies the frame into a reused `ByteVector` for
+ * `messageReceived()`; override it to parse the bytes in place instead.
+ * `Ocp1Message::UnmarshalOcp1Message()` then parses a frame into a typed message
+ * object.  A stream that loses frame sync is treated as a lost connection.
  *
  * ## Thread safety
- * The read thread owns the socket exclusively.  Writes go through `sendMessage()`
- * which acquires `socketLock` (a `shared_mutex`).  When `callbacksOnMessageThread
- * = false`, callbacks are delivered synchronously on the read thread.  When it is
- * `true` (the default), callbacks are instead posted to a dedicated
- * `NanoAsyncDispatcher` worker thread, decoupling their execution from socket I/O —
- * see the constructor documentation.
+ * The read thread blocks until the socket is readable or `disconnect()` wakes it
+ * through a `NanoWakeup`, so it neither polls while idle nor delays teardown.
+ * It owns the socket exclusively.  Writes go through `sendMessage()` /
+ * `sendMessages()` which acquire `socketLock` (a `shared_mutex`) and never block
+ * (see "Send queue" below).  When `callbacksOnMessageThread = false`, callbacks
+ * are delivered synchronously on the read thread.  When it is `true` (the
+ * default), callbacks are instead posted to a dedicated `NanoAsyncDispatcher`
+ * worker thread, decoupling their execution from socket I/O — see the
+ * constructor documentation.
+ *
+ * ## Reactor mode
+ * A connection constructed with a `NanoReactor` does not start a read thread of its
+ * own.  Its socket is switched to non-blocking mode and registered with the reactor,
+ * whose single I/O thread runs the same `readAvailableFrames()` when the socket
+ * becomes ready — or, with the io_uring backend, hands over the bytes it has
+ * already received, which go through the same `Ocp1FrameReader`.  In this mode
+ * "the read thread" above means the reactor thread, and with
+ * `callbacksOnMessageThread = true` the reactor's shared dispatcher is used, so the
+ * number of threads does not grow with the number of connections.
+ *
+ * ## Connecting
+ * `connectToSocket()` blocks the caller until the handshake is done.
+ * `connectToSocketAsync()` only starts it: a `NanoConnector` races the host's
+ * (cached) addresses with non-blocking connects, waited for by the read thread
+ * or the reactor, and the connection proceeds as usual once one succeeds.
+ * `connectToTransport()` skips TCP altogether and runs on any `NanoTransport`,
+ * e.g. an in-process `NanoPipe` to a simulated device.
+ *
+ * ## Send queue
+ * The socket is non-blocking in both modes.  `sendMessage()` writes straight to
+ * the socket if nothing is queued and appends whatever the kernel did not take —
+ * from a whole message down to the tail of a partially written one — to a
+ * per-connection outbound queue.  The read thread (or reactor) then also waits
+ * for the socket to become writable and drains the queue, resuming mid-message.
+ * Once more than the high-water mark is queued, `sendBackpressureChanged(true)` is
+ * called; once the queue has drained to the low-water mark,
+ * `sendBackpressureChanged(false)`.  Producers that can skip or merge updates —
+ * e.g. position streams — should do so while backpressure is on.
+ *
+ * ## Batched sending
+ * Bursts of commands (e.g. one AddSubscription and one GetValue per object after
+ * connecting) should be collected in a `SendBatch`.  Its messages are handed to
+ * the OS with one gather-write (`sendmsg()` / `WSASend()`) per up to
+ * `NanoSocket::maxGatherBuffers` messages instead of one `send()` each, so they
+ * leave as a few full TCP segments.
  */
 class Ocp1Connection
 {
@@ -91,6 +143,18 @@ public:
      */
     Ocp1Connection(bool callbacksOnMessageThread = true,
                    ThreadPriority threadPriority = ThreadPriority::normal);
+
+    /**
+     * @brief Constructs a connection whose socket I/O is driven by a shared reactor.
+     * @param reactor                   Event loop to register the socket with once
+     *                                  connected. Must not be null.
+     * @param callbacksOnMessageThread  If true, callbacks are posted to the reactor's
+     *                                  shared `NanoAsyncDispatcher`; if false, they run
+     *                                  synchronously on the reactor thread and must not
+     *                                  block.
+     */
+    Ocp1Connection(std::shared_ptr<NanoReactor> reactor,
+                   bool callbacksOnMessageThread = true);
     virtual ~Ocp1Connection();
 
     Ocp1Connection(const Ocp1Connection&)            = delete;
@@ -98,7 +162,7 @@ public:
 
     /**
      * @brief Attempts a TCP connection to the given host and port.
-     * Spawns the read thread on success.
+     * Spawns the read thread (or registers with the reactor) on success.
      * @param hostName          IP address or hostname of the remote device.
      * @param portNumber        TCP port number.
      * @param timeOutMillisecs  Maximum time to wait for the TCP handshake.
@@ -106,6 +170,78 @@ public:
      */
     bool connectToSocket(const std::string& hostName, int portNumber, int timeOutMillisecs);
 
+    /**
+     * @brief Starts a TCP connection attempt and returns without waiting for it.
+     *
+     * The host's addresses are resolved once and cached (see `NanoConnector`);
+     * if there are several, they are raced in parallel and the first to connect
+     * wins.  Success is reported through `connectionMade()` as usual.  The read
+     * thread (or, in reactor mode, the reactor) waits for the attempt, so no
+     * thread blocks on a device that does not answer.
+     *
+     * Calling it again while an attempt is in flight does nothing until
+     * `timeOutMillisecs` have passed; then the attempt is restarted.
+     *
+     * @return False if the host could not be resolved or no attempt could be started.
+     */
+    bool connectToSocketAsync(const std::string& hostName, int portNumber, int timeOutMillisecs);
+
+    /**
+     * @brief Runs the connection over an already connected transport instead of
+     * a TCP socket, e.g. one end of a `NanoPipe` (see
+     * `Ocp1ConnectionServer::connectInProcess()`).  Proceeds as after a connect:
+     * `connectionMade()`, then reading on the read thread or reactor.
+     * @return False if the transport is null or not connected.
+     */
+    bool connectToTransport(std::unique_ptr<NanoTransport> transport);
+
+    /** @brief Returns true while a `connectToSocketAsync()` attempt is in flight. */
+    bool isConnecting() const;
+
+    /** @brief Counters of the connect attempts made so far, see `getConnectStats()`. */
+    struct ConnectStats
+    {
+        std::uint64_t attempts{ 0 };  ///< Connects started, blocking or asynchronous.
+        std::uint64_t failures{ 0 };  ///< Attempts that were refused, unreachable, unresolvable or timed out.
+        std::uint64_t connects{ 0 };  ///< Attempts that connected.
+    };
+
+    /**
+     * @brief Returns how many connects were attempted and how they ended, e.g. to
+     * watch the network churn caused by retrying devices that are switched off.
+     * An attempt still in flight counts in `attempts` only.
+     */
+    ConnectStats getConnectStats() const;
+
+    /**
+     * @brief Enables TCP Fast Open (Linux) for `connectToSocketAsync()` reconnects
+     * to the address that accepted the previous connection.  The messages sent
+     * from `connectionMade()` then travel with the SYN, saving a round trip.  As
+     * the handshake only starts with the first send, `connectionMade()` fires
+     * before the peer is known to be reachable — an unreachable device is
+     * reported through `connectionLost()` instead.  Off by default.
+     */
+    void setFastOpenEnabled(bool enabled);
+
+    /**
+     * @brief Sets the socket tuning — DSCP marking, buffer sizes, keepalive, … —
+     * for connections made from now on and applies it to the current one, if any.
+     * Options the OS rejects (e.g. `SO_BUSY_POLL` without `CAP_NET_ADMIN`) do not
+     * prevent connecting; check `getAppliedSocketOptions()`.
+     * @return False if the current socket rejected an option.
+     */
+    bool setSocketOptions(const SocketOptions& options);
+
+    /** @brief Returns the options set with `setSocketOptions()`. */
+    SocketOptions getSocketOptions() const;
+
+    /**
+     * @brief Reports the options in effect on the current socket, as the OS
+     * reports them (see `NanoSocket::getAppliedOptions()`).
+     * @return False if not connected.
+     */
+    bool getAppliedSocketOptions(SocketOptions& applied) const;
+
     /**
      * @brief Closes the TCP socket and stops the read thread.
      * @param timeoutMs  Maximum ms to wait for the read thread to exit.
@@ -114,21 +250,106 @@ public:
      */
     void disconnect(int timeoutMs = 0, Notify notify = Notify::yes);
 
-    /** @brief Returns true if the TCP socket is currently open. */
+    /** @brief Returns true if the TCP socket (or transport) is currently open. */
     bool isConnected() const;
 
-    /** @brief Returns the underlying socket (for diagnostics). */
-    NanoSocket* getSocket() const noexcept { return socket.get(); }
+    /** @brief Returns the reactor driving this connection, or null in thread mode. */
+    const std::shared_ptr<NanoReactor>& getReactor() const noexcept { return reactor; }
+
+    /** @brief Returns the underlying socket or other transport (for diagnostics). */
+    NanoTransport* getSocket() const noexcept { return socket.get(); }
+
+    /**
+     * @brief Returns the allocator for handles of commands sent on this connection.
+     * Thread-safe; the sequence continues across reconnects.
+     */
+    Ocp1HandleAllocator& getHandleAllocator() noexcept { return handleAllocator; }
 
     /** @brief Returns the hostname of the currently connected remote peer, or an empty string. */
     std::string getConnectedHostName() const;
 
     /**
-     * @brief Sends a complete OCP.1 frame over the TCP socket.
-     * @param message  Complete serialized OCP.1 message bytes.
-     * @return True if all bytes were written successfully.
+     * @brief Sends a complete OCP.1 frame over the TCP socket without blocking.
+     * What the socket cannot take right away is queued and sent by the I/O thread.
+     * @param message  Complete serialized OCP.1 message bytes, e.g. a `ByteVector` or
+     *                 a buffer filled by `Ocp1Message::SerializeInto()`.  Only copied
+     *                 if the socket cannot take all of it right away.
+     * @return True if the message was written or queued; false if not connected
+     *         or the socket failed.
      */
-    bool sendMessage(const ByteVector& message);
+    bool sendMessage(ByteSpan message);
+
+    /**
+     * @brief Sends several complete OCP.1 frames back-to-back using gather-writes.
+     * Queues like `sendMessage()`.
+     * @param messages  Serialized OCP.1 messages, sent in order.
+     * @return True if all messages were written or queued.
+     */
+    bool sendMessages(const std::vector<ByteVector>& messages);
+
+    static constexpr std::size_t DefaultSendLowWaterMark  = 64 * 1024;
+    static constexpr std::size_t DefaultSendHighWaterMark = 256 * 1024;
+
+    /**
+     * @brief Sets the queued-byte thresholds for `sendBackpressureChanged()`.
+     * @param lowWaterMark   Backpressure ends once no more than this is queued.
+     * @param highWaterMark  Backpressure starts once more than this is queued.
+     *                       Raised to lowWaterMark if smaller.
+     */
+    void setSendWaterMarks(std::size_t lowWaterMark, std::size_t highWaterMark);
+
+    /** @brief Returns the number of bytes waiting in the send queue. */
+    std::size_t getSendQueueSize() const;
+
+    /** @brief Returns true between the high-water and the low-water crossing. */
+    bool isSendBackpressured() const noexcept { return sendBackpressured.load(); }
+
+    /**
+     * @class SendBatch
+     * @brief Collects outgoing messages and sends them with as few writes as possible.
+     *
+     * Messages passed to `add()` are held until `flush()` or destruction, or until
+     * `FlushThreshold` bytes have accumulated, and are then written with
+     * `sendMessages()`.  Not thread-safe; intended for a burst issued by one thread.
+     *
+     * @code
+     * Ocp1Connection::SendBatch batch(*client);
+     * for (const auto& def : defs)
+     *     batch.add(Ocp1CommandResponseRequired(def.GetValueCommand(), client->getHandleAllocator(), handle).GetSerializedData());
+     * bool ok = batch.flush();
+     * @endcode
+     */
+    class SendBatch
+    {
+    public:
+        /** Pending bytes at which `add()` flushes on its own, bounding memory use. */
+        static constexpr std::size_t FlushThreshold = 64 * 1024;
+
+        explicit SendBatch(Ocp1Connection& connection);
+        /** Flushes whatever is still pending. */
+        ~SendBatch();
+
+        SendBatch(const SendBatch&)            = delete;
+        SendBatch& operator=(const SendBatch&) = delete;
+
+        /** @brief Queues one complete serialized OCP.1 message. */
+        void add(ByteVector message);
+
+        /**
+         * @brief Sends all queued messages.
+         * @return False if any message added to this batch so far could not be sent.
+         */
+        bool flush();
+
+        /** @brief Returns the number of messages queued but not yet sent. */
+        std::size_t getNumPending() const noexcept { return m_messages.size(); }
+
+    private:
+        Ocp1Connection&         m_connection;
+        std::vector<ByteVector> m_messages;
+        std::size_t             m_pendingBytes{ 0 };
+        bool                    m_ok{ true };
+    };
 
     //==============================================================================
     /** @brief Called when the TCP connection is successfully established. Override to react. */
@@ -140,26 +361,70 @@ public:
      * Pass `message` to `Ocp1Message::UnmarshalOcp1Message()` to get a typed message object.
      */
     virtual void messageReceived(const ByteVector& message) = 0;
+    /**
+     * @brief Called with each complete OCP.1 frame, before any copy is made.
+     * `frame` points into the pooled receive buffer and may be kept (by copying
+     * the `Ocp1SharedFrame`) beyond the call.  The default copies it into a reused
+     * buffer and calls `messageReceived()`.
+     */
+    virtual void frameReceived(const Ocp1SharedFrame& frame);
+    /**
+     * @brief Called when the send queue crosses the high-water mark (true) or has
+     * drained to the low-water mark (false).  Runs on the sending or the I/O
+     * thread, or on the dispatcher with `callbacksOnMessageThread`; use
+     * `isSendBackpressured()` for the current state.  The default does nothing.
+     */
+    virtual void sendBackpressureChanged(bool backpressured);
+
+protected:
+    //==============================================================================
+    /**
+     * @brief Calls `fn` with the current transport, which is not closed or
+     * replaced meanwhile — e.g. to service a transport with timers of its own
+     * (see `NanoOcp1DatagramClient`).  `fn` must not call back into the
+     * connection: `socketLock` is held, and it is not reentrant.
+     * @return False if there is no transport.
+     */
+    template <typename Fn>
+    bool withTransport(Fn&& fn) const
+    {
+        std::shared_lock<std::shared_mutex> sl(socketLock);
+        if (socket == nullptr)
+            return false;
+        fn(*socket);
+        return true;
+    }
 
 private:
     //==============================================================================
     mutable std::shared_mutex        socketLock;
-    std::unique_ptr<NanoSocket>      socket;
+    std::unique_ptr<NanoTransport>   socket;
+    SocketOptions                    socketOptions;  // for new sockets; guarded by socketLock
     bool                             callbackConnectionState = false;
     const bool                       useMessageThread;
 
     friend class Ocp1ConnectionServer;
     void initialise();
-    void initialiseWithSocket(std::unique_ptr<NanoSocket>);
+    bool prepareConnection();
+    void initialiseWithSocket(std::unique_ptr<NanoTransport>);
+    bool runConnect(int timeoutMs);
+    void connectCompleted();
     void deleteSocket();
     void connectionMadeInt();
     void connectionLostInt();
-    void deliverDataInt(const ByteVector&);
-    bool readNextMessage();
-    int  readData(void*, int);
+    void deliverDataInt(const Ocp1SharedFrame&);
+    bool readAvailableFrames();
+    bool receiveFrames(const std::uint8_t* data, std::size_t size);
+    bool deliverBufferedFrames();
+    void handleReadFailure();
+
+    Ocp1HandleAllocator               handleAllocator;
+    Ocp1FrameReader                   frameReader;    // read thread / reactor thread only
+    ByteVector                        deliveryBuffer; // reused by frameReceived(), guarded by safeAction
 
     struct ConnectionThread;
     std::unique_ptr<ConnectionThread> thread;
+    std::unique_ptr<NanoWakeup>       threadWakeup; // interrupts the read thread's wait
     std::atomic<bool>                 threadIsRunning{ false };
 
     class SafeAction;
@@ -167,12 +432,42 @@ private:
 
     // Non-null only when useMessageThread is true. Owns the worker thread that
     // connectionMadeInt()/connectionLostInt()/deliverDataInt() post to instead of
-    // calling directly.
-    std::unique_ptr<NanoAsyncDispatcher> dispatcher;
+    // calling directly. Shared with all other connections of the same reactor.
+    std::shared_ptr<NanoAsyncDispatcher> dispatcher;
     void dispatchOrCall(std::function<void(Ocp1Connection&)> fn);
 
     void runThread();
-    int  writeData(void*, int);
+    bool sendBuffers(NanoTransport::Buffer* buffers, std::size_t numBuffers);
+    bool flushSendQueue();
+    void enableSendInterest();
+    bool usesReactorWriteInterest() const;
+    void clearSendQueue();
+    void sendBackpressureChangedInt(bool backpressured);
+
+    // Outbound queue; guarded by sendMutex (taken after socketLock).
+    mutable std::mutex                sendMutex;
+    std::deque<ByteVector>            sendQueue;
+    std::size_t                       sendQueueOffset = 0; // bytes of sendQueue.front() already sent
+    std::size_t                       sendQueueBytes  = 0; // bytes not yet sent
+    std::size_t                       sendLowWaterMark  = DefaultSendLowWaterMark;
+    std::size_t                       sendHighWaterMark = DefaultSendHighWaterMark;
+    bool                              sendInterest    = false; // I/O side waits for writability
+    std::atomic<bool>                 sendBackpressured{ false };
+
+    std::unique_ptr<NanoConnector>    connector;      // drives connectToSocketAsync()
+    std::atomic<bool>                 fastOpenEnabled{ false };
+
+    void connectAttemptStarted();
+    void connectAttemptFinished(bool connected);
+    std::atomic<std::uint64_t>        connectAttempts{ 0 };
+    std::atomic<std::uint64_t>        connectFailures{ 0 };
+    std::atomic<std::uint64_t>        connectSuccesses{ 0 };
+    std::atomic<bool>                 connectOutcomePending{ false }; // counted once per attempt
+
+    // Reactor mode only (null otherwise).
+    std::shared_ptr<NanoReactor>      reactor;
+    struct ReactorHandler;
+    std::unique_ptr<ReactorHandler>   reactorHandler;
 
     ThreadPriority m_threadPriority;
 };
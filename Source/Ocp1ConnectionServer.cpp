@@ -42,8 +42,10 @@ bool Ocp1ConnectionServer::beginWaitingForSocket(const int portNumber,
     stop();
 
     socket.reset(new NanoSocket());
+    socket->setOptions(socketOptions); // inherited by accepted sockets
     if (socket->createListener(portNumber, bindAddress))
     {
+        wakeup.drain(); // discard a wake-up left over from the last stop()
         startThread(m_threadPriority);
         return true;
     }
@@ -54,10 +56,10 @@ bool Ocp1ConnectionServer::beginWaitingForSocket(const int portNumber,
 
 void Ocp1ConnectionServer::stop()
 {
+    // Wake the accept loop rather than closing the listener under it; the
+    // listener is closed once the thread has been joined.
     signalThreadShouldExit();
-
-    if (socket != nullptr)
-        socket->close();
+    wakeup.signal();
 
     stopThread(4000);
     socket.reset();
@@ -68,15 +70,39 @@ int Ocp1ConnectionServer::getBoundPort() const noexcept
     return (socket == nullptr) ? -1 : socket->getBoundPort();
 }
 
+bool Ocp1ConnectionServer::connectInProcess(Ocp1Connection& client, std::size_t capacity)
+{
+    std::unique_ptr<NanoPipe> serverEnd, clientEnd;
+    if (!NanoPipe::createPair(serverEnd, clientEnd, capacity))
+        return false;
+
+    // Server side first, so it reads whatever the client sends from connectionMade().
+    auto* newConnection = createConnectionObject();
+    if (newConnection == nullptr)
+        return false;
+
+    newConnection->initialiseWithSocket(std::move(serverEnd));
+    return client.connectToTransport(std::move(clientEnd));
+}
+
 void Ocp1ConnectionServer::run()
 {
     while (!threadShouldExit() && socket != nullptr)
     {
-        std::unique_ptr<NanoSocket> clientSocket(socket->waitForNextConnection());
+        std::unique_ptr<NanoSocket> clientSocket(socket->waitForNextConnection(wakeup.getHandle()));
 
         if (clientSocket != nullptr)
+        {
             if (auto* newConnection = createConnectionObject())
+            {
+                newConnection->setSocketOptions(clientSocket->getOptions());
                 newConnection->initialiseWithSocket(std::move(clientSocket));
+            }
+        }
+        else
+        {
+            wakeup.drain(); // woken by stop(): re-check threadShouldExit()
+        }
     }
 }
 
@@ -18,11 +18,14 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
+#include "internal/NanoPipe.h"
 #include "internal/NanoSocket.h"
 #include "internal/NanoThread.h"
+#include "internal/NanoWakeup.h"
 
 
 namespace NanoOcp1
@@ -35,7 +38,8 @@ class Ocp1Connection;
  * @class Ocp1ConnectionServer
  * @brief TCP accept-loop server base class for OCP.1 connections.
  *
- * Runs a background thread that blocks on `accept()` and calls the
+ * Runs a background thread that blocks on `accept()` (until a client connects
+ * or `stop()` wakes it) and calls the
  * pure-virtual `createConnectionObject()` each time a new TCP client connects.
  * The concrete subclass (`NanoOcp1Server`) implements `createConnectionObject()`
  * to return a `NanoOcp1Client` peer wired to the server's callbacks.
@@ -71,6 +75,28 @@ public:
     /** @brief Returns the port number the server is bound to, or -1 if not listening. */
     int getBoundPort() const noexcept;
 
+    /**
+     * @brief Sets the socket tuning for the listener and every connection it
+     * accepts.  Takes effect with the next `beginWaitingForSocket()`.
+     */
+    void setSocketOptions(const SocketOptions& options) { socketOptions = options; }
+
+    /** @brief Returns the options set with `setSocketOptions()`. */
+    const SocketOptions& getSocketOptions() const noexcept { return socketOptions; }
+
+    /**
+     * @brief Connects `client` to this server in-process, through a `NanoPipe`
+     * instead of TCP — e.g. for a simulated device in tests or benchmarks.
+     *
+     * Creates the server-side connection with `createConnectionObject()`, as for
+     * an accepted client, and hands the other end to
+     * `Ocp1Connection::connectToTransport()`.  Needs no listening socket; must
+     * not run concurrently with the accept loop creating a connection.
+     * @param capacity  Ring size per direction (see `NanoPipe`).
+     * @return False if the pipe could not be created or the server rejected it.
+     */
+    bool connectInProcess(Ocp1Connection& client, std::size_t capacity = NanoPipe::DefaultCapacity);
+
 protected:
     //==============================================================================
     /**
@@ -87,6 +113,8 @@ protected:
 private:
     //==============================================================================
     std::unique_ptr<NanoSocket> socket;
+    NanoWakeup                  wakeup; // interrupts the accept wait on stop()
+    SocketOptions               socketOptions;
 
     void run() override;
 
@@ -21,6 +21,7 @@
 #include "Ocp1Message.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 
 
@@ -48,7 +49,15 @@ void Ocp1Controller::trackObject(std::unique_ptr<Ocp1CommandDefinition> def, Val
     // Must not be called from within a tracked-object callback (no re-entrant iteration).
     const std::uint32_t ono = def->m_targetOno;
     m_onoToIdx[ono] = m_trackedObjects.size();
-    m_trackedObjects.push_back({ std::move(def), std::move(cb) });
+    m_trackedObjects.push_back({ std::move(def), std::move(cb), {} });
+}
+
+void Ocp1Controller::trackObjectView(std::unique_ptr<Ocp1CommandDefinition> def, ValueViewCallback cb)
+{
+    // Must not be called from within a tracked-object callback (no re-entrant iteration).
+    const std::uint32_t ono = def->m_targetOno;
+    m_onoToIdx[ono] = m_trackedObjects.size();
+    m_trackedObjects.push_back({ std::move(def), {}, std::move(cb) });
 }
 
 void Ocp1Controller::clearTrackedObjects()
@@ -70,7 +79,14 @@ void Ocp1Controller::connect(const std::string& host, int port, int timeoutMs)
     m_port      = port;
     m_timeoutMs = timeoutMs;
 
-    m_client = std::make_unique<NanoOcp1Client>(host, port, m_callbacksOnMessageThread);
+    if (m_reactor)
+        m_client = std::make_unique<NanoOcp1Client>(host, port, m_reactor, m_callbacksOnMessageThread);
+    else
+        m_client = std::make_unique<NanoOcp1Client>(host, port, m_callbacksOnMessageThread);
+
+    m_client->setSendWaterMarks(m_sendLowWaterMark, m_sendHighWaterMark);
+    m_client->setSocketOptions(m_socketOptions);
+    m_client->setReconnectPolicy(m_reconnectPolicy);
 
     m_client->onConnectionEstablished = [this]() {
         afterConnected();
@@ -86,14 +102,97 @@ void Ocp1Controller::connect(const std::string& host, int port, int timeoutMs)
             setState(State::Connecting);
     };
 
-    m_client->onDataReceived = [this](const ByteVector& data) {
-        return processMessage(data);
+    // Parse frames in place: tracked-object values reach their callbacks
+    // without the payload being copied on the way.
+    m_client->onFrameReceived = [this](const Ocp1SharedFrame& frame) {
+        std::lock_guard<std::mutex> lk(m_processMutex);
+        return processMessage(frame);
+    };
+
+    m_client->onSendBackpressureChanged = [this](bool backpressured) {
+        if (onSendBackpressureChanged)
+            onSendBackpressureChanged(backpressured);
     };
 
     setState(State::Connecting);
+    startNotificationClient();
     m_client->start();
 }
 
+void Ocp1Controller::setUdpNotifications(int udpPort, const DatagramPolicy& policy)
+{
+    m_udpPort        = udpPort;
+    m_datagramPolicy = policy;
+}
+
+void Ocp1Controller::startNotificationClient()
+{
+    if (m_udpPort <= 0)
+        return;
+
+    if (m_reactor)
+        m_notificationClient = std::make_unique<NanoOcp1DatagramClient>(m_host, m_udpPort, m_reactor, m_callbacksOnMessageThread);
+    else
+        m_notificationClient = std::make_unique<NanoOcp1DatagramClient>(m_host, m_udpPort, m_callbacksOnMessageThread);
+
+    m_notificationClient->setDatagramPolicy(m_datagramPolicy);
+    m_notificationClient->setSocketOptions(m_socketOptions);
+    m_notificationsLost = false;
+
+    m_notificationClient->onConnectionLost = [this]() {
+        m_notificationsLost = true;
+    };
+
+    // A device whose KeepAlives stopped has dropped its UDP subscriptions (or
+    // rebooted); while the TCP side is up, subscribe again once it is back.
+    m_notificationClient->onConnectionEstablished = [this]() {
+        const auto state = m_state.load();
+        if (m_notificationsLost.exchange(false) && state != State::Disconnected && state != State::Connecting)
+        {
+            // The TCP thread may rebuild m_trackedObjects meanwhile (see
+            // SoundscapeController::onUntrackedGetValueResponse()).
+            std::lock_guard<std::mutex> lk(m_processMutex);
+            createObjectSubscriptions();
+        }
+    };
+
+    m_notificationClient->onFrameReceived = [this](const Ocp1SharedFrame& frame) {
+        std::lock_guard<std::mutex> lk(m_processMutex);
+        return processMessage(frame);
+    };
+
+    m_notificationClient->start();
+}
+
+void Ocp1Controller::stopNotificationClient()
+{
+    if (!m_notificationClient)
+        return;
+
+    // As for m_client in disconnect(): join its threads before the callbacks go.
+    m_notificationClient->stop();
+    m_notificationClient->onConnectionEstablished = {};
+    m_notificationClient->onConnectionLost        = {};
+    m_notificationClient->onFrameReceived         = {};
+    m_notificationClient.reset();
+}
+
+void Ocp1Controller::setSendWaterMarks(std::size_t lowWaterMark, std::size_t highWaterMark)
+{
+    m_sendLowWaterMark  = lowWaterMark;
+    m_sendHighWaterMark = highWaterMark;
+}
+
+bool Ocp1Controller::isSendBackpressured() const
+{
+    return m_client && m_client->isSendBackpressured();
+}
+
+bool Ocp1Controller::getAppliedSocketOptions(SocketOptions& applied) const
+{
+    return m_client && m_client->getAppliedSocketOptions(applied);
+}
+
 void Ocp1Controller::disconnect()
 {
     // Set state first so that any callback that checks m_state (e.g. the
@@ -120,10 +219,13 @@ void Ocp1Controller::disconnect()
 
         m_client->onConnectionEstablished = {};
         m_client->onConnectionLost        = {};
-        m_client->onDataReceived          = {};
+        m_client->onFrameReceived         = {};
+        m_client->onSendBackpressureChanged = {};
         m_client.reset();
     }
 
+    stopNotificationClient();
+
     // Safe: socket thread is guaranteed dead, so no concurrent startTimer()
     // call can race with this stopTimer().
     stopTimer();
@@ -139,11 +241,51 @@ bool Ocp1Controller::setValue(const Ocp1CommandDefinition& def, const Variant& v
         return false;
 
     std::uint32_t handle{0};
-    const bool ok = m_client->sendData(
-        Ocp1CommandResponseRequired(def.SetValueCommand(value), handle).GetSerializedData());
-    if (ok)
-        addPendingSetValueHandle(handle, def.m_targetOno);
-    return ok;
+    if (m_setValueMode == SetValueMode::FireAndForget)
+        return m_client->sendData(
+            Ocp1Command(def.SetValueCommand(value), m_client->getHandleAllocator(), handle).GetSerializedData());
+
+    // Registered before sending, as the response may arrive before sendData() returns.
+    auto command = Ocp1CommandResponseRequired(def.SetValueCommand(value), m_client->getHandleAllocator(), handle);
+    addPendingSetValueHandle(handle, def.m_targetOno);
+    if (m_client->sendData(command.GetSerializedData()))
+        return true;
+    popPendingSetValueHandle(handle);
+    return false;
+}
+
+
+bool Ocp1Controller::setValue(const Ocp1PreparedCommand& command, ByteSpan parameterData)
+{
+    if (!m_client || m_state != State::Connected || !command.IsValid())
+        return false;
+
+    std::array<std::uint8_t, 256> stackFrame;
+    ByteVector heapFrame;
+    const auto size = command.GetSerializedSize(parameterData.size());
+    auto* frame = stackFrame.data();
+    if (size > stackFrame.size())
+    {
+        heapFrame.resize(size);
+        frame = heapFrame.data();
+    }
+
+    const auto handle = m_client->getHandleAllocator().next();
+    command.SerializeInto(frame, size, handle, parameterData);
+    if (command.GetMessageType() != Ocp1Message::CommandResponseRequired)
+        return m_client->sendMessage(ByteSpan(frame, size));
+
+    addPendingSetValueHandle(handle, command.GetTargetOno());
+    if (m_client->sendMessage(ByteSpan(frame, size)))
+        return true;
+    popPendingSetValueHandle(handle);
+    return false;
+}
+
+bool Ocp1Controller::setValue(const Ocp1PreparedCommand& command, const Variant& value)
+{
+    const auto parameterData = value.ToParamData(command.GetDataType());
+    return setValue(command, ByteSpan(parameterData.data(), parameterData.size()));
 }
 
 
@@ -165,21 +307,31 @@ bool Ocp1Controller::createObjectSubscriptions()
     if (!m_client || m_state == State::Disconnected)
         return false;
 
-    bool success = true;
+    // A large batch is flushed while it is still being built, so the state and
+    // each handle are set up before their command can reach the device.
+    if (!m_trackedObjects.empty() || hasPendingSubscriptions())
+        setState(State::Subscribing);
+
+    // Notifications arrive on the connection the subscriptions were made on.
+    Ocp1Connection& connection = m_notificationClient ? static_cast<Ocp1Connection&>(*m_notificationClient)
+                                                      : static_cast<Ocp1Connection&>(*m_client);
+    Ocp1Connection::SendBatch batch(connection);
+    Ocp1PduBuilder pdu;
+    // Handles come from the command connection even when the notification
+    // client sends, as all responses are matched against the same pending maps.
+    auto handle = reserveHandles(m_trackedObjects.size());
     for (const auto& tracked : m_trackedObjects)
     {
-        std::uint32_t handle{0};
-        success = m_client->sendData(
-            Ocp1CommandResponseRequired(
-                tracked.def->AddSubscriptionCommand(), handle).GetSerializedData()
-        ) && success;
-        addPendingSubscriptionHandle(handle);
+        Ocp1CommandResponseRequired command(m_compactNotifications ? tracked.def->AddSubscription2Command()
+                                                                   : tracked.def->AddSubscriptionCommand());
+        command.SetHandle(handle);
+        addPendingSubscriptionHandle(handle++);
+        addCommand(batch, pdu, command);
     }
+    if (!pdu.IsEmpty())
+        batch.add(pdu.GetSerializedData());
 
-    if (hasPendingSubscriptions())
-        setState(State::Subscribing);
-
-    return success;
+    return batch.flush();
 }
 
 bool Ocp1Controller::queryObjectValues()
@@ -187,9 +339,12 @@ bool Ocp1Controller::queryObjectValues()
     if (!m_client || m_state == State::Disconnected)
         return false;
 
-    bool success = true;
+    std::vector<const Ocp1CommandDefinition*> defs;
+    defs.reserve(m_trackedObjects.size());
     for (const auto& tracked : m_trackedObjects)
-        success = queryObjectValue(*tracked.def) && success;
+        defs.push_back(tracked.def.get());
+
+    const bool success = queryObjectValuesBatched(defs);
 
     if (hasPendingGetValues())
     {
@@ -207,17 +362,77 @@ bool Ocp1Controller::queryObjectValues()
     return success;
 }
 
+bool Ocp1Controller::queryObjectValuesBatched(const std::vector<const Ocp1CommandDefinition*>& defs)
+{
+    if (!m_client)
+        return false;
+
+    std::vector<std::uint32_t> handles;
+    handles.reserve(defs.size());
+
+    Ocp1Connection::SendBatch batch(*m_client);
+    Ocp1PduBuilder pdu;
+    auto handle = reserveHandles(defs.size());
+    for (const auto* def : defs)
+    {
+        Ocp1CommandResponseRequired command(def->GetValueCommand());
+        command.SetHandle(handle);
+        addPendingGetValueHandle(handle, def->m_targetOno);
+        handles.push_back(handle++);
+        addCommand(batch, pdu, command);
+    }
+    if (!pdu.IsEmpty())
+        batch.add(pdu.GetSerializedData());
+
+    if (batch.flush())
+        return true;
+
+    // As in queryObjectValue(), only queries that were sent stay pending.  Which
+    // part of a failed batch made it out is unknown, so none of it is tracked.
+    for (const auto handle : handles)
+        popPendingGetValueHandle(handle);
+    return false;
+}
+
+std::uint32_t Ocp1Controller::reserveHandles(std::size_t count)
+{
+    // One atomic operation for the whole batch; the block never wraps, so the
+    // caller can simply count up from the first handle.
+    return m_client->getHandleAllocator().reserve(static_cast<std::uint32_t>(count));
+}
+
+void Ocp1Controller::addCommand(Ocp1Connection::SendBatch& batch, Ocp1PduBuilder& pdu, Ocp1CommandResponseRequired& command)
+{
+    if (m_messagesPerPdu <= 1)
+    {
+        batch.add(command.GetSerializedData());
+        return;
+    }
+
+    // Well below the largest UDP datagram, so a PDU also fits the notification client.
+    constexpr std::size_t maxPduSize = 32 * 1024;
+
+    pdu.Add(command);
+    if (pdu.GetMessageCount() >= m_messagesPerPdu || pdu.GetSize() >= maxPduSize)
+    {
+        batch.add(pdu.GetSerializedData());
+        pdu.Clear();
+    }
+}
+
 bool Ocp1Controller::queryObjectValue(const Ocp1CommandDefinition& def)
 {
     if (!m_client)
         return false;
 
+    // Registered before sending, as the response may arrive before sendData() returns.
     std::uint32_t handle{0};
-    const bool ok = m_client->sendData(
-        Ocp1CommandResponseRequired(def.GetValueCommand(), handle).GetSerializedData());
-    if (ok)
-        addPendingGetValueHandle(handle, def.m_targetOno);
-    return ok;
+    auto command = Ocp1CommandResponseRequired(def.GetValueCommand(), m_client->getHandleAllocator(), handle);
+    addPendingGetValueHandle(handle, def.m_targetOno);
+    if (m_client->sendData(command.GetSerializedData()))
+        return true;
+    popPendingGetValueHandle(handle);
+    return false;
 }
 
 
@@ -262,125 +477,156 @@ void Ocp1Controller::retryPendingGetValues()
         return;
     }
 
+    std::vector<const Ocp1CommandDefinition*> defs;
+    defs.reserve(staleOnos.size());
     for (const auto ono : staleOnos)
     {
         auto it = m_onoToIdx.find(ono);
         if (it != m_onoToIdx.end())
-            queryObjectValue(*m_trackedObjects[it->second].def);
+            defs.push_back(m_trackedObjects[it->second].def.get());
     }
+    queryObjectValuesBatched(defs);
 }
 
 
 // ── Message dispatch ──────────────────────────────────────────────────────────
 
-bool Ocp1Controller::processMessage(const ByteVector& data)
+void Ocp1Controller::deliverValue(std::size_t idx, ByteSpan paramData)
 {
-    auto msg = Ocp1Message::UnmarshalOcp1Message(data);
-    if (!msg)
+    const auto& tracked = m_trackedObjects[idx];
+    if (tracked.viewCb)
+    {
+        tracked.viewCb(paramData);
+    }
+    else if (tracked.cb)
+    {
+        // Once grown to the largest value seen, the scratch buffer no longer allocates.
+        m_valueScratch.assign(paramData.begin(), paramData.end());
+        tracked.cb(m_valueScratch);
+    }
+}
+
+bool Ocp1Controller::processMessage(ByteSpan data)
+{
+    // A PDU may carry several messages of the same type (see Ocp1PduReader).
+    Ocp1PduReader pdu(data);
+    if (!pdu.IsValid())
         return false;
 
-    switch (msg->GetMessageType())
+    bool handled = false;
+    switch (pdu.GetMessageType())
     {
     case Ocp1Message::Notification:
+    case Ocp1Message::Notification2:
     {
-        const auto* notif = static_cast<Ocp1Notification*>(msg.get());
-        const auto  it    = m_onoToIdx.find(notif->GetEmitterOno());
-        if (it == m_onoToIdx.end())
-            return false;
-        const auto& tracked = m_trackedObjects[it->second];
-        if (tracked.cb)
-            tracked.cb(notif->GetParameterData());
-        return true;
+        Ocp1NotificationView notif;
+        while (pdu.Next(notif))
+            handled = processNotification(notif) || handled;
+        return handled;
     }
 
     case Ocp1Message::Response:
     {
-        const auto* resp   = static_cast<Ocp1Response*>(msg.get());
-        const auto  handle = resp->GetResponseHandle();
+        Ocp1ResponseView resp;
+        while (pdu.Next(resp))
+            handled = processResponse(resp) || handled;
+        return handled;
+    }
 
-        if (resp->GetResponseStatus() != 0)
-        {
-            // Error response — still counts as answered for state-advancement purposes.
-            const bool    wasSub      = popPendingSubscriptionHandle(handle);
-            const uint32_t failedOno  = popPendingGetValueHandle(handle);
-            popPendingSetValueHandle(handle);
+    case Ocp1Message::KeepAlive:
+        return true;
 
-            if (wasSub && !hasPendingSubscriptions())
-            {
-                setState(State::Subscribed);
-                if (hasPendingGetValues())
-                    setState(State::GetValues);
-                else
-                {
-                    stopTimer();
-                    setState(State::Connected);
-                }
-            }
-            else if (failedOno != 0 && !hasPendingGetValues())
+    default:
+        return false;
+    }
+}
+
+bool Ocp1Controller::processNotification(const Ocp1NotificationView& notif)
+{
+    const auto it = m_onoToIdx.find(notif.emitterOno);
+    if (it == m_onoToIdx.end())
+        return false;
+    deliverValue(it->second, notif.parameterData);
+    return true;
+}
+
+bool Ocp1Controller::processResponse(const Ocp1ResponseView& resp)
+{
+    const auto handle = resp.handle;
+
+    if (resp.status != 0)
+    {
+        // Error response — still counts as answered for state-advancement purposes.
+        const bool    wasSub      = popPendingSubscriptionHandle(handle);
+        const uint32_t failedOno  = popPendingGetValueHandle(handle);
+        popPendingSetValueHandle(handle);
+
+        if (wasSub && !hasPendingSubscriptions())
+        {
+            setState(State::Subscribed);
+            if (hasPendingGetValues())
+                setState(State::GetValues);
+            else
             {
                 stopTimer();
-                setState(hasPendingSubscriptions() ? State::Subscribing : State::Connected);
+                setState(State::Connected);
             }
-            return false;
         }
+        else if (failedOno != 0 && !hasPendingGetValues())
+        {
+            stopTimer();
+            setState(hasPendingSubscriptions() ? State::Subscribing : State::Connected);
+        }
+        return false;
+    }
 
-        // Subscription ACK
-        if (popPendingSubscriptionHandle(handle))
+    // Subscription ACK
+    if (popPendingSubscriptionHandle(handle))
+    {
+        if (!hasPendingSubscriptions())
         {
-            if (!hasPendingSubscriptions())
+            setState(State::Subscribed);
+            if (hasPendingGetValues())
+                setState(State::GetValues);
+            else
             {
-                setState(State::Subscribed);
-                if (hasPendingGetValues())
-                    setState(State::GetValues);
-                else
-                {
-                    stopTimer();
-                    setState(State::Connected);
-                }
+                stopTimer();
+                setState(State::Connected);
             }
-            return true;
         }
+        return true;
+    }
 
-        // GetValue response
-        const std::uint32_t getValOno = popPendingGetValueHandle(handle);
-        if (getValOno != 0)
+    // GetValue response
+    const std::uint32_t getValOno = popPendingGetValueHandle(handle);
+    if (getValOno != 0)
+    {
+        if (resp.paramCount > 0)
         {
-            if (resp->GetParamCount() > 0)
+            const auto it = m_onoToIdx.find(getValOno);
+            if (it != m_onoToIdx.end())
             {
-                const auto it = m_onoToIdx.find(getValOno);
-                if (it != m_onoToIdx.end())
-                {
-                    const auto& tracked = m_trackedObjects[it->second];
-                    if (tracked.cb)
-                        tracked.cb(resp->GetParameterData());
-                }
-                else
-                {
-                    // ONo was queried but not registered via trackObject().
-                    // Let subclasses handle it (e.g. SoundscapeController intercepts
-                    // the Fixed_GUID response here to trigger subscribe+query).
-                    onUntrackedGetValueResponse(getValOno, resp->GetParameterData());
-                }
+                deliverValue(it->second, resp.parameterData);
             }
-            if (!hasPendingGetValues())
+            else
             {
-                stopTimer();
-                setState(hasPendingSubscriptions() ? State::Subscribing : State::Connected);
+                // ONo was queried but not registered via trackObject().
+                // Let subclasses handle it (e.g. SoundscapeController intercepts
+                // the Fixed_GUID response here to trigger subscribe+query).
+                onUntrackedGetValueResponse(getValOno, ByteVector(resp.parameterData.begin(), resp.parameterData.end()));
             }
-            return true;
         }
-
-        // SetValue ACK (or any other tracked response)
-        popPendingSetValueHandle(handle);
+        if (!hasPendingGetValues())
+        {
+            stopTimer();
+            setState(hasPendingSubscriptions() ? State::Subscribing : State::Connected);
+        }
         return true;
     }
 
-    case Ocp1Message::KeepAlive:
-        return true;
-
-    default:
-        return false;
-    }
+    // SetValue ACK (or any other tracked response)
+    popPendingSetValueHandle(handle);
+    return true;
 }
 
 
@@ -449,6 +695,12 @@ std::uint32_t Ocp1Controller::popPendingSetValueHandle(std::uint32_t handle)
     return ono;
 }
 
+bool Ocp1Controller::hasPendingSetValues()
+{
+    std::lock_guard<std::mutex> lk(m_pendingMutex);
+    return !m_pendingSetValueHandles.empty();
+}
+
 void Ocp1Controller::clearPendingHandles()
 {
     std::lock_guard<std::mutex> lk(m_pendingMutex);
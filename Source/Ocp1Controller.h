@@ -20,9 +20,12 @@
 
 #include "NanoOcp1.h"
 #include "Ocp1ObjectDefinitions.h"
+#include "Ocp1Property.h"
 #include "Variant.h"
 #include "internal/NanoTimer.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <functional>
 #include <map>
@@ -42,7 +45,8 @@ namespace NanoOcp1
  *
  * Manages the connection lifecycle for any OCA-compliant device:
  * TCP connection with auto-retry, subscribe/query/set command dispatch,
- * response-handle tracking, and value-change notification delivery.
+ * response-handle tracking, and value-change notification delivery —
+ * optionally over UDP, see setUdpNotifications().
  *
  * ## Usage
  * 1. Call trackObject() for each OCA parameter of interest.
@@ -59,6 +63,8 @@ namespace NanoOcp1
  * `NanoAsyncDispatcher` worker thread rather than firing directly on the
  * NanoOcp1 socket thread — see `Ocp1Connection`'s constructor documentation.
  * Pass `false` to receive callbacks synchronously on the socket thread instead.
+ * With setReactor(), "the socket thread" is the reactor's shared I/O thread and
+ * the dispatcher is shared by all connections on that reactor.
  * Either way, callers that need to marshal onto a specific thread of their own
  * (e.g. a GUI thread) must still do so inside their callback implementations.
  *
@@ -85,6 +91,12 @@ public:
     /** Callback invoked with raw OCA parameter bytes when a tracked object changes. */
     using ValueCallback = std::function<void(const ByteVector& paramData)>;
 
+    /**
+     * Zero-copy variant of ValueCallback: paramData points into the receive
+     * buffer and is only valid for the duration of the call.
+     */
+    using ValueViewCallback = std::function<void(ByteSpan paramData)>;
+
     /**
      * @param callbacksOnMessageThread  See "Threading" above. Forwarded to the
      *                                  internal `NanoOcp1Client` on every connect().
@@ -106,6 +118,35 @@ public:
      */
     void trackObject(std::unique_ptr<Ocp1CommandDefinition> def, ValueCallback cb);
 
+    /**
+     * Like trackObject(), but the callback receives the parameter bytes in place,
+     * without the copy into a ByteVector.  Use for high-rate objects such as
+     * level meters.
+     *
+     * @param def  Heap-allocated object definition (ownership transferred).
+     * @param cb   Called with a view of the raw parameter bytes on each value update.
+     */
+    void trackObjectView(std::unique_ptr<Ocp1CommandDefinition> def, ValueViewCallback cb);
+
+    /**
+     * Like trackObject(), but the callback receives the value decoded as the
+     * property's type, without going through a Variant.  For an
+     * Ocp1Property<std::string_view> the view is only valid during the callback.
+     *
+     * @param property  Typed object definition; copied.
+     * @param cb        Called with the decoded value on each value update.
+     *                  Updates too short to decode are dropped.
+     */
+    template <typename T>
+    void trackObject(const Ocp1Property<T>& property, typename Ocp1Property<T>::Callback cb)
+    {
+        trackObjectView(std::make_unique<Ocp1Property<T>>(property), [cb = std::move(cb)](ByteSpan data) {
+            T value{};
+            if (Ocp1Property<T>::Decode(data, value))
+                cb(value);
+        });
+    }
+
     /**
      * Remove all tracked objects.  May only be called while Disconnected.
      */
@@ -113,12 +154,56 @@ public:
 
     //==========================================================================
     /**
-     * Send a SetValue command for the given definition.
+     * Send a SetValue command for the given definition, as a
+     * CommandResponseRequired or a Command depending on setSetValueMode().
      * Only succeeds when the controller is in the Connected state.
      * @return true if the command was sent successfully.
      */
     bool setValue(const Ocp1CommandDefinition& def, const Variant& value);
 
+    /**
+     * Send a command prepared once with Ocp1PreparedCommand, e.g.
+     * Ocp1PreparedCommand::SetValue(def), for frequent updates of the same object.
+     * Only the handle, sizes and parameters are written per call, into a stack
+     * buffer for parameters of up to a few hundred bytes.  The command is sent
+     * with the message type it was prepared with, regardless of setSetValueMode().
+     * Only succeeds when the controller is in the Connected state.
+     * @param parameterData  Marshaled parameters, e.g. from Variant::ToParamData().
+     * @return true if the command was sent successfully.
+     */
+    bool setValue(const Ocp1PreparedCommand& command, ByteSpan parameterData);
+
+    /**
+     * Same as above, marshaling the value as the prepared command's data type.
+     */
+    bool setValue(const Ocp1PreparedCommand& command, const Variant& value);
+
+    /**
+     * Send a SetValue command for a typed property, as a CommandResponseRequired
+     * or a Command depending on setSetValueMode().  The value is marshaled with
+     * Ocp1ValueCodec<T> into a stack buffer, without a Variant or an allocation.
+     * Only succeeds when the controller is in the Connected state.
+     * @return true if the command was sent successfully.
+     */
+    template <typename T>
+    bool setValue(const Ocp1Property<T>& property, const typename Ocp1Property<T>::ValueType& value)
+    {
+        std::array<std::uint8_t, 256> stackData;
+        ByteVector heapData;
+        const auto size = Ocp1Property<T>::GetEncodedSize(value);
+        auto* data = stackData.data();
+        if (size > stackData.size())
+        {
+            heapData.resize(size);
+            data = heapData.data();
+        }
+        Ocp1Property<T>::Encode(value, data, size);
+
+        const auto msgType = m_setValueMode == SetValueMode::FireAndForget ? Ocp1Message::Command
+                                                                           : Ocp1Message::CommandResponseRequired;
+        return setValue(Ocp1PreparedCommand::SetValue(property, msgType), ByteSpan(data, size));
+    }
+
     //==========================================================================
     /**
      * Start the connection lifecycle.  No-op if the controller is not Disconnected.
@@ -127,6 +212,94 @@ public:
      */
     void connect(const std::string& host, int port, int timeoutMs = 150);
 
+    /**
+     * Run the socket I/O of subsequent connect() calls on a shared reactor
+     * instead of a dedicated read thread.  Pass nullptr to go back to thread
+     * mode.  Takes effect on the next connect().
+     */
+    void setReactor(std::shared_ptr<NanoReactor> reactor) { m_reactor = std::move(reactor); }
+
+    /**
+     * Set the send-queue thresholds for onSendBackpressureChanged (see
+     * Ocp1Connection::setSendWaterMarks()).  Takes effect on the next connect().
+     */
+    void setSendWaterMarks(std::size_t lowWaterMark, std::size_t highWaterMark);
+
+    /**
+     * Set the socket tuning (DSCP marking, buffer sizes, keepalive, ... see
+     * SocketOptions).  Takes effect on the next connect().
+     */
+    void setSocketOptions(const SocketOptions& options) { m_socketOptions = options; }
+
+    /**
+     * Set how the client retries while the device is unreachable (backoff,
+     * jitter, see ReconnectPolicy).  Takes effect on the next connect().
+     */
+    void setReconnectPolicy(const ReconnectPolicy& policy) { m_reconnectPolicy = policy; }
+
+    /**
+     * Route subscriptions — and so the notifications they cause — over OCP.1
+     * UDP to udpPort of the same host, while GetValue and SetValue stay on TCP.
+     * High-rate notifications such as level meters then no longer queue behind
+     * large responses on the TCP stream.  A NanoOcp1DatagramClient carries
+     * them; the subscriptions are made again whenever the device comes back
+     * after its KeepAlives stopped.  Pass 0 (the default) to keep everything
+     * on TCP.  Takes effect on the next connect().
+     */
+    void setUdpNotifications(int udpPort, const DatagramPolicy& policy = {});
+
+    /**
+     * Pack up to count AddSubscription and GetValue commands into each PDU sent
+     * after connecting (see Ocp1PduBuilder), instead of one command per PDU.
+     * This saves a header per command and lets the device parse the initial
+     * sync in far fewer frames, but the device must accept PDUs with a message
+     * count above 1.  Defaults to 1.  May only be called while Disconnected.
+     */
+    void setMessagesPerPdu(std::uint16_t count) { m_messagesPerPdu = std::max<std::uint16_t>(count, 1); }
+
+    /**
+     * Subscribe with AddSubscription2 (AES70-2023) instead of AddSubscription, so
+     * that the device sends compact Notification2 messages: 8 bytes less per
+     * notification, which adds up for level meters.  The device must implement
+     * AES70-2023; notifications in either format are understood regardless.
+     * Defaults to false.  May only be called while Disconnected.
+     */
+    void setCompactNotifications(bool enabled) { m_compactNotifications = enabled; }
+    bool getCompactNotifications() const { return m_compactNotifications; }
+
+    /** How setValue() sends its commands, see setSetValueMode(). */
+    enum class SetValueMode
+    {
+        Acknowledged,   ///< CommandResponseRequired; the device answers every SetValue.
+        FireAndForget   ///< Command; the device sends no Response and no handle stays pending.
+    };
+
+    /**
+     * Send SetValues as fire-and-forget Commands (see Ocp1Command) instead of
+     * CommandResponseRequired.  Meant for high-rate streams such as positions
+     * from a tracking system: it halves the messages on the wire and leaves no
+     * handle per value to track, but a SetValue the device rejects goes
+     * unnoticed.  Values still come back as notifications for tracked objects.
+     * Defaults to Acknowledged.  May be changed at any time.
+     */
+    void setSetValueMode(SetValueMode mode) { m_setValueMode = mode; }
+    SetValueMode getSetValueMode() const { return m_setValueMode; }
+
+    /** The client carrying notifications over UDP, or null (see setUdpNotifications()). */
+    NanoOcp1DatagramClient* notificationClient() const { return m_notificationClient.get(); }
+
+    /**
+     * Report the socket options in effect on the current connection (see
+     * Ocp1Connection::getAppliedSocketOptions()).  Returns false if not connected.
+     */
+    bool getAppliedSocketOptions(SocketOptions& applied) const;
+
+    /**
+     * True while the device is not keeping up with the commands sent to it, i.e.
+     * between the high-water and low-water crossings of the send queue.
+     */
+    bool isSendBackpressured() const;
+
     /** Stop the connection and reset to Disconnected state. */
     void disconnect();
 
@@ -136,6 +309,13 @@ public:
     /** Fired on the socket thread whenever the connection state changes. */
     std::function<void(State)> onStateChanged;
 
+    /**
+     * Fired when the send queue crosses its high-water mark (true) and once it
+     * has drained to the low-water mark (false).  Callers streaming setValue()
+     * updates (e.g. positions) should skip or coalesce them while it is on.
+     */
+    std::function<void(bool)> onSendBackpressureChanged;
+
 protected:
     //==========================================================================
     /**
@@ -172,14 +352,16 @@ protected:
     virtual void onUntrackedGetValueResponse(std::uint32_t ono, const ByteVector& paramData);
 
     /**
-     * Send AddSubscription commands for every tracked object.
+     * Send AddSubscription commands for every tracked object, batched into as
+     * few socket writes as possible (see Ocp1Connection::SendBatch).
      * Transitions to Subscribing state.  Safe to call from the socket thread.
      * @return true if all commands were sent without error.
      */
     bool createObjectSubscriptions();
 
     /**
-     * Send GetValue commands for every tracked object.
+     * Send GetValue commands for every tracked object, batched like
+     * createObjectSubscriptions().
      * Transitions to GetValues state and starts the response-timeout timer.
      * If no objects are tracked, transitions directly to Connected.
      * @return true if all commands were sent without error.
@@ -209,14 +391,23 @@ protected:
 
     void addPendingSetValueHandle(std::uint32_t handle, std::uint32_t ono);
     std::uint32_t popPendingSetValueHandle(std::uint32_t handle);
+    bool hasPendingSetValues();
 
     void clearPendingHandles();
 
 private:
     //==========================================================================
-    bool processMessage(const ByteVector& data);
+    bool processMessage(ByteSpan data);
+    bool processNotification(const Ocp1NotificationView& notif);
+    bool processResponse(const Ocp1ResponseView& resp);
+    void addCommand(Ocp1Connection::SendBatch& batch, Ocp1PduBuilder& pdu, Ocp1CommandResponseRequired& command);
+    std::uint32_t reserveHandles(std::size_t count);
+    void deliverValue(std::size_t idx, ByteSpan paramData);
     void setState(State s);
     void retryPendingGetValues();
+    bool queryObjectValuesBatched(const std::vector<const Ocp1CommandDefinition*>& defs);
+    void startNotificationClient();
+    void stopNotificationClient();
 
     // NanoTimer override — fired when the GetValues response-timeout elapses.
     void timerCallback() override;
@@ -226,16 +417,32 @@ private:
     {
         std::unique_ptr<Ocp1CommandDefinition> def;
         ValueCallback                           cb;
+        ValueViewCallback                       viewCb;
     };
 
     std::vector<TrackedObject>             m_trackedObjects;
     std::unordered_map<uint32_t, size_t>   m_onoToIdx;      ///< ONo → index in m_trackedObjects
+    ByteVector                             m_valueScratch;  ///< Reused to hand parameter bytes to ValueCallbacks
 
     std::unique_ptr<NanoOcp1Client>        m_client;
     std::string                            m_host;
     int                                    m_port{50014};
     int                                    m_timeoutMs{150};
     bool                                   m_callbacksOnMessageThread;
+    std::shared_ptr<NanoReactor>           m_reactor;
+    std::size_t                            m_sendLowWaterMark{Ocp1Connection::DefaultSendLowWaterMark};
+    std::size_t                            m_sendHighWaterMark{Ocp1Connection::DefaultSendHighWaterMark};
+    SocketOptions                          m_socketOptions;
+    ReconnectPolicy                        m_reconnectPolicy;
+    std::uint16_t                          m_messagesPerPdu{1};
+    bool                                   m_compactNotifications{false};
+    std::atomic<SetValueMode>              m_setValueMode{SetValueMode::Acknowledged};
+
+    std::unique_ptr<NanoOcp1DatagramClient> m_notificationClient; ///< Null unless notifications go over UDP.
+    int                                    m_udpPort{0};
+    DatagramPolicy                         m_datagramPolicy;
+    std::atomic<bool>                      m_notificationsLost{false}; ///< UDP device silent since subscribing.
+    std::mutex                             m_processMutex;  ///< Serialises processMessage() and the UDP re-subscribe across both clients.
 
     std::atomic<State>                     m_state{State::Disconnected};
 
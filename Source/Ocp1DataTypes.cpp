@@ -16,23 +16,62 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <cassert>
+#include <algorithm>
 #include <cstring>
 
 #include "Ocp1DataTypes.h"
 
+// Batch codec kernels: SSE2 is part of every x86-64 target, AVX2 is compiled
+// in per function and selected at runtime unless the whole build targets it.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // Network byte order is native: the batch codecs are plain copies.
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NANOOCP1_BATCH_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define NANOOCP1_BATCH_AVX2
+#define NANOOCP1_TARGET_AVX2
+#include <immintrin.h>
+#elif defined(__GNUC__) || defined(__clang__)
+#define NANOOCP1_BATCH_AVX2
+#define NANOOCP1_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define NANOOCP1_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
 namespace NanoOcp1
 {
 
-static constexpr std::uint8_t uint8_8(8);
-static constexpr std::uint8_t uint8_16(16);
-static constexpr std::uint8_t uint8_24(24);
-static constexpr std::uint8_t uint8_32(32);
-static constexpr std::uint8_t uint8_40(40);
-static constexpr std::uint8_t uint8_48(48);
-static constexpr std::uint8_t uint8_56(56);
+namespace
+{
+
+/** Builds a ByteVector of the given size with one of the appending DataFromX() overloads. */
+template <typename Append>
+ByteVector AppendToByteVector(std::size_t size, Append&& append)
+{
+    ByteVector ret(size);
+    ByteAppender out(ret.data(), ret.size());
+    append(out);
+    return ret;
+}
+
+std::uint64_t ReadUint64(const std::uint8_t* buffer) noexcept
+{
+    return (static_cast<std::uint64_t>(ReadUint32(buffer)) << 32) | ReadUint32(buffer + 4);
+}
+
+void AppendUint64(std::uint64_t value, ByteAppender& out) noexcept
+{
+    out.appendUint32(static_cast<std::uint32_t>(value >> 32));
+    out.appendUint32(static_cast<std::uint32_t>(value));
+}
+
+} // namespace
 
-bool DataToBool(const ByteVector& parameterData, bool* pOk)
+bool DataToBool(ByteSpan parameterData, bool* pOk)
 {
     bool ret(false);
     bool ok = parameterData.size() == 1;
@@ -55,7 +94,12 @@ ByteVector DataFromBool(bool boolValue)
     return ByteVector{ boolValue ? static_cast<std::uint8_t>(1) : static_cast<std::uint8_t>(0) };
 }
 
-std::int32_t DataToInt32(const ByteVector& parameterData, bool* pOk)
+void DataFromBool(bool boolValue, ByteAppender& out) noexcept
+{
+    out.appendUint8(boolValue ? static_cast<std::uint8_t>(1) : static_cast<std::uint8_t>(0));
+}
+
+std::int32_t DataToInt32(ByteSpan parameterData, bool* pOk)
 {
     std::int32_t ret(0);
 
@@ -63,9 +107,7 @@ std::int32_t DataToInt32(const ByteVector& parameterData, bool* pOk)
     bool ok = (parameterData.size() >= sizeof(std::int32_t)); // 4 bytes expected.
     if (ok)
     {
-        ret = (((parameterData[0] << uint8_24) & 0xff000000) +
-               ((parameterData[1] << uint8_16) & 0x00ff0000) +
-               ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
+        ret = static_cast<std::int32_t>(ReadUint32(parameterData.data()));
     }
 
     if (pOk != nullptr)
@@ -78,18 +120,96 @@ std::int32_t DataToInt32(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromInt32(std::int32_t intValue)
 {
-    ByteVector ret;
-    ret.reserve(4);
+    return AppendToByteVector(4, [&](ByteAppender& out) { DataFromInt32(intValue, out); });
+}
 
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+void DataFromInt32(std::int32_t intValue, ByteAppender& out) noexcept
+{
+    out.appendUint32(static_cast<std::uint32_t>(intValue));
+}
+
+std::int8_t DataToInt8(ByteSpan parameterData, bool* pOk)
+{
+    std::int8_t ret(0);
+    bool ok = (parameterData.size() >= sizeof(std::int8_t));
+    if (ok)
+    {
+        ret = static_cast<std::int8_t>(parameterData[0]);
+    }
+
+    if (pOk != nullptr)
+    {
+        *pOk = ok;
+    }
+
+    return ret;
+}
+
+ByteVector DataFromInt8(std::int8_t value)
+{
+    return ByteVector{ static_cast<std::uint8_t>(value) };
+}
+
+void DataFromInt8(std::int8_t value, ByteAppender& out) noexcept
+{
+    out.appendUint8(static_cast<std::uint8_t>(value));
+}
+
+std::int16_t DataToInt16(ByteSpan parameterData, bool* pOk)
+{
+    std::int16_t ret(0);
+    bool ok = (parameterData.size() >= sizeof(std::int16_t));
+    if (ok)
+    {
+        ret = static_cast<std::int16_t>(ReadUint16(parameterData.data()));
+    }
+
+    if (pOk != nullptr)
+    {
+        *pOk = ok;
+    }
 
     return ret;
 }
 
-std::uint8_t DataToUint8(const ByteVector& parameterData, bool* pOk)
+ByteVector DataFromInt16(std::int16_t value)
+{
+    return AppendToByteVector(2, [&](ByteAppender& out) { DataFromInt16(value, out); });
+}
+
+void DataFromInt16(std::int16_t value, ByteAppender& out) noexcept
+{
+    out.appendUint16(static_cast<std::uint16_t>(value));
+}
+
+std::int64_t DataToInt64(ByteSpan parameterData, bool* pOk)
+{
+    std::int64_t ret(0);
+    bool ok = (parameterData.size() >= sizeof(std::int64_t));
+    if (ok)
+    {
+        ret = static_cast<std::int64_t>(ReadUint64(parameterData.data()));
+    }
+
+    if (pOk != nullptr)
+    {
+        *pOk = ok;
+    }
+
+    return ret;
+}
+
+ByteVector DataFromInt64(std::int64_t value)
+{
+    return AppendToByteVector(8, [&](ByteAppender& out) { DataFromInt64(value, out); });
+}
+
+void DataFromInt64(std::int64_t value, ByteAppender& out) noexcept
+{
+    AppendUint64(static_cast<std::uint64_t>(value), out);
+}
+
+std::uint8_t DataToUint8(ByteSpan parameterData, bool* pOk)
 {
     std::uint8_t ret(0);
     bool ok = (parameterData.size() >= sizeof(std::uint8_t));
@@ -108,23 +228,21 @@ std::uint8_t DataToUint8(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromUint8(std::uint8_t value)
 {
-    ByteVector ret;
-    ret.push_back(value);
-
-    return ret;
+    return ByteVector{ value };
 }
 
+void DataFromUint8(std::uint8_t value, ByteAppender& out) noexcept
+{
+    out.appendUint8(value);
+}
 
-std::uint16_t DataToUint16(const ByteVector& parameterData, bool* pOk)
+std::uint16_t DataToUint16(ByteSpan parameterData, bool* pOk)
 {
     std::uint16_t ret(0);
     bool ok = (parameterData.size() >= sizeof(std::uint16_t));
     if (ok)
     {
-        for (size_t i = 0; i < sizeof(std::uint16_t); i++)
-        {
-            ret = ((ret << static_cast<std::uint16_t>(8)) & 0xff00) + parameterData[i];
-        }
+        ret = ReadUint16(parameterData.data());
     }
 
     if (pOk != nullptr)
@@ -137,23 +255,22 @@ std::uint16_t DataToUint16(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromUint16(std::uint16_t value)
 {
-    ByteVector ret;
-    ret.push_back(static_cast<std::uint8_t>(value >> 8));
-    ret.push_back(static_cast<std::uint8_t>(value));
+    return AppendToByteVector(2, [&](ByteAppender& out) { DataFromUint16(value, out); });
+}
 
-    return ret;
+void DataFromUint16(std::uint16_t value, ByteAppender& out) noexcept
+{
+    out.appendUint16(value);
 }
 
-std::uint32_t DataToUint32(const ByteVector& parameterData, bool* pOk)
+std::uint32_t DataToUint32(ByteSpan parameterData, bool* pOk)
 {
     std::uint32_t ret(0);
 
     bool ok = (parameterData.size() >= sizeof(std::uint32_t)); // 4 bytes expected.
     if (ok)
     {
-        ret = (((parameterData[0] << uint8_24) & 0xff000000) +
-               ((parameterData[1] << uint8_16) & 0x00ff0000) +
-               ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
+        ret = ReadUint32(parameterData.data());
     }
 
     if (pOk != nullptr)
@@ -166,33 +283,22 @@ std::uint32_t DataToUint32(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromUint32(std::uint32_t intValue)
 {
-    ByteVector ret;
-    ret.reserve(4);
-
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+    return AppendToByteVector(4, [&](ByteAppender& out) { DataFromUint32(intValue, out); });
+}
 
-    return ret;
+void DataFromUint32(std::uint32_t intValue, ByteAppender& out) noexcept
+{
+    out.appendUint32(intValue);
 }
 
-std::uint64_t DataToUint64(const ByteVector& parameterData, bool* pOk)
+std::uint64_t DataToUint64(ByteSpan parameterData, bool* pOk)
 {
     std::uint64_t ret(0);
 
     bool ok = (parameterData.size() >= sizeof(std::uint64_t)); // 8 bytes expected.
     if (ok)
     {
-        // Assemble from big-endian bytes (same pattern as DataToUint32).
-        ret = ((static_cast<std::uint64_t>(parameterData[0]) << 56) & 0xff00000000000000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[1]) << 48) & 0x00ff000000000000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[2]) << 40) & 0x0000ff0000000000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[3]) << 32) & 0x000000ff00000000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[4]) << 24) & 0x00000000ff000000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[5]) << 16) & 0x0000000000ff0000ULL)
-            | ((static_cast<std::uint64_t>(parameterData[6]) <<  8) & 0x000000000000ff00ULL)
-            |  (static_cast<std::uint64_t>(parameterData[7])        & 0x00000000000000ffULL);
+        ret = ReadUint64(parameterData.data());
     }
 
     if (pOk != nullptr)
@@ -205,20 +311,15 @@ std::uint64_t DataToUint64(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromUint64(std::uint64_t intValue)
 {
-    return ByteVector
-        ({
-            static_cast<std::uint8_t>(intValue >> 56),
-            static_cast<std::uint8_t>(intValue >> 48),
-            static_cast<std::uint8_t>(intValue >> 40),
-            static_cast<std::uint8_t>(intValue >> 32),
-            static_cast<std::uint8_t>(intValue >> 24),
-            static_cast<std::uint8_t>(intValue >> 16),
-            static_cast<std::uint8_t>(intValue >> 8),
-            static_cast<std::uint8_t>(intValue),
-        });
+    return AppendToByteVector(8, [&](ByteAppender& out) { DataFromUint64(intValue, out); });
 }
 
-std::string DataToString(const ByteVector& parameterData, bool* pOk)
+void DataFromUint64(std::uint64_t intValue, ByteAppender& out) noexcept
+{
+    AppendUint64(intValue, out);
+}
+
+std::string DataToString(ByteSpan parameterData, bool* pOk)
 {
     std::string ret;
 
@@ -236,34 +337,56 @@ std::string DataToString(const ByteVector& parameterData, bool* pOk)
 
 ByteVector DataFromString(const std::string& string)
 {
-    ByteVector ret;
+    return AppendToByteVector(string.length() + 2, [&](ByteAppender& out) { DataFromString(string, out); });
+}
+
+void DataFromString(std::string_view string, ByteAppender& out) noexcept
+{
+    out.appendUint16(static_cast<std::uint16_t>(string.length()));
+    out.appendBytes(reinterpret_cast<const std::uint8_t*>(string.data()), string.length());
+}
+
+std::float_t DataToFloat(ByteSpan parameterData, bool* pOk)
+{
+    float ret(0);
 
-    const char* pStringData = string.c_str();
-    std::size_t stringLength = string.length();
+    bool ok = (parameterData.size() >= sizeof(float)); // 4 bytes expected.
+    if (ok)
+    {
+        const auto intValue = ReadUint32(parameterData.data());
+        std::memcpy(&ret, &intValue, sizeof(ret));
+    }
 
-    ret.reserve(stringLength + static_cast<std::size_t>(2));
-    ret.push_back(static_cast<std::uint8_t>(stringLength >> static_cast<std::size_t>(8)));
-    ret.push_back(static_cast<std::uint8_t>(stringLength));
-    for (int i = 0; i < (int)stringLength; i++)
+    if (pOk != nullptr)
     {
-        ret.push_back(static_cast<std::uint8_t>(pStringData[i]));
+        *pOk = ok;
     }
 
     return ret;
 }
 
-std::float_t DataToFloat(const ByteVector& parameterData, bool* pOk)
+ByteVector DataFromFloat(std::float_t floatValue)
+{
+    return AppendToByteVector(4, [&](ByteAppender& out) { DataFromFloat(floatValue, out); });
+}
+
+void DataFromFloat(std::float_t floatValue, ByteAppender& out) noexcept
+{
+    const float value = floatValue;
+    std::uint32_t intValue;
+    std::memcpy(&intValue, &value, sizeof(intValue));
+    out.appendUint32(intValue);
+}
+
+std::double_t DataToDouble(ByteSpan parameterData, bool* pOk)
 {
-    std::float_t ret(0);
+    double ret(0);
 
-    bool ok = (parameterData.size() >= sizeof(std::float_t)); // 4 bytes expected.
-    ok = ok && (sizeof(int) == sizeof(std::float_t)); // Required for pointer cast to work
+    bool ok = (parameterData.size() >= sizeof(double)); // 8 bytes expected.
     if (ok)
     {
-        int intValue = (((parameterData[0] << uint8_24) & 0xff000000) +
-                        ((parameterData[1] << uint8_16) & 0x00ff0000) +
-                        ((parameterData[2] << uint8_8)  & 0x0000ff00) + parameterData[3]);
-        ret = *(std::float_t*)&intValue;
+        const auto intValue = ReadUint64(parameterData.data());
+        std::memcpy(&ret, &intValue, sizeof(ret));
     }
 
     if (pOk != nullptr)
@@ -274,39 +397,32 @@ std::float_t DataToFloat(const ByteVector& parameterData, bool* pOk)
     return ret;
 }
 
-ByteVector DataFromFloat(std::float_t floatValue)
+ByteVector DataFromDouble(std::double_t doubleValue)
 {
-    ByteVector ret;
-    ret.reserve(4);
-
-    assert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work
-    std::uint32_t intValue = *(std::uint32_t*)&floatValue;
-
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+    return AppendToByteVector(8, [&](ByteAppender& out) { DataFromDouble(doubleValue, out); });
+}
 
-    return ret;
+void DataFromDouble(std::double_t doubleValue, ByteAppender& out) noexcept
+{
+    const double value = doubleValue;
+    std::uint64_t intValue;
+    std::memcpy(&intValue, &value, sizeof(intValue));
+    AppendUint64(intValue, out);
 }
 
-std::double_t DataToDouble(const ByteVector& parameterData, bool* pOk)
+std::vector<bool> DataToBitString(ByteSpan parameterData, bool* pOk)
 {
-    std::double_t ret(0);
+    std::vector<bool> ret;
 
-    bool ok = (parameterData.size() >= sizeof(std::double_t)); // 8 bytes expected.
-    ok = ok && (sizeof(std::uint64_t) == sizeof(std::double_t)); // Required for pointer cast to work
+    bool ok = parameterData.size() >= 2; // At least 2 bytes for the bit count
+    const std::size_t count = ok ? ReadUint16(parameterData.data()) : 0;
+    ok = ok && (parameterData.size() - 2 >= (count + 7) / 8);
     if (ok)
     {
-        std::uint64_t intValue = (((static_cast<std::uint64_t>(parameterData[0]) << uint8_56) & 0xff00000000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[1]) << uint8_48) & 0x00ff000000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[2]) << uint8_40) & 0x0000ff0000000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[3]) << uint8_32) & 0x000000ff00000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[4]) << uint8_24) & 0x00000000ff000000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[5]) << uint8_16) & 0x0000000000ff0000ULL) +
-                                  ((static_cast<std::uint64_t>(parameterData[6]) << uint8_8)  & 0x000000000000ff00ULL) +
-                                  parameterData[7]);
-        ret = *(std::double_t*)&intValue;
+        ret.resize(count);
+        const auto* packed = parameterData.data() + 2;
+        for (std::size_t i = 0; i < count; ++i)
+            ret[i] = ((packed[i / 8] >> (7 - i % 8)) & 1) != 0;
     }
 
     if (pOk != nullptr)
@@ -317,48 +433,36 @@ std::double_t DataToDouble(const ByteVector& parameterData, bool* pOk)
     return ret;
 }
 
-ByteVector DataFromDouble(std::double_t doubleValue)
+ByteVector DataFromBitString(const std::vector<bool>& bits)
 {
-    assert(sizeof(std::uint64_t) == sizeof(std::double_t)); // Required for pointer cast to work
-    std::uint64_t intValue = *(std::uint64_t*)&doubleValue;
+    // Sized for the bits the 2-byte count can cover, as the appender overload writes no more.
+    const auto count = std::min<std::size_t>(bits.size(), 0xffff);
+    return AppendToByteVector(2 + (count + 7) / 8, [&](ByteAppender& out) { DataFromBitString(bits, out); });
+}
 
-    return ByteVector
-        ({
-            static_cast<std::uint8_t>(intValue >> 56),
-            static_cast<std::uint8_t>(intValue >> 48),
-            static_cast<std::uint8_t>(intValue >> 40),
-            static_cast<std::uint8_t>(intValue >> 32),
-            static_cast<std::uint8_t>(intValue >> 24),
-            static_cast<std::uint8_t>(intValue >> 16),
-            static_cast<std::uint8_t>(intValue >> 8),
-            static_cast<std::uint8_t>(intValue),
-        });
+void DataFromBitString(const std::vector<bool>& bits, ByteAppender& out) noexcept
+{
+    const auto count = std::min<std::size_t>(bits.size(), 0xffff);
+    out.appendUint16(static_cast<std::uint16_t>(count));
+    for (std::size_t i = 0; i < count; i += 8)
+    {
+        std::uint8_t packed = 0;
+        for (std::size_t bit = 0; bit < 8 && i + bit < count; ++bit)
+            packed |= static_cast<std::uint8_t>(bits[i + bit] ? 0x80 >> bit : 0);
+        out.appendUint8(packed);
+    }
 }
 
 ByteVector DataFromPosition(std::float_t x, std::float_t y, std::float_t z)
 {
-    assert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast below
-    std::uint32_t xInt = *(std::uint32_t*)&x;
-    std::uint32_t yInt = *(std::uint32_t*)&y;
-    std::uint32_t zInt = *(std::uint32_t*)&z;
-
-    ByteVector ret
-    ({
-        static_cast<std::uint8_t>(xInt >> 24),
-        static_cast<std::uint8_t>(xInt >> 16),
-        static_cast<std::uint8_t>(xInt >> 8),
-        static_cast<std::uint8_t>(xInt),
-        static_cast<std::uint8_t>(yInt >> 24),
-        static_cast<std::uint8_t>(yInt >> 16),
-        static_cast<std::uint8_t>(yInt >> 8),
-        static_cast<std::uint8_t>(yInt),
-        static_cast<std::uint8_t>(zInt >> 24),
-        static_cast<std::uint8_t>(zInt >> 16),
-        static_cast<std::uint8_t>(zInt >> 8),
-        static_cast<std::uint8_t>(zInt),
-    });
+    return AppendToByteVector(12, [&](ByteAppender& out) { DataFromPosition(x, y, z, out); });
+}
 
-    return ret;
+void DataFromPosition(std::float_t x, std::float_t y, std::float_t z, ByteAppender& out) noexcept
+{
+    DataFromFloat(x, out);
+    DataFromFloat(y, out);
+    DataFromFloat(z, out);
 }
 
 ByteVector DataFromPositionAndRotation(std::float_t x, std::float_t y, std::float_t z, std::float_t hor, std::float_t vert, std::float_t rot)
@@ -368,88 +472,57 @@ ByteVector DataFromPositionAndRotation(std::float_t x, std::float_t y, std::floa
 
 ByteVector DataFromAimingAndPosition(std::float_t hor, std::float_t vert, std::float_t rot, std::float_t x, std::float_t y, std::float_t z)
 {
-    ByteVector ret;
-    ret.reserve(6 * 4);
-
-    assert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work
-
-    std::uint32_t intValue = *(std::uint32_t*)&hor;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&vert;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&rot;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&x;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&y;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
-
-    intValue = *(std::uint32_t*)&z;
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 24));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 16));
-    ret.push_back(static_cast<std::uint8_t>(intValue >> 8));
-    ret.push_back(static_cast<std::uint8_t>(intValue));
+    return AppendToByteVector(24, [&](ByteAppender& out) { DataFromAimingAndPosition(hor, vert, rot, x, y, z, out); });
+}
 
-    return ret;
+void DataFromAimingAndPosition(std::float_t hor, std::float_t vert, std::float_t rot, std::float_t x, std::float_t y, std::float_t z, ByteAppender& out) noexcept
+{
+    DataFromFloat(hor, out);
+    DataFromFloat(vert, out);
+    DataFromFloat(rot, out);
+    DataFromPosition(x, y, z, out);
 }
 
 ByteVector DataFromOnoForSubscription(std::uint32_t ono, bool add)
 {
-    ByteVector ret;
-    ret.reserve(add ? 25 : 16);
-
-    ret.push_back(static_cast<std::uint8_t>(ono >> 24)); // Emitter ONo
-    ret.push_back(static_cast<std::uint8_t>(ono >> 16));
-    ret.push_back(static_cast<std::uint8_t>(ono >> 8));
-    ret.push_back(static_cast<std::uint8_t>(ono));
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // EventID def level: OcaRoot
-    ret.push_back(static_cast<std::uint8_t>(0x01));
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // EventID idx: PropertyChanged
-    ret.push_back(static_cast<std::uint8_t>(0x01));
-
-    ret.push_back(static_cast<std::uint8_t>(ono >> 24)); // Subscriber ONo
-    ret.push_back(static_cast<std::uint8_t>(ono >> 16));
-    ret.push_back(static_cast<std::uint8_t>(ono >> 8));
-    ret.push_back(static_cast<std::uint8_t>(ono));
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // Method def level: OcaSubscriptionManager
-    ret.push_back(static_cast<std::uint8_t>(0x03));
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // Method idx: AddSubscription
-    ret.push_back(static_cast<std::uint8_t>(0x01));
+    return AppendToByteVector(add ? 25 : 16, [&](ByteAppender& out) { DataFromOnoForSubscription(ono, add, out); });
+}
+
+void DataFromOnoForSubscription(std::uint32_t ono, bool add, ByteAppender& out) noexcept
+{
+    out.appendUint32(ono);      // Emitter ONo
+    out.appendUint16(0x0001);   // EventID def level: OcaRoot
+    out.appendUint16(0x0001);   // EventID idx: PropertyChanged
+
+    out.appendUint32(ono);      // Subscriber ONo
+    out.appendUint16(0x0003);   // Method def level: OcaSubscriptionManager
+    out.appendUint16(0x0001);   // Method idx: AddSubscription
 
     if (!add)
-        return ret;
+        return;
 
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // Context size: 0
-    ret.push_back(static_cast<std::uint8_t>(0x00));
-    ret.push_back(static_cast<std::uint8_t>(0x01)); // Delivery mode: Reliable
+    out.appendUint16(0x0000);   // Context size: 0
+    out.appendUint8(0x01);      // Delivery mode: Reliable
 
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // Destination info length: always 4
-    ret.push_back(static_cast<std::uint8_t>(0x04));
-    ret.push_back(static_cast<std::uint8_t>(0x00)); // Destination info (4 empty bytes)
-    ret.push_back(static_cast<std::uint8_t>(0x00));
-    ret.push_back(static_cast<std::uint8_t>(0x00));
-    ret.push_back(static_cast<std::uint8_t>(0x00));
+    out.appendUint16(0x0004);   // Destination info length: always 4
+    out.appendUint32(0x00000000); // Destination info (4 empty bytes)
+}
 
-    return ret;
+ByteVector DataFromOnoForSubscription2(std::uint32_t ono)
+{
+    return AppendToByteVector(15, [&](ByteAppender& out) { DataFromOnoForSubscription2(ono, out); });
+}
+
+void DataFromOnoForSubscription2(std::uint32_t ono, ByteAppender& out) noexcept
+{
+    out.appendUint32(ono);      // Emitter ONo
+    out.appendUint16(0x0001);   // EventID def level: OcaRoot
+    out.appendUint16(0x0001);   // EventID idx: PropertyChanged
+
+    out.appendUint8(0x01);      // Delivery mode: Normal
+
+    out.appendUint16(0x0004);   // Destination info length: always 4
+    out.appendUint32(0x00000000); // Destination info (4 empty bytes)
 }
 
 std::string StatusToString(std::uint8_t status)
@@ -523,32 +596,242 @@ std::string HandleToString(std::uint32_t handle)
     return result;
 }
 
-std::uint32_t ReadUint32(const char* buffer)
+namespace
 {
-    return (((static_cast<std::uint8_t>(buffer[0]) << uint8_24) & 0xff000000) +
-            ((static_cast<std::uint8_t>(buffer[1]) << uint8_16) & 0x00ff0000) +
-            ((static_cast<std::uint8_t>(buffer[2]) << uint8_8)  & 0x0000ff00) +
-              static_cast<std::uint8_t>(buffer[3]));
+
+#if defined(NANOOCP1_BATCH_AVX2)
+/** Reverses the bytes of each 4-byte element, 8 elements at a time.  Returns the number converted. */
+NANOOCP1_TARGET_AVX2 std::size_t SwapBytes32Avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+{
+    const auto mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                       3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
 }
 
-std::uint32_t ReadUint32(const std::uint8_t* buffer)
+/** Reverses the bytes of each 2-byte element, 16 elements at a time.  Returns the number converted. */
+NANOOCP1_TARGET_AVX2 std::size_t SwapBytes16Avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
 {
-    return (((buffer[0] << uint8_24) & 0xff000000) +
-            ((buffer[1] << uint8_16) & 0x00ff0000) +
-            ((buffer[2] << uint8_8)  & 0x0000ff00) +
-              buffer[3]);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                            _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)));
+    }
+    return i;
+}
+
+bool HasAvx2() noexcept
+{
+#if defined(__AVX2__)
+    return true;
+#else
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+#endif
 }
+#endif
 
-std::uint16_t ReadUint16(const char* buffer)
+/**
+ * Reverses the bytes of each 4-byte element of src into dst.  Converts both
+ * ways, as the swap is its own inverse; on big-endian hosts it is a copy.
+ */
+void ConvertBigEndian32(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
 {
-    return (((static_cast<std::uint8_t>(buffer[0]) << uint8_8)  & 0xff00) +
-              static_cast<std::uint8_t>(buffer[1]));
+    std::size_t i = 0;
+
+#if defined(NANOOCP1_BATCH_AVX2)
+    if (count >= 8 && HasAvx2())
+        i = SwapBytes32Avx2(src, dst, count);
+#endif
+
+#if defined(NANOOCP1_BATCH_SSE2)
+    for (; i + 4 <= count; i += 4)
+    {
+        // SSE2 has no byte shuffle: swap the bytes of each 16-bit half, then the halves.
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), v);
+    }
+#elif defined(NANOOCP1_BATCH_NEON)
+    for (; i + 4 <= count; i += 4)
+        vst1q_u8(dst + 4 * i, vrev32q_u8(vld1q_u8(src + 4 * i)));
+#endif
+
+    for (; i < count; ++i)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, src + 4 * i, sizeof(value));
+        WriteUint32(dst + 4 * i, value);
+    }
 }
 
-std::uint16_t ReadUint16(const std::uint8_t* buffer)
+/** Reverses the bytes of each 2-byte element of src into dst, see ConvertBigEndian32(). */
+void ConvertBigEndian16(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
 {
-    return (((buffer[0] << uint8_8)  & 0xff00) +
-              buffer[1]);
+    std::size_t i = 0;
+
+#if defined(NANOOCP1_BATCH_AVX2)
+    if (count >= 16 && HasAvx2())
+        i = SwapBytes16Avx2(src, dst, count);
+#endif
+
+#if defined(NANOOCP1_BATCH_SSE2)
+    for (; i + 8 <= count; i += 8)
+    {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(NANOOCP1_BATCH_NEON)
+    for (; i + 8 <= count; i += 8)
+        vst1q_u8(dst + 2 * i, vrev16q_u8(vld1q_u8(src + 2 * i)));
+#endif
+
+    for (; i < count; ++i)
+    {
+        std::uint16_t value;
+        std::memcpy(&value, src + 2 * i, sizeof(value));
+        WriteUint16(dst + 2 * i, value);
+    }
+}
+
+#if defined(NANOOCP1_BATCH_AVX2)
+/** Expands 32 bits per iteration; returns the number of bits done. */
+NANOOCP1_TARGET_AVX2 std::size_t UnpackBitsAvx2(const std::uint8_t* packed, std::uint8_t* bits, std::size_t count) noexcept
+{
+    // Every byte of the broadcast is copied to the 8 lanes of its bits, then
+    // each lane tests its own bit, most significant first.
+    const auto spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                         2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const auto mask   = _mm256_set1_epi64x(0x0102040810204080LL);
+    const auto one    = _mm256_set1_epi8(1);
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32)
+    {
+        std::int32_t four;
+        std::memcpy(&four, packed + i / 8, sizeof(four));
+        const auto v = _mm256_shuffle_epi8(_mm256_set1_epi32(four), spread);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits + i),
+                            _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(v, mask), mask), one));
+    }
+    return i;
+}
+#endif
+
+template <typename T>
+std::size_t ReadArray32(ByteSpan data, T* values, std::size_t count) noexcept
+{
+    static_assert(sizeof(T) == 4, "4-byte element type expected");
+    count = std::min(count, data.size() / 4);
+    ConvertBigEndian32(data.data(), reinterpret_cast<std::uint8_t*>(values), count);
+    return count;
+}
+
+template <typename T>
+void WriteArray32(std::uint8_t* buffer, const T* values, std::size_t count) noexcept
+{
+    static_assert(sizeof(T) == 4, "4-byte element type expected");
+    ConvertBigEndian32(reinterpret_cast<const std::uint8_t*>(values), buffer, count);
+}
+
+} // namespace
+
+std::size_t ReadFloat32Array(ByteSpan data, float* values, std::size_t count) noexcept
+{
+    return ReadArray32(data, values, count);
+}
+
+std::size_t ReadInt32Array(ByteSpan data, std::int32_t* values, std::size_t count) noexcept
+{
+    return ReadArray32(data, values, count);
+}
+
+std::size_t ReadUint32Array(ByteSpan data, std::uint32_t* values, std::size_t count) noexcept
+{
+    return ReadArray32(data, values, count);
+}
+
+std::size_t ReadUint16Array(ByteSpan data, std::uint16_t* values, std::size_t count) noexcept
+{
+    count = std::min(count, data.size() / 2);
+    ConvertBigEndian16(data.data(), reinterpret_cast<std::uint8_t*>(values), count);
+    return count;
+}
+
+void WriteFloat32Array(std::uint8_t* buffer, const float* values, std::size_t count) noexcept
+{
+    WriteArray32(buffer, values, count);
+}
+
+void WriteInt32Array(std::uint8_t* buffer, const std::int32_t* values, std::size_t count) noexcept
+{
+    WriteArray32(buffer, values, count);
+}
+
+void WriteUint32Array(std::uint8_t* buffer, const std::uint32_t* values, std::size_t count) noexcept
+{
+    WriteArray32(buffer, values, count);
+}
+
+void WriteUint16Array(std::uint8_t* buffer, const std::uint16_t* values, std::size_t count) noexcept
+{
+    ConvertBigEndian16(reinterpret_cast<const std::uint8_t*>(values), buffer, count);
+}
+
+void UnpackBits(const std::uint8_t* packed, std::uint8_t* bits, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+#if defined(NANOOCP1_BATCH_AVX2)
+    if (count >= 32 && HasAvx2())
+        i = UnpackBitsAvx2(packed, bits, count);
+#endif
+
+#if defined(NANOOCP1_BATCH_SSE2)
+    const auto mask = _mm_set1_epi64x(0x0102040810204080LL);
+    const auto one  = _mm_set1_epi8(1);
+    for (; i + 16 <= count; i += 16)
+    {
+        // Two packed bytes, each repeated into 8 lanes by successive unpacking.
+        auto v = _mm_cvtsi32_si128(packed[i / 8] | (packed[i / 8 + 1] << 8));
+        v = _mm_unpacklo_epi8(v, v);
+        v = _mm_unpacklo_epi16(v, v);
+        v = _mm_unpacklo_epi32(v, v);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bits + i),
+                         _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(v, mask), mask), one));
+    }
+#elif defined(NANOOCP1_BATCH_NEON)
+    static const std::uint8_t maskBytes[16] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                                0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+    const auto mask = vld1q_u8(maskBytes);
+    const auto one  = vdupq_n_u8(1);
+    for (; i + 16 <= count; i += 16)
+    {
+        const auto v = vcombine_u8(vdup_n_u8(packed[i / 8]), vdup_n_u8(packed[i / 8 + 1]));
+        vst1q_u8(bits + i, vandq_u8(vtstq_u8(v, mask), one));
+    }
+#endif
+
+    for (; i < count; ++i)
+        bits[i] = static_cast<std::uint8_t>((packed[i / 8] >> (7 - i % 8)) & 1);
+}
+
+void PackBits(const std::uint8_t* bits, std::uint8_t* packed, std::size_t count) noexcept
+{
+    for (std::size_t i = 0; i < count; i += 8)
+    {
+        std::uint8_t byte = 0;
+        for (std::size_t bit = 0; bit < 8 && i + bit < count; ++bit)
+            byte |= static_cast<std::uint8_t>(bits[i + bit] != 0 ? 0x80 >> bit : 0);
+        packed[i / 8] = byte;
+    }
 }
 
 std::uint32_t GetONo(std::uint32_t type, std::uint32_t record, std::uint32_t channel, std::uint32_t boxAndObjectNumber)
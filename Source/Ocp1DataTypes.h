@@ -20,8 +20,14 @@
 
 #include <vector>       //< USE std::vector
 #include <string>       //< USE std::to_string
+#include <string_view>  //< USE std::string_view
 #include <cmath>        //< USE std::float_t, std::double_t
 #include <cstdint>      //< USE std::uint8_t, std::int32_t, etc.
+#include <cstddef>      //< USE std::size_t
+#include <cstring>      //< USE std::memcpy
+#if defined(_MSC_VER)
+#include <stdlib.h>     //< USE _byteswap_ushort, _byteswap_ulong
+#endif
 
 namespace NanoOcp1
 {
@@ -31,11 +37,121 @@ namespace NanoOcp1
  *
  * Every `Ocp1Message::GetSerializedData()`, `DataFromX()`, and `Variant::ToParamData()`
  * returns a `ByteVector`.  The `sendData()` / `sendMessage()` methods also take one.
+ * `Ocp1Message::SerializeInto()` writes a message into caller-owned memory instead.
  * Replaces `juce::MemoryBlock` from the original JUCE-based implementation.
  */
 using ByteVector = std::vector<std::uint8_t>;
 
 
+/**
+ * @brief Non-owning, read-only view of a contiguous range of bytes.
+ *
+ * Minimal stand-in for C++20 `std::span<const std::uint8_t>`.  Used where OCP.1 data
+ * is handed on straight out of a receive buffer instead of being copied into a
+ * `ByteVector` first.  The viewed memory must outlive the span.  A `ByteVector`
+ * converts to it implicitly, so the `DataToX()` helpers accept either, e.g. the
+ * parameter bytes of a message view or `ByteSpan::subspan()` of a larger value.
+ */
+class ByteSpan
+{
+public:
+    constexpr ByteSpan() noexcept = default;
+    constexpr ByteSpan(const std::uint8_t* data, std::size_t size) noexcept : m_data(data), m_size(size) {}
+    ByteSpan(const ByteVector& bytes) noexcept : m_data(bytes.data()), m_size(bytes.size()) {}
+
+    constexpr const std::uint8_t* data() const noexcept { return m_data; }
+    constexpr std::size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+    constexpr const std::uint8_t* begin() const noexcept { return m_data; }
+    constexpr const std::uint8_t* end() const noexcept { return m_data + m_size; }
+
+    constexpr const std::uint8_t& operator[](std::size_t idx) const noexcept { return m_data[idx]; }
+
+    /** @brief Returns the sub-range [offset, offset + count), clamped to this span. */
+    constexpr ByteSpan subspan(std::size_t offset, std::size_t count = static_cast<std::size_t>(-1)) const noexcept
+    {
+        if (offset > m_size)
+            offset = m_size;
+        if (count > m_size - offset)
+            count = m_size - offset;
+        return ByteSpan(m_data + offset, count);
+    }
+
+private:
+    const std::uint8_t* m_data{ nullptr };
+    std::size_t         m_size{ 0 };
+};
+
+
+/**
+ * @brief Writes the big-endian fields of an OCP.1 frame into a caller-owned buffer.
+ *
+ * Serialization counterpart of `ByteSpan`: each field is converted to network
+ * byte order in a register and written with one store, and nothing is allocated,
+ * so a frame can be built straight into a reused or pooled buffer.  Appending
+ * beyond the capacity writes nothing and marks the appender as overflowed, which
+ * the caller checks once at the end.
+ */
+class ByteAppender
+{
+public:
+    constexpr ByteAppender(std::uint8_t* data, std::size_t capacity) noexcept : m_data(data), m_capacity(capacity) {}
+
+    void appendUint8(std::uint8_t value) noexcept
+    {
+        if (reserve(1))
+            m_data[m_size++] = value;
+    }
+
+    void appendUint16(std::uint16_t value) noexcept;
+    void appendUint32(std::uint32_t value) noexcept;
+
+    void appendBytes(const std::uint8_t* data, std::size_t size) noexcept
+    {
+        if (size > 0 && reserve(size))
+        {
+            std::memcpy(m_data + m_size, data, size);
+            m_size += size;
+        }
+    }
+
+    void appendBytes(ByteSpan bytes) noexcept { appendBytes(bytes.data(), bytes.size()); }
+
+    /**
+     * @brief Appends size bytes for the caller to fill in, e.g. with WriteFloat32Array().
+     * @return  The start of the bytes, or nullptr if they do not fit.
+     */
+    std::uint8_t* appendSpace(std::size_t size) noexcept
+    {
+        if (!reserve(size))
+            return nullptr;
+        auto* space = m_data + m_size;
+        m_size += size;
+        return space;
+    }
+
+    /** @brief Returns the number of bytes written so far. */
+    constexpr std::size_t size() const noexcept { return m_size; }
+
+    /** @brief Returns true if an append did not fit; the buffer content is then incomplete. */
+    constexpr bool overflowed() const noexcept { return m_overflowed; }
+
+private:
+    bool reserve(std::size_t size) noexcept
+    {
+        if (size > m_capacity - m_size)
+            m_overflowed = true;
+        return !m_overflowed;
+    }
+
+    std::uint8_t* m_data{ nullptr };
+    std::size_t   m_capacity{ 0 };
+    std::size_t   m_size{ 0 };
+    bool          m_overflowed{ false };
+};
+
+
 /**
  * @brief OCA base data type codes, matching `OcaBaseDataType` in the AES70 specification.
  *
@@ -88,12 +204,12 @@ enum Ocp1DataType
 
 
 /**
- * @brief  Convenience helper method to convert a byte vector into a bool
- * @param  parameterData Vector of bytes containing the value to be converted.
+ * @brief  Convenience helper method to convert bytes into a bool
+ * @param  parameterData Bytes containing the value to be converted.
  * @param  pOk           Optional parameter to verify if the conversion was successful.
  * @return               The value contained in the parameterData as bool.
  */
-bool DataToBool(const ByteVector& parameterData, bool* pOk = nullptr);
+bool DataToBool(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * @brief  Convenience helper method to convert a bool into a byte vector
@@ -103,13 +219,20 @@ bool DataToBool(const ByteVector& parameterData, bool* pOk = nullptr);
 ByteVector DataFromBool(bool boolValue);
 
 /**
- * Convenience helper method to convert a byte vector into a Int32
+ * @brief  Convenience helper method to append a bool to a caller-owned buffer, without allocating.
+ * @param  boolValue Value to be converted.
+ * @param  out       Receives the byte; marked overflowed if it does not fit.
+ */
+void DataFromBool(bool boolValue, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Int32
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Int32.
  */
-std::int32_t DataToInt32(const ByteVector& parameterData, bool* pOk = nullptr);
+std::int32_t DataToInt32(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Int32 into a byte vector
@@ -120,13 +243,96 @@ std::int32_t DataToInt32(const ByteVector& parameterData, bool* pOk = nullptr);
 ByteVector DataFromInt32(std::int32_t value);
 
 /**
- * Convenience helper method to convert a byte vector into a Uint8
+ * Convenience helper method to append a Int32 to a caller-owned buffer, without allocating.
+ *
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 4 bytes; marked overflowed if they do not fit.
+ */
+void DataFromInt32(std::int32_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Int8
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int8.
+ */
+std::int8_t DataToInt8(ByteSpan parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int8 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+ByteVector DataFromInt8(std::int8_t value);
+
+/**
+ * Convenience helper method to append a Int8 to a caller-owned buffer, without allocating.
+ *
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the byte; marked overflowed if it does not fit.
+ */
+void DataFromInt8(std::int8_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Int16
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int16.
+ */
+std::int16_t DataToInt16(ByteSpan parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int16 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+ByteVector DataFromInt16(std::int16_t value);
+
+/**
+ * Convenience helper method to append a Int16 to a caller-owned buffer, without allocating.
+ *
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 2 bytes; marked overflowed if they do not fit.
+ */
+void DataFromInt16(std::int16_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Int64
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The value contained in the parameterData as a Int64.
+ */
+std::int64_t DataToInt64(ByteSpan parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a Int64 into a byte vector
+ *
+ * @param[in] value     Value to be converted.
+ * @return  The value as a byte vector.
+ */
+ByteVector DataFromInt64(std::int64_t value);
+
+/**
+ * Convenience helper method to append a Int64 to a caller-owned buffer, without allocating.
+ *
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 8 bytes; marked overflowed if they do not fit.
+ */
+void DataFromInt64(std::int64_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Uint8
  * 
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint8.
  */
-std::uint8_t DataToUint8(const ByteVector& parameterData, bool* pOk = nullptr);
+std::uint8_t DataToUint8(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint8 into a byte vector
@@ -137,13 +343,21 @@ std::uint8_t DataToUint8(const ByteVector& parameterData, bool* pOk = nullptr);
 ByteVector DataFromUint8(std::uint8_t value);
 
 /**
- * Convenience helper method to convert a byte vector into a Uint16
+ * Convenience helper method to append a Uint8 to a caller-owned buffer, without allocating.
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the byte; marked overflowed if it does not fit.
+ */
+void DataFromUint8(std::uint8_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Uint16
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint16.
  */
-std::uint16_t DataToUint16(const ByteVector& parameterData, bool* pOk = nullptr);
+std::uint16_t DataToUint16(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint16 into a byte vector
@@ -154,13 +368,21 @@ std::uint16_t DataToUint16(const ByteVector& parameterData, bool* pOk = nullptr)
 ByteVector DataFromUint16(std::uint16_t value);
 
 /**
- * Convenience helper method to convert a byte vector into a Uint32
+ * Convenience helper method to append a Uint16 to a caller-owned buffer, without allocating.
+ *
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 2 bytes; marked overflowed if they do not fit.
+ */
+void DataFromUint16(std::uint16_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Uint32
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint32.
  */
-std::uint32_t DataToUint32(const ByteVector& parameterData, bool* pOk = nullptr);
+std::uint32_t DataToUint32(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint32 into a byte vector
@@ -171,13 +393,21 @@ std::uint32_t DataToUint32(const ByteVector& parameterData, bool* pOk = nullptr)
 ByteVector DataFromUint32(std::uint32_t value);
 
 /**
- * Convenience helper method to convert a byte vector into a Uint64
+ * Convenience helper method to append a Uint32 to a caller-owned buffer, without allocating.
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 4 bytes; marked overflowed if they do not fit.
+ */
+void DataFromUint32(std::uint32_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a Uint64
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a Uint64.
  */
-std::uint64_t DataToUint64(const ByteVector& parameterData, bool* pOk = nullptr);
+std::uint64_t DataToUint64(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a Uint64 into a byte vector
@@ -188,14 +418,22 @@ std::uint64_t DataToUint64(const ByteVector& parameterData, bool* pOk = nullptr)
 ByteVector DataFromUint64(std::uint64_t value);
 
 /**
- * Convenience helper method to convert a byte vector into a std::string
+ * Convenience helper method to append a Uint64 to a caller-owned buffer, without allocating.
  *
- * @param[in] parameterData     Vector of bytes containing the string to be converted.
+ * @param[in] value     Value to be converted.
+ * @param[out] out      Receives the 8 bytes; marked overflowed if they do not fit.
+ */
+void DataFromUint64(std::uint64_t value, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a std::string
+ *
+ * @param[in] parameterData     Bytes containing the string to be converted.
  *                              Note that the first two bytes contain the string's length.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The string contained in the parameterData as a std::string.
  */
-std::string DataToString(const ByteVector& parameterData, bool* pOk = nullptr);
+std::string DataToString(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a std::string into a byte vector
@@ -206,13 +444,21 @@ std::string DataToString(const ByteVector& parameterData, bool* pOk = nullptr);
 ByteVector DataFromString(const std::string& string);
 
 /**
- * Convenience helper method to convert a byte vector into a 32-bit float.
+ * Convenience helper method to append a string (2 length bytes, then the characters) to a caller-owned buffer, without allocating.
+ *
+ * @param[in] string   String to be converted.
+ * @param[out] out      Receives the bytes; marked overflowed if they do not fit.
+ */
+void DataFromString(std::string_view string, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a 32-bit float.
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a float.
  */
-std::float_t DataToFloat(const ByteVector& parameterData, bool* pOk = nullptr);
+std::float_t DataToFloat(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a 32-bit float into a byte vector
@@ -223,13 +469,21 @@ std::float_t DataToFloat(const ByteVector& parameterData, bool* pOk = nullptr);
 ByteVector DataFromFloat(std::float_t floatValue);
 
 /**
- * Convenience helper method to convert a byte vector into a 64-bit double.
+ * Convenience helper method to append a 32-bit float to a caller-owned buffer, without allocating.
  *
- * @param[in] parameterData     Vector of bytes containing the value to be converted.
+ * @param[in] floatValue     Value to be converted.
+ * @param[out] out      Receives the 4 bytes; marked overflowed if they do not fit.
+ */
+void DataFromFloat(std::float_t floatValue, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a 64-bit double.
+ *
+ * @param[in] parameterData     Bytes containing the value to be converted.
  * @param[in] pOk               Optional parameter to verify if the conversion was successful.
  * @return  The value contained in the parameterData as a double.
  */
-std::double_t DataToDouble(const ByteVector& parameterData, bool* pOk = nullptr);
+std::double_t DataToDouble(ByteSpan parameterData, bool* pOk = nullptr);
 
 /**
  * Convenience helper method to convert a 64-bit double into a byte vector
@@ -239,6 +493,40 @@ std::double_t DataToDouble(const ByteVector& parameterData, bool* pOk = nullptr)
  */
 ByteVector DataFromDouble(std::double_t doubleValue);
 
+/**
+ * Convenience helper method to append a 64-bit double to a caller-owned buffer, without allocating.
+ *
+ * @param[in] doubleValue    Value to be converted.
+ * @param[out] out      Receives the 8 bytes; marked overflowed if they do not fit.
+ */
+void DataFromDouble(std::double_t doubleValue, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to convert bytes into a bit string (OcaBitstring).
+ *
+ * @param[in] parameterData     Bytes containing the bit string: a 2-byte bit count,
+ *                              followed by the bits packed most significant bit first.
+ * @param[in] pOk               Optional parameter to verify if the conversion was successful.
+ * @return  The bits, in wire order.
+ */
+std::vector<bool> DataToBitString(ByteSpan parameterData, bool* pOk = nullptr);
+
+/**
+ * Convenience helper method to convert a bit string (OcaBitstring) into a byte vector
+ *
+ * @param[in] bits      Bits to be converted, in wire order; at most 65535.
+ * @return  The bit count and the packed bits as a byte vector.
+ */
+ByteVector DataFromBitString(const std::vector<bool>& bits);
+
+/**
+ * Convenience helper method to append a bit string (OcaBitstring) to a caller-owned buffer, without allocating.
+ *
+ * @param[in] bits      Bits to be converted, in wire order; at most 65535.
+ * @param[out] out      Receives the bit count and the packed bits; marked overflowed if they do not fit.
+ */
+void DataFromBitString(const std::vector<bool>& bits, ByteAppender& out) noexcept;
+
 /**
  * Convenience helper method to convert a 3D position (three 32-bit floats) into a byte vector
  *
@@ -249,6 +537,16 @@ ByteVector DataFromDouble(std::double_t doubleValue);
  */
 ByteVector DataFromPosition(std::float_t x, std::float_t y, std::float_t z);
 
+/**
+ * Convenience helper method to append a 3D position (three 32-bit floats) to a caller-owned buffer, without allocating.
+ *
+ * @param[in] x     Position along x axis.
+ * @param[in] y     Position along y axis.
+ * @param[in] z     Position along z axis.
+ * @param[out] out      Receives the 12 bytes; marked overflowed if they do not fit.
+ */
+void DataFromPosition(std::float_t x, std::float_t y, std::float_t z, ByteAppender& out) noexcept;
+
 /**
  * Convenience helper method to convert a 3D aiming and position (six 32-bit floats) into a byte vector
  * @note The aiming angles are marshaled first and the position second, to keep in line with the 
@@ -264,6 +562,19 @@ ByteVector DataFromPosition(std::float_t x, std::float_t y, std::float_t z);
  */
 ByteVector DataFromAimingAndPosition(std::float_t hor, std::float_t vert, std::float_t rot, std::float_t x, std::float_t y, std::float_t z);
 
+/**
+ * Convenience helper method to append a 3D aiming and position (six 32-bit floats, aiming first) to a caller-owned buffer, without allocating.
+ *
+ * @param[in] hor   Horizontal aiming (yaw).
+ * @param[in] vert  Vertical aiming (pitch).
+ * @param[in] rot   Rotational aiming (roll).
+ * @param[in] x     Position along x axis.
+ * @param[in] y     Position along y axis.
+ * @param[in] z     Position along z axis.
+ * @param[out] out      Receives the 24 bytes; marked overflowed if they do not fit.
+ */
+void DataFromAimingAndPosition(std::float_t hor, std::float_t vert, std::float_t rot, std::float_t x, std::float_t y, std::float_t z, ByteAppender& out) noexcept;
+
 [[deprecated("Use DataFromAimingAndPosition instead, this method will be removed in the future. "
   "NOTE: The order of the input parameters in the new method has been changed to be more consistent with the marshaling order.")]]
 ByteVector DataFromPositionAndRotation(std::float_t x, std::float_t y, std::float_t z, std::float_t hor, std::float_t vert, std::float_t rot);
@@ -278,6 +589,34 @@ ByteVector DataFromPositionAndRotation(std::float_t x, std::float_t y, std::floa
  */
 ByteVector DataFromOnoForSubscription(std::uint32_t ono, bool add = true);
 
+/**
+ * Convenience helper method to append the AddSubscription or RemoveSubscription parameters for an object to a caller-owned buffer, without allocating.
+ *
+ * @param[in] ono     ONo of the object that the subscription shall be added or removed for.
+ * @param[in] add     True for AddSubscription, false for RemoveSubscription.
+ * @param[out] out      Receives the 25 or 16 bytes; marked overflowed if they do not fit.
+ */
+void DataFromOnoForSubscription(std::uint32_t ono, bool add, ByteAppender& out) noexcept;
+
+/**
+ * Convenience helper method to generate a byte vector containing the parameters
+ * of an AddSubscription2 or RemoveSubscription2 command (AES70-2023) for a given
+ * object: its PropertyChanged event, the delivery mode and an empty destination.
+ * Both methods take the same parameters.
+ *
+ * @param[in] ono     ONo of the object that the subscription shall be added or removed for.
+ * @return  The parameters as a byte vector.
+ */
+ByteVector DataFromOnoForSubscription2(std::uint32_t ono);
+
+/**
+ * Convenience helper method to append the AddSubscription2 / RemoveSubscription2 parameters for an object to a caller-owned buffer, without allocating.
+ *
+ * @param[in] ono     ONo of the object that the subscription shall be added or removed for.
+ * @param[out] out      Receives the 15 bytes; marked overflowed if they do not fit.
+ */
+void DataFromOnoForSubscription2(std::uint32_t ono, ByteAppender& out) noexcept;
+
 /**
  * Convenience method to convert an integer representing an OcaStatus to its string representation.
  *
@@ -304,12 +643,23 @@ std::string DataTypeToString(int dataType);
 std::string HandleToString(std::uint32_t handle);
 
 /**
- * Convenience method to read 4 bytes from a buffer.
+ * Convenience method to read 4 bytes from a buffer, most significant byte first.
+ * Compiles to a single (unaligned) load and a byte swap.
  *
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 4 bytes as an uint32_t.
  */
-std::uint32_t ReadUint32(const char* buffer);
+inline std::uint32_t ReadUint32(const std::uint8_t* buffer) noexcept
+{
+    std::uint32_t value;
+    std::memcpy(&value, buffer, sizeof(value));
+#if defined(_MSC_VER)
+    value = _byteswap_ulong(value);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
 
 /**
  * Convenience method to read 4 bytes from a buffer.
@@ -317,15 +667,29 @@ std::uint32_t ReadUint32(const char* buffer);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 4 bytes as an uint32_t.
  */
-std::uint32_t ReadUint32(const std::uint8_t* buffer);
+inline std::uint32_t ReadUint32(const char* buffer) noexcept
+{
+    return ReadUint32(reinterpret_cast<const std::uint8_t*>(buffer));
+}
 
 /**
- * Convenience method to read 2 bytes from a buffer.
+ * Convenience method to read 2 bytes from a buffer, most significant byte first.
+ * Compiles to a single (unaligned) load and a byte swap.
  *
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 2 bytes as an uint16_t.
  */
-std::uint16_t ReadUint16(const char* buffer);
+inline std::uint16_t ReadUint16(const std::uint8_t* buffer) noexcept
+{
+    std::uint16_t value;
+    std::memcpy(&value, buffer, sizeof(value));
+#if defined(_MSC_VER)
+    value = _byteswap_ushort(value);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap16(value);
+#endif
+    return value;
+}
 
 /**
  * Convenience method to read 2 bytes from a buffer.
@@ -333,7 +697,107 @@ std::uint16_t ReadUint16(const char* buffer);
  * @param[in] buffer     Pointer to the start of the data to be read.
  * @return  Resulting 2 bytes as an uint16_t.
  */
-std::uint16_t ReadUint16(const std::uint8_t* buffer);
+inline std::uint16_t ReadUint16(const char* buffer) noexcept
+{
+    return ReadUint16(reinterpret_cast<const std::uint8_t*>(buffer));
+}
+
+/**
+ * Convenience method to write 4 bytes to a buffer, most significant byte first.
+ * Compiles to a byte swap and a single (unaligned) store.
+ *
+ * @param[out] buffer   Pointer to the start of the 4 bytes to be written.
+ * @param[in] value     Value to write.
+ */
+inline void WriteUint32(std::uint8_t* buffer, std::uint32_t value) noexcept
+{
+#if defined(_MSC_VER)
+    value = _byteswap_ulong(value);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    std::memcpy(buffer, &value, sizeof(value));
+}
+
+/**
+ * Convenience method to write 2 bytes to a buffer, most significant byte first.
+ * Compiles to a byte swap and a single (unaligned) store.
+ *
+ * @param[out] buffer   Pointer to the start of the 2 bytes to be written.
+ * @param[in] value     Value to write.
+ */
+inline void WriteUint16(std::uint8_t* buffer, std::uint16_t value) noexcept
+{
+#if defined(_MSC_VER)
+    value = _byteswap_ushort(value);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    value = __builtin_bswap16(value);
+#endif
+    std::memcpy(buffer, &value, sizeof(value));
+}
+
+/**
+ * @name Batch big-endian codecs
+ * @brief Span-based array conversions for float32, int32, uint32 and uint16 values.
+ *
+ * Convert whole arrays of 4- or 2-byte values between OCP.1 (big-endian) byte
+ * order and native values, e.g. the 128 source positions of a snapshot or a
+ * block of 6-DOF speaker blobs laid out back to back.  Large arrays are
+ * converted 8 (AVX2) or 4 (SSE2, NEON) values per instruction; the remainder
+ * and other targets use the scalar ReadUint32() / WriteUint32() path.  AVX2 is
+ * used when the compiler targets it, or, with GCC and Clang, when the CPU
+ * reports it at runtime.
+ *
+ * The Read functions decode `count` values, or as many as `data` holds, and
+ * return the number decoded.  The Write functions encode exactly `count` values;
+ * `buffer` must hold `count` times the value size.  Source and destination
+ * must not overlap.
+ * @{
+ */
+std::size_t ReadFloat32Array(ByteSpan data, float* values, std::size_t count) noexcept;
+std::size_t ReadInt32Array(ByteSpan data, std::int32_t* values, std::size_t count) noexcept;
+std::size_t ReadUint32Array(ByteSpan data, std::uint32_t* values, std::size_t count) noexcept;
+std::size_t ReadUint16Array(ByteSpan data, std::uint16_t* values, std::size_t count) noexcept;
+
+void WriteFloat32Array(std::uint8_t* buffer, const float* values, std::size_t count) noexcept;
+void WriteInt32Array(std::uint8_t* buffer, const std::int32_t* values, std::size_t count) noexcept;
+void WriteUint32Array(std::uint8_t* buffer, const std::uint32_t* values, std::size_t count) noexcept;
+void WriteUint16Array(std::uint8_t* buffer, const std::uint16_t* values, std::size_t count) noexcept;
+/** @} */
+
+/**
+ * @name Bit string codecs
+ * @brief Conversion between packed bits and one byte per bit.
+ *
+ * `UnpackBits()` expands `count` bits, packed most significant bit first as in an
+ * OcaBitstring, into one byte per bit (0 or 1), e.g. the mute or overload flags
+ * of all channels of a device; 32 (AVX2) or 16 (SSE2, NEON) bits are expanded
+ * per instruction.  `PackBits()` is the inverse; any non-zero byte is a set bit,
+ * and the unused low bits of the last byte are cleared.  `packed` holds
+ * (count + 7) / 8 bytes, `bits` holds count bytes.
+ * @{
+ */
+void UnpackBits(const std::uint8_t* packed, std::uint8_t* bits, std::size_t count) noexcept;
+void PackBits(const std::uint8_t* bits, std::uint8_t* packed, std::size_t count) noexcept;
+/** @} */
+
+inline void ByteAppender::appendUint16(std::uint16_t value) noexcept
+{
+    if (reserve(sizeof(value)))
+    {
+        WriteUint16(m_data + m_size, value);
+        m_size += sizeof(value);
+    }
+}
+
+inline void ByteAppender::appendUint32(std::uint32_t value) noexcept
+{
+    if (reserve(sizeof(value)))
+    {
+        WriteUint32(m_data + m_size, value);
+        m_size += sizeof(value);
+    }
+}
 
 /**
  * Convenience method to generate a unique target object number.
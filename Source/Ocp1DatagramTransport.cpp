@@ -0,0 +1,317 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Ocp1DatagramTransport.h"
+
+#include "Ocp1Message.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace NanoOcp1
+{
+
+
+// ── PDU helpers ───────────────────────────────────────────────────────────────
+
+namespace
+{
+
+// True if data holds one or more complete OCP.1 PDUs and nothing else.
+bool isWholePdus(const std::uint8_t* data, std::size_t size)
+{
+    if (size == 0)
+        return false;
+
+    while (size > 0)
+    {
+        if (size < Ocp1Header::Ocp1HeaderSize || data[0] != 0x3b)
+            return false;
+        const auto pduSize = static_cast<std::size_t>(ReadUint32(data + 3)) + 1; // msgSize excludes the sync byte
+        if (pduSize < Ocp1Header::Ocp1HeaderSize || pduSize > size)
+            return false;
+        data += pduSize;
+        size -= pduSize;
+    }
+    return true;
+}
+
+// Calls fn(handle) for every message of the given type in a sequence of whole
+// PDUs.  Commands and responses both start with their size and their handle.
+template <typename Fn>
+void forEachHandle(const std::uint8_t* data, std::size_t size, Ocp1Message::MessageType type, Fn&& fn)
+{
+    while (size >= Ocp1Header::Ocp1HeaderSize)
+    {
+        const auto pduSize = std::min<std::size_t>(static_cast<std::size_t>(ReadUint32(data + 3)) + 1, size);
+        if (data[7] == type)
+        {
+            const auto count = ReadUint16(data + 8);
+            std::size_t offset = Ocp1Header::Ocp1HeaderSize;
+            for (std::uint16_t i = 0; i < count && offset + 8 <= pduSize; ++i)
+            {
+                fn(ReadUint32(data + offset + 4));
+                const auto messageSize = ReadUint32(data + offset);
+                if (messageSize < 8)
+                    break;
+                offset += messageSize;
+            }
+        }
+        data += pduSize;
+        size -= pduSize;
+    }
+}
+
+} // namespace
+
+
+// ── Construction / destruction ────────────────────────────────────────────────
+
+Ocp1DatagramTransport::Ocp1DatagramTransport(std::unique_ptr<NanoDatagramSocket> socket,
+                                             const DatagramPolicy& policy)
+    : m_socket(std::move(socket)),
+      m_policy(policy),
+      m_datagram(NanoDatagramSocket::maxDatagramSize)
+{
+}
+
+Ocp1DatagramTransport::~Ocp1DatagramTransport()
+{
+    close();
+}
+
+
+// ── Reading ───────────────────────────────────────────────────────────────────
+
+int Ocp1DatagramTransport::readAvailable(void* data, int num)
+{
+    auto*       out   = static_cast<std::uint8_t*>(data);
+    std::size_t space = num > 0 ? static_cast<std::size_t>(num) : 0;
+    std::size_t total = 0;
+
+    for (;;)
+    {
+        if (m_heldSize > 0)
+        {
+            const auto chunk = std::min(m_heldSize, space);
+            std::memcpy(out + total, m_datagram.data() + m_heldOffset, chunk);
+            total        += chunk;
+            space        -= chunk;
+            m_heldOffset += chunk;
+            m_heldSize   -= chunk;
+            if (m_heldSize > 0 || space == 0)
+                break;
+        }
+
+        const auto n = m_socket->readAvailable(m_datagram.data(), static_cast<int>(m_datagram.size()));
+        if (n < 0)
+            return total > 0 ? static_cast<int>(total) : -1;
+        if (n == 0)
+            break;
+
+        const auto size = static_cast<std::size_t>(n);
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (!isWholePdus(m_datagram.data(), size))
+        {
+            ++m_stats.datagramsDropped;
+            continue;
+        }
+
+        ++m_stats.datagramsReceived;
+        m_lastReceive = Clock::now();
+        acknowledgeResponses(m_datagram.data(), size);
+        m_heldOffset = 0;
+        m_heldSize   = size;
+    }
+
+    return static_cast<int>(total);
+}
+
+bool Ocp1DatagramTransport::hasBufferedData() const
+{
+    return m_heldSize > 0;
+}
+
+int Ocp1DatagramTransport::waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const
+{
+    if ((events & readEvent) != 0 && m_heldSize > 0)
+        return readEvent;
+    return m_socket->waitForEvents(events, timeoutMs, wakeHandle);
+}
+
+void Ocp1DatagramTransport::acknowledgeResponses(const std::uint8_t* data, std::size_t size)
+{
+    if (m_pending.empty())
+        return;
+
+    forEachHandle(data, size, Ocp1Message::Response, [this](std::uint32_t handle) {
+        const auto found = m_pendingByHandle.find(handle);
+        if (found == m_pendingByHandle.end())
+            return;
+
+        const auto it = found->second;
+        m_pendingByHandle.erase(found);
+        auto& handles = it->handles;
+        handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+        if (handles.empty())
+            m_pending.erase(it);
+    });
+}
+
+
+// ── Writing ───────────────────────────────────────────────────────────────────
+
+int Ocp1DatagramTransport::writeGather(const Buffer* buffers, int numBuffers)
+{
+    // Tracking after the send, under the lock that acknowledgeResponses() also
+    // takes, cannot miss a response that arrives in between.
+    std::lock_guard<std::mutex> lk(m_mutex);
+    const auto written = m_socket->writeGather(buffers, numBuffers);
+    if (written <= 0)
+        return written;
+
+    const auto now = Clock::now();
+    std::size_t remaining = static_cast<std::size_t>(written);
+    for (int i = 0; i < numBuffers && remaining >= buffers[i].size; ++i)
+    {
+        remaining -= buffers[i].size;
+        ++m_stats.datagramsSent;
+        trackCommands(buffers[i], now);
+    }
+    return written;
+}
+
+void Ocp1DatagramTransport::trackCommands(const Buffer& buffer, Clock::time_point now)
+{
+    const auto* data = static_cast<const std::uint8_t*>(buffer.data);
+
+    std::vector<std::uint32_t> handles;
+    forEachHandle(data, buffer.size, Ocp1Message::CommandResponseRequired, [&](std::uint32_t handle) {
+        // A command sent again by the caller is already covered.
+        if (m_pendingByHandle.count(handle) == 0)
+            handles.push_back(handle);
+    });
+    if (handles.empty())
+        return;
+
+    PendingCommand command;
+    command.datagram.assign(data, data + buffer.size);
+    command.handles = std::move(handles);
+    command.due     = now + std::chrono::milliseconds(m_policy.retransmitTimeoutMs);
+    const auto it = m_pending.insert(m_pending.end(), std::move(command));
+    for (const auto handle : it->handles)
+        m_pendingByHandle.emplace(handle, it);
+}
+
+void Ocp1DatagramTransport::forgetCommand(PendingList::iterator it)
+{
+    for (const auto handle : it->handles)
+        m_pendingByHandle.erase(handle);
+    m_pending.erase(it);
+}
+
+int Ocp1DatagramTransport::retransmitDue()
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    const auto now = Clock::now();
+
+    int sent = 0;
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        auto current = it++;
+        if (current->due > now)
+            continue;
+
+        if (current->retransmissions >= m_policy.maxRetransmits)
+        {
+            ++m_stats.commandsGivenUp;
+            forgetCommand(current);
+            continue;
+        }
+
+        const Buffer buffer{ current->datagram.data(), current->datagram.size() };
+        const auto written = m_socket->writeGather(&buffer, 1);
+        if (written < 0)
+            break;
+        if (written == 0)
+            continue; // send buffer full: try again next time
+
+        ++current->retransmissions;
+        current->due = now + std::chrono::milliseconds(m_policy.retransmitTimeoutMs) * (1 << current->retransmissions);
+        ++m_stats.datagramsSent;
+        ++m_stats.retransmissions;
+        ++sent;
+    }
+    return sent;
+}
+
+
+// ── State ─────────────────────────────────────────────────────────────────────
+
+std::size_t Ocp1DatagramTransport::getPendingCommandCount() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_pendingByHandle.size();
+}
+
+std::chrono::steady_clock::time_point Ocp1DatagramTransport::getLastReceiveTime() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_lastReceive;
+}
+
+Ocp1DatagramTransport::Stats Ocp1DatagramTransport::getStats() const
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_stats;
+}
+
+void Ocp1DatagramTransport::close()
+{
+    m_socket->close();
+}
+
+bool Ocp1DatagramTransport::isConnected() const
+{
+    return m_socket->isConnected();
+}
+
+std::string Ocp1DatagramTransport::getHostName() const
+{
+    return m_socket->getHostName();
+}
+
+bool Ocp1DatagramTransport::setNonBlocking(bool nonBlocking)
+{
+    return m_socket->setNonBlocking(nonBlocking);
+}
+
+bool Ocp1DatagramTransport::setOptions(const SocketOptions& options)
+{
+    return m_socket->setOptions(options);
+}
+
+bool Ocp1DatagramTransport::getAppliedOptions(SocketOptions& applied) const
+{
+    return m_socket->getAppliedOptions(applied);
+}
+
+
+} // namespace NanoOcp1
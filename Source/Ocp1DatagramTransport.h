@@ -0,0 +1,177 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Ocp1DataTypes.h"
+#include "internal/NanoSocket.h"
+
+
+namespace NanoOcp1
+{
+
+
+/**
+ * @struct DatagramPolicy
+ * @brief Liveness and retransmission timing of OCP.1 over UDP.
+ *
+ * UDP has neither a connection nor delivery guarantees.  The controller sends
+ * a KeepAlive every `keepAliveIntervalMs`, announcing that interval as its
+ * heartbeat time, and considers the device gone after `missedKeepAlives`
+ * intervals without a datagram from it.  Commands that require a response are
+ * sent again if it has not arrived after `retransmitTimeoutMs`, doubling per
+ * attempt, and given up after `maxRetransmits` retransmissions.  Notifications,
+ * responses and KeepAlives are never retransmitted: a lost level-meter value is
+ * superseded by the next one anyway.
+ */
+struct DatagramPolicy
+{
+    int keepAliveIntervalMs{ 1000 };  ///< Heartbeat interval in both directions.
+    int missedKeepAlives{ 3 };        ///< Silent intervals before the device counts as gone.
+    int retransmitTimeoutMs{ 100 };   ///< Wait for a response before the first retransmission.
+    int maxRetransmits{ 4 };          ///< Retransmissions before a command is given up.
+};
+
+
+/**
+ * @class Ocp1DatagramTransport
+ * @brief `NanoTransport` carrying OCP.1 frames over UDP, one PDU per datagram.
+ *
+ * Wraps a connected `NanoDatagramSocket`, so an `Ocp1Connection` runs over UDP
+ * as it does over TCP (see `Ocp1Connection::connectToTransport()`): every
+ * message sent leaves as one datagram, and received datagrams are handed to
+ * the `Ocp1FrameReader` back to back.  A datagram that is not a sequence of
+ * complete OCP.1 PDUs is dropped rather than breaking the frame sync.
+ *
+ * Every `Ocp1CommandResponseRequired` sent is kept until a response with its
+ * handle arrives; `retransmitDue()`, called periodically by the owner, sends
+ * overdue ones again as `DatagramPolicy` says.  Liveness is up to the owner as
+ * well, based on `getLastReceiveTime()` (see `NanoOcp1DatagramClient`).
+ *
+ * `retransmitDue()` and the getters may be called from any thread, alongside
+ * the usual single reader and serialised writers.
+ */
+class Ocp1DatagramTransport : public NanoTransport
+{
+public:
+    /** @brief Counters since construction, see `getStats()`. */
+    struct Stats
+    {
+        std::uint64_t datagramsSent{ 0 };      ///< Including retransmissions.
+        std::uint64_t datagramsReceived{ 0 };  ///< Valid datagrams only.
+        std::uint64_t datagramsDropped{ 0 };   ///< Received datagrams that were not whole OCP.1 PDUs.
+        std::uint64_t retransmissions{ 0 };    ///< Commands sent again for lack of a response.
+        std::uint64_t commandsGivenUp{ 0 };    ///< Commands that never got a response.
+    };
+
+    /**
+     * @param socket  Connected datagram socket (see `NanoDatagramSocket::connect()`).
+     * @param policy  Retransmission timing; the KeepAlive settings are the owner's.
+     */
+    explicit Ocp1DatagramTransport(std::unique_ptr<NanoDatagramSocket> socket,
+                                   const DatagramPolicy& policy = {});
+    ~Ocp1DatagramTransport() override;
+
+    Ocp1DatagramTransport(const Ocp1DatagramTransport&)            = delete;
+    Ocp1DatagramTransport& operator=(const Ocp1DatagramTransport&) = delete;
+
+    /**
+     * @brief Reads as many datagrams as fit, back to back.  One that does not fit
+     * completely continues in the next call (see `hasBufferedData()`).
+     */
+    int  readAvailable(void* data, int num) override;
+    /** @brief Sends each buffer, a complete serialized OCP.1 message, as one datagram. */
+    int  writeGather(const Buffer* buffers, int numBuffers) override;
+    int  waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const override;
+    bool hasBufferedData() const override;
+
+    NanoSocketHandle getHandle() const noexcept override { return m_socket->getHandle(); }
+    bool isSocket() const noexcept override { return true; }
+    bool isStream() const noexcept override { return false; }
+
+    void        close() override;
+    bool        isConnected() const override;
+    std::string getHostName() const override;
+    bool        setNonBlocking(bool nonBlocking) override;
+    bool        setOptions(const SocketOptions& options) override;
+    bool        getAppliedOptions(SocketOptions& applied) const override;
+
+    //==========================================================================
+    /**
+     * @brief Sends commands whose response is overdue again and gives up on those
+     * out of retransmissions.
+     * @return The number of datagrams sent.
+     */
+    int retransmitDue();
+
+    /** @brief Returns the number of commands still waiting for a response. */
+    std::size_t getPendingCommandCount() const;
+
+    /** @brief Returns when the last valid datagram arrived; the epoch if none has yet. */
+    std::chrono::steady_clock::time_point getLastReceiveTime() const;
+
+    /** @brief Returns the counters, see `Stats`. */
+    Stats getStats() const;
+
+    /** @brief Returns the local port the socket is bound to. */
+    int getBoundPort() const { return m_socket->getBoundPort(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /** A sent command (or PDU of commands) waiting for its responses. */
+    struct PendingCommand
+    {
+        ByteVector                 datagram;
+        std::vector<std::uint32_t> handles;    ///< Not yet answered.
+        Clock::time_point          due;
+        int                        retransmissions{ 0 };
+    };
+    using PendingList = std::list<PendingCommand>;
+
+    void trackCommands(const Buffer& buffer, Clock::time_point now);      ///< m_mutex held.
+    void acknowledgeResponses(const std::uint8_t* data, std::size_t size); ///< m_mutex held.
+    void forgetCommand(PendingList::iterator it);                          ///< m_mutex held.
+
+    std::unique_ptr<NanoDatagramSocket> m_socket;
+    DatagramPolicy                      m_policy;
+
+    mutable std::mutex                             m_mutex;  ///< Guards everything below and socket sends.
+    PendingList                                    m_pending;
+    std::unordered_map<std::uint32_t, PendingList::iterator> m_pendingByHandle;
+    Clock::time_point                              m_lastReceive;
+    Stats                                          m_stats;
+
+    // Read side, used by the reading thread only.
+    ByteVector  m_datagram;        ///< Receive buffer for one datagram.
+    std::size_t m_heldOffset{ 0 }; ///< Start of the part of m_datagram not yet returned.
+    std::size_t m_heldSize{ 0 };   ///< Bytes of m_datagram not yet returned.
+};
+
+
+} // namespace NanoOcp1
@@ -0,0 +1,275 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+
+namespace NanoOcp1
+{
+
+
+// ── Ocp1SharedFrame ──────────────────────────────────────────────────────────
+
+struct Ocp1SharedFrame::Block
+{
+    explicit Block(std::size_t size) : data(size) {}
+
+    std::atomic<std::size_t> refs{ 1 };
+    ByteVector               data;
+};
+
+namespace
+{
+
+void retain(Ocp1SharedFrame::Block* block) noexcept
+{
+    if (block)
+        block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void release(Ocp1SharedFrame::Block* block) noexcept
+{
+    // acq_rel: the reader's acquire load in isShared() must see every read of
+    // the frame bytes done before the release, before it overwrites them.
+    if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete block;
+}
+
+} // namespace
+
+Ocp1SharedFrame::Ocp1SharedFrame(Block* block, ByteSpan data) noexcept
+    : m_block(block), m_data(data)
+{
+    retain(m_block);
+}
+
+Ocp1SharedFrame::Ocp1SharedFrame(const Ocp1SharedFrame& other) noexcept
+    : m_block(other.m_block), m_data(other.m_data)
+{
+    retain(m_block);
+}
+
+Ocp1SharedFrame::Ocp1SharedFrame(Ocp1SharedFrame&& other) noexcept
+    : m_block(other.m_block), m_data(other.m_data)
+{
+    other.m_block = nullptr;
+    other.m_data  = {};
+}
+
+Ocp1SharedFrame& Ocp1SharedFrame::operator=(const Ocp1SharedFrame& other) noexcept
+{
+    if (this != &other)
+    {
+        retain(other.m_block);
+        release(m_block);
+        m_block = other.m_block;
+        m_data  = other.m_data;
+    }
+    return *this;
+}
+
+Ocp1SharedFrame& Ocp1SharedFrame::operator=(Ocp1SharedFrame&& other) noexcept
+{
+    if (this != &other)
+    {
+        release(m_block);
+        m_block       = other.m_block;
+        m_data        = other.m_data;
+        other.m_block = nullptr;
+        other.m_data  = {};
+    }
+    return *this;
+}
+
+Ocp1SharedFrame::~Ocp1SharedFrame()
+{
+    release(m_block);
+}
+
+
+// ── Ocp1FrameReader ──────────────────────────────────────────────────────────
+
+Ocp1FrameReader::Ocp1FrameReader(std::size_t capacity, std::size_t maxFrameSize)
+    : m_capacity(std::max<std::size_t>(capacity, Ocp1Header::Ocp1HeaderSize)),
+      m_maxFrameSize(std::max<std::size_t>(maxFrameSize, Ocp1Header::Ocp1HeaderSize))
+{
+    m_block = new Block(m_capacity);
+    m_pool.push_back(m_block);
+}
+
+Ocp1FrameReader::~Ocp1FrameReader()
+{
+    // Blocks still referenced by frames are deleted by their last frame.
+    for (auto* block : m_pool)
+        release(block);
+}
+
+bool Ocp1FrameReader::isShared() const
+{
+    return m_block->refs.load(std::memory_order_acquire) > 1;
+}
+
+bool Ocp1FrameReader::canAppend() const
+{
+    // Keep appending behind live frames while a useful amount of room is left
+    // and the pending frame, if its size is known, still fits.
+    const auto size = m_block->data.size();
+    return size - m_writePos >= size / 4 && m_readPos + m_pendingFrameSize <= size;
+}
+
+std::size_t Ocp1FrameReader::getMinimumCapacity() const
+{
+    return std::max(m_capacity, m_pendingFrameSize);
+}
+
+Ocp1FrameReader::Block* Ocp1FrameReader::takeFreeBlock(std::size_t minSize)
+{
+    for (auto* block : m_pool)
+    {
+        if (block != m_block && block->refs.load(std::memory_order_acquire) == 1)
+        {
+            if (block->data.size() < minSize)
+                block->data.resize(minSize);
+            return block;
+        }
+    }
+
+    auto* block = new Block(minSize);
+    m_pool.push_back(block);
+    return block;
+}
+
+std::uint8_t* Ocp1FrameReader::getWriteBuffer()
+{
+    if (!isShared())
+    {
+        // Move a trailing partial frame to the front so the free space is maximal
+        // and the frame ends up contiguous once the rest of it arrives.
+        if (m_readPos == m_writePos)
+        {
+            m_readPos  = 0;
+            m_writePos = 0;
+        }
+        else if (m_readPos > 0)
+        {
+            std::memmove(m_block->data.data(), m_block->data.data() + m_readPos, m_writePos - m_readPos);
+            m_writePos -= m_readPos;
+            m_readPos   = 0;
+        }
+
+        // A single frame larger than the buffer: grow just enough to hold it.
+        if (m_pendingFrameSize > m_block->data.size())
+            m_block->data.resize(m_pendingFrameSize);
+    }
+    else if (!canAppend())
+    {
+        // Frames in this block are still referenced: continue in another block,
+        // taking only the trailing partial frame along.
+        auto* next = takeFreeBlock(getMinimumCapacity());
+        const auto buffered = getBufferedSize();
+        if (buffered > 0)
+            std::memcpy(next->data.data(), m_block->data.data() + m_readPos, buffered);
+        m_block    = next;
+        m_readPos  = 0;
+        m_writePos = buffered;
+    }
+
+    m_writeLimit = m_block->data.size();
+    return m_block->data.data() + m_writePos;
+}
+
+std::size_t Ocp1FrameReader::getWritableSize() const
+{
+    if (m_writeLimit != 0)
+        return m_writeLimit - m_writePos;
+
+    // Not prepared yet: account for what getWriteBuffer() will do, so the two
+    // may be called in either order.  Frames released in between can only make
+    // more room, so this is a lower bound.
+    if (!isShared())
+        return std::max(m_block->data.size(), m_pendingFrameSize) - getBufferedSize();
+    if (canAppend())
+        return m_block->data.size() - m_writePos;
+    return getMinimumCapacity() - getBufferedSize();
+}
+
+void Ocp1FrameReader::commitWrite(std::size_t bytes)
+{
+    const auto limit = m_writeLimit != 0 ? m_writeLimit : m_block->data.size();
+    assert(bytes <= limit - m_writePos);
+    m_writePos  += std::min(bytes, limit - m_writePos);
+    m_writeLimit = 0;
+}
+
+Ocp1FrameReader::Status Ocp1FrameReader::nextFrame(ByteSpan& frame)
+{
+    const auto available = m_writePos - m_readPos;
+    if (available < Ocp1Header::Ocp1HeaderSize)
+        return Status::Incomplete;
+
+    const auto* start = m_block->data.data() + m_readPos;
+
+    // msgSize does not include the sync byte. Without a sync byte and a plausible
+    // size there is no way to find the next frame boundary, so the stream is lost.
+    const auto frameSize = static_cast<std::size_t>(ReadUint32(start + 3)) + 1;
+    if (start[0] != 0x3b || frameSize < Ocp1Header::Ocp1HeaderSize || frameSize > m_maxFrameSize)
+        return Status::Invalid;
+
+    if (available < frameSize)
+    {
+        m_pendingFrameSize = frameSize;
+        return Status::Incomplete;
+    }
+
+    frame = ByteSpan(start, frameSize);
+    m_readPos         += frameSize;
+    m_pendingFrameSize = 0;
+    return Status::Frame;
+}
+
+Ocp1FrameReader::Status Ocp1FrameReader::nextFrame(Ocp1SharedFrame& frame)
+{
+    ByteSpan span;
+    const auto status = nextFrame(span);
+    if (status == Status::Frame)
+        frame = Ocp1SharedFrame(m_block, span);
+    return status;
+}
+
+void Ocp1FrameReader::reset()
+{
+    // Bytes still referenced by frames must not be overwritten: drop the
+    // buffered data but leave the write position behind them.
+    m_readPos          = m_writePos;
+    m_pendingFrameSize = 0;
+    m_writeLimit       = 0;
+    if (!isShared())
+    {
+        m_readPos  = 0;
+        m_writePos = 0;
+    }
+}
+
+
+} // namespace NanoOcp1
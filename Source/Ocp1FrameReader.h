@@ -0,0 +1,183 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Ocp1DataTypes.h"
+
+
+namespace NanoOcp1
+{
+
+
+/**
+ * @class Ocp1SharedFrame
+ * @brief Reference-counted view of one received frame inside an `Ocp1FrameReader` buffer.
+ *
+ * Copying an `Ocp1SharedFrame` copies a pointer and bumps a reference count; the
+ * frame bytes themselves stay where the socket read put them.  As long as any
+ * copy is alive, the reader does not overwrite or move them, so a frame can be
+ * handed to another thread (e.g. the callback dispatcher) without copying its
+ * payload.  When the last copy is gone, the buffer returns to the reader's pool.
+ *
+ * Copies may be created and destroyed on any thread.  The bytes are read-only.
+ */
+class Ocp1SharedFrame
+{
+public:
+    Ocp1SharedFrame() noexcept = default;
+    Ocp1SharedFrame(const Ocp1SharedFrame& other) noexcept;
+    Ocp1SharedFrame(Ocp1SharedFrame&& other) noexcept;
+    Ocp1SharedFrame& operator=(const Ocp1SharedFrame& other) noexcept;
+    Ocp1SharedFrame& operator=(Ocp1SharedFrame&& other) noexcept;
+    ~Ocp1SharedFrame();
+
+    /** @brief Returns the frame bytes (sync byte included). */
+    ByteSpan getData() const noexcept { return m_data; }
+    operator ByteSpan() const noexcept { return m_data; }
+
+    const std::uint8_t* data() const noexcept { return m_data.data(); }
+    std::size_t size() const noexcept { return m_data.size(); }
+    bool empty() const noexcept { return m_data.empty(); }
+
+    /** @brief Returns an owning copy of the frame bytes. */
+    ByteVector toByteVector() const { return ByteVector(m_data.begin(), m_data.end()); }
+
+    /** @brief Pooled receive buffer shared by the frames sliced from it. */
+    struct Block;
+
+private:
+    friend class Ocp1FrameReader;
+    Ocp1SharedFrame(Block* block, ByteSpan data) noexcept;
+
+    Block*   m_block{ nullptr };
+    ByteSpan m_data;
+};
+
+
+/**
+ * @class Ocp1FrameReader
+ * @brief Receive buffer that splits an OCP.1 byte stream into complete frames.
+ *
+ * The owner reads as much as the socket has available straight into
+ * `getWriteBuffer()` and reports the amount with `commitWrite()`.  `nextFrame()`
+ * then yields every complete frame in the buffer as a `ByteSpan` pointing into
+ * the buffer itself — no copy, no allocation.  A trailing partial frame stays
+ * buffered and is moved to the front on the next `getWriteBuffer()` call, so a
+ * frame is always contiguous in memory.
+ *
+ * With this, one `recv()` typically yields many small frames (e.g. a burst of
+ * DS100 level-meter notifications) instead of costing two reads and one
+ * `ByteVector` per frame.
+ *
+ * Frames taken as `Ocp1SharedFrame` stay valid beyond the next read: while any of
+ * them is alive, new data is appended behind them, or — once the buffer is full
+ * — read into another buffer from a small pool, carrying over only the trailing
+ * partial frame.  Buffers return to the pool when their last frame is released,
+ * so steady-state delivery allocates nothing.
+ *
+ * Not thread-safe; intended to be owned by a single reading thread.
+ */
+class Ocp1FrameReader
+{
+public:
+    /** @brief Result of `nextFrame()`. */
+    enum class Status
+    {
+        Frame,      ///< A complete frame was returned.
+        Incomplete, ///< More data is needed before the next frame is complete.
+        Invalid     ///< The stream is not valid OCP.1 framing (bad sync byte or size).
+    };
+
+    static constexpr std::size_t DefaultCapacity     = 65536;
+    static constexpr std::size_t DefaultMaxFrameSize = 16 * 1024 * 1024;
+
+    /**
+     * @param capacity      Initial buffer size, i.e. the most that is read per call.
+     * @param maxFrameSize  Frames declaring a larger size are reported as Invalid.
+     *                      The buffer grows on demand up to this size.
+     */
+    explicit Ocp1FrameReader(std::size_t capacity = DefaultCapacity,
+                             std::size_t maxFrameSize = DefaultMaxFrameSize);
+    ~Ocp1FrameReader();
+
+    Ocp1FrameReader(const Ocp1FrameReader&)            = delete;
+    Ocp1FrameReader& operator=(const Ocp1FrameReader&) = delete;
+
+    /**
+     * @brief Returns the start of the free space to read new data into.
+     * Invalidates all spans previously returned by `nextFrame(ByteSpan&)`;
+     * `Ocp1SharedFrame`s stay valid.
+     */
+    std::uint8_t* getWriteBuffer();
+
+    /**
+     * @brief Returns the number of bytes that may be written to `getWriteBuffer()`.
+     * May be called before or after `getWriteBuffer()`.
+     */
+    std::size_t getWritableSize() const;
+
+    /** @brief Marks bytes written to `getWriteBuffer()` as received. */
+    void commitWrite(std::size_t bytes);
+
+    /**
+     * @brief Extracts the next complete frame.
+     * @param frame  Set to the frame (sync byte included) when Status::Frame is returned.
+     *               Valid until the next `getWriteBuffer()` or `reset()` call.
+     */
+    Status nextFrame(ByteSpan& frame);
+
+    /**
+     * @brief Extracts the next complete frame as a reference-counted view that
+     * stays valid until its last copy is destroyed.
+     */
+    Status nextFrame(Ocp1SharedFrame& frame);
+
+    /** @brief Returns the number of received bytes not yet returned as frames. */
+    std::size_t getBufferedSize() const { return m_writePos - m_readPos; }
+
+    /** @brief Returns the number of pooled buffers, i.e. the most ever in use at once. */
+    std::size_t getNumBuffers() const noexcept { return m_pool.size(); }
+
+    /** @brief Discards all buffered data, e.g. when a new connection is made. */
+    void reset();
+
+private:
+    using Block = Ocp1SharedFrame::Block;
+
+    bool        isShared() const;
+    bool        canAppend() const;
+    std::size_t getMinimumCapacity() const;
+    Block*      takeFreeBlock(std::size_t minSize);
+
+    std::vector<Block*> m_pool;              ///< Each entry holds one reference to its block.
+    Block*              m_block{ nullptr };  ///< Block currently read into; one of m_pool.
+    std::size_t         m_readPos{ 0 };
+    std::size_t         m_writePos{ 0 };
+    std::size_t         m_writeLimit{ 0 };   ///< End of the space handed out by getWriteBuffer(), 0 if none.
+    std::size_t         m_pendingFrameSize{ 0 }; ///< Size of the incomplete frame at m_readPos, once its header is in.
+    std::size_t         m_capacity;
+    std::size_t         m_maxFrameSize;
+};
+
+
+} // namespace NanoOcp1
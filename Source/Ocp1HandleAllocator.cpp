@@ -0,0 +1,84 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "Ocp1HandleAllocator.h"
+
+#include <limits>
+
+
+namespace NanoOcp1
+{
+
+
+namespace
+{
+
+constexpr std::uint32_t lastHandle = std::numeric_limits<std::uint32_t>::max();
+
+/** Moves a stored position onto the first handle of a block that fits before the wraparound. */
+std::uint32_t blockStart(std::uint32_t position, std::uint32_t count) noexcept
+{
+    if (position < Ocp1HandleAllocator::FirstHandle || lastHandle - position < count - 1)
+        return Ocp1HandleAllocator::FirstHandle;
+    return position;
+}
+
+} // namespace
+
+
+Ocp1HandleAllocator::Ocp1HandleAllocator(std::uint32_t first) noexcept
+    : m_next(first < FirstHandle ? FirstHandle : first)
+{
+}
+
+std::uint32_t Ocp1HandleAllocator::reserve(std::uint32_t count) noexcept
+{
+    if (count == 0 || count > lastHandle - FirstHandle + 1)
+        return InvalidHandle;
+
+    // Handles only need to be unique, not ordered with other memory accesses.
+    auto position = m_next.load(std::memory_order_relaxed);
+    std::uint32_t first;
+    do
+    {
+        first = blockStart(position, count);
+        // first + count wraps to 0 after the last handle; blockStart() skips that next time.
+    } while (!m_next.compare_exchange_weak(position, first + count, std::memory_order_relaxed));
+
+    return first;
+}
+
+std::uint32_t Ocp1HandleAllocator::peek() const noexcept
+{
+    return blockStart(m_next.load(std::memory_order_relaxed), 1);
+}
+
+void Ocp1HandleAllocator::reset(std::uint32_t first) noexcept
+{
+    m_next.store(first < FirstHandle ? FirstHandle : first, std::memory_order_relaxed);
+}
+
+Ocp1HandleAllocator& Ocp1HandleAllocator::getDefault() noexcept
+{
+    static Ocp1HandleAllocator allocator;
+    return allocator;
+}
+
+
+} // namespace NanoOcp1
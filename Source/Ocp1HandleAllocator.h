@@ -0,0 +1,84 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace NanoOcp1
+{
+
+
+/**
+ * @class Ocp1HandleAllocator
+ * @brief Hands out command handles, lock-free and safe to use from any thread.
+ *
+ * A handle identifies a command until its `Ocp1Response` arrives, so it only
+ * has to be unique among the commands pending on one connection.  Each
+ * `Ocp1Connection` therefore owns an allocator (`getHandleAllocator()`), and
+ * controllers on different connections never contend for the same counter.
+ *
+ * Handles count up from `FirstHandle` and wrap around after 0xFFFFFFFF,
+ * skipping 0 and 1 (OCA_INVALID_SESSIONID and OCA_LOCAL_SESSIONID).  A block
+ * returned by `reserve()` never straddles the wraparound, so its handles are
+ * consecutive: first, first + 1, …, first + count - 1.
+ */
+class Ocp1HandleAllocator
+{
+public:
+    static constexpr std::uint32_t InvalidHandle = 0;
+    static constexpr std::uint32_t FirstHandle   = 2;
+
+    /** @param first  Handle returned by the first call; values below FirstHandle start at FirstHandle. */
+    explicit Ocp1HandleAllocator(std::uint32_t first = FirstHandle) noexcept;
+
+    Ocp1HandleAllocator(const Ocp1HandleAllocator&)            = delete;
+    Ocp1HandleAllocator& operator=(const Ocp1HandleAllocator&) = delete;
+
+    /** @brief Returns the next handle. */
+    std::uint32_t next() noexcept { return reserve(1); }
+
+    /**
+     * @brief Reserves `count` consecutive handles, e.g. for a batch of commands,
+     * with a single atomic operation.
+     * @return The first handle of the block, or InvalidHandle if count is 0 or
+     *         exceeds the number of valid handles.
+     */
+    std::uint32_t reserve(std::uint32_t count) noexcept;
+
+    /** @brief Returns the handle the next call to `next()` would return, if uncontended. */
+    std::uint32_t peek() const noexcept;
+
+    /** @brief Restarts the sequence, e.g. in tests.  Not meant to race with `reserve()`. */
+    void reset(std::uint32_t first = FirstHandle) noexcept;
+
+    /**
+     * @brief Returns a process-wide allocator, used by commands created without
+     * an explicit one (see `Ocp1CommandResponseRequired`).
+     */
+    static Ocp1HandleAllocator& getDefault() noexcept;
+
+private:
+    std::atomic<std::uint32_t> m_next;
+};
+
+
+} // namespace NanoOcp1
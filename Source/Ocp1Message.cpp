@@ -19,6 +19,7 @@
 #include "Ocp1Message.h"
 
 #include <cassert>
+#include <cstring>
 
 
 namespace NanoOcp1
@@ -48,6 +49,26 @@ Ocp1CommandDefinition Ocp1CommandDefinition::RemoveSubscriptionCommand() const
                                  DataFromOnoForSubscription(m_targetOno, false));
 }
 
+Ocp1CommandDefinition Ocp1CommandDefinition::AddSubscription2Command() const
+{
+    return Ocp1CommandDefinition(0x00000004,                     // ONO of OcaSubscriptionManager
+                                 m_propertyType,
+                                 3,                              // OcaSubscriptionManager level
+                                 8,                              // AddSubscription2 method
+                                 3,                              // 3 Params
+                                 DataFromOnoForSubscription2(m_targetOno));
+}
+
+Ocp1CommandDefinition Ocp1CommandDefinition::RemoveSubscription2Command() const
+{
+    return Ocp1CommandDefinition(0x00000004,                     // ONO of OcaSubscriptionManager
+                                 m_propertyType,
+                                 3,                              // OcaSubscriptionManager level
+                                 9,                              // RemoveSubscription2 method
+                                 3,                              // 3 Params
+                                 DataFromOnoForSubscription2(m_targetOno));
+}
+
 Ocp1CommandDefinition Ocp1CommandDefinition::GetValueCommand() const
 {
     return Ocp1CommandDefinition(m_targetOno,
@@ -60,14 +81,12 @@ Ocp1CommandDefinition Ocp1CommandDefinition::GetValueCommand() const
 
 Ocp1CommandDefinition Ocp1CommandDefinition::SetValueCommand(const Variant& newValue) const
 {
-    ByteVector newParamData = newValue.ToParamData(GetDataType());
-
     return Ocp1CommandDefinition(m_targetOno,
                                  m_propertyType,
                                  m_propertyDefLevel,
                                  2,                     // Set method is usually MethodIdx 2
                                  1,                     // Set method usually takes one parameter
-                                 newParamData);
+                                 newValue.ToParamData(GetDataType()));
 }
 
 Ocp1CommandDefinition* Ocp1CommandDefinition::Clone() const
@@ -80,7 +99,7 @@ Ocp1CommandDefinition* Ocp1CommandDefinition::Clone() const
 // Class Ocp1Header
 //==============================================================================
 
-Ocp1Header::Ocp1Header(const ByteVector& memory)
+Ocp1Header::Ocp1Header(ByteSpan memory)
     :   m_syncVal(static_cast<std::uint8_t>(0)),
         m_protoVers(static_cast<std::uint16_t>(0)),
         m_msgSize(static_cast<std::uint32_t>(0)),
@@ -90,7 +109,7 @@ Ocp1Header::Ocp1Header(const ByteVector& memory)
     assert(memory.size() >= 10); // Not enough data to fit even an Ocp1Header.
     if (memory.size() >= 10)
     {
-        m_syncVal = memory.at(0);
+        m_syncVal = memory[0];
         assert(m_syncVal == 0x3b); // Message does not start with the sync byte.
 
         m_protoVers = ReadUint16(memory.data() + 1);
@@ -99,8 +118,8 @@ Ocp1Header::Ocp1Header(const ByteVector& memory)
         m_msgSize = ReadUint32(memory.data() + 3);
         assert(m_msgSize >= Ocp1HeaderSize); // Message has unexpected size.
 
-        m_msgType = memory.at(7);
-        assert(m_msgType <= Ocp1Message::KeepAlive); // Message type outside expected range.
+        m_msgType = memory[7];
+        assert(m_msgType <= Ocp1Message::Notification2); // Message type outside expected range.
 
         m_msgCnt = ReadUint16(memory.data() + 8);
         assert(m_msgCnt > 0); // At least one message expected.
@@ -110,27 +129,28 @@ Ocp1Header::Ocp1Header(const ByteVector& memory)
 bool Ocp1Header::IsValid() const
 {
     return ((m_syncVal == 0x3b) && (m_protoVers == 1) && (m_msgSize >= Ocp1HeaderSize) &&
-            (m_msgType <= Ocp1Message::KeepAlive) && (m_msgCnt > 0));
+            (m_msgType <= Ocp1Message::Notification2) && (m_msgCnt > 0));
 }
 
 ByteVector Ocp1Header::GetSerializedData() const
 {
-    ByteVector serializedData;
+    ByteVector serializedData(Ocp1HeaderSize);
 
-    serializedData.push_back(m_syncVal);
-    serializedData.push_back(static_cast<std::uint8_t>(m_protoVers >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_protoVers));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgSize));
-    serializedData.push_back(m_msgType);
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgCnt >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_msgCnt));
+    ByteAppender out(serializedData.data(), serializedData.size());
+    SerializeInto(out);
 
     return serializedData;
 }
 
+void Ocp1Header::SerializeInto(ByteAppender& out) const
+{
+    out.appendUint8(m_syncVal);
+    out.appendUint16(m_protoVers);
+    out.appendUint32(m_msgSize);
+    out.appendUint8(m_msgType);
+    out.appendUint16(m_msgCnt);
+}
+
 std::uint32_t Ocp1Header::CalculateMessageSize(std::uint8_t msgType, size_t parameterDataLength)
 {
     std::uint32_t ret(0);
@@ -150,6 +170,9 @@ std::uint32_t Ocp1Header::CalculateMessageSize(std::uint8_t msgType, size_t para
         case Ocp1Message::KeepAlive:
             ret = static_cast<std::uint32_t>(9 + parameterDataLength);
             break;
+        case Ocp1Message::Notification2:
+            ret = static_cast<std::uint32_t>(29 + parameterDataLength);
+            break;
         default:
             break;
     }
@@ -162,11 +185,316 @@ std::uint32_t Ocp1Header::CalculateMessageSize(std::uint8_t msgType, size_t para
 // Class Ocp1Message
 //==============================================================================
 
-// OCA_INVALID_SESSIONID  == 0, OCA_LOCAL_SESSIONID == 1
-std::uint32_t Ocp1Message::m_nextHandle = 2;
+ByteVector Ocp1Message::GetSerializedData()
+{
+    ByteVector serializedData(GetSerializedSize());
+    SerializeInto(serializedData.data(), serializedData.size());
+
+    return serializedData;
+}
+
+std::size_t Ocp1Message::SerializeInto(std::uint8_t* dst, std::size_t capacity) const
+{
+    const auto size = GetSerializedSize();
+    if (dst == nullptr || capacity < size)
+        return 0;
+
+    ByteAppender out(dst, size);
+    m_header.SerializeInto(out);
+    SerializeMessageInto(out);
+    assert(!out.overflowed() && out.size() == size); // Header size and message fields disagree.
+
+    return out.size();
+}
+
+
+bool Ocp1Message::PeekMessageType(ByteSpan frame, MessageType& type)
+{
+    if (frame.size() < Ocp1Header::Ocp1HeaderSize)
+        return false;
+
+    // Same conditions as Ocp1Header::IsValid().
+    const auto msgType = frame[7];
+    if (frame[0] != 0x3b || ReadUint16(frame.data() + 1) != 1 || ReadUint32(frame.data() + 3) < Ocp1Header::Ocp1HeaderSize
+        || msgType > Notification2 || ReadUint16(frame.data() + 8) == 0)
+        return false;
+
+    type = static_cast<MessageType>(msgType);
+    return true;
+}
+
+bool Ocp1Message::ParseNotification(ByteSpan frame, Ocp1NotificationView& view)
+{
+    MessageType type;
+    if (!PeekMessageType(frame, type))
+        return false;
+
+    if (type == Notification)
+        return ParseNotificationMessage(frame.subspan(Ocp1Header::Ocp1HeaderSize), view);
+    if (type == Notification2)
+        return ParseNotification2Message(frame.subspan(Ocp1Header::Ocp1HeaderSize), view);
+    return false;
+}
+
+bool Ocp1Message::ParseNotificationMessage(ByteSpan message, Ocp1NotificationView& view)
+{
+    // Peer-declared sizes only guarantee what was received; guard the fixed fields read below.
+    if (message.size() < 15)
+        return false;
+
+    std::uint32_t notificationSize(ReadUint32(message.data()));
+    std::uint32_t newValueSize = notificationSize - 28;
+    if (newValueSize < 1)
+        return false;
+
+    // Not a valid object number.
+    std::uint32_t targetOno(ReadUint32(message.data() + 4));
+    if (targetOno == 0)
+        return false;
+
+    // Method DefinitionLevel expected to be 3 (OcaSubscriptionManager)
+    std::uint16_t methodDefLevel(ReadUint16(message.data() + 8));
+    if (methodDefLevel < 1)
+        return false;
+
+    // Method index expected to be 1 (AddSubscription)
+    std::uint16_t methodIdx(ReadUint16(message.data() + 10));
+    if (methodIdx < 1)
+        return false;
+
+    // At least one parameter expected.
+    std::uint8_t paramCount = message[12];
+    if (paramCount < 1)
+        return false;
+
+    std::uint16_t contextSize(ReadUint16(message.data() + 13));
+
+    // contextSize is peer-controlled; re-validate before using it as a read offset.
+    if (message.size() < static_cast<std::size_t>(27) + contextSize)
+        return false;
+
+    // Not a valid object number.
+    std::uint32_t emitterOno(ReadUint32(message.data() + 15 + contextSize));
+    if (emitterOno == 0)
+        return false;
+
+    // Event definiton level expected to be 1 (OcaRoot).
+    std::uint16_t eventDefLevel(ReadUint16(message.data() + 19 + contextSize));
+    if (eventDefLevel != 1)
+        return false;
+
+    // Event index expected to be 1 (OCA_EVENT_PROPERTY_CHANGED).
+    std::uint16_t eventIdx(ReadUint16(message.data() + 21 + contextSize));
+    if (eventIdx != 1)
+        return false;
+
+    // Property definition level expected to be > 0.
+    std::uint16_t propDefLevel(ReadUint16(message.data() + 23 + contextSize));
+    if (propDefLevel == 0)
+        return false;
+
+    // Property index expected to be > 0.
+    std::uint16_t propIdx(ReadUint16(message.data() + 25 + contextSize));
+    if (propIdx == 0)
+        return false;
+
+    // notificationSize (and thus newValueSize) is peer-controlled; re-validate before slicing.
+    if (message.size() < static_cast<std::size_t>(27) + contextSize + newValueSize)
+        return false;
+
+    view.emitterOno              = emitterOno;
+    view.emitterPropertyDefLevel = propDefLevel;
+    view.emitterPropertyIndex    = propIdx;
+    view.paramCount              = paramCount;
+    view.parameterData           = message.subspan(27 + static_cast<std::size_t>(contextSize), newValueSize);
+    return true;
+}
+
+bool Ocp1Message::ParseNotification2Message(ByteSpan message, Ocp1NotificationView& view)
+{
+    // Peer-declared sizes only guarantee what was received; guard the fixed fields read below.
+    if (message.size() < 15)
+        return false;
+
+    // Not a valid object number.
+    std::uint32_t emitterOno(ReadUint32(message.data() + 4));
+    if (emitterOno == 0)
+        return false;
+
+    // Event definiton level expected to be 1 (OcaRoot).
+    std::uint16_t eventDefLevel(ReadUint16(message.data() + 8));
+    if (eventDefLevel != 1)
+        return false;
+
+    // Event index expected to be 1 (OCA_EVENT_PROPERTY_CHANGED).
+    std::uint16_t eventIdx(ReadUint16(message.data() + 10));
+    if (eventIdx != 1)
+        return false;
+
+    // Notification type expected to be 0 (Event); an Exception carries no value.
+    if (message[12] != 0)
+        return false;
+
+    // Event data: PropertyID (4), at least one value byte and the ChangeType (1).
+    std::uint16_t dataSize(ReadUint16(message.data() + 13));
+    if (dataSize < 6)
+        return false;
+
+    // dataSize is peer-controlled; re-validate before slicing.
+    if (message.size() < static_cast<std::size_t>(15) + dataSize)
+        return false;
+
+    // Property definition level expected to be > 0.
+    std::uint16_t propDefLevel(ReadUint16(message.data() + 15));
+    if (propDefLevel == 0)
+        return false;
+
+    // Property index expected to be > 0.
+    std::uint16_t propIdx(ReadUint16(message.data() + 17));
+    if (propIdx == 0)
+        return false;
+
+    view.emitterOno              = emitterOno;
+    view.emitterPropertyDefLevel = propDefLevel;
+    view.emitterPropertyIndex    = propIdx;
+    view.paramCount              = 1;
+    view.parameterData           = message.subspan(19, dataSize - 5u);
+    return true;
+}
+
+bool Ocp1Message::ParseResponse(ByteSpan frame, Ocp1ResponseView& view)
+{
+    MessageType type;
+    if (!PeekMessageType(frame, type) || type != Response)
+        return false;
+
+    return ParseResponseMessage(frame.subspan(Ocp1Header::Ocp1HeaderSize), view);
+}
+
+bool Ocp1Message::ParseResponseMessage(ByteSpan message, Ocp1ResponseView& view)
+{
+    // Peer-declared sizes only guarantee what was received; guard the fixed fields read below.
+    if (message.size() < 10)
+        return false;
+
+    std::uint32_t responseSize(ReadUint32(message.data()));
+    std::uint32_t parameterDataLength = responseSize - 10;
+    if (responseSize < 10)
+        return false;
+
+    // Not a valid handle.
+    std::uint32_t handle(ReadUint32(message.data() + 4));
+    if (handle == 0)
+        return false;
+
+    // responseSize (and thus parameterDataLength) is peer-controlled; re-validate before slicing.
+    if (message.size() < static_cast<std::size_t>(10) + parameterDataLength)
+        return false;
+
+    view.handle        = handle;
+    view.status        = message[8];
+    view.paramCount    = message[9];
+    view.parameterData = message.subspan(10, parameterDataLength);
+    return true;
+}
+
+bool Ocp1Message::ParseCommand(ByteSpan frame, Ocp1CommandView& view)
+{
+    MessageType type;
+    if (!PeekMessageType(frame, type) || (type != Command && type != CommandResponseRequired))
+        return false;
+
+    view.responseRequired = (type == CommandResponseRequired);
+    return ParseCommandMessage(frame.subspan(Ocp1Header::Ocp1HeaderSize), view);
+}
+
+bool Ocp1Message::ParseCommandMessage(ByteSpan message, Ocp1CommandView& view)
+{
+    constexpr std::size_t handleOffset = 4;
+    constexpr std::size_t targetOnoOffset = handleOffset + 4;
+    constexpr std::size_t methodDefLevelOffset = targetOnoOffset + 4;
+    constexpr std::size_t methodIdxOffset = methodDefLevelOffset + 2;
+    constexpr std::size_t paramCountOffset = methodIdxOffset + 2;
+    constexpr std::size_t parameterDataOffset = paramCountOffset + 1;
+    constexpr std::uint32_t minimumCommandSize = 17; // Size without parameters
+
+    // Guard against reading commandSize itself past the end of a truncated message.
+    if (message.size() < sizeof(std::uint32_t))
+        return false;
+
+    // commandSize(4) + handle(4) + targetOno(4) + methodDefLevel(2) + methodIdx(2) + paramCount(1) = 17 bytes
+    const std::uint32_t commandSize(ReadUint32(message.data()));
+    if (commandSize < minimumCommandSize)
+        return false;
+
+    // commandSize is peer-controlled; re-validate before reading the fields it covers.
+    if (message.size() < commandSize)
+        return false;
+
+    // Only a Response needs to find its command by handle; a Command may leave it 0.
+    const std::uint32_t handle(ReadUint32(message.data() + handleOffset));
+    const bool isInvalidHandle = (handle == 0 && view.responseRequired);
+    if (isInvalidHandle)
+        return false;
+
+    const std::uint32_t targetOno(ReadUint32(message.data() + targetOnoOffset));
+    const bool isInvalidTargetOno = (targetOno == 0);
+    if (isInvalidTargetOno)
+        return false;
+
+    const std::uint16_t methodDefLevel(ReadUint16(message.data() + methodDefLevelOffset));
+    const bool isInvalidMethodDefLevel = (methodDefLevel < 1);
+    if (isInvalidMethodDefLevel)
+        return false;
+
+    const std::uint16_t methodIdx(ReadUint16(message.data() + methodIdxOffset));
+    const bool isInvalidMethodIdx = (methodIdx < 1);
+    if (isInvalidMethodIdx)
+        return false;
+
+    const std::uint8_t paramCount = message[paramCountOffset];
+
+    view.handle         = handle;
+    view.targetOno      = targetOno;
+    view.methodDefLevel = methodDefLevel;
+    view.methodIndex    = methodIdx;
+    view.paramCount     = paramCount;
+    view.parameterData  = (paramCount == 0) ? ByteSpan()
+                                            : message.subspan(parameterDataOffset, commandSize - parameterDataOffset);
+    return true;
+}
+
+bool Ocp1Message::ParseKeepAlive(ByteSpan frame, Ocp1KeepAliveView& view)
+{
+    MessageType type;
+    if (!PeekMessageType(frame, type) || type != KeepAlive)
+        return false;
+
+    // The heartbeat is all that follows the header; its size tells its unit.
+    const auto pduSize = static_cast<std::size_t>(ReadUint32(frame.data() + 3)) + 1;
+    return ParseKeepAliveMessage(frame.subspan(0, pduSize).subspan(Ocp1Header::Ocp1HeaderSize), view);
+}
+
+bool Ocp1Message::ParseKeepAliveMessage(ByteSpan message, Ocp1KeepAliveView& view)
+{
+    if (message.size() == sizeof(std::uint16_t))
+    {
+        view.heartBeatSeconds      = ReadUint16(message.data());
+        view.heartBeatMilliseconds = 0;
+        return true;
+    }
+
+    if (message.size() == sizeof(std::uint32_t))
+    {
+        view.heartBeatSeconds      = 0;
+        view.heartBeatMilliseconds = ReadUint32(message.data());
+        return true;
+    }
 
+    return false;
+}
 
-std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const ByteVector& receivedData)
+std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(ByteSpan receivedData)
 {
     // Ocp1Header's own constructor asserts on this same condition, which aborts
     // rather than failing gracefully in a debug build; check first so a short
@@ -182,108 +510,37 @@ std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const ByteVector&
     {
         case Notification:
             {
-                // Peer-declared msgSize only guarantees Ocp1HeaderSize bytes; guard the fixed fields read below.
-                if (receivedData.size() < 25)
-                    return nullptr;
-
-                std::uint32_t notificationSize(ReadUint32(receivedData.data() + 10));
-                std::uint32_t newValueSize = notificationSize - 28;
-                if (newValueSize < 1)
-                    return nullptr;
-
-                // Not a valid object number.
-                std::uint32_t targetOno(ReadUint32(receivedData.data() + 14));
-                if (targetOno == 0)
-                    return nullptr;
-
-                // Method DefinitionLevel expected to be 3 (OcaSubscriptionManager)
-                std::uint16_t methodDefLevel(ReadUint16(receivedData.data() + 18));
-                if (methodDefLevel < 1)
-                    return nullptr;
-
-                // Method index expected to be 1 (AddSubscription)
-                std::uint16_t methodIdx(ReadUint16(receivedData.data() + 20));
-                if (methodIdx < 1)
+                Ocp1NotificationView view;
+                if (!ParseNotification(receivedData, view))
                     return nullptr;
 
-                // At least one parameter expected.
-                std::uint8_t paramCount = receivedData[22];
-                if (paramCount < 1)
-                    return nullptr;
-
-                std::uint16_t contextSize(ReadUint16(receivedData.data() + 23));
-
-                // contextSize is peer-controlled; re-validate before using it as a read offset.
-                if (receivedData.size() < static_cast<std::size_t>(37) + contextSize)
-                    return nullptr;
-
-                // Not a valid object number.
-                std::uint32_t emitterOno(ReadUint32(receivedData.data() + 25 + contextSize));
-                if (emitterOno == 0)
-                    return nullptr;
-
-                // Event definiton level expected to be 1 (OcaRoot).
-                std::uint16_t eventDefLevel(ReadUint16(receivedData.data() + 29 + contextSize));
-                if (eventDefLevel != 1)
-                    return nullptr;
+                auto parameterData = ByteVector(view.parameterData.begin(), view.parameterData.end());
 
-                // Event index expected to be 1 (OCA_EVENT_PROPERTY_CHANGED).
-                std::uint16_t eventIdx(ReadUint16(receivedData.data() + 31 + contextSize));
-                if (eventIdx != 1)
-                    return nullptr;
-
-                // Property definition level expected to be > 0.
-                std::uint16_t propDefLevel(ReadUint16(receivedData.data() + 33 + contextSize));
-                if (propDefLevel == 0)
-                    return nullptr;
-
-                // Property index expected to be > 0.
-                std::uint16_t propIdx(ReadUint16(receivedData.data() + 35 + contextSize));
-                if (propIdx == 0)
-                    return nullptr;
+                return std::make_unique<Ocp1Notification>(view.emitterOno, view.emitterPropertyDefLevel,
+                                                          view.emitterPropertyIndex, view.paramCount, std::move(parameterData));
+            }
 
-                // notificationSize (and thus newValueSize) is peer-controlled; re-validate before slicing.
-                if (receivedData.size() < static_cast<std::size_t>(37) + contextSize + newValueSize)
+        case Notification2:
+            {
+                Ocp1NotificationView view;
+                if (!ParseNotification(receivedData, view))
                     return nullptr;
 
-                const auto parameterData = ByteVector(receivedData.begin() + 37 + contextSize,
-                                                                     receivedData.begin() + 37 + contextSize + newValueSize);
+                auto parameterData = ByteVector(view.parameterData.begin(), view.parameterData.end());
 
-                return std::make_unique<Ocp1Notification>(emitterOno, propDefLevel, propIdx, paramCount, parameterData);
+                return std::make_unique<Ocp1Notification2>(view.emitterOno, view.emitterPropertyDefLevel,
+                                                           view.emitterPropertyIndex, view.paramCount, std::move(parameterData));
             }
 
         case Response:
             {
-                // Peer-declared msgSize only guarantees Ocp1HeaderSize bytes; guard the fixed fields read below.
-                if (receivedData.size() < 20)
+                Ocp1ResponseView view;
+                if (!ParseResponse(receivedData, view))
                     return nullptr;
 
-                std::uint32_t responseSize(ReadUint32(receivedData.data() + 10));
-                std::uint32_t parameterDataLength = responseSize - 10;
-                if (responseSize < 10)
-                    return nullptr;
-
-                // Not a valid handle.
-                std::uint32_t handle(ReadUint32(receivedData.data() + 14));
-                if (handle == 0)
-                    return nullptr;
-
-                const std::uint8_t status = receivedData[18];
-                const std::uint8_t paramCount = receivedData[19];
+                auto parameterData = ByteVector(view.parameterData.begin(), view.parameterData.end());
 
-                // responseSize (and thus parameterDataLength) is peer-controlled; re-validate before slicing.
-                if (receivedData.size() < static_cast<std::size_t>(20) + parameterDataLength)
-                    return nullptr;
-
-                const auto parameterData = [&receivedData, &parameterDataLength]() {
-                    if (parameterDataLength == 0)
-                        return ByteVector{};
-                    else
-                        return ByteVector(receivedData.begin() + 20, receivedData.begin() + 20 + parameterDataLength);
-                    }();
-                assert(parameterData.size() == parameterDataLength);
-
-                return std::make_unique<Ocp1Response>(handle, status, paramCount, parameterData);
+                return std::make_unique<Ocp1Response>(view.handle, view.status, view.paramCount, std::move(parameterData));
             }
 
         case KeepAlive:
@@ -298,105 +555,143 @@ std::unique_ptr<Ocp1Message> Ocp1Message::UnmarshalOcp1Message(const ByteVector&
             }
 
         case Command:
-            {
-                // Not used in this implementation. See CommandResponseRequired instead.
-                return nullptr;
-            }
         case CommandResponseRequired:
             {
-                constexpr std::size_t commandSizeOffset = Ocp1Header::Ocp1HeaderSize;
-                constexpr std::size_t handleOffset = commandSizeOffset + 4;
-                constexpr std::size_t targetOnoOffset = handleOffset + 4;
-                constexpr std::size_t methodDefLevelOffset = targetOnoOffset + 4;
-                constexpr std::size_t methodIdxOffset = methodDefLevelOffset + 2;
-                constexpr std::size_t paramCountOffset = methodIdxOffset + 2;
-                constexpr std::uint32_t minimumCommandSize = 17; // Size without parameters
-                constexpr std::size_t parameterDataOffset = paramCountOffset + 1;
-
-                // Guard against reading commandSize itself past the end of a truncated frame.
-                if (receivedData.size() < commandSizeOffset + sizeof(std::uint32_t))
+                Ocp1CommandView view;
+                if (!ParseCommand(receivedData, view))
                     return nullptr;
 
-                // commandSize(4) + handle(4) + targetOno(4) + methodDefLevel(2) + methodIdx(2) + paramCount(1) = 17 bytes
-                const std::uint32_t commandSize(ReadUint32(receivedData.data() + commandSizeOffset));
-                if (commandSize < minimumCommandSize)
-                    return nullptr;
+                auto parameterData = ByteVector(view.parameterData.begin(), view.parameterData.end());
 
-                if(receivedData.size() < Ocp1Header::Ocp1HeaderSize + commandSize)
-                    return nullptr;
+                std::unique_ptr<Ocp1Command> result;
+                if (view.responseRequired)
+                    result = std::make_unique<Ocp1CommandResponseRequired>(view.targetOno, view.methodDefLevel,
+                                                                           view.methodIndex, view.paramCount, std::move(parameterData));
+                else
+                    result = std::make_unique<Ocp1Command>(view.targetOno, view.methodDefLevel,
+                                                           view.methodIndex, view.paramCount, std::move(parameterData));
+                result->SetHandle(view.handle);
+                return result;
+            }
+        default:
+            return nullptr;
+    }
+}
 
-                std::uint32_t handle(ReadUint32(receivedData.data() + handleOffset));
-                const bool isInvalidHandle = (handle == 0);
-                if (isInvalidHandle)
-                    return nullptr;
 
-                const std::uint32_t targetOno(ReadUint32(receivedData.data() + targetOnoOffset));
-                const bool isInvalidTargetOno = (targetOno == 0);
-                if (isInvalidTargetOno)
-                    return nullptr;
 
-                const std::uint16_t methodDefLevel(ReadUint16(receivedData.data() + methodDefLevelOffset));
-                const bool isInvalidMethodDefLevel = (methodDefLevel < 1);
-                if (isInvalidMethodDefLevel)
-                    return nullptr;
+std::vector<std::unique_ptr<Ocp1Message>> Ocp1Message::UnmarshalOcp1Messages(ByteSpan receivedData)
+{
+    std::vector<std::unique_ptr<Ocp1Message>> messages;
 
-                const std::uint16_t methodIdx(ReadUint16(receivedData.data() + methodIdxOffset));
-                const bool isInvalidMethodIdx = (methodIdx < 1);
-                if (isInvalidMethodIdx)
-                    return nullptr;
+    Ocp1PduReader pdu(receivedData);
+    if (!pdu.IsValid())
+        return messages;
 
-                const std::uint8_t paramCount = receivedData[paramCountOffset];
-                
-                const auto parameterData = [&receivedData, &paramCount, &parameterDataOffset]() {
-                    if (paramCount == 0)
-                        return ByteVector{};
-                    else if(receivedData.begin() + parameterDataOffset >= receivedData.end())
-                        return ByteVector{};
-                    else
-                        return ByteVector(receivedData.begin() + parameterDataOffset, receivedData.end());
-                }();
-
-                auto result = std::make_unique<Ocp1CommandResponseRequired>(targetOno, methodDefLevel, methodIdx, paramCount, parameterData);
-                result->SetHandle(handle);
-                return result;
-            }
-        default:
-            return nullptr;
+    if (pdu.GetMessageCount() == 1)
+    {
+        auto message = UnmarshalOcp1Message(receivedData);
+        if (message)
+            messages.push_back(std::move(message));
+        return messages;
+    }
+
+    // Give each message a header of its own, so that UnmarshalOcp1Message()
+    // applies exactly the same checks to it as to a single-message PDU.
+    messages.reserve(pdu.GetMessageCount());
+    ByteVector single(receivedData.begin(), receivedData.begin() + Ocp1Header::Ocp1HeaderSize);
+    ByteSpan messageData;
+    while (pdu.Next(messageData))
+    {
+        const auto msgSize = static_cast<std::uint32_t>(Ocp1Header::Ocp1HeaderSize - 1 + messageData.size());
+        single.resize(Ocp1Header::Ocp1HeaderSize);
+        WriteUint32(single.data() + 3, msgSize);
+        WriteUint16(single.data() + 8, 1);
+        single.insert(single.end(), messageData.begin(), messageData.end());
+
+        auto message = UnmarshalOcp1Message(single);
+        if (!message)
+            return {};
+        messages.push_back(std::move(message));
     }
+
+    if (!pdu.IsValid() || messages.size() != pdu.GetMessageCount())
+        return {};
+
+    return messages;
 }
 
 
 
 //==============================================================================
-// Class Ocp1CommandResponseRequired
+// Class Ocp1Command
 //==============================================================================
 
-ByteVector Ocp1CommandResponseRequired::GetSerializedData()
+void Ocp1Command::SerializeMessageInto(ByteAppender& out) const
 {
-    ByteVector serializedData = m_header.GetSerializedData();
-
     std::uint32_t commandSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(commandSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_targetOno));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodDefLevel));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodIndex >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_methodIndex));
-    serializedData.push_back(static_cast<std::uint8_t>(m_paramCount));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
+    out.appendUint32(commandSize);
+    out.appendUint32(m_handle);
+    out.appendUint32(m_targetOno);
+    out.appendUint16(m_methodDefLevel);
+    out.appendUint16(m_methodIndex);
+    out.appendUint8(m_paramCount);
+    out.appendBytes(m_parameterData.data(), m_parameterData.size());
+}
+
+
+
+//==============================================================================
+// Class Ocp1PreparedCommand
+//==============================================================================
+
+Ocp1PreparedCommand::Ocp1PreparedCommand(const Ocp1CommandDefinition& command, Ocp1Message::MessageType msgType)
+    : m_dataType(command.GetDataType()),
+      m_valid(command.m_targetOno != 0 && command.m_propertyDefLevel >= 1 && command.m_propertyIndex >= 1 &&
+              (msgType == Ocp1Message::Command || msgType == Ocp1Message::CommandResponseRequired))
+{
+    // Serialize a parameterless command with handle 0; sizes and handle are patched per send.
+    Ocp1CommandResponseRequired prefix(command.m_targetOno, command.m_propertyDefLevel,
+                                       command.m_propertyIndex, command.m_paramCount, ByteVector());
+    prefix.SerializeInto(m_prefix.data(), m_prefix.size());
+    m_prefix[7] = static_cast<std::uint8_t>(msgType);
+}
+
+Ocp1PreparedCommand Ocp1PreparedCommand::SetValue(const Ocp1CommandDefinition& def, Ocp1Message::MessageType msgType)
+{
+    return Ocp1PreparedCommand(Ocp1CommandDefinition(def.m_targetOno,
+                                                     def.m_propertyType,
+                                                     def.m_propertyDefLevel,
+                                                     2,         // Set method is usually MethodIdx 2
+                                                     1),        // Set method usually takes one parameter
+                               msgType);
+}
+
+std::size_t Ocp1PreparedCommand::SerializeInto(std::uint8_t* dst, std::size_t capacity,
+                                               std::uint32_t handle, ByteSpan parameterData) const
+{
+    const auto size = GetSerializedSize(parameterData.size());
+    if (!m_valid || dst == nullptr || capacity < size)
+        return 0;
+
+    constexpr std::size_t commandSizeOffset = Ocp1Header::Ocp1HeaderSize;
+    constexpr std::size_t handleOffset = commandSizeOffset + 4;
+
+    std::memcpy(dst, m_prefix.data(), PrefixSize);
+    WriteUint32(dst + 3, static_cast<std::uint32_t>(size - 1)); // msgSize excludes the sync byte
+    WriteUint32(dst + commandSizeOffset, static_cast<std::uint32_t>(size - commandSizeOffset));
+    WriteUint32(dst + handleOffset, handle);
+    if (!parameterData.empty())
+        std::memcpy(dst + PrefixSize, parameterData.data(), parameterData.size());
+
+    return size;
+}
+
+ByteVector Ocp1PreparedCommand::GetSerializedData(std::uint32_t handle, ByteSpan parameterData) const
+{
+    ByteVector serializedData(GetSerializedSize(parameterData.size()));
+    if (SerializeInto(serializedData.data(), serializedData.size(), handle, parameterData) == 0)
+        return ByteVector();
 
     return serializedData;
 }
@@ -407,27 +702,14 @@ ByteVector Ocp1CommandResponseRequired::GetSerializedData()
 // Class Ocp1Response
 //==============================================================================
 
-ByteVector Ocp1Response::GetSerializedData()
+void Ocp1Response::SerializeMessageInto(ByteAppender& out) const
 {
-    ByteVector serializedData = m_header.GetSerializedData();
-
     std::uint32_t responseSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(responseSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_handle));
-    serializedData.push_back(static_cast<std::uint8_t>(m_status));
-    serializedData.push_back(static_cast<std::uint8_t>(m_paramCount));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
-
-    return serializedData;
+    out.appendUint32(responseSize);
+    out.appendUint32(m_handle);
+    out.appendUint8(m_status);
+    out.appendUint8(m_paramCount);
+    out.appendBytes(m_parameterData.data(), m_parameterData.size());
 }
 
 
@@ -436,51 +718,53 @@ ByteVector Ocp1Response::GetSerializedData()
 // Class Ocp1Notification
 //==============================================================================
 
-ByteVector Ocp1Notification::GetSerializedData()
+void Ocp1Notification::SerializeMessageInto(ByteAppender& out) const
 {
-    ByteVector serializedData = m_header.GetSerializedData();
-
     std::uint32_t notificationSize(m_header.GetMessageSize() - 9); // Message size minus the header
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 24));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(notificationSize));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 24)); // TargetOno
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno));
+    out.appendUint32(notificationSize);
+    out.appendUint32(m_emitterOno); // TargetOno
     std::uint16_t methodDefLevel = 3; // OcaSubscriptionManager
-    serializedData.push_back(static_cast<std::uint8_t>(methodDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(methodDefLevel));
+    out.appendUint16(methodDefLevel);
     std::uint16_t methodIdx = 1; // AddSubscription
-    serializedData.push_back(static_cast<std::uint8_t>(methodIdx >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(methodIdx));
-    std::uint16_t paramCount = 2;
-    serializedData.push_back(static_cast<std::uint8_t>(paramCount));
+    out.appendUint16(methodIdx);
+    std::uint8_t paramCount = 2;
+    out.appendUint8(paramCount);
     std::uint16_t contextLength = 0;
-    serializedData.push_back(static_cast<std::uint8_t>(contextLength >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(contextLength));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 24)); // EmitterOno
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 16));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterOno));
+    out.appendUint16(contextLength);
+    out.appendUint32(m_emitterOno); // EmitterOno
     std::uint16_t eventDefLevel = 1; // OcaRoot level
-    serializedData.push_back(static_cast<std::uint8_t>(eventDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(eventDefLevel));
+    out.appendUint16(eventDefLevel);
     std::uint16_t eventIdx = 1; // PropertyChanged event
-    serializedData.push_back(static_cast<std::uint8_t>(eventIdx >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(eventIdx));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyDefLevel >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyDefLevel));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyIndex >> 8));
-    serializedData.push_back(static_cast<std::uint8_t>(m_emitterPropertyIndex));
-    for (size_t i = 0; i < m_parameterData.size(); i++)
-    {
-        serializedData.push_back(m_parameterData[i]);
-    }
-    serializedData.push_back(static_cast<std::uint8_t>(1)); // Ending byte
+    out.appendUint16(eventIdx);
+    out.appendUint16(m_emitterPropertyDefLevel);
+    out.appendUint16(m_emitterPropertyIndex);
+    out.appendBytes(m_parameterData.data(), m_parameterData.size());
+    out.appendUint8(static_cast<std::uint8_t>(1)); // Ending byte
+}
 
-    return serializedData;
+
+
+//==============================================================================
+// Class Ocp1Notification2
+//==============================================================================
+
+void Ocp1Notification2::SerializeMessageInto(ByteAppender& out) const
+{
+    std::uint32_t notificationSize(m_header.GetMessageSize() - 9); // Message size minus the header
+    out.appendUint32(notificationSize);
+    out.appendUint32(m_emitterOno); // EmitterOno
+    std::uint16_t eventDefLevel = 1; // OcaRoot level
+    out.appendUint16(eventDefLevel);
+    std::uint16_t eventIdx = 1; // PropertyChanged event
+    out.appendUint16(eventIdx);
+    std::uint8_t notificationType = 0; // Event
+    out.appendUint8(notificationType);
+    std::uint16_t dataSize = static_cast<std::uint16_t>(m_parameterData.size() + 5); // PropertyID, value, ChangeType
+    out.appendUint16(dataSize);
+    out.appendUint16(m_emitterPropertyDefLevel);
+    out.appendUint16(m_emitterPropertyIndex);
+    out.appendBytes(m_parameterData.data(), m_parameterData.size());
+    out.appendUint8(static_cast<std::uint8_t>(1)); // ChangeType CurrentChanged
 }
 
 
@@ -521,12 +805,192 @@ std::uint32_t Ocp1KeepAlive::GetHeartBeatMilliseconds() const
     return 0;
 }
 
-ByteVector Ocp1KeepAlive::GetSerializedData()
+void Ocp1KeepAlive::SerializeMessageInto(ByteAppender& out) const
 {
-    ByteVector serializedData = m_header.GetSerializedData();
-    serializedData.insert(serializedData.end(), m_parameterData.begin(), m_parameterData.end());
-    
+    out.appendBytes(m_parameterData.data(), m_parameterData.size());
+}
+
+
+//==============================================================================
+// Class Ocp1PduBuilder
+//==============================================================================
+
+Ocp1PduBuilder::Ocp1PduBuilder(std::uint8_t msgType)
+    :   m_msgType(msgType),
+        m_msgCnt(static_cast<std::uint16_t>(0)),
+        m_data(Ocp1Header::Ocp1HeaderSize, 0)
+{
+}
+
+bool Ocp1PduBuilder::Add(Ocp1Message& message)
+{
+    // KeepAlives have no size field, so a reader could not tell where one ends.
+    if (message.GetMessageType() != m_msgType || m_msgType == Ocp1Message::KeepAlive || m_msgCnt == MaxMessageCount)
+        return false;
+
+    // Write the message without its header straight behind the previous one.
+    const auto offset = m_data.size();
+    const auto size = message.GetSerializedSize() - Ocp1Header::Ocp1HeaderSize;
+    m_data.resize(offset + size);
+
+    ByteAppender out(m_data.data() + offset, size);
+    message.SerializeMessageInto(out);
+    if (out.overflowed() || out.size() != size)
+    {
+        m_data.resize(offset);
+        return false;
+    }
+
+    m_msgCnt++;
+
+    return true;
+}
+
+ByteVector Ocp1PduBuilder::GetSerializedData() const
+{
+    if (IsEmpty())
+        return ByteVector();
+
+    ByteVector serializedData(m_data);
+
+    std::uint32_t msgSize(static_cast<std::uint32_t>(m_data.size() - 1)); // Excluding the sync byte
+    serializedData[0] = 0x3b;
+    WriteUint16(serializedData.data() + 1, 1);
+    WriteUint32(serializedData.data() + 3, msgSize);
+    serializedData[7] = m_msgType;
+    WriteUint16(serializedData.data() + 8, m_msgCnt);
+
     return serializedData;
 }
 
+void Ocp1PduBuilder::Clear()
+{
+    m_data.resize(Ocp1Header::Ocp1HeaderSize);
+    m_msgCnt = 0;
+}
+
+
+
+//==============================================================================
+// Class Ocp1PduReader
+//==============================================================================
+
+Ocp1PduReader::Ocp1PduReader(ByteSpan frame)
+    :   m_frame(frame),
+        m_msgType(Ocp1Message::Command),
+        m_msgCnt(static_cast<std::uint16_t>(0)),
+        m_msgRead(static_cast<std::uint16_t>(0)),
+        m_offset(Ocp1Header::Ocp1HeaderSize),
+        m_valid(Ocp1Message::PeekMessageType(frame, m_msgType))
+{
+    if (m_valid)
+    {
+        m_msgCnt = ReadUint16(frame.data() + 8);
+
+        // Never read past the declared end of the PDU, even if more bytes follow.
+        const auto pduSize = static_cast<std::size_t>(ReadUint32(frame.data() + 3)) + 1;
+        if (pduSize < m_frame.size())
+            m_frame = m_frame.subspan(0, pduSize);
+    }
+}
+
+bool Ocp1PduReader::Next(ByteSpan& message)
+{
+    if (!m_valid || m_msgRead >= m_msgCnt)
+        return false;
+
+    if (m_msgType == Ocp1Message::KeepAlive)
+    {
+        // No size field: a KeepAlive PDU carries exactly one heartbeat.
+        m_valid = (m_msgCnt == 1);
+        if (!m_valid)
+            return false;
+
+        message = m_frame.subspan(m_offset);
+        m_offset = m_frame.size();
+        m_msgRead++;
+        return true;
+    }
+
+    // Every other message starts with its own size, which includes the size field.
+    if (m_frame.size() - m_offset < sizeof(std::uint32_t))
+    {
+        m_valid = false;
+        return false;
+    }
+
+    const std::size_t messageSize(ReadUint32(m_frame.data() + m_offset));
+    if (messageSize < sizeof(std::uint32_t) || messageSize > m_frame.size() - m_offset)
+    {
+        m_valid = false;
+        return false;
+    }
+
+    message = m_frame.subspan(m_offset, messageSize);
+    m_offset += messageSize;
+    m_msgRead++;
+    return true;
+}
+
+bool Ocp1PduReader::Next(Ocp1NotificationView& view)
+{
+    ByteSpan message;
+    if ((m_msgType != Ocp1Message::Notification && m_msgType != Ocp1Message::Notification2) || !Next(message))
+        return false;
+
+    m_valid = (m_msgType == Ocp1Message::Notification2) ? Ocp1Message::ParseNotification2Message(message, view)
+                                                        : Ocp1Message::ParseNotificationMessage(message, view);
+    return m_valid;
+}
+
+bool Ocp1PduReader::Next(Ocp1ResponseView& view)
+{
+    ByteSpan message;
+    if (m_msgType != Ocp1Message::Response || !Next(message))
+        return false;
+
+    m_valid = Ocp1Message::ParseResponseMessage(message, view);
+    return m_valid;
+}
+
+bool Ocp1PduReader::Next(Ocp1CommandView& view)
+{
+    ByteSpan message;
+    if ((m_msgType != Ocp1Message::Command && m_msgType != Ocp1Message::CommandResponseRequired) || !Next(message))
+        return false;
+
+    view.responseRequired = (m_msgType == Ocp1Message::CommandResponseRequired);
+    m_valid = Ocp1Message::ParseCommandMessage(message, view);
+    return m_valid;
+}
+
+bool Ocp1PduReader::Next(Ocp1KeepAliveView& view)
+{
+    ByteSpan message;
+    if (m_msgType != Ocp1Message::KeepAlive || !Next(message))
+        return false;
+
+    m_valid = Ocp1Message::ParseKeepAliveMessage(message, view);
+    return m_valid;
+}
+
+bool Ocp1PduReader::Next(Ocp1MessageView& view)
+{
+    switch (m_msgType)
+    {
+        case Ocp1Message::Command:
+        case Ocp1Message::CommandResponseRequired:
+            return Next(view.emplace<Ocp1CommandView>());
+        case Ocp1Message::Notification:
+        case Ocp1Message::Notification2:
+            return Next(view.emplace<Ocp1NotificationView>());
+        case Ocp1Message::Response:
+            return Next(view.emplace<Ocp1ResponseView>());
+        case Ocp1Message::KeepAlive:
+            return Next(view.emplace<Ocp1KeepAliveView>());
+        default:
+            return false;
+    }
+}
+
 }
@@ -18,10 +18,15 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include "Variant.h"
 #include "Ocp1DataTypes.h" //< USE Ocp1DataType
+#include "Ocp1HandleAllocator.h"
 
 
 namespace NanoOcp1
@@ -90,13 +95,13 @@ struct Ocp1CommandDefinition
                           std::uint16_t propertyDefLevel,
                           std::uint16_t propertyIndex,
                           std::uint8_t paramCount = static_cast<std::uint8_t>(0),
-                          const ByteVector& parameterData = std::vector<std::uint8_t>())
+                          ByteVector parameterData = ByteVector())
         :   m_targetOno(targetOno),
             m_propertyType(propertyType),
             m_propertyDefLevel(propertyDefLevel),
             m_propertyIndex(propertyIndex),
             m_paramCount(paramCount),
-            m_parameterData(parameterData)
+            m_parameterData(std::move(parameterData))
     {
     }
 
@@ -121,6 +126,23 @@ struct Ocp1CommandDefinition
      */
     virtual Ocp1CommandDefinition RemoveSubscriptionCommand() const;
 
+    /**
+     * Generates a Ocp1CommandDefinition for an AddSubscription2 command (AES70-2023),
+     * which makes the device send compact Notification2 messages for this object.
+     * Can be overriden for custom object AddSubscription2 commands.
+     *
+     * @return An AddSubscription2 command definition.
+     */
+    virtual Ocp1CommandDefinition AddSubscription2Command() const;
+
+    /**
+     * Generates a Ocp1CommandDefinition for a RemoveSubscription2 command (AES70-2023).
+     * Can be overriden for custom object RemoveSubscription2 commands.
+     *
+     * @return A RemoveSubscription2 command definition.
+     */
+    virtual Ocp1CommandDefinition RemoveSubscription2Command() const;
+
     /**
      * Generates a Ocp1CommandDefinition for a typical GetValue command (methodIndex 1).
      * Can be overriden for custom object GetValue commands.
@@ -184,9 +206,9 @@ public:
     }
 
     /**
-     * Class constructor which creates a Ocp1Header based on a ByteVector.
+     * Class constructor which creates a Ocp1Header from the start of a received frame.
      */
-    explicit Ocp1Header(const ByteVector& memory);
+    explicit Ocp1Header(ByteSpan memory);
 
     /**
      * Class destructor.
@@ -228,6 +250,13 @@ public:
      */
     ByteVector GetSerializedData() const;
 
+    /**
+     * Writes the binary contents of the header to a caller-owned buffer.
+     *
+     * @param[in] out   Appender the 10 header bytes are written to.
+     */
+    void SerializeInto(ByteAppender& out) const;
+
     /**
      * Helper method to calculate the OCA message size based on the message's type and 
      * the number of parameter data bytes contained in the message.
@@ -248,9 +277,66 @@ protected:
     std::uint16_t               m_protoVers;    // Always 1
     std::uint32_t               m_msgSize;      // Size of the complete OCA message in bytes, excluding the initial sync bit.
     std::uint8_t                m_msgType;      // Type of OCA message (i.e. Notification, KeepAlive, etc).
-    std::uint16_t               m_msgCnt;       // Always 1
+    std::uint16_t               m_msgCnt;       // Number of messages in the PDU, 1 unless built by Ocp1PduBuilder
+};
+
+
+/**
+ * Fields of a received Notification, parsed in place by Ocp1Message::ParseNotification().
+ * parameterData points into the parsed frame and is valid for as long as the frame is.
+ */
+struct Ocp1NotificationView
+{
+    std::uint32_t   emitterOno{ 0 };
+    std::uint16_t   emitterPropertyDefLevel{ 0 };
+    std::uint16_t   emitterPropertyIndex{ 0 };
+    std::uint8_t    paramCount{ 0 };
+    ByteSpan        parameterData;
+};
+
+/**
+ * Fields of a received Response, parsed in place by Ocp1Message::ParseResponse().
+ * parameterData points into the parsed frame and is valid for as long as the frame is.
+ */
+struct Ocp1ResponseView
+{
+    std::uint32_t   handle{ 0 };
+    std::uint8_t    status{ 0 };
+    std::uint8_t    paramCount{ 0 };
+    ByteSpan        parameterData;
+};
+
+/**
+ * Fields of a received Command or CommandResponseRequired, parsed in place by
+ * Ocp1Message::ParseCommand().  parameterData points into the parsed frame and is
+ * valid for as long as the frame is.
+ */
+struct Ocp1CommandView
+{
+    std::uint32_t   handle{ 0 };
+    std::uint32_t   targetOno{ 0 };
+    std::uint16_t   methodDefLevel{ 0 };
+    std::uint16_t   methodIndex{ 0 };
+    std::uint8_t    paramCount{ 0 };
+    ByteSpan        parameterData;
+    bool            responseRequired{ true };   // False for a Command (type 0).
 };
 
+/**
+ * Fields of a received KeepAlive, parsed in place by Ocp1Message::ParseKeepAlive().
+ * Exactly one of the two heartbeat fields is set, depending on the form the peer sent.
+ */
+struct Ocp1KeepAliveView
+{
+    std::uint16_t   heartBeatSeconds{ 0 };
+    std::uint32_t   heartBeatMilliseconds{ 0 };
+};
+
+/**
+ * Any received message, parsed in place.  See Ocp1PduReader::Next() and VisitOcp1Messages().
+ */
+using Ocp1MessageView = std::variant<Ocp1CommandView, Ocp1NotificationView, Ocp1ResponseView, Ocp1KeepAliveView>;
+
 
 /**
  * @class Ocp1Message
@@ -314,6 +400,7 @@ public:
      * | 2 | Notification | Device→Client | Unsolicited property-change event (requires prior `AddSubscription`). |
      * | 3 | Response | Device→Client | Reply to a `CommandResponseRequired`; carries status and return value. |
      * | 4 | KeepAlive | Both | Heartbeat for connection supervision; carries heartbeat interval. |
+     * | 5 | Notification2 | Device→Client | Compact (EV2) notification of AES70-2023; requires `AddSubscription2`. |
      */
     enum MessageType
     {
@@ -321,15 +408,16 @@ public:
         CommandResponseRequired = 1,    ///< Command that expects a Response with a matching handle.
         Notification = 2,               ///< Unsolicited property change from device to client.
         Response = 3,                   ///< Device reply to a CommandResponseRequired.
-        KeepAlive = 4                   ///< Heartbeat for connection supervision.
+        KeepAlive = 4,                  ///< Heartbeat for connection supervision.
+        Notification2 = 5               ///< Compact property change notification (AES70-2023 EV2).
     };
 
     /**
      * Class constructor.
      */
-    Ocp1Message(std::uint8_t msgType, const ByteVector& parameterData)
+    Ocp1Message(std::uint8_t msgType, ByteVector parameterData)
         : m_header(Ocp1Header(msgType, parameterData.size())),
-        m_parameterData(parameterData)
+        m_parameterData(std::move(parameterData))
 
     {
     }
@@ -361,85 +449,222 @@ public:
 
     /**
      * Returns a vector of bytes representing the binary contents of the complete message.
-     * Must be reimplemented for each message type.
+     * Allocates a vector of exactly GetSerializedSize() bytes; use SerializeInto() to
+     * serialize into memory that is reused instead.
      *
      * @return  A vector containing the OCA message including header.
      */
-    virtual ByteVector GetSerializedData() = 0;
+    virtual ByteVector GetSerializedData();
+
+    /**
+     * Gets the size of the complete serialized message.
+     *
+     * @return  Size of the OCA message including header, in bytes.
+     */
+    std::size_t GetSerializedSize() const
+    {
+        return static_cast<std::size_t>(m_header.GetMessageSize()) + 1; // msgSize excludes the sync byte
+    }
+
+    /**
+     * Writes the binary contents of the complete message to a caller-owned buffer,
+     * without allocating.
+     *
+     * @param[out] dst      Buffer to write the OCA message including header to.
+     * @param[in] capacity  Size of the buffer, in bytes.
+     * @return  Number of bytes written, i.e. GetSerializedSize(), or 0 if capacity is too small.
+     */
+    std::size_t SerializeInto(std::uint8_t* dst, std::size_t capacity) const;
 
 
     /**
-     * Factory method which creates a new Ocp1Message object based on a vector<std::uint8_t>.
+     * Factory method which creates a new Ocp1Message object from a received frame.
      *
-     * @param[in] receivedData    Vector containing the received OCA message.
+     * @param[in] receivedData    The received OCA message, e.g. a ByteVector or an Ocp1SharedFrame.
      * @return  A unique pointer to the unmarshaled Ocp1Message object.
      */
-    static std::unique_ptr<Ocp1Message> UnmarshalOcp1Message(const ByteVector& receivedData);
+    static std::unique_ptr<Ocp1Message> UnmarshalOcp1Message(ByteSpan receivedData);
+
+    /**
+     * Factory method which creates a new Ocp1Message object for every message contained
+     * in a received PDU.  A PDU may carry several messages of the same type (see
+     * Ocp1PduBuilder); UnmarshalOcp1Message() only returns the first of them.
+     *
+     * @param[in] receivedData    The received OCA PDU.
+     * @return  The unmarshaled messages in PDU order, or an empty vector if any of them is invalid.
+     */
+    static std::vector<std::unique_ptr<Ocp1Message>> UnmarshalOcp1Messages(ByteSpan receivedData);
+
+    /**
+     * Reads the message type from the header of a received frame without parsing the rest.
+     *
+     * @param[in] frame     Complete received OCA message.
+     * @param[out] type     Set to the message type if the header is valid.
+     * @return  False if the frame does not start with a valid header.
+     */
+    static bool PeekMessageType(ByteSpan frame, MessageType& type);
+
+    /**
+     * Parses a received Notification in place, without copying its parameter data.
+     * Applies the same checks as UnmarshalOcp1Message().  Both the classic
+     * Notification and the compact Notification2 are accepted; the header tells
+     * them apart, so the result is the same view either way.
+     *
+     * @param[in] frame     Complete received OCA message.
+     * @param[out] view     Set to the notification's fields on success.
+     * @return  False if the frame is not a valid Notification or Notification2.
+     */
+    static bool ParseNotification(ByteSpan frame, Ocp1NotificationView& view);
+
+    /**
+     * Parses a received Response in place, without copying its parameter data.
+     * Applies the same checks as UnmarshalOcp1Message().
+     *
+     * @param[in] frame     Complete received OCA message.
+     * @param[out] view     Set to the response's fields on success.
+     * @return  False if the frame is not a valid Response.
+     */
+    static bool ParseResponse(ByteSpan frame, Ocp1ResponseView& view);
+
+    /**
+     * Parses a single Notification message in place, e.g. one returned by
+     * Ocp1PduReader::Next().
+     *
+     * @param[in] message   The message bytes, starting at its size field.
+     * @param[out] view     Set to the notification's fields on success.
+     * @return  False if the bytes are not a valid Notification message.
+     */
+    static bool ParseNotificationMessage(ByteSpan message, Ocp1NotificationView& view);
+
+    /**
+     * Parses a single Notification2 message in place.  Only PropertyChanged events
+     * are accepted; exception notifications carry no property value and are rejected.
+     *
+     * @param[in] message   The message bytes, starting at its size field.
+     * @param[out] view     Set to the notification's fields on success.
+     * @return  False if the bytes are not a valid Notification2 property change.
+     */
+    static bool ParseNotification2Message(ByteSpan message, Ocp1NotificationView& view);
+
+    /**
+     * Parses a single Response message in place, e.g. one returned by
+     * Ocp1PduReader::Next().
+     *
+     * @param[in] message   The message bytes, starting at its size field.
+     * @param[out] view     Set to the response's fields on success.
+     * @return  False if the bytes are not a valid Response message.
+     */
+    static bool ParseResponseMessage(ByteSpan message, Ocp1ResponseView& view);
+
+    /**
+     * Parses a received Command or CommandResponseRequired in place, without copying
+     * its parameter data.  Applies the same checks as UnmarshalOcp1Message().
+     *
+     * @param[in] frame     Complete received OCA message.
+     * @param[out] view     Set to the command's fields on success.
+     * @return  False if the frame is not a valid command.
+     */
+    static bool ParseCommand(ByteSpan frame, Ocp1CommandView& view);
+
+    /**
+     * Parses a single command message in place.  Leaves view.responseRequired
+     * unchanged, as only the PDU header tells the two command types apart; set
+     * it beforehand, since only a CommandResponseRequired must carry a handle.
+     *
+     * @param[in] message   The message bytes, starting at its size field.
+     * @param[out] view     Set to the command's fields on success.
+     * @return  False if the bytes are not a valid command message.
+     */
+    static bool ParseCommandMessage(ByteSpan message, Ocp1CommandView& view);
+
+    /**
+     * Parses a received KeepAlive in place.
+     *
+     * @param[in] frame     Complete received OCA message.
+     * @param[out] view     Set to the heartbeat on success.
+     * @return  False if the frame is not a valid KeepAlive.
+     */
+    static bool ParseKeepAlive(ByteSpan frame, Ocp1KeepAliveView& view);
+
+    /**
+     * Parses the heartbeat of a KeepAlive in place.
+     *
+     * @param[in] message   The 2 (seconds) or 4 (milliseconds) heartbeat bytes following the header.
+     * @param[out] view     Set to the heartbeat on success.
+     * @return  False if the bytes are not a valid heartbeat.
+     */
+    static bool ParseKeepAliveMessage(ByteSpan message, Ocp1KeepAliveView& view);
 
 
 protected:
+    /**
+     * Writes everything following the header.  Must be reimplemented for each message type.
+     *
+     * @param[in] out   Appender the message fields are written to.
+     */
+    virtual void SerializeMessageInto(ByteAppender& out) const = 0;
+
+    friend class Ocp1PduBuilder;
+
     Ocp1Header                  m_header;           // OCA message header.
     ByteVector   m_parameterData;                   // Parameter data contained by the message.
-    static std::uint32_t        m_nextHandle;       // Static variable to generate unique command handles.
 };
 
 
 /**
- * Representation of an OCA CommandResponseRequired message.
+ * Representation of an OCA Command message: a command the device executes
+ * without sending a Response.
+ *
+ * Meant for high-rate parameter streams — e.g. positions from a tracking
+ * system — where every value supersedes the previous one, so acknowledging
+ * each of them would only double the traffic.  The device still sends
+ * Notifications for subscribed properties.  The wire layout is the same as
+ * that of Ocp1CommandResponseRequired, which derives from this class.
  */
-class Ocp1CommandResponseRequired : public Ocp1Message
+class Ocp1Command : public Ocp1Message
 {
 public:
     /**
      * Class constructor without creating the handle.
-     * To set the handle of this command, use SetHandle() after instantiation.
+     * The device does not answer a Command, so its handle is not needed to
+     * match a Response; use SetHandle() to set one anyway.
      */
-    Ocp1CommandResponseRequired(std::uint32_t targetOno,
-                                std::uint16_t methodDefLevel,
-                                std::uint16_t methodIndex,
-                                std::uint8_t paramCount,
-                                const ByteVector& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(CommandResponseRequired), parameterData),
-            m_handle(0),
-            m_targetOno(targetOno),
-            m_methodDefLevel(methodDefLevel),
-            m_methodIndex(methodIndex),
-            m_paramCount(paramCount)
+    Ocp1Command(std::uint32_t targetOno,
+                std::uint16_t methodDefLevel,
+                std::uint16_t methodIndex,
+                std::uint8_t paramCount,
+                ByteVector parameterData)
+        : Ocp1Command(static_cast<std::uint8_t>(Command), targetOno, methodDefLevel, methodIndex,
+                      paramCount, std::move(parameterData))
     {
     }
 
     /**
-     * Class constructor.
+     * Class constructor that takes parameters via a Ocp1CommandDefinition struct.
      */
-    Ocp1CommandResponseRequired(std::uint32_t targetOno,
-                                std::uint16_t methodDefLevel,
-                                std::uint16_t methodIndex,
-                                std::uint8_t paramCount,
-                                const ByteVector& parameterData,
-                                std::uint32_t& handle)
-        : Ocp1CommandResponseRequired(targetOno, methodDefLevel, methodIndex,
-                                      paramCount, parameterData)
+    explicit Ocp1Command(const Ocp1CommandDefinition& def)
+        : Ocp1Command(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
+                      def.m_paramCount, def.m_parameterData)
     {
-        // Return a new unique handle every time this class is instantiated.
-        m_handle = m_nextHandle;
-        handle = m_handle;
-        m_nextHandle++;
     }
 
     /**
-     * Class constructor that takes parameters via a Ocp1CommandDefinition struct.
+     * Class constructor that takes parameters via a Ocp1CommandDefinition struct
+     * and the next handle from the given allocator.
      */
-    Ocp1CommandResponseRequired(const Ocp1CommandDefinition& def,
-                                std::uint32_t& handle)
-        : Ocp1CommandResponseRequired(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
-                                      def.m_paramCount, def.m_parameterData, handle)
+    Ocp1Command(const Ocp1CommandDefinition& def,
+                Ocp1HandleAllocator& handles,
+                std::uint32_t& handle)
+        : Ocp1Command(def)
     {
+        m_handle = handles.next();
+        handle = m_handle;
     }
 
     /**
      * Class destructor.
      */
-    ~Ocp1CommandResponseRequired() override = default;
+    ~Ocp1Command() override = default;
 
     /**
      * Override the automatically assigned command handle with a manually defined one.
@@ -470,12 +695,35 @@ public:
     {
         return m_methodIndex;
     }
+
+    std::uint8_t GetParamCount() const
+    {
+        return m_paramCount;
+    }
     
+protected:
+    /**
+     * Class constructor for the message types sharing the command layout.
+     */
+    Ocp1Command(std::uint8_t msgType,
+                std::uint32_t targetOno,
+                std::uint16_t methodDefLevel,
+                std::uint16_t methodIndex,
+                std::uint8_t paramCount,
+                ByteVector parameterData)
+        : Ocp1Message(msgType, std::move(parameterData)),
+            m_handle(0),
+            m_targetOno(targetOno),
+            m_methodDefLevel(methodDefLevel),
+            m_methodIndex(methodIndex),
+            m_paramCount(paramCount)
+    {
+    }
+
     // Reimplemented from Ocp1Message
 
-    ByteVector GetSerializedData() override;
+    void SerializeMessageInto(ByteAppender& out) const override;
 
-protected:
     std::uint32_t               m_handle;           // Handle of the command.
     std::uint32_t               m_targetOno;        // Target ONo of the command.
     std::uint16_t               m_methodDefLevel;   // Level of the method definition within the AES70 class hierarchy.
@@ -484,6 +732,204 @@ protected:
 };
 
 
+/**
+ * Representation of an OCA CommandResponseRequired message.
+ */
+class Ocp1CommandResponseRequired : public Ocp1Command
+{
+public:
+    /**
+     * Class constructor without creating the handle.
+     * To set the handle of this command, use SetHandle() after instantiation.
+     */
+    Ocp1CommandResponseRequired(std::uint32_t targetOno,
+                                std::uint16_t methodDefLevel,
+                                std::uint16_t methodIndex,
+                                std::uint8_t paramCount,
+                                ByteVector parameterData)
+        : Ocp1Command(static_cast<std::uint8_t>(CommandResponseRequired), targetOno, methodDefLevel,
+                      methodIndex, paramCount, std::move(parameterData))
+    {
+    }
+
+    /**
+     * Class constructor.  Takes the next handle from the process-wide
+     * Ocp1HandleAllocator::getDefault(); prefer the overload taking the
+     * allocator of the connection the command is sent on.
+     */
+    Ocp1CommandResponseRequired(std::uint32_t targetOno,
+                                std::uint16_t methodDefLevel,
+                                std::uint16_t methodIndex,
+                                std::uint8_t paramCount,
+                                ByteVector parameterData,
+                                std::uint32_t& handle)
+        : Ocp1CommandResponseRequired(targetOno, methodDefLevel, methodIndex,
+                                      paramCount, std::move(parameterData), Ocp1HandleAllocator::getDefault(), handle)
+    {
+    }
+
+    /**
+     * Class constructor that takes the next handle from the given allocator,
+     * typically Ocp1Connection::getHandleAllocator().
+     */
+    Ocp1CommandResponseRequired(std::uint32_t targetOno,
+                                std::uint16_t methodDefLevel,
+                                std::uint16_t methodIndex,
+                                std::uint8_t paramCount,
+                                ByteVector parameterData,
+                                Ocp1HandleAllocator& handles,
+                                std::uint32_t& handle)
+        : Ocp1CommandResponseRequired(targetOno, methodDefLevel, methodIndex,
+                                      paramCount, std::move(parameterData))
+    {
+        m_handle = handles.next();
+        handle = m_handle;
+    }
+
+    /**
+     * Class constructor that takes parameters via a Ocp1CommandDefinition struct.
+     */
+    Ocp1CommandResponseRequired(const Ocp1CommandDefinition& def,
+                                std::uint32_t& handle)
+        : Ocp1CommandResponseRequired(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
+                                      def.m_paramCount, def.m_parameterData, handle)
+    {
+    }
+
+    /**
+     * Class constructor that takes parameters via a Ocp1CommandDefinition struct,
+     * without creating the handle.  To set the handle of this command, use
+     * SetHandle() after instantiation, e.g. with one of a block of handles
+     * reserved via Ocp1HandleAllocator::reserve().
+     */
+    explicit Ocp1CommandResponseRequired(const Ocp1CommandDefinition& def)
+        : Ocp1CommandResponseRequired(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
+                                      def.m_paramCount, def.m_parameterData)
+    {
+    }
+
+    /**
+     * Class constructor that takes parameters via a Ocp1CommandDefinition struct
+     * and the next handle from the given allocator.
+     */
+    Ocp1CommandResponseRequired(const Ocp1CommandDefinition& def,
+                                Ocp1HandleAllocator& handles,
+                                std::uint32_t& handle)
+        : Ocp1CommandResponseRequired(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
+                                      def.m_paramCount, def.m_parameterData, handles, handle)
+    {
+    }
+
+    /**
+     * Class destructor.
+     */
+    ~Ocp1CommandResponseRequired() override = default;
+};
+
+
+/**
+ * A Command or CommandResponseRequired whose fixed part is serialized once and reused.
+ *
+ * Header, target ONo, method and parameter count of a command do not change
+ * between sends; only the handle, the sizes and the parameter bytes do.
+ * Ocp1PreparedCommand keeps the first 27 bytes of the frame ready and
+ * SerializeInto() copies them and patches those fields, so a repeated
+ * SetValue is a memcpy and three stores instead of building and serializing
+ * an Ocp1CommandDefinition and an Ocp1CommandResponseRequired each time.
+ *
+ * ```cpp
+ * // Once per object:
+ * auto prepared = Ocp1PreparedCommand::SetValue(positionDef);
+ * // Per update:
+ * std::uint8_t frame[64];
+ * auto size = prepared.SerializeInto(frame, sizeof(frame), connection.getHandleAllocator().next(), positionBytes);
+ * connection.sendMessage(ByteSpan(frame, size));
+ * ```
+ * See also Ocp1Controller::setValue(const Ocp1PreparedCommand&, ByteSpan).
+ */
+class Ocp1PreparedCommand
+{
+public:
+    /** Size of the prepared part: header plus command fields up to the parameter count. */
+    static constexpr std::size_t PrefixSize = Ocp1Header::Ocp1HeaderSize + 17;
+
+    /**
+     * Creates an invalid prepared command.
+     */
+    Ocp1PreparedCommand() = default;
+
+    /**
+     * Prepares sends of the given command, e.g. def.GetValueCommand().
+     * Its parameter data is ignored; pass the parameters with every send.
+     *
+     * @param[in] command   Target and method of the command.
+     * @param[in] msgType   CommandResponseRequired, or Command to send without a Response (see Ocp1Command).
+     */
+    explicit Ocp1PreparedCommand(const Ocp1CommandDefinition& command,
+                                 Ocp1Message::MessageType msgType = Ocp1Message::CommandResponseRequired);
+
+    /**
+     * Prepares SetValue commands (methodIndex 2, one parameter) for the given
+     * object, as built by Ocp1CommandDefinition::SetValueCommand().
+     */
+    static Ocp1PreparedCommand SetValue(const Ocp1CommandDefinition& def,
+                                        Ocp1Message::MessageType msgType = Ocp1Message::CommandResponseRequired);
+
+    /**
+     * Returns Command or CommandResponseRequired.
+     */
+    Ocp1Message::MessageType GetMessageType() const
+    {
+        return static_cast<Ocp1Message::MessageType>(m_prefix[7]);
+    }
+
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    std::uint32_t GetTargetOno() const
+    {
+        return ReadUint32(m_prefix.data() + Ocp1Header::Ocp1HeaderSize + 8);
+    }
+
+    Ocp1DataType GetDataType() const
+    {
+        return m_dataType;
+    }
+
+    /**
+     * Returns the size of the frame for parameters of the given size.
+     */
+    std::size_t GetSerializedSize(std::size_t parameterDataSize) const
+    {
+        return PrefixSize + parameterDataSize;
+    }
+
+    /**
+     * Writes the command frame with the given handle and parameters.
+     *
+     * @param[out] dst              Buffer of at least GetSerializedSize(parameterData.size()) bytes.
+     * @param[in] capacity          Size of dst.
+     * @param[in] handle            Command handle, e.g. from Ocp1HandleAllocator::next().
+     * @param[in] parameterData     Marshaled parameters, e.g. from Variant::ToParamData().
+     * @return  Number of bytes written, or 0 if the command is invalid or capacity is too small.
+     */
+    std::size_t SerializeInto(std::uint8_t* dst, std::size_t capacity,
+                              std::uint32_t handle, ByteSpan parameterData) const;
+
+    /**
+     * Returns the command frame with the given handle and parameters in a new vector.
+     */
+    ByteVector GetSerializedData(std::uint32_t handle, ByteSpan parameterData) const;
+
+private:
+    std::array<std::uint8_t, PrefixSize>    m_prefix{};                     // Frame up to the parameter data, sizes and handle unset.
+    Ocp1DataType                            m_dataType{ OCP1DATATYPE_NONE }; // Data type of the parameter.
+    bool                                    m_valid{ false };
+};
+
+
 /**
  * Representation of an Oca Response message.
  */
@@ -496,8 +942,8 @@ public:
     Ocp1Response(std::uint32_t handle,
                  std::uint8_t status,
                  std::uint8_t paramCount,
-                 const ByteVector& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(Response), parameterData),
+                 ByteVector parameterData)
+        : Ocp1Message(static_cast<std::uint8_t>(Response), std::move(parameterData)),
             m_handle(handle),
             m_status(status),
             m_paramCount(paramCount)
@@ -539,11 +985,11 @@ public:
         return m_paramCount;
     }
 
+protected:
     // Reimplemented from Ocp1Message
 
-    ByteVector GetSerializedData() override;
+    void SerializeMessageInto(ByteAppender& out) const override;
 
-protected:
     /**
      * Handle of the response. Should match the handle of a previously sent command.
      */
@@ -574,8 +1020,8 @@ public:
                      std::uint16_t emitterPropertyDefLevel,
                      std::uint16_t emitterPropertyIndex,
                      std::uint8_t paramCount,
-                     const ByteVector& parameterData)
-        : Ocp1Message(static_cast<std::uint8_t>(Notification), parameterData),
+                     ByteVector parameterData)
+        : Ocp1Message(static_cast<std::uint8_t>(Notification), std::move(parameterData)),
             m_emitterOno(emitterOno),
             m_emitterPropertyDefLevel(emitterPropertyDefLevel),
             m_emitterPropertyIndex(emitterPropertyIndex),
@@ -593,6 +1039,26 @@ public:
         return m_emitterOno;
     }
 
+    /**
+     * Get the definition level of the property that changed.
+     *
+     * @return  The property's level within the AES70 class hierarchy.
+     */
+    std::uint16_t GetEmitterPropertyDefLevel() const
+    {
+        return m_emitterPropertyDefLevel;
+    }
+
+    /**
+     * Get the index of the property that changed.
+     *
+     * @return  The property's index within its AES70 class definition.
+     */
+    std::uint16_t GetEmitterPropertyIndex() const
+    {
+        return m_emitterPropertyIndex;
+    }
+
     /**
      * Class destructor.
      */
@@ -621,11 +1087,28 @@ public:
                 (def->m_propertyIndex == m_emitterPropertyIndex));
     }
 
+protected:
+    /**
+     * Constructor for derived notification formats.
+     */
+    Ocp1Notification(std::uint8_t msgType,
+                     std::uint32_t emitterOno,
+                     std::uint16_t emitterPropertyDefLevel,
+                     std::uint16_t emitterPropertyIndex,
+                     std::uint8_t paramCount,
+                     ByteVector parameterData)
+        : Ocp1Message(msgType, std::move(parameterData)),
+            m_emitterOno(emitterOno),
+            m_emitterPropertyDefLevel(emitterPropertyDefLevel),
+            m_emitterPropertyIndex(emitterPropertyIndex),
+            m_paramCount(paramCount)
+    {
+    }
+
     // Reimplemented from Ocp1Message
 
-    ByteVector GetSerializedData() override;
+    void SerializeMessageInto(ByteAppender& out) const override;
 
-protected:
     std::uint32_t               m_emitterOno;               // ONo of the object whose property changed, triggering this notification.
     std::uint16_t               m_emitterPropertyDefLevel;  // Level of the property definition within the AES70 class hierarchy.
     std::uint16_t               m_emitterPropertyIndex;     // Index of the property within its AES70 class definition.
@@ -637,6 +1120,48 @@ protected:
 };
 
 
+/**
+ * Representation of an Oca Notification2 message (AES70-2023, "EV2").
+ *
+ * Carries the same property change as an Ocp1Notification, without the fields
+ * the classic format inherits from being a command to the subscriber: target
+ * ONo, method ID, parameter count and subscriber context.  A float level meter
+ * update shrinks from 42 to 34 bytes on the wire.  Devices only send this format
+ * to controllers that subscribed with AddSubscription2 or
+ * AddPropertyChangeSubscription2.
+ *
+ * Layout after the header: NotificationSize (4), EmitterONo (4), EventID (2+2),
+ * NotificationType (1, 0 = Event), then a blob (length 2) holding the PropertyID
+ * (2+2), the new value and the ChangeType (1).
+ */
+class Ocp1Notification2 : public Ocp1Notification
+{
+public:
+    /**
+     * Class constructor.
+     */
+    Ocp1Notification2(std::uint32_t emitterOno,
+                      std::uint16_t emitterPropertyDefLevel,
+                      std::uint16_t emitterPropertyIndex,
+                      std::uint8_t paramCount,
+                      ByteVector parameterData)
+        : Ocp1Notification(static_cast<std::uint8_t>(Notification2), emitterOno,
+                           emitterPropertyDefLevel, emitterPropertyIndex, paramCount, std::move(parameterData))
+    {
+    }
+
+    /**
+     * Class destructor.
+     */
+    ~Ocp1Notification2() override = default;
+
+protected:
+    // Reimplemented from Ocp1Message
+
+    void SerializeMessageInto(ByteAppender& out) const override;
+};
+
+
 /**
  * Representation of an Oca KeepAlive message. 
  */
@@ -671,9 +1196,260 @@ public:
     std::uint32_t GetHeartBeatMilliseconds() const;
 
 
+protected:
     // Reimplemented from Ocp1Message
 
-    ByteVector GetSerializedData() override;
+    void SerializeMessageInto(ByteAppender& out) const override;
+};
+
+
+/**
+ * @class Ocp1PduBuilder
+ * @brief Packs several messages of the same type into one OCP.1 PDU.
+ *
+ * The OCP.1 header carries a message count, so N commands (or notifications,
+ * or responses) can share one 10-byte header and be framed, sent and parsed as
+ * a single unit.  This saves header bytes and per-frame work in bursts such as
+ * the AddSubscription and GetValue commands sent after connecting:
+ * ```cpp
+ * Ocp1PduBuilder pdu;
+ * for (const auto& def : defs)
+ * {
+ *     std::uint32_t handle{0};
+ *     Ocp1CommandResponseRequired cmd(def.GetValueCommand(), handle);
+ *     pdu.Add(cmd);
+ * }
+ * client->sendData(pdu.GetSerializedData());
+ * ```
+ *
+ * KeepAlive messages carry no size field and therefore cannot be packed.
+ * Not thread-safe.
+ */
+class Ocp1PduBuilder
+{
+public:
+    /** Largest number of messages the 16-bit message count allows. */
+    static constexpr std::uint16_t MaxMessageCount = 0xFFFF;
+
+    /**
+     * Class constructor.
+     *
+     * @param[in] msgType   Type of the messages this PDU will carry.
+     */
+    explicit Ocp1PduBuilder(std::uint8_t msgType = Ocp1Message::CommandResponseRequired);
+
+    /**
+     * Appends a message to the PDU.
+     *
+     * @param[in] message   Message of the type given to the constructor.
+     * @return  False if the message has a different type, is a KeepAlive, or the PDU is full.
+     */
+    bool Add(Ocp1Message& message);
+
+    /**
+     * Gets the number of messages added since construction or the last Clear().
+     */
+    std::uint16_t GetMessageCount() const { return m_msgCnt; }
+
+    /**
+     * Checks if no message has been added yet.
+     */
+    bool IsEmpty() const { return m_msgCnt == 0; }
+
+    /**
+     * Gets the size of the PDU built so far, in bytes, including the header.
+     */
+    std::size_t GetSize() const { return m_data.size(); }
+
+    /**
+     * Returns the complete PDU, header included.
+     *
+     * @return  The serialized PDU, or an empty vector if no message has been added.
+     */
+    ByteVector GetSerializedData() const;
+
+    /**
+     * Removes all messages, keeping the allocated memory for the next PDU.
+     */
+    void Clear();
+
+private:
+    std::uint8_t                m_msgType;  // Type of all messages in the PDU.
+    std::uint16_t               m_msgCnt;   // Number of messages added.
+    ByteVector                  m_data;     // Header placeholder followed by the messages.
+};
+
+
+/**
+ * @class Ocp1PduReader
+ * @brief Iterates over the messages contained in a received PDU, in place.
+ *
+ * Most PDUs carry a single message, but a peer may pack several messages of the
+ * same type into one (see Ocp1PduBuilder).  `Next()` yields each message's bytes,
+ * starting at its size field, as a view into the frame; the fields can then be
+ * read with `Ocp1Message::ParseNotificationMessage()` and similar.
+ * ```cpp
+ * Ocp1PduReader pdu(frame);
+ * Ocp1NotificationView notif;
+ * while (pdu.Next(notif))
+ *     handle(notif);
+ * ```
+ * Iteration stops at the first malformed message; IsValid() then returns false.
+ */
+class Ocp1PduReader
+{
+public:
+    /**
+     * Class constructor.
+     *
+     * @param[in] frame     Complete received PDU, sync byte included.  Must outlive the reader.
+     */
+    explicit Ocp1PduReader(ByteSpan frame);
+
+    /**
+     * Checks if the header and all messages read so far are valid.
+     */
+    bool IsValid() const { return m_valid; }
+
+    /**
+     * Gets the type of the messages in the PDU.  Only meaningful if the header is valid.
+     */
+    Ocp1Message::MessageType GetMessageType() const { return m_msgType; }
+
+    /**
+     * Gets the number of messages the header announces.
+     */
+    std::uint16_t GetMessageCount() const { return m_msgCnt; }
+
+    /**
+     * Advances to the next message.
+     *
+     * @param[out] message  Set to the message bytes, starting at its size field.
+     *                      For a KeepAlive, which has no size field, the heartbeat bytes.
+     * @return  False when all messages have been read or the next one is malformed.
+     */
+    bool Next(ByteSpan& message);
+
+    /**
+     * Advances to the next message and parses it as a Notification or Notification2,
+     * depending on the PDU's message type.
+     *
+     * @return  False when all messages have been read, or if the PDU does not carry
+     *          notifications or the next one is malformed.
+     */
+    bool Next(Ocp1NotificationView& view);
+
+    /**
+     * Advances to the next message and parses it as a Response.
+     *
+     * @return  False when all messages have been read, or if the PDU does not carry
+     *          Responses or the next one is malformed.
+     */
+    bool Next(Ocp1ResponseView& view);
+
+    /**
+     * Advances to the next message and parses it as a Command or CommandResponseRequired.
+     *
+     * @return  False when all messages have been read, or if the PDU does not carry
+     *          commands or the next one is malformed.
+     */
+    bool Next(Ocp1CommandView& view);
+
+    /**
+     * Advances to the next message and parses it as a KeepAlive.
+     *
+     * @return  False when the message has been read, or if the PDU is not a valid KeepAlive.
+     */
+    bool Next(Ocp1KeepAliveView& view);
+
+    /**
+     * Advances to the next message and parses it as whatever type the PDU carries.
+     *
+     * @return  False when all messages have been read or the next one is malformed.
+     */
+    bool Next(Ocp1MessageView& view);
+
+private:
+    ByteSpan                    m_frame;    // The PDU being read.
+    Ocp1Message::MessageType    m_msgType;  // Type of all messages in the PDU.
+    std::uint16_t               m_msgCnt;   // Number of messages the header announces.
+    std::uint16_t               m_msgRead;  // Number of messages returned so far.
+    std::size_t                 m_offset;   // Offset of the next message in m_frame.
+    bool                        m_valid;    // False once the header or a message was found malformed.
+};
+
+
+/**
+ * Calls visitor with the view of every message in a received PDU, parsed in place.
+ * The visitor must accept each view type — Ocp1CommandView, Ocp1NotificationView,
+ * Ocp1ResponseView and Ocp1KeepAliveView — like a std::visit() visitor; a set of
+ * lambdas can be combined with Ocp1Overloaded:
+ * ```cpp
+ * VisitOcp1Messages(frame, Ocp1Overloaded{
+ *     [&](const Ocp1NotificationView& notif) { onValue(notif.emitterOno, notif.parameterData); },
+ *     [&](const Ocp1ResponseView& resp) { onResponse(resp.handle, resp.status); },
+ *     [](const auto&) {} });
+ * ```
+ * No message is copied and nothing is allocated.
+ *
+ * @param[in] frame     Complete received PDU, sync byte included.
+ * @param[in] visitor   Callable invoked once per message, in PDU order.
+ * @return  False if the PDU or one of its messages is malformed.  Messages
+ *          before the malformed one have been visited.
+ */
+template <typename Visitor>
+bool VisitOcp1Messages(ByteSpan frame, Visitor&& visitor)
+{
+    Ocp1PduReader pdu(frame);
+    switch (pdu.GetMessageType())
+    {
+        case Ocp1Message::Command:
+        case Ocp1Message::CommandResponseRequired:
+            {
+                Ocp1CommandView view;
+                while (pdu.Next(view))
+                    visitor(static_cast<const Ocp1CommandView&>(view));
+                break;
+            }
+        case Ocp1Message::Notification:
+        case Ocp1Message::Notification2:
+            {
+                Ocp1NotificationView view;
+                while (pdu.Next(view))
+                    visitor(static_cast<const Ocp1NotificationView&>(view));
+                break;
+            }
+        case Ocp1Message::Response:
+            {
+                Ocp1ResponseView view;
+                while (pdu.Next(view))
+                    visitor(static_cast<const Ocp1ResponseView&>(view));
+                break;
+            }
+        case Ocp1Message::KeepAlive:
+            {
+                Ocp1KeepAliveView view;
+                while (pdu.Next(view))
+                    visitor(static_cast<const Ocp1KeepAliveView&>(view));
+                break;
+            }
+        default:
+            break;
+    }
+
+    return pdu.IsValid();
+}
+
+/**
+ * Combines several lambdas into one visitor for VisitOcp1Messages() or std::visit().
+ */
+template <typename... Fns>
+struct Ocp1Overloaded : Fns...
+{
+    using Fns::operator()...;
 };
 
+template <typename... Fns>
+Ocp1Overloaded(Fns...) -> Ocp1Overloaded<Fns...>;
+
 }
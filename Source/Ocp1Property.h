@@ -0,0 +1,589 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Ocp1DataTypes.h"
+#include "Ocp1Message.h"
+
+
+namespace NanoOcp1
+{
+
+
+/**
+ * @brief 3D position as sent by DS100 position objects (3 × float32 blob).
+ */
+struct Position3
+{
+    std::float_t x{ 0.0f };
+    std::float_t y{ 0.0f };
+    std::float_t z{ 0.0f };
+};
+
+/**
+ * @brief Loudspeaker 6-DOF position as sent by DS100 speaker position objects
+ *        (6 × float32 blob, angles first).
+ */
+struct AimingAndPosition
+{
+    std::float_t hor{ 0.0f };
+    std::float_t vert{ 0.0f };
+    std::float_t rot{ 0.0f };
+    std::float_t x{ 0.0f };
+    std::float_t y{ 0.0f };
+    std::float_t z{ 0.0f };
+};
+
+/**
+ * @brief Bit string (OcaBitstring), e.g. one flag per channel, with one byte per bit.
+ */
+struct BitString
+{
+    std::vector<std::uint8_t> bits; ///< 0 or 1 per bit, in wire order.
+
+    bool operator==(const BitString& other) const { return bits == other.bits; }
+    bool operator!=(const BitString& other) const { return bits != other.bits; }
+};
+
+
+/**
+ * @brief Compile-time OCP.1 encoding of the C++ type T.
+ *
+ * Each specialization provides:
+ * - `DataType` — the `Ocp1DataType` a property of this type is declared with.
+ * - `Decode(ByteSpan, T&)` — reads the value from the start of received parameter
+ *   data; false if the data is too short.  Trailing bytes are ignored, as a
+ *   GetValue response may carry the property's limits behind its value.
+ * - `Size(const T&)` and `Encode(const T&, ByteAppender&)` — the marshaled value.
+ *
+ * Specializations exist for bool, the fixed-width integers, float, double,
+ * std::string, std::string_view (decoded as a view into the received data),
+ * Position3, AimingAndPosition and BitString, and for the containers
+ * std::vector<T> (OcaList), std::map<K, V> (OcaMap) and
+ * std::array<std::uint8_t, N> (OcaBlobFixedLen) of any of them.  Other types
+ * can be added by specializing this template.
+ */
+template <typename T>
+struct Ocp1ValueCodec;
+
+/**
+ * @brief Shared implementation for types marshaled as sizeof(T) big-endian bytes.
+ */
+template <typename T>
+struct Ocp1ArithmeticCodec
+{
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported value size.");
+
+    using Bits = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                 std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                 std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    static bool Decode(ByteSpan data, T& value) noexcept
+    {
+        if (data.size() < sizeof(T))
+            return false;
+        value = Read(data.data());
+        return true;
+    }
+
+    static constexpr std::size_t Size(const T&) noexcept { return sizeof(T); }
+
+    static void Encode(const T& value, ByteAppender& out) noexcept
+    {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        std::uint8_t bytes[sizeof(T)];
+        for (std::size_t i = sizeof(T); i-- > 0; bits = static_cast<Bits>(bits >> 8))
+            bytes[i] = static_cast<std::uint8_t>(bits);
+        out.appendBytes(bytes, sizeof(T));
+    }
+
+    /** Reads sizeof(T) bytes, most significant first; compiles to a load and a byte swap. */
+    static T Read(const std::uint8_t* data) noexcept
+    {
+        Bits bits{ 0 };
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            bits = static_cast<Bits>((bits << 8) | data[i]);
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+template <> struct Ocp1ValueCodec<std::int8_t>   : Ocp1ArithmeticCodec<std::int8_t>   { static constexpr Ocp1DataType DataType = OCP1DATATYPE_INT8; };
+template <> struct Ocp1ValueCodec<std::int16_t>  : Ocp1ArithmeticCodec<std::int16_t>  { static constexpr Ocp1DataType DataType = OCP1DATATYPE_INT16; };
+template <> struct Ocp1ValueCodec<std::int32_t>  : Ocp1ArithmeticCodec<std::int32_t>  { static constexpr Ocp1DataType DataType = OCP1DATATYPE_INT32; };
+template <> struct Ocp1ValueCodec<std::int64_t>  : Ocp1ArithmeticCodec<std::int64_t>  { static constexpr Ocp1DataType DataType = OCP1DATATYPE_INT64; };
+template <> struct Ocp1ValueCodec<std::uint8_t>  : Ocp1ArithmeticCodec<std::uint8_t>  { static constexpr Ocp1DataType DataType = OCP1DATATYPE_UINT8; };
+template <> struct Ocp1ValueCodec<std::uint16_t> : Ocp1ArithmeticCodec<std::uint16_t> { static constexpr Ocp1DataType DataType = OCP1DATATYPE_UINT16; };
+template <> struct Ocp1ValueCodec<std::uint32_t> : Ocp1ArithmeticCodec<std::uint32_t> { static constexpr Ocp1DataType DataType = OCP1DATATYPE_UINT32; };
+template <> struct Ocp1ValueCodec<std::uint64_t> : Ocp1ArithmeticCodec<std::uint64_t> { static constexpr Ocp1DataType DataType = OCP1DATATYPE_UINT64; };
+template <> struct Ocp1ValueCodec<float>         : Ocp1ArithmeticCodec<float>         { static constexpr Ocp1DataType DataType = OCP1DATATYPE_FLOAT32; };
+template <> struct Ocp1ValueCodec<double>        : Ocp1ArithmeticCodec<double>        { static constexpr Ocp1DataType DataType = OCP1DATATYPE_FLOAT64; };
+
+template <>
+struct Ocp1ValueCodec<bool>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_BOOLEAN;
+
+    static bool Decode(ByteSpan data, bool& value) noexcept
+    {
+        if (data.empty())
+            return false;
+        value = (data[0] != 0);
+        return true;
+    }
+
+    static constexpr std::size_t Size(const bool&) noexcept { return 1; }
+
+    static void Encode(const bool& value, ByteAppender& out) noexcept { out.appendUint8(value ? 1 : 0); }
+};
+
+/**
+ * OCA string: 2-byte length followed by the UTF-8 bytes.  The decoded view points
+ * into the received data and is only valid for as long as that is.
+ */
+template <>
+struct Ocp1ValueCodec<std::string_view>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_STRING;
+
+    static bool Decode(ByteSpan data, std::string_view& value) noexcept
+    {
+        if (data.size() < 2)
+            return false;
+        const std::size_t length = ReadUint16(data.data());
+        if (data.size() - 2 < length)
+            return false;
+        value = std::string_view(reinterpret_cast<const char*>(data.data() + 2), length);
+        return true;
+    }
+
+    /** Strings longer than the 16-bit length field allows are truncated. */
+    static std::size_t Size(const std::string_view& value) noexcept { return 2 + std::min<std::size_t>(value.size(), 0xffff); }
+
+    static void Encode(const std::string_view& value, ByteAppender& out) noexcept
+    {
+        const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(value.size(), 0xffff));
+        out.appendUint16(length);
+        out.appendBytes(reinterpret_cast<const std::uint8_t*>(value.data()), length);
+    }
+};
+
+template <>
+struct Ocp1ValueCodec<std::string>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_STRING;
+
+    static bool Decode(ByteSpan data, std::string& value)
+    {
+        std::string_view view;
+        if (!Ocp1ValueCodec<std::string_view>::Decode(data, view))
+            return false;
+        value.assign(view.data(), view.size());
+        return true;
+    }
+
+    static std::size_t Size(const std::string& value) noexcept { return Ocp1ValueCodec<std::string_view>::Size(value); }
+
+    static void Encode(const std::string& value, ByteAppender& out) noexcept { Ocp1ValueCodec<std::string_view>::Encode(value, out); }
+};
+
+template <>
+struct Ocp1ValueCodec<Position3>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_DB_POSITION;
+
+    static bool Decode(ByteSpan data, Position3& value) noexcept
+    {
+        if (data.size() < 12)
+            return false;
+        value.x = Ocp1ArithmeticCodec<float>::Read(data.data());
+        value.y = Ocp1ArithmeticCodec<float>::Read(data.data() + 4);
+        value.z = Ocp1ArithmeticCodec<float>::Read(data.data() + 8);
+        return true;
+    }
+
+    static constexpr std::size_t Size(const Position3&) noexcept { return 12; }
+
+    static void Encode(const Position3& value, ByteAppender& out) noexcept
+    {
+        for (const auto coordinate : { value.x, value.y, value.z })
+            Ocp1ArithmeticCodec<float>::Encode(coordinate, out);
+    }
+};
+
+template <>
+struct Ocp1ValueCodec<AimingAndPosition>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_DB_POSITION;
+
+    static bool Decode(ByteSpan data, AimingAndPosition& value) noexcept
+    {
+        if (data.size() < 24)
+            return false;
+        value.hor  = Ocp1ArithmeticCodec<float>::Read(data.data());
+        value.vert = Ocp1ArithmeticCodec<float>::Read(data.data() + 4);
+        value.rot  = Ocp1ArithmeticCodec<float>::Read(data.data() + 8);
+        value.x    = Ocp1ArithmeticCodec<float>::Read(data.data() + 12);
+        value.y    = Ocp1ArithmeticCodec<float>::Read(data.data() + 16);
+        value.z    = Ocp1ArithmeticCodec<float>::Read(data.data() + 20);
+        return true;
+    }
+
+    static constexpr std::size_t Size(const AimingAndPosition&) noexcept { return 24; }
+
+    static void Encode(const AimingAndPosition& value, ByteAppender& out) noexcept
+    {
+        for (const auto coordinate : { value.hor, value.vert, value.rot, value.x, value.y, value.z })
+            Ocp1ArithmeticCodec<float>::Encode(coordinate, out);
+    }
+};
+
+
+template <>
+struct Ocp1ValueCodec<BitString>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_BIT_STRING;
+
+    /** Unpacks the bits with UnpackBits(), 16 or 32 per instruction. */
+    static bool Decode(ByteSpan data, BitString& value)
+    {
+        if (data.size() < 2)
+            return false;
+        const std::size_t count = ReadUint16(data.data());
+        if (data.size() - 2 < (count + 7) / 8)
+            return false;
+        value.bits.resize(count);
+        UnpackBits(data.data() + 2, value.bits.data(), count);
+        return true;
+    }
+
+    /** Bit strings longer than the 16-bit count allows are truncated. */
+    static std::size_t Size(const BitString& value) noexcept { return 2 + (GetCount(value) + 7) / 8; }
+
+    static void Encode(const BitString& value, ByteAppender& out) noexcept
+    {
+        const auto count = GetCount(value);
+        out.appendUint16(static_cast<std::uint16_t>(count));
+        if (auto* packed = out.appendSpace((count + 7) / 8))
+            PackBits(value.bits.data(), packed, count);
+    }
+
+private:
+    static std::size_t GetCount(const BitString& value) noexcept { return std::min<std::size_t>(value.bits.size(), 0xffff); }
+};
+
+/**
+ * OcaList<T>: 2-byte element count followed by the elements.  Lists of 1-byte
+ * integers, float, int32, uint32 and uint16 are decoded with the batch codecs
+ * straight into the vector's storage, other element types one by one.  Like the
+ * other composite types, lists are declared as OCP1DATATYPE_BLOB;
+ * std::vector<std::uint8_t> also matches the layout of an OcaBlob.
+ */
+template <typename T>
+struct Ocp1ValueCodec<std::vector<T>>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_BLOB;
+
+    static bool Decode(ByteSpan data, std::vector<T>& value)
+    {
+        if (data.size() < 2)
+            return false;
+        const std::size_t count = ReadUint16(data.data());
+        auto elements = data.subspan(2);
+
+        if constexpr (IsByte)
+        {
+            if (elements.size() < count)
+                return false;
+            value.assign(elements.begin(), elements.begin() + count);
+        }
+        else if constexpr (IsBatch)
+        {
+            if (elements.size() / sizeof(T) < count)
+                return false;
+            value.resize(count);
+            ReadArray(elements, value.data(), count);
+        }
+        else
+        {
+            value.clear();
+            value.reserve(std::min(count, elements.size())); // Every element takes at least a byte.
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                T element{};
+                if (!Ocp1ValueCodec<T>::Decode(elements, element))
+                    return false;
+                elements = elements.subspan(Ocp1ValueCodec<T>::Size(element));
+                value.push_back(std::move(element));
+            }
+        }
+        return true;
+    }
+
+    /** Lists longer than the 16-bit count allows are truncated. */
+    static std::size_t Size(const std::vector<T>& value) noexcept
+    {
+        const auto count = GetCount(value);
+        if constexpr (IsByte || IsBatch)
+            return 2 + count * sizeof(T);
+
+        std::size_t size = 2;
+        for (std::size_t i = 0; i < count; ++i)
+            size += Ocp1ValueCodec<T>::Size(value[i]);
+        return size;
+    }
+
+    static void Encode(const std::vector<T>& value, ByteAppender& out) noexcept
+    {
+        const auto count = GetCount(value);
+        out.appendUint16(static_cast<std::uint16_t>(count));
+
+        if constexpr (IsByte)
+        {
+            out.appendBytes(reinterpret_cast<const std::uint8_t*>(value.data()), count);
+        }
+        else if constexpr (IsBatch)
+        {
+            if (auto* space = out.appendSpace(count * sizeof(T)))
+                WriteArray(space, value.data(), count);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                Ocp1ValueCodec<T>::Encode(value[i], out);
+        }
+    }
+
+private:
+    static constexpr bool IsByte  = sizeof(T) == 1 && std::is_integral_v<T> && !std::is_same_v<T, bool>;
+    static constexpr bool IsBatch = std::is_same_v<T, float> || std::is_same_v<T, std::int32_t> ||
+                                    std::is_same_v<T, std::uint32_t> || std::is_same_v<T, std::uint16_t>;
+
+    static std::size_t GetCount(const std::vector<T>& value) noexcept { return std::min<std::size_t>(value.size(), 0xffff); }
+
+    static void ReadArray(ByteSpan data, float* values, std::size_t count) noexcept { ReadFloat32Array(data, values, count); }
+    static void ReadArray(ByteSpan data, std::int32_t* values, std::size_t count) noexcept { ReadInt32Array(data, values, count); }
+    static void ReadArray(ByteSpan data, std::uint32_t* values, std::size_t count) noexcept { ReadUint32Array(data, values, count); }
+    static void ReadArray(ByteSpan data, std::uint16_t* values, std::size_t count) noexcept { ReadUint16Array(data, values, count); }
+
+    static void WriteArray(std::uint8_t* buffer, const float* values, std::size_t count) noexcept { WriteFloat32Array(buffer, values, count); }
+    static void WriteArray(std::uint8_t* buffer, const std::int32_t* values, std::size_t count) noexcept { WriteInt32Array(buffer, values, count); }
+    static void WriteArray(std::uint8_t* buffer, const std::uint32_t* values, std::size_t count) noexcept { WriteUint32Array(buffer, values, count); }
+    static void WriteArray(std::uint8_t* buffer, const std::uint16_t* values, std::size_t count) noexcept { WriteUint16Array(buffer, values, count); }
+};
+
+/**
+ * OcaMap<K, V>: 2-byte entry count followed by the key and value of each entry.
+ * Declared as OCP1DATATYPE_BLOB, like lists.  A repeated key keeps its first value.
+ */
+template <typename K, typename V>
+struct Ocp1ValueCodec<std::map<K, V>>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_BLOB;
+
+    static bool Decode(ByteSpan data, std::map<K, V>& value)
+    {
+        if (data.size() < 2)
+            return false;
+        const std::size_t count = ReadUint16(data.data());
+        auto entries = data.subspan(2);
+
+        value.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            K key{};
+            V mapped{};
+            if (!Ocp1ValueCodec<K>::Decode(entries, key))
+                return false;
+            entries = entries.subspan(Ocp1ValueCodec<K>::Size(key));
+            if (!Ocp1ValueCodec<V>::Decode(entries, mapped))
+                return false;
+            entries = entries.subspan(Ocp1ValueCodec<V>::Size(mapped));
+            value.emplace(std::move(key), std::move(mapped));
+        }
+        return true;
+    }
+
+    /** Maps with more entries than the 16-bit count allows are truncated. */
+    static std::size_t Size(const std::map<K, V>& value) noexcept
+    {
+        std::size_t size = 2, count = 0;
+        for (auto it = value.begin(); it != value.end() && count < 0xffff; ++it, ++count)
+            size += Ocp1ValueCodec<K>::Size(it->first) + Ocp1ValueCodec<V>::Size(it->second);
+        return size;
+    }
+
+    static void Encode(const std::map<K, V>& value, ByteAppender& out) noexcept
+    {
+        const auto count = std::min<std::size_t>(value.size(), 0xffff);
+        out.appendUint16(static_cast<std::uint16_t>(count));
+        auto it = value.begin();
+        for (std::size_t i = 0; i < count; ++i, ++it)
+        {
+            Ocp1ValueCodec<K>::Encode(it->first, out);
+            Ocp1ValueCodec<V>::Encode(it->second, out);
+        }
+    }
+};
+
+/**
+ * OcaBlobFixedLen<N>: N bytes without a length field.
+ */
+template <std::size_t N>
+struct Ocp1ValueCodec<std::array<std::uint8_t, N>>
+{
+    static constexpr Ocp1DataType DataType = OCP1DATATYPE_BLOB_FIXED_LEN;
+
+    static bool Decode(ByteSpan data, std::array<std::uint8_t, N>& value) noexcept
+    {
+        if (data.size() < N)
+            return false;
+        std::copy(data.begin(), data.begin() + N, value.begin());
+        return true;
+    }
+
+    static constexpr std::size_t Size(const std::array<std::uint8_t, N>&) noexcept { return N; }
+
+    static void Encode(const std::array<std::uint8_t, N>& value, ByteAppender& out) noexcept { out.appendBytes(value.data(), N); }
+};
+
+
+/**
+ * @class Ocp1Property
+ * @brief Object definition whose value type is known at compile time.
+ *
+ * An `Ocp1CommandDefinition` like any other — it can be tracked, subscribed and
+ * queried the usual way — but its value is decoded straight into a T with
+ * `Ocp1ValueCodec<T>`, without the run-time type switch and the copies of a
+ * `Variant`.  `Ocp1Controller::trackObject()` and `setValue()` have overloads
+ * taking one.
+ * ```cpp
+ * Ocp1Property<float> gain(DS100::dbOcaObjectDef_MatrixInput_Gain(5));
+ * controller.trackObject(gain, [](const float& dB) { ... });
+ * controller.setValue(gain, -6.0f);
+ *
+ * Ocp1Property<Position3> position(DS100::dbOcaObjectDef_Positioning_Source_Position(5));
+ * controller.setValue(position, { 0.5f, 0.5f, 0.0f });
+ * ```
+ * T must have an `Ocp1ValueCodec` specialization.
+ */
+template <typename T>
+class Ocp1Property : public Ocp1CommandDefinition
+{
+public:
+    using ValueType = T;
+    using Codec     = Ocp1ValueCodec<T>;
+
+    /** Callback type of the typed `Ocp1Controller::trackObject()` overload. */
+    using Callback  = std::function<void(const T&)>;
+
+    /**
+     * Constructs a property of the given object, declared with `Codec::DataType`.
+     */
+    Ocp1Property(std::uint32_t targetOno, std::uint16_t propertyDefLevel, std::uint16_t propertyIndex)
+        : Ocp1CommandDefinition(targetOno, Codec::DataType, propertyDefLevel, propertyIndex)
+    {
+    }
+
+    /**
+     * Adopts an existing object definition, e.g. one from Ocp1DS100ObjectDefinitions.h.
+     * Its command factory methods are those of Ocp1CommandDefinition; definitions
+     * that override them must not be adopted.  The definition's data type must be
+     * `Codec::DataType`, see `IsCompatible()`; this is asserted.
+     */
+    explicit Ocp1Property(const Ocp1CommandDefinition& def)
+        : Ocp1CommandDefinition(def)
+    {
+        assert(IsCompatible(def) && "Ocp1Property value type does not match the definition's data type");
+    }
+
+    /**
+     * Returns true if T is the value type of the object definition, i.e. its data
+     * type is `Codec::DataType`.  Otherwise values would be decoded from, or sent
+     * as, the wrong wire type.
+     */
+    static constexpr bool IsCompatible(Ocp1DataType type) noexcept { return type == Codec::DataType; }
+    static bool IsCompatible(const Ocp1CommandDefinition& def) noexcept { return IsCompatible(def.GetDataType()); }
+
+    ~Ocp1Property() override = default;
+
+    /** Decodes received parameter data; false if it is too short for a T. */
+    static bool Decode(ByteSpan parameterData, T& value) { return Codec::Decode(parameterData, value); }
+
+    /** Returns the marshaled size of value. */
+    static std::size_t GetEncodedSize(const T& value) { return Codec::Size(value); }
+
+    /**
+     * Marshals value into a caller-owned buffer.
+     * @return  Number of bytes written, or 0 if capacity is too small.
+     */
+    static std::size_t Encode(const T& value, std::uint8_t* dst, std::size_t capacity)
+    {
+        ByteAppender out(dst, capacity);
+        Codec::Encode(value, out);
+        return out.overflowed() ? 0 : out.size();
+    }
+
+    /** Returns value marshaled into a new ByteVector. */
+    static ByteVector Encode(const T& value)
+    {
+        ByteVector data(Codec::Size(value));
+        Encode(value, data.data(), data.size());
+        return data;
+    }
+
+    using Ocp1CommandDefinition::SetValueCommand;
+
+    /**
+     * Generates a SetValue command definition for a typed value.
+     */
+    Ocp1CommandDefinition SetValueCommand(const T& value) const
+    {
+        return Ocp1CommandDefinition(m_targetOno, m_propertyType, m_propertyDefLevel,
+                                     2,                     // Set method is usually MethodIdx 2
+                                     1,                     // Set method usually takes one parameter
+                                     Encode(value));
+    }
+
+    Ocp1Property* Clone() const override
+    {
+        return new Ocp1Property(*this);
+    }
+};
+
+
+} // namespace NanoOcp1
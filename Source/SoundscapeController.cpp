@@ -219,7 +219,7 @@ bool SoundscapeController::setOcaRevisionAndDeviceModel(const std::string& guid)
  * Rebuild the base-class tracked-object list from m_activeRemoteObjects.
  *
  * For each active object whose ROI+addr is present in m_ROIsToDefsMap, registers
- * a ValueCallback that decodes the raw OCA parameter bytes into a typed Variant
+ * a ValueViewCallback that wraps the raw OCA parameter bytes in a lazy Variant
  * and delivers a populated RemoteObject to onRemoteObjectReceived.
  *
  * ROIs that have no OCA counterpart (X/Y/XY split views, Scene_Prev/Next/Recall)
@@ -247,9 +247,11 @@ void SoundscapeController::rebuildTrackedObjects()
 
         auto defCopy = std::unique_ptr<Ocp1CommandDefinition>(defIt->second.Clone());
 
-        trackObject(std::move(defCopy), [this, roi, addr, dt](const ByteVector& data) {
-            Variant val(data, dt);
-            RemoteObject ro(roi, addr, std::move(val));
+        // The value is decoded only when the receiver reads it.  Payloads of
+        // all DS100 value types fit inline (of a position response, only the
+        // current value is kept), so delivery does not allocate.
+        trackObjectView(std::move(defCopy), [this, roi, addr, dt](ByteSpan data) {
+            RemoteObject ro(roi, addr, Variant::Lazy(data, dt));
             if (onRemoteObjectReceived)
                 onRemoteObjectReceived(ro);
         });
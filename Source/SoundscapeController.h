@@ -135,6 +135,8 @@ public:
      *
      * Callers receive populated RemoteObjects via `onRemoteObjectReceived`, and
      * send them (with the desired value in `Var`) via `setObjectValue()`.
+     * All DS100 value types, i.e. scalars, positions and names of up to
+     * `Variant::InlineString::InlineCapacity` bytes, are held without heap memory.
      */
     struct RemoteObject
     {
@@ -295,7 +297,9 @@ public:
      * queried object delivers a new value.  Return true if the object was
      * handled; false is ignored.
      *
-     * The `RemoteObject::Var` field contains the decoded value.
+     * The `RemoteObject::Var` field contains the value as a lazy `Variant`: it
+     * is decoded when read, so objects the receiver drops cost no decoding, and
+     * comparing it with a previously received value compares the raw bytes.
      */
     std::function<bool(const RemoteObject&)> onRemoteObjectReceived;
 
@@ -17,119 +17,293 @@
  */
 
 #include "Variant.h"
+#include "Ocp1Property.h"
 #include <assert.h>
+#include <cstring>
 #include <sstream>
 
 
 namespace NanoOcp1
 {
 
+Variant::InlineString::InlineString(std::string_view str)
+{
+    assign(nullptr, 0, str);
+}
+
+Variant::InlineString::InlineString(char prefix, std::string_view str)
+{
+    assign(&prefix, 1, str);
+}
+
+void Variant::InlineString::assign(const char* prefix, std::size_t prefixSize, std::string_view str)
+{
+    const std::size_t size = prefixSize + str.size();
+    auto* target = reinterpret_cast<char*>(m_bytes);
+    if (size <= InlineCapacity)
+    {
+        m_bytes[TagPos] = static_cast<std::uint8_t>(size);
+    }
+    else
+    {
+        target = new char[size];
+        std::memcpy(m_bytes, &target, sizeof(target));
+        std::memcpy(m_bytes + sizeof(target), &size, sizeof(size));
+        m_bytes[TagPos] = HeapTag;
+    }
+
+    if (prefixSize > 0)
+        std::memcpy(target, prefix, prefixSize);
+    std::memcpy(target + prefixSize, str.data(), str.size());
+}
+
+Variant::InlineString::InlineString(const InlineString& other)
+    : InlineString(other.view())
+{
+}
+
+Variant::InlineString::InlineString(InlineString&& other) noexcept
+{
+    // Takes over the heap buffer, if any, along with the bytes.
+    std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+    other.m_bytes[TagPos] = 0;
+}
+
+Variant::InlineString& Variant::InlineString::operator=(const InlineString& other)
+{
+    if (this != &other)
+        *this = InlineString(other.view());
+    return *this;
+}
+
+Variant::InlineString& Variant::InlineString::operator=(InlineString&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::memcpy(m_bytes, other.m_bytes, sizeof(m_bytes));
+        other.m_bytes[TagPos] = 0;
+    }
+    return *this;
+}
+
+Variant::InlineString::~InlineString()
+{
+    release();
+}
+
+std::string_view Variant::InlineString::view() const noexcept
+{
+    if (isInline())
+        return std::string_view(reinterpret_cast<const char*>(m_bytes), m_bytes[TagPos]);
+
+    const char* heap{ nullptr };
+    std::size_t size{ 0 };
+    std::memcpy(&heap, m_bytes, sizeof(heap));
+    std::memcpy(&size, m_bytes + sizeof(heap), sizeof(size));
+    return std::string_view(heap, size);
+}
+
+void Variant::InlineString::release() noexcept
+{
+    if (isInline())
+        return;
+
+    char* heap{ nullptr };
+    std::memcpy(&heap, m_bytes, sizeof(heap));
+    delete[] heap;
+    m_bytes[TagPos] = 0;
+}
+
+
+Variant::EncodedValue::EncodedValue(ByteSpan data, Ocp1DataType type)
+    : m_bytes(static_cast<char>(type), std::string_view(reinterpret_cast<const char*>(data.data()), data.size()))
+{
+}
+
+Ocp1DataType Variant::EncodedValue::GetType() const noexcept
+{
+    return static_cast<Ocp1DataType>(static_cast<std::uint8_t>(m_bytes.view().front()));
+}
+
+ByteSpan Variant::EncodedValue::GetData() const noexcept
+{
+    const auto bytes = m_bytes.view().substr(1);
+    return ByteSpan(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size());
+}
+
 Variant::Variant(bool v) { m_value = v; }
+Variant::Variant(std::int8_t v) { m_value = v; }
+Variant::Variant(std::int16_t v) { m_value = v; }
 Variant::Variant(std::int32_t v) { m_value = v; }
+Variant::Variant(std::int64_t v) { m_value = v; }
 Variant::Variant(std::uint8_t v) { m_value = v; }
 Variant::Variant(std::uint16_t v) { m_value = v; }
 Variant::Variant(std::uint32_t v) { m_value = v; }
 Variant::Variant(std::uint64_t v) { m_value = v; }
 Variant::Variant(std::float_t v) { m_value = v; }
 Variant::Variant(std::double_t v) { m_value = v; }
-Variant::Variant(const std::string& v) { m_value = v; }
-Variant::Variant(const char* v) : Variant(std::string(v)) { } // Allow Variant("test") to become of TypeString.
+Variant::Variant(const std::string& v) { m_value.emplace<TypeString>(v); }
+Variant::Variant(const char* v) { m_value.emplace<TypeString>(v); } // Allow Variant("test") to become of TypeString.
+Variant::Variant(const std::array<std::float_t, 3>& position) { m_value = position; }
+Variant::Variant(const std::array<std::float_t, 6>& aimingAndPosition) { m_value = aimingAndPosition; }
 
 Variant::Variant(std::float_t x, std::float_t y, std::float_t z)
 {
-    assert(sizeof(std::uint32_t) == sizeof(std::float_t)); // Required for pointer cast to work below
-    std::uint32_t xInt = *(std::uint32_t*)&x;
-    std::uint32_t yInt = *(std::uint32_t*)&y;
-    std::uint32_t zInt = *(std::uint32_t*)&z;
-
-    m_value = ByteVector
-        ({
-            static_cast<std::uint8_t>(xInt >> 24),
-            static_cast<std::uint8_t>(xInt >> 16),
-            static_cast<std::uint8_t>(xInt >> 8),
-            static_cast<std::uint8_t>(xInt),
-            static_cast<std::uint8_t>(yInt >> 24),
-            static_cast<std::uint8_t>(yInt >> 16),
-            static_cast<std::uint8_t>(yInt >> 8),
-            static_cast<std::uint8_t>(yInt),
-            static_cast<std::uint8_t>(zInt >> 24),
-            static_cast<std::uint8_t>(zInt >> 16),
-            static_cast<std::uint8_t>(zInt >> 8),
-            static_cast<std::uint8_t>(zInt),
-        });
+    m_value = std::array<std::float_t, 3>{ x, y, z };
 }
 
 Variant::Variant(const ByteVector& data, Ocp1DataType type)
+    : Variant(ByteSpan(data), type)
+{
+}
+
+Variant::Variant(ByteSpan data, Ocp1DataType type)
+{
+    [[maybe_unused]] const bool ok = DecodeInto(data, type, m_value);
+    assert(ok); // Conversion not possible or not yet implemented!
+}
+
+Variant Variant::Lazy(ByteSpan data, Ocp1DataType type)
+{
+    // Like DecodeInto(), keep only the current value of a position GetValue
+    // response (current, min and max), so it fits inline.
+    if (type == OCP1DATATYPE_DB_POSITION && data.size() == 36)
+        data = data.subspan(0, 12);
+
+    Variant lazy;
+    if (data.size() + 1 > InlineString::InlineCapacity) // + 1 for the type byte.
+    {
+        // Would be copied to the heap anyway: decode right away instead.
+        if (!DecodeInto(data, type, lazy.m_value))
+            lazy.m_value = std::monostate{};
+    }
+    else
+    {
+        lazy.m_value.emplace<TypeEncoded>(data, type);
+    }
+    return lazy;
+}
+
+bool Variant::DecodeInto(ByteSpan data, Ocp1DataType type, VariantType& value)
 {
     bool ok(false);
     switch (type)
     {
         case OCP1DATATYPE_BOOLEAN:
-            m_value = NanoOcp1::DataToBool(data, &ok);
+            value = NanoOcp1::DataToBool(data, &ok);
+            break;
+        case OCP1DATATYPE_INT8:
+            value = NanoOcp1::DataToInt8(data, &ok);
+            break;
+        case OCP1DATATYPE_INT16:
+            value = NanoOcp1::DataToInt16(data, &ok);
             break;
         case OCP1DATATYPE_INT32:
-            m_value = NanoOcp1::DataToInt32(data, &ok);
+            value = NanoOcp1::DataToInt32(data, &ok);
+            break;
+        case OCP1DATATYPE_INT64:
+            value = NanoOcp1::DataToInt64(data, &ok);
             break;
         case OCP1DATATYPE_UINT8:
-            m_value = NanoOcp1::DataToUint8(data, &ok);
+            value = NanoOcp1::DataToUint8(data, &ok);
             break;
         case OCP1DATATYPE_UINT16:
-            m_value = NanoOcp1::DataToUint16(data, &ok);
+            value = NanoOcp1::DataToUint16(data, &ok);
             break;
         case OCP1DATATYPE_UINT32:
-            m_value = NanoOcp1::DataToUint32(data, &ok);
+            value = NanoOcp1::DataToUint32(data, &ok);
             break;
         case OCP1DATATYPE_UINT64:
-            m_value = NanoOcp1::DataToUint64(data, &ok);
+            value = NanoOcp1::DataToUint64(data, &ok);
             break;
         case OCP1DATATYPE_FLOAT32:
-            m_value = NanoOcp1::DataToFloat(data, &ok);
+            value = NanoOcp1::DataToFloat(data, &ok);
             break;
         case OCP1DATATYPE_FLOAT64:
-            m_value = NanoOcp1::DataToDouble(data, &ok);
+            value = NanoOcp1::DataToDouble(data, &ok);
             break;
         case OCP1DATATYPE_STRING:
-            m_value = NanoOcp1::DataToString(data, &ok);
+            ok = (data.size() >= 2); // Same as DataToString: everything after the 2 length bytes.
+            if (ok)
+                value.emplace<TypeString>(std::string_view(reinterpret_cast<const char*>(data.data()) + 2,
+                                                             data.size() - 2));
             break;
         case OCP1DATATYPE_BLOB:
             ok = (data.size() >= 2); // OcaBlob size is 2 bytes
             if (ok)
             {
                 // TODO: include 2 initial bytes?
-                m_value = data;
+                value = ByteVector(data.begin(), data.end());
             }
             break;
         case OCP1DATATYPE_DB_POSITION:
             ok = (data.size() == 12) || // Notification contains 3 floats: x, y, z.
                  (data.size() == 24) || // Notification contains 6 floats: x, y, z, hor, vert, rot.
                  (data.size() == 36);   // Response contains 9 floats: current, min, and max x, y, z.
-            if (ok)
-            {
-                m_value = data;
-            }
+            if (data.size() == 24)
+                NanoOcp1::ReadFloat32Array(data, value.emplace<TypeAimingAndPosition>().data(), 6);
+            else if (ok)
+                NanoOcp1::ReadFloat32Array(data, value.emplace<TypePosition>().data(), 3); // Current x, y, z only.
             break;
-        case OCP1DATATYPE_NONE:
-        case OCP1DATATYPE_INT8:
-        case OCP1DATATYPE_INT16:
-        case OCP1DATATYPE_INT64:
         case OCP1DATATYPE_BIT_STRING:
+            ok = IsBitString(data);
+            if (ok)
+                value = ByteVector(data.begin(), data.end()); // Kept packed, see ToBitString().
+            break;
         case OCP1DATATYPE_BLOB_FIXED_LEN:
+            ok = true; // The length is implied by the property, there is nothing to check.
+            value = ByteVector(data.begin(), data.end());
+            break;
+        case OCP1DATATYPE_NONE:
         case OCP1DATATYPE_CUSTOM:
         default:
             break;
     }
 
-    assert(ok); // Conversion not possible or not yet implemented!
+    return ok;
+}
+
+Variant Variant::Decoded() const
+{
+    if (m_value.index() != TypeEncoded)
+        return *this;
+
+    const auto& encoded = std::get<TypeEncoded>(m_value);
+    Variant decoded;
+    if (!DecodeInto(encoded.GetData(), encoded.GetType(), decoded.m_value))
+        decoded.m_value = std::monostate{};
+
+    return decoded;
+}
+
+bool Variant::Decode()
+{
+    if (m_value.index() != TypeEncoded)
+        return true;
+
+    *this = Decoded();
+    return IsValid();
+}
+
+bool Variant::IsDecoded() const
+{
+    return (m_value.index() != TypeEncoded);
 }
 
 bool Variant::operator==(const Variant& other) const
 {
+    // Lazy Variants are compared by type and raw bytes, without decoding, unless
+    // the other one is decoded already.
+    if (m_value.index() != other.m_value.index() && (!IsDecoded() || !other.IsDecoded()))
+        return Decoded().m_value == other.Decoded().m_value;
+
     return m_value == other.m_value;
 }
 
 bool Variant::operator!=(const Variant& other) const
 {
-    return m_value != other.m_value;
+    return !(*this == other);
 }
 
 bool Variant::IsValid() const
@@ -142,7 +316,10 @@ Ocp1DataType Variant::GetDataType() const
     switch (m_value.index())
     {
         case TypeBool:          return OCP1DATATYPE_BOOLEAN;
+        case TypeInt8:          return OCP1DATATYPE_INT8;
+        case TypeInt16:         return OCP1DATATYPE_INT16;
         case TypeInt32:         return OCP1DATATYPE_INT32;
+        case TypeInt64:         return OCP1DATATYPE_INT64;
         case TypeUInt8:         return OCP1DATATYPE_UINT8;
         case TypeUInt16:        return OCP1DATATYPE_UINT16;
         case TypeUInt32:        return OCP1DATATYPE_UINT32;
@@ -151,6 +328,41 @@ Ocp1DataType Variant::GetDataType() const
         case TypeDouble:        return OCP1DATATYPE_FLOAT64;
         case TypeString:        return OCP1DATATYPE_STRING;
         case TypeByteVector:    return OCP1DATATYPE_BLOB;
+        case TypePosition:      return OCP1DATATYPE_BLOB;
+        case TypeAimingAndPosition: return OCP1DATATYPE_BLOB;
+        case TypeEncoded:       return GetDecodedDataType(std::get<TypeEncoded>(m_value).GetType());
+        default:
+            break;
+    }
+
+    return OCP1DATATYPE_NONE;
+}
+
+Ocp1DataType Variant::GetDecodedDataType(Ocp1DataType type)
+{
+    // Must match the alternative DecodeInto() picks for the type.
+    switch (type)
+    {
+        case OCP1DATATYPE_BOOLEAN:
+        case OCP1DATATYPE_INT8:
+        case OCP1DATATYPE_INT16:
+        case OCP1DATATYPE_INT32:
+        case OCP1DATATYPE_INT64:
+        case OCP1DATATYPE_UINT8:
+        case OCP1DATATYPE_UINT16:
+        case OCP1DATATYPE_UINT32:
+        case OCP1DATATYPE_UINT64:
+        case OCP1DATATYPE_FLOAT32:
+        case OCP1DATATYPE_FLOAT64:
+        case OCP1DATATYPE_STRING:
+            return type;
+        case OCP1DATATYPE_BLOB:
+        case OCP1DATATYPE_DB_POSITION:
+        case OCP1DATATYPE_BIT_STRING:
+        case OCP1DATATYPE_BLOB_FIXED_LEN:
+            return OCP1DATATYPE_BLOB;
+        case OCP1DATATYPE_NONE:
+        case OCP1DATATYPE_CUSTOM:
         default:
             break;
     }
@@ -180,10 +392,18 @@ bool Variant::ToBool(bool* pOk) const
             return (std::get<std::float_t>(m_value) > std::float_t(0.0f));
         case TypeDouble:
             return (std::get<std::double_t>(m_value) > std::double_t(0.0));
+        case TypeInt8:
+            return (std::get<std::int8_t>(m_value) > std::int8_t(0));
+        case TypeInt16:
+            return (std::get<std::int16_t>(m_value) > std::int16_t(0));
+        case TypeInt64:
+            return (std::get<std::int64_t>(m_value) > std::int64_t(0));
         case TypeString:
-            return (std::get<std::string>(m_value) == "true");
+            return (std::get<InlineString>(m_value).view() == "true");
         case TypeByteVector:
             return DataToBool(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToBool(pOk);
         default:
             break;
     }
@@ -216,10 +436,16 @@ std::int32_t Variant::ToInt32(bool* pOk) const
             return static_cast<std::int32_t>(std::lround(std::get<std::float_t>(m_value)));
         case TypeDouble:
             return static_cast<std::int32_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::int32_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::int32_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::int32_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try 
             { 
-                return static_cast<std::int32_t>(std::stol(std::get<std::string>(m_value))); 
+                return static_cast<std::int32_t>(std::stol(std::string(std::get<InlineString>(m_value).view()))); 
             } 
             catch (...) 
             { 
@@ -227,6 +453,8 @@ std::int32_t Variant::ToInt32(bool* pOk) const
             }
         case TypeByteVector:
             return DataToInt32(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToInt32(pOk);
         default:
             break;
     }
@@ -259,10 +487,16 @@ std::uint8_t Variant::ToUInt8(bool* pOk) const
             return static_cast<std::uint8_t>(std::lround(std::get<std::float_t>(m_value)));
         case TypeDouble:
             return static_cast<std::uint8_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::uint8_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint8_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint8_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return static_cast<std::uint8_t>(std::stol(std::get<std::string>(m_value)));
+                return static_cast<std::uint8_t>(std::stol(std::string(std::get<InlineString>(m_value).view())));
             }
             catch (...)
             {
@@ -270,6 +504,8 @@ std::uint8_t Variant::ToUInt8(bool* pOk) const
             }
         case TypeByteVector:
             return DataToUint8(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToUInt8(pOk);
         default:
             break;
     }
@@ -302,10 +538,16 @@ std::uint16_t Variant::ToUInt16(bool* pOk) const
             return static_cast<std::uint16_t>(std::lround(std::get<std::float_t>(m_value)));
         case TypeDouble:
             return static_cast<std::uint16_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::uint16_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint16_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint16_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return static_cast<std::uint16_t>(std::stoi(std::get<std::string>(m_value)));
+                return static_cast<std::uint16_t>(std::stoi(std::string(std::get<InlineString>(m_value).view())));
             }
             catch (...)
             {
@@ -313,6 +555,8 @@ std::uint16_t Variant::ToUInt16(bool* pOk) const
             }
         case TypeByteVector:
             return DataToUint16(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToUInt16(pOk);
         default:
             break;
     }
@@ -345,10 +589,16 @@ std::uint32_t Variant::ToUInt32(bool* pOk) const
             return static_cast<std::uint32_t>(std::lround(std::get<std::float_t>(m_value)));
         case TypeDouble:
             return static_cast<std::uint32_t>(std::lround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::uint32_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint32_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint32_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return static_cast<std::uint32_t>(std::stoi(std::get<std::string>(m_value)));
+                return static_cast<std::uint32_t>(std::stoi(std::string(std::get<InlineString>(m_value).view())));
             }
             catch (...)
             {
@@ -356,6 +606,8 @@ std::uint32_t Variant::ToUInt32(bool* pOk) const
             }
         case TypeByteVector:
             return DataToUint32(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToUInt32(pOk);
         default:
             break;
     }
@@ -388,10 +640,16 @@ std::uint64_t Variant::ToUInt64(bool* pOk) const
             return static_cast<std::uint64_t>(std::llround(std::get<std::float_t>(m_value)));
         case TypeDouble:
             return static_cast<std::uint64_t>(std::llround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::uint64_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::uint64_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::uint64_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return static_cast<std::uint64_t>(std::stoll(std::get<std::string>(m_value)));
+                return static_cast<std::uint64_t>(std::stoll(std::string(std::get<InlineString>(m_value).view())));
             }
             catch (...)
             {
@@ -399,6 +657,8 @@ std::uint64_t Variant::ToUInt64(bool* pOk) const
             }
         case TypeByteVector:
             return DataToUint64(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToUInt64(pOk);
         default:
             break;
     }
@@ -409,6 +669,57 @@ std::uint64_t Variant::ToUInt64(bool* pOk) const
     return std::uint64_t(0);
 }
 
+std::int64_t Variant::ToInt64(bool* pOk) const
+{
+    if (pOk != nullptr) *pOk = true;
+
+    switch (m_value.index())
+    {
+        case TypeBool:
+            return std::get<bool>(m_value) ? std::int64_t(1) : std::int64_t(0);
+        case TypeInt32:
+            return static_cast<std::int64_t>(std::get<std::int32_t>(m_value));
+        case TypeUInt8:
+            return static_cast<std::int64_t>(std::get<std::uint8_t>(m_value));
+        case TypeUInt16:
+            return static_cast<std::int64_t>(std::get<std::uint16_t>(m_value));
+        case TypeUInt32:
+            return static_cast<std::int64_t>(std::get<std::uint32_t>(m_value));
+        case TypeUInt64:
+            return static_cast<std::int64_t>(std::get<std::uint64_t>(m_value));
+        case TypeFloat:
+            return static_cast<std::int64_t>(std::llround(std::get<std::float_t>(m_value)));
+        case TypeDouble:
+            return static_cast<std::int64_t>(std::llround(std::get<std::double_t>(m_value)));
+        case TypeInt8:
+            return static_cast<std::int64_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::int64_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return std::get<std::int64_t>(m_value);
+        case TypeString:
+            try
+            {
+                return static_cast<std::int64_t>(std::stoll(std::string(std::get<InlineString>(m_value).view())));
+            }
+            catch (...)
+            {
+                break;
+            }
+        case TypeByteVector:
+            return DataToInt64(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToInt64(pOk);
+        default:
+            break;
+    }
+
+    // Conversion not possible or not yet implemented!
+    if (pOk != nullptr) *pOk = false;
+
+    return std::int64_t(0);
+}
+
 std::double_t Variant::ToDouble(bool* pOk) const
 {
     if (pOk != nullptr) *pOk = true;
@@ -431,10 +742,16 @@ std::double_t Variant::ToDouble(bool* pOk) const
             return static_cast<std::double_t>(std::get<std::float_t>(m_value));
         case TypeDouble:
             return std::get<std::double_t>(m_value);
+        case TypeInt8:
+            return static_cast<std::double_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::double_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::double_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return std::stod(std::get<std::string>(m_value));
+                return std::stod(std::string(std::get<InlineString>(m_value).view()));
             }
             catch (...)
             {
@@ -442,6 +759,8 @@ std::double_t Variant::ToDouble(bool* pOk) const
             }
         case TypeByteVector:
             return DataToDouble(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToDouble(pOk);
         default:
             break;
     }
@@ -474,10 +793,16 @@ std::float_t Variant::ToFloat(bool* pOk) const
             return std::get<std::float_t>(m_value);
         case TypeDouble:
             return static_cast<std::float_t>(std::get<std::double_t>(m_value));
+        case TypeInt8:
+            return static_cast<std::float_t>(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return static_cast<std::float_t>(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return static_cast<std::float_t>(std::get<std::int64_t>(m_value));
         case TypeString:
             try
             {
-                return static_cast<std::float_t>(std::stof(std::get<std::string>(m_value)));
+                return static_cast<std::float_t>(std::stof(std::string(std::get<InlineString>(m_value).view())));
             }
             catch (...)
             {
@@ -485,6 +810,8 @@ std::float_t Variant::ToFloat(bool* pOk) const
             }
         case TypeByteVector:
             return DataToFloat(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToFloat(pOk);
         default:
             break;
     }
@@ -517,10 +844,18 @@ std::string Variant::ToString(bool* pOk) const
             return std::to_string(std::get<std::float_t>(m_value));
         case TypeDouble:
             return std::to_string(std::get<std::double_t>(m_value));
+        case TypeInt8:
+            return std::to_string(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return std::to_string(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return std::to_string(std::get<std::int64_t>(m_value));
         case TypeString:
-            return std::get<std::string>(m_value);
+            return std::string(std::get<InlineString>(m_value).view());
         case TypeByteVector:
             return DataToString(std::get<ByteVector>(m_value), pOk);
+        case TypeEncoded:
+            return Decoded().ToString(pOk);
         default:
             break;
     }
@@ -531,6 +866,28 @@ std::string Variant::ToString(bool* pOk) const
     return std::string{};
 }
 
+std::string_view Variant::ToStringView(bool* pOk) const
+{
+    if (m_value.index() == TypeEncoded)
+    {
+        // A string needs no decoding: view its characters in the stored bytes.
+        const auto& encoded = std::get<TypeEncoded>(m_value);
+        const auto data = encoded.GetData();
+        const auto ok = (encoded.GetType() == OCP1DATATYPE_STRING) && (data.size() >= 2);
+        if (pOk != nullptr)
+            *pOk = ok;
+
+        return ok ? std::string_view(reinterpret_cast<const char*>(data.data()) + 2, data.size() - 2)
+                  : std::string_view{};
+    }
+
+    const auto ok = (m_value.index() == TypeString);
+    if (pOk != nullptr)
+        *pOk = ok;
+
+    return ok ? std::get<TypeString>(m_value).view() : std::string_view{};
+}
+
 ByteVector Variant::ToByteVector(bool* pOk) const
 {
     if (pOk != nullptr) *pOk = true;
@@ -553,10 +910,28 @@ ByteVector Variant::ToByteVector(bool* pOk) const
             return DataFromFloat(std::get<std::float_t>(m_value));
         case TypeDouble:
             return DataFromDouble(std::get<std::double_t>(m_value));
+        case TypeInt8:
+            return DataFromInt8(std::get<std::int8_t>(m_value));
+        case TypeInt16:
+            return DataFromInt16(std::get<std::int16_t>(m_value));
+        case TypeInt64:
+            return DataFromInt64(std::get<std::int64_t>(m_value));
         case TypeString:
-            return DataFromString(std::get<std::string>(m_value));
+            return DataFromString(std::string(std::get<InlineString>(m_value).view()));
         case TypeByteVector:
             return std::get<ByteVector>(m_value);
+        case TypePosition:
+        {
+            const auto& pos = std::get<TypePosition>(m_value);
+            return DataFromPosition(pos[0], pos[1], pos[2]);
+        }
+        case TypeAimingAndPosition:
+        {
+            const auto& pos = std::get<TypeAimingAndPosition>(m_value);
+            return DataFromAimingAndPosition(pos[0], pos[1], pos[2], pos[3], pos[4], pos[5]);
+        }
+        case TypeEncoded:
+            return Decoded().ToByteVector(pOk);
         default:
             break;
     }
@@ -579,8 +954,14 @@ ByteVector Variant::ToParamData(Ocp1DataType type /* = OCP1DATATYPE_NONE */, boo
     {
         case OCP1DATATYPE_BOOLEAN:
             return DataFromBool(ToBool(pOk));
+        case OCP1DATATYPE_INT8:
+            return DataFromInt8(static_cast<std::int8_t>(ToInt32(pOk)));
+        case OCP1DATATYPE_INT16:
+            return DataFromInt16(static_cast<std::int16_t>(ToInt32(pOk)));
         case OCP1DATATYPE_INT32:
             return DataFromInt32(ToInt32(pOk));
+        case OCP1DATATYPE_INT64:
+            return DataFromInt64(ToInt64(pOk));
         case OCP1DATATYPE_UINT8:
             return DataFromUint8(ToUInt8(pOk));
         case OCP1DATATYPE_UINT16:
@@ -599,12 +980,16 @@ ByteVector Variant::ToParamData(Ocp1DataType type /* = OCP1DATATYPE_NONE */, boo
             return ToByteVector(pOk);
         case OCP1DATATYPE_DB_POSITION:
             return ToByteVector(pOk);
-        case OCP1DATATYPE_NONE:
-        case OCP1DATATYPE_INT8:
-        case OCP1DATATYPE_INT16:
-        case OCP1DATATYPE_INT64:
         case OCP1DATATYPE_BIT_STRING:
+            if (m_value.index() == TypeEncoded)
+                return Decoded().ToParamData(type, pOk);
+            // Only a blob holding a marshaled bit string can be sent as one.
+            if (m_value.index() == TypeByteVector && IsBitString(std::get<ByteVector>(m_value)))
+                return std::get<ByteVector>(m_value);
+            break;
         case OCP1DATATYPE_BLOB_FIXED_LEN:
+            return ToByteVector(pOk);
+        case OCP1DATATYPE_NONE:
         case OCP1DATATYPE_CUSTOM:
         default:
             break;
@@ -620,6 +1005,17 @@ std::array<std::float_t, 3> Variant::ToPosition(bool* pOk) const
 {
     std::array<std::float_t, 3> ret{ 0.0f };
 
+    if (m_value.index() == TypeEncoded)
+        return Decoded().ToPosition(pOk);
+
+    if (m_value.index() == TypePosition)
+    {
+        if (pOk != nullptr)
+            *pOk = true;
+
+        return std::get<TypePosition>(m_value);
+    }
+
     if (m_value.index() != TypeByteVector)
     {
         if (pOk != nullptr)
@@ -633,13 +1029,7 @@ std::array<std::float_t, 3> Variant::ToPosition(bool* pOk) const
                (data.size() == 36));  // Value contains 9 floats: x, y, z, plus min and max each on top.
 
     if (ok)
-        ret[0] = NanoOcp1::DataToFloat(data, &ok); // x
-
-    if (ok)
-        ret[1] = NanoOcp1::DataToFloat(ByteVector(data.data() + 4, data.data() + 8), &ok); // y
-
-    if (ok)
-        ret[2] = NanoOcp1::DataToFloat(ByteVector(data.data() + 8, data.data() + 12), &ok); // z
+        NanoOcp1::ReadFloat32Array(data, ret.data(), 3); // x, y, z
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -676,6 +1066,17 @@ std::array<std::float_t, 6> Variant::ToAimingAndPosition(bool* pOk) const
 {
     std::array<std::float_t, 6> ret{ 0.0f };
 
+    if (m_value.index() == TypeEncoded)
+        return Decoded().ToAimingAndPosition(pOk);
+
+    if (m_value.index() == TypeAimingAndPosition)
+    {
+        if (pOk != nullptr)
+            *pOk = true;
+
+        return std::get<TypeAimingAndPosition>(m_value);
+    }
+
     if (m_value.index() != TypeByteVector)
     {
         if (pOk != nullptr)
@@ -688,22 +1089,7 @@ std::array<std::float_t, 6> Variant::ToAimingAndPosition(bool* pOk) const
     bool ok = (data.size() == 24); // Value contains 6 floats: horAngle, vertAngle, rotAngle, x, y, z.
     
     if (ok)
-        ret[0] = NanoOcp1::DataToFloat(data, &ok); // hor
-
-    if (ok)
-        ret[1] = NanoOcp1::DataToFloat(ByteVector(data.data() + 4, data.data() + 8), &ok); // ver
-
-    if (ok)
-        ret[2] = NanoOcp1::DataToFloat(ByteVector(data.data() + 8, data.data() + 12), &ok); // rot
-
-    if (ok)
-        ret[3] = NanoOcp1::DataToFloat(ByteVector(data.data() + 12, data.data() + 16), &ok); // x
-
-    if (ok)
-        ret[4] = NanoOcp1::DataToFloat(ByteVector(data.data() + 16, data.data() + 20), &ok); // y
-
-    if (ok)
-        ret[5] = NanoOcp1::DataToFloat(ByteVector(data.data() + 20, data.data() + 24), &ok); // z
+        NanoOcp1::ReadFloat32Array(data, ret.data(), 6); // hor, vert, rot, x, y, z
 
     if (pOk != nullptr)
         *pOk = ok;
@@ -732,92 +1118,62 @@ std::string Variant::ToAimingAndPositionString(bool* pOk) const
     return ret;
 }
 
-std::vector<bool> Variant::ToBoolVector(bool* pOk) const
+std::vector<bool> Variant::ToBitString(bool* pOk) const
 {
-    std::vector<bool> boolVector;
+    if (m_value.index() == TypeEncoded)
+        return Decoded().ToBitString(pOk);
 
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
-
-        return boolVector;
-    }
-
-    const auto& data = std::get<ByteVector>(m_value);
-    bool ok = (data.size() >= 2); // OcaList size takes up the first 2 bytes.
+    bool ok = (m_value.index() == TypeByteVector) && IsBitString(std::get<ByteVector>(m_value));
 
-    std::uint16_t listSize(0);
+    std::vector<bool> bits;
     if (ok)
-        listSize = NanoOcp1::DataToUint16(data, &ok);
-
-    ok = ok && (data.size() == listSize + 2);
-    if (ok && listSize > 0)
-    {
-        boolVector.reserve(listSize);
-        std::size_t readPos(2); // Start after the OcaList size bytes
-        while (readPos < data.size() && ok)
-        {
-            ByteVector tmpData(data.data() + readPos, data.data() + readPos + 1);
-            boolVector.push_back(NanoOcp1::DataToBool(tmpData, &ok));
-            readPos++;
-        }
-    }
-
-    ok = ok && (boolVector.size() == listSize);
+        bits = NanoOcp1::DataToBitString(std::get<ByteVector>(m_value), &ok);
 
     if (pOk != nullptr)
         *pOk = ok;
 
-    return boolVector;
+    return bits;
 }
 
-std::vector<std::string> Variant::ToStringVector(bool* pOk) const
+std::vector<bool> Variant::ToBoolVector(bool* pOk) const
 {
-    std::vector<std::string> stringVector;
-
-    if (m_value.index() != TypeByteVector)
-    {
-        if (pOk != nullptr)
-            *pOk = false;
+    return ToList<bool>(pOk);
+}
 
-        return stringVector;
-    }
+std::vector<std::string> Variant::ToStringVector(bool* pOk) const
+{
+    return ToList<std::string>(pOk);
+}
 
-    const auto& data = std::get<ByteVector>(m_value);
-    bool ok = (data.size() >= 2); // OcaList size takes up the first 2 bytes.
+template <typename T>
+std::vector<T> Variant::ToList(bool* pOk) const
+{
+    if (m_value.index() == TypeEncoded)
+        return Decoded().ToList<T>(pOk);
 
-    std::uint16_t listSize(0);
+    std::vector<T> list;
+    bool ok = (m_value.index() == TypeByteVector);
     if (ok)
-        listSize = NanoOcp1::DataToUint16(data, &ok);
-
-    // Byte vector has the right size even assuming empty strings (min 2 bytes per string + 2 bytes for list size).
-    ok = ok && (data.size() >= ((listSize * 2) + 2));
-    if (ok && listSize > 0)
     {
-        stringVector.reserve(static_cast<size_t>(listSize));
-        std::size_t readPos(2); // Start after the OcaList size bytes
-        while (readPos + 2 <= data.size() && ok)
-        {
-            ByteVector stringLenData(data.data() + readPos, data.data() + readPos + 2);
-            auto stringLen = NanoOcp1::DataToUint16(stringLenData, &ok);
-            readPos += 2;
-
-            ok = ok && (readPos + stringLen <= data.size());
-            if (ok)
-            {
-                stringVector.push_back(std::string(data.data() + readPos, data.data() + readPos + stringLen));
-                readPos += stringLen;
-            }
-        }
+        // The whole blob must be the list, without trailing bytes.
+        const auto& data = std::get<ByteVector>(m_value);
+        ok = Ocp1ValueCodec<std::vector<T>>::Decode(data, list) &&
+             Ocp1ValueCodec<std::vector<T>>::Size(list) == data.size();
     }
 
-    ok = ok && (stringVector.size() == listSize);
+    if (!ok)
+        list.clear();
 
     if (pOk != nullptr)
         *pOk = ok;
 
-    return stringVector;
+    return list;
+}
+
+bool Variant::IsBitString(ByteSpan data)
+{
+    // 2 bytes bit count, followed by exactly as many bytes as the bits need.
+    return (data.size() >= 2) && (data.size() == 2 + (ReadUint16(data.data()) + std::size_t(7)) / 8);
 }
 
 }
@@ -21,6 +21,8 @@
 #include <cstdint>          //< USE std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t in GCC-13
 #include <variant>          //< USE std::variant
 #include <array>            //< USE std::array
+#include <string>           //< USE std::string
+#include <string_view>      //< USE std::string_view
 #include "Ocp1DataTypes.h"  //< USE NanoOcp1::Ocp1DataType
 
 
@@ -86,7 +88,10 @@ namespace NanoOcp1
  * | Constructor | Internal TypeIndex | `GetDataType()` returns |
  * |---|---|---|
  * | `Variant(bool)` | TypeBool | OCP1DATATYPE_BOOLEAN |
+ * | `Variant(int8_t)` | TypeInt8 | OCP1DATATYPE_INT8 |
+ * | `Variant(int16_t)` | TypeInt16 | OCP1DATATYPE_INT16 |
  * | `Variant(int32_t)` | TypeInt32 | OCP1DATATYPE_INT32 |
+ * | `Variant(int64_t)` | TypeInt64 | OCP1DATATYPE_INT64 |
  * | `Variant(uint8_t)` | TypeUInt8 | OCP1DATATYPE_UINT8 |
  * | `Variant(uint16_t)` | TypeUInt16 | OCP1DATATYPE_UINT16 |
  * | `Variant(uint32_t)` | TypeUInt32 | OCP1DATATYPE_UINT32 |
@@ -94,17 +99,44 @@ namespace NanoOcp1
  * | `Variant(float_t)` | TypeFloat | OCP1DATATYPE_FLOAT32 |
  * | `Variant(double_t)` | TypeDouble | OCP1DATATYPE_FLOAT64 |
  * | `Variant(string)` | TypeString | OCP1DATATYPE_STRING |
- * | `Variant(float x, float y, float z)` | TypeByteVector | OCP1DATATYPE_BLOB |
- * | `Variant(ByteVector, type)` | TypeByteVector | OCP1DATATYPE_BLOB |
+ * | `Variant(float x, float y, float z)` | TypePosition | OCP1DATATYPE_BLOB |
+ * | `Variant(std::array<float, 6>)` | TypeAimingAndPosition | OCP1DATATYPE_BLOB |
+ * | `Variant(ByteVector, DB_POSITION)` | TypePosition or TypeAimingAndPosition | OCP1DATATYPE_BLOB |
+ * | `Variant(ByteVector, BLOB)` | TypeByteVector | OCP1DATATYPE_BLOB |
+ * | `Variant(ByteVector, BIT_STRING)` | TypeByteVector | OCP1DATATYPE_BLOB |
+ * | `Variant(ByteVector, BLOB_FIXED_LEN)` | TypeByteVector | OCP1DATATYPE_BLOB |
+ * | `Variant(ByteSpan, type)` | as for ByteVector | as for ByteVector |
+ * | `Variant::Lazy(ByteSpan, type)` | TypeEncoded | as for ByteVector |
  * | `Variant()` (default) | TypeNone | OCP1DATATYPE_NONE; invalid until set |
+ *
+ * ## Storage
+ * Positions, aiming-and-positions and strings of up to `InlineString::InlineCapacity`
+ * bytes (DS100 channel names, GUIDs, scene indices) are stored inline, so decoding
+ * any DS100 value into a Variant does not allocate.  Only longer strings and blobs
+ * go to the heap.  Variant has no virtual functions, and none of its alternatives
+ * points into itself, so moving it is a plain copy of its bytes.
+ *
+ * ## Lazy decoding
+ * `Variant::Lazy()` keeps the parameter bytes as received, together with their type,
+ * and decodes them only when an accessor such as `ToFloat()` or `ToPosition()` is
+ * called.  Two lazy Variants compare equal if their type and bytes match, so a
+ * repeated notification is detected without decoding either of them.  Accessors
+ * decode on every call and leave the Variant unchanged, so const access stays
+ * thread-safe; call `Decode()` to keep the decoded value for repeated access.
  */
 class Variant
 {
 public:
     /** @brief Constructs a Variant holding a boolean value. */
     Variant(bool v);
+    /** @brief Constructs a Variant holding a signed 8-bit integer. */
+    Variant(std::int8_t v);
+    /** @brief Constructs a Variant holding a signed 16-bit integer. */
+    Variant(std::int16_t v);
     /** @brief Constructs a Variant holding a signed 32-bit integer. */
     Variant(std::int32_t v);
+    /** @brief Constructs a Variant holding a signed 64-bit integer. */
+    Variant(std::int64_t v);
     /** @brief Constructs a Variant holding an unsigned 8-bit integer. */
     Variant(std::uint8_t v);
     /** @brief Constructs a Variant holding an unsigned 16-bit integer. */
@@ -122,7 +154,7 @@ public:
     /** @brief Constructs a Variant holding a string value (C-string overload). */
     Variant(const char* v);
     /**
-     * @brief Constructs a Variant holding a 3D position as a 12-byte blob (3 × big-endian float32).
+     * @brief Constructs a Variant holding a 3D position, marshaled as 3 × big-endian float32.
      * This is the preferred way to build a value for `SetValueCommand` on a
      * `dbOcaObjectDef_Positioning_Source_Position`.
      * @param x  Normalised X position [0.0, 1.0].
@@ -130,6 +162,14 @@ public:
      * @param z  Normalised Z position [0.0, 1.0].
      */
     Variant(std::float_t x, std::float_t y, std::float_t z);
+    /** @brief Constructs a Variant holding a 3D position (x, y, z). */
+    Variant(const std::array<std::float_t, 3>& position);
+    /**
+     * @brief Constructs a Variant holding an aiming and position value, marshaled
+     * as 6 × big-endian float32 for e.g. `dbOcaObjectDef_Positioning_Speaker_Position`.
+     * @param aimingAndPosition  hor, vert, rot, x, y, z — the order of `ToAimingAndPosition()`.
+     */
+    Variant(const std::array<std::float_t, 6>& aimingAndPosition);
 
     /**
      * Default constructor. Type-less and value-less per default, and will return FALSE on IsValid as such.
@@ -142,10 +182,35 @@ public:
      *
      * @param[in] data  Byte vector representing the parameter data obtained by i.e. an OCP1 Notification or Response.
      * @param[in] type  Data type of the Ocp1CommandDefinition associated with that OCP1 message.
+     *                  OCP1DATATYPE_DB_POSITION data is decoded into TypePosition (12 bytes,
+     *                  or the current value of a 36-byte GetValue response with min and max)
+     *                  or TypeAimingAndPosition (24 bytes).
      */
     Variant(const std::vector<std::uint8_t>& data, Ocp1DataType type = OCP1DATATYPE_BLOB);
 
-    virtual ~Variant() = default;
+    /**
+     * Unmarshaling constructor reading straight from a received frame, e.g. the
+     * parameterData of an Ocp1NotificationView.  Scalar types and strings are
+     * decoded without an intermediate ByteVector, positions without any allocation.
+     *
+     * @param[in] data  Parameter data obtained by i.e. an OCP1 Notification or Response.
+     * @param[in] type  Data type of the Ocp1CommandDefinition associated with that OCP1 message.
+     */
+    Variant(ByteSpan data, Ocp1DataType type);
+
+    /**
+     * Lazy unmarshaling: stores a copy of the parameter bytes and their type, and
+     * decodes them on access.  Payloads of up to 29 bytes, i.e. all DS100 scalars,
+     * positions and short names, are stored inline; of a 36-byte DB_POSITION
+     * response, only the current value is kept, as when decoding.  Longer
+     * payloads are decoded right away, so the result is not lazy and invalid
+     * data leaves it invalid.  Otherwise, invalid data is not detected until an
+     * accessor reports it through `pOk`.
+     *
+     * @param[in] data  Parameter data obtained by i.e. an OCP1 Notification or Response.
+     * @param[in] type  Data type of the Ocp1CommandDefinition associated with that OCP1 message.
+     */
+    static Variant Lazy(ByteSpan data, Ocp1DataType type);
 
     /** @brief Returns true if both Variants hold the same type and value. */
     bool operator==(const Variant& other) const;
@@ -160,8 +225,21 @@ public:
      */
     bool IsValid() const;
 
+    /** @brief Returns false for a Variant created by `Lazy()` that has not been decoded yet. */
+    bool IsDecoded() const;
+
+    /**
+     * Decodes the bytes of a lazy Variant in place, so later accessors read the
+     * decoded value.  Does nothing for a Variant that is already decoded.
+     *
+     * @return False if the bytes are not valid for their type; the Variant is then invalid.
+     */
+    bool Decode();
+
     /**
      * Gives the native type of this Variant, i.e. the type it was created as.
+     * For a lazy Variant, this is the type its data decodes to, taken from the
+     * stored type without decoding; invalid data is only detected on access.
      *
      * @return This Variant's native type, as a Ocp1DataType.
      */
@@ -203,6 +281,8 @@ public:
     std::uint32_t ToUInt32(bool* pOk = nullptr) const;
     /** @brief Returns the value as uint64_t. */
     std::uint64_t ToUInt64(bool* pOk = nullptr) const;
+    /** @brief Returns the value as int64_t. */
+    std::int64_t ToInt64(bool* pOk = nullptr) const;
     /** @brief Returns the value as float_t (32-bit). Conversion from double loses precision. */
     std::float_t ToFloat(bool* pOk = nullptr) const;
     /** @brief Returns the value as double_t (64-bit). */
@@ -213,12 +293,19 @@ public:
      * For a human-readable representation of numeric types, use `ToPositionString()` etc.
      */
     std::string ToString(bool* pOk = nullptr) const;
+    /**
+     * @brief Returns the value of a TypeString Variant without copying it.
+     * The view is valid as long as this Variant is alive and unchanged.
+     * For a lazy string Variant it points into the stored bytes, without decoding.
+     * Fails for all other types.
+     */
+    std::string_view ToStringView(bool* pOk = nullptr) const;
 
     /** @} */
 
     /**
      * Convenience helper method to extract x, y, and z float values from a Variant.
-     * The Variant should internally contain the values as 3 x 4 bytes.
+     * The Variant should hold a position, or a blob of 3 (or 9, incl. min and max) x 4 bytes.
      *
      * @param[in] pOk   Optional parameter to verify if the conversion was successful.
      * @return  The contained x, y, and z values.
@@ -236,6 +323,7 @@ public:
     /**
      * Convenience helper method to extract x, y, z, horizontal angle (yaw),
      * vertical angle (pitch) and rotation angle (roll) float values from a Variant.
+     * The Variant should hold an aiming and position, or a blob of 6 x 4 bytes.
      * @note The aiming angles are unmarshaled first and the position second, to keep in line
      *       with the CdbOcaAimingAndPosition::Unmarshal method.
      *
@@ -266,6 +354,16 @@ public:
      */
     std::vector<bool> ToBoolVector(bool* pOk = nullptr) const;
 
+    /**
+     * Convenience helper method to extract the bits of an OcaBitstring from a Variant,
+     * e.g. one mute flag per channel.  The Variant needs to hold a marshaled bit string,
+     * as decoded from OCP1DATATYPE_BIT_STRING parameter data.
+     *
+     * @param[in] pOk   Optional parameter to verify if the conversion was successful.
+     * @return  The bits, in wire order.
+     */
+    std::vector<bool> ToBitString(bool* pOk = nullptr) const;
+
     /**
      * Convenience helper method to extract a std::vector<std::string> from a from a Variant.
      * The Variant's contents need to be marshalled as an OcaList<OcaString>.
@@ -276,7 +374,66 @@ public:
     std::vector<std::string> ToStringVector(bool* pOk = nullptr) const;
 
 
+    /**
+     * @brief Storage of TypeString values.
+     *
+     * Up to `InlineCapacity` bytes are kept inside the object, longer strings in a
+     * heap buffer.  The last byte holds the inline length, or `HeapTag` when the
+     * first bytes hold the heap pointer and length instead.
+     */
+    class InlineString
+    {
+    public:
+        static constexpr std::size_t InlineCapacity = 30;
+
+        InlineString() noexcept { m_bytes[TagPos] = 0; }
+        explicit InlineString(std::string_view str);
+        /** @brief Stores the prefix character followed by str. */
+        InlineString(char prefix, std::string_view str);
+        InlineString(const InlineString& other);
+        InlineString(InlineString&& other) noexcept;
+        InlineString& operator=(const InlineString& other);
+        InlineString& operator=(InlineString&& other) noexcept;
+        ~InlineString();
+
+        /** @brief Returns the stored characters. */
+        std::string_view view() const noexcept;
+        /** @brief Returns true if the characters are stored inline. */
+        bool isInline() const noexcept { return m_bytes[TagPos] != HeapTag; }
+
+        bool operator==(const InlineString& other) const noexcept { return view() == other.view(); }
+        bool operator!=(const InlineString& other) const noexcept { return view() != other.view(); }
+
+    private:
+        static constexpr std::size_t  TagPos  = 31;
+        static constexpr std::uint8_t HeapTag = 0xff;
+
+        void assign(const char* prefix, std::size_t prefixSize, std::string_view str);
+        void release() noexcept;
+
+        alignas(char*) std::uint8_t m_bytes[32];
+    };
+
 protected:
+    /**
+     * @brief Storage of TypeEncoded values: the Ocp1DataType in the first byte,
+     * followed by the parameter bytes as received.
+     */
+    class EncodedValue
+    {
+    public:
+        EncodedValue(ByteSpan data, Ocp1DataType type);
+
+        Ocp1DataType GetType() const noexcept;
+        ByteSpan GetData() const noexcept;
+
+        bool operator==(const EncodedValue& other) const noexcept { return m_bytes == other.m_bytes; }
+        bool operator!=(const EncodedValue& other) const noexcept { return m_bytes != other.m_bytes; }
+
+    private:
+        InlineString m_bytes;
+    };
+
     /**
      * Marshals the Variant into a byte vector using a format based on the Variant's native type.
      *
@@ -304,8 +461,14 @@ protected:
         TypeUInt64,         ///< std::uint64_t
         TypeFloat,          ///< std::float_t  (32-bit IEEE 754)
         TypeDouble,         ///< std::double_t (64-bit IEEE 754)
-        TypeString,         ///< std::string   (OCA string: 2-byte length prefix + UTF-8 bytes)
-        TypeByteVector      ///< std::vector<uint8_t> — used for blobs and multi-float spatial types
+        TypeString,         ///< InlineString  (OCA string: 2-byte length prefix + UTF-8 bytes)
+        TypeByteVector,     ///< std::vector<uint8_t> — used for blobs and lists
+        TypePosition,       ///< std::array<float, 3> — x, y, z
+        TypeAimingAndPosition, ///< std::array<float, 6> — hor, vert, rot, x, y, z
+        TypeInt8,           ///< std::int8_t
+        TypeInt16,          ///< std::int16_t
+        TypeInt64,          ///< std::int64_t
+        TypeEncoded         ///< EncodedValue — type and raw bytes of a lazy Variant
     };
 
     /**
@@ -324,8 +487,37 @@ protected:
                                      std::uint64_t,                 // TypeUInt64
                                      std::float_t,                  // TypeFloat
                                      std::double_t,                 // TypeDouble
-                                     std::string,                   // TypeString
-                                     std::vector<std::uint8_t>>;    // TypeByteVector
+                                     InlineString,                  // TypeString
+                                     std::vector<std::uint8_t>,     // TypeByteVector
+                                     std::array<std::float_t, 3>,   // TypePosition
+                                     std::array<std::float_t, 6>,   // TypeAimingAndPosition
+                                     std::int8_t,                   // TypeInt8
+                                     std::int16_t,                  // TypeInt16
+                                     std::int64_t,                  // TypeInt64
+                                     EncodedValue>;                 // TypeEncoded
+
+    /**
+     * Unmarshals data of the given type into value, as the unmarshaling constructor does.
+     *
+     * @return False if the data is not valid for the type, or the type is not supported.
+     */
+    static bool DecodeInto(ByteSpan data, Ocp1DataType type, VariantType& value);
+
+    /** @brief Returns the GetDataType() of a Variant that DecodeInto() filled for the type. */
+    static Ocp1DataType GetDecodedDataType(Ocp1DataType type);
+
+    /** @brief Returns true if data is exactly one marshaled OcaBitstring. */
+    static bool IsBitString(ByteSpan data);
+
+    /**
+     * Decodes an OcaList<T> blob with Ocp1ValueCodec<std::vector<T>>.
+     * Fails if the blob holds more or less than the list.
+     */
+    template <typename T>
+    std::vector<T> ToList(bool* pOk) const;
+
+    /** @brief Returns a decoded copy of a lazy Variant, or a copy of this Variant otherwise. */
+    Variant Decoded() const;
 
 private:
     VariantType m_value; ///< The stored value; active alternative determined by TypeIndex.
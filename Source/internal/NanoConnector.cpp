@@ -0,0 +1,388 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "NanoConnector.h"
+#include "NanoReactor.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace NanoOcp1
+{
+
+// ── Resolve cache ─────────────────────────────────────────────────────────────
+// Shared by all connectors, so reconnecting a rack of devices resolves each
+// host once per ResolveCacheTtlMs rather than once per attempt.
+
+namespace
+{
+
+struct CachedResolution
+{
+    std::vector<NanoSocket::Address>      addresses;   ///< addresses[0] is the last good one if lastGood
+    std::chrono::steady_clock::time_point expiry;
+    bool                                  lastGood{ false };
+};
+
+std::mutex& getCacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, CachedResolution>& getCache()
+{
+    static std::unordered_map<std::string, CachedResolution> cache;
+    return cache;
+}
+
+std::string getCacheKey(const std::string& hostName, int portNumber)
+{
+    return hostName + '|' + std::to_string(portNumber);
+}
+
+bool lookUp(const std::string& hostName, int portNumber, std::vector<NanoSocket::Address>& addresses, bool& lastGood)
+{
+    const auto key = getCacheKey(hostName, portNumber);
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(getCacheMutex());
+        auto it = getCache().find(key);
+        if (it != getCache().end() && now < it->second.expiry)
+        {
+            addresses = it->second.addresses;
+            lastGood  = it->second.lastGood;
+            return true;
+        }
+    }
+
+    // Resolve without holding the lock: DNS may take a while.
+    if (!NanoSocket::resolve(hostName, portNumber, addresses))
+        return false;
+
+    lastGood = false;
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    getCache()[key] = { addresses, now + std::chrono::milliseconds(NanoConnector::ResolveCacheTtlMs), false };
+    return true;
+}
+
+void rememberGood(const std::string& hostName, int portNumber, const NanoSocket::Address& address)
+{
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    auto it = getCache().find(getCacheKey(hostName, portNumber));
+    if (it == getCache().end())
+        return;
+
+    auto& addresses = it->second.addresses;
+    auto  good      = std::find(addresses.begin(), addresses.end(), address);
+    if (good != addresses.end())
+    {
+        std::rotate(addresses.begin(), good, good + 1);
+        it->second.lastGood = true;
+    }
+}
+
+} // namespace
+
+void NanoConnector::clearResolveCache()
+{
+    std::lock_guard<std::mutex> lock(getCacheMutex());
+    getCache().clear();
+}
+
+
+// ── Attempt ───────────────────────────────────────────────────────────────────
+
+struct NanoConnector::Attempt : public NanoReactor::Handler
+{
+    explicit Attempt(NanoConnector& o) : owner(o) {}
+
+    // A finished connect shows up as writable, a failed one as an error, which
+    // the reactor reports as readable.
+    void handleReadable() override { owner.attemptReady(this); }
+    void handleWritable() override { owner.attemptReady(this); }
+
+    NanoConnector&              owner;
+    std::unique_ptr<NanoSocket> socket{ std::make_unique<NanoSocket>() };
+    std::size_t                 addressIndex{ 0 };
+    bool                        registered{ false };
+};
+
+
+// ── Construction / destruction ────────────────────────────────────────────────
+
+NanoConnector::NanoConnector() = default;
+
+NanoConnector::NanoConnector(std::shared_ptr<NanoReactor> reactor, std::function<void(Status)> onComplete)
+    : m_reactor(std::move(reactor)), m_onComplete(std::move(onComplete))
+{
+}
+
+NanoConnector::~NanoConnector()
+{
+    cancel();
+}
+
+
+// ── Control ───────────────────────────────────────────────────────────────────
+
+bool NanoConnector::start(const std::string& hostName, int portNumber, int timeoutMs, bool fastOpen,
+                          const SocketOptions& options)
+{
+    cancel();
+
+    std::vector<NanoSocket::Address> addresses;
+    bool lastGood = false;
+    const bool resolved = lookUp(hostName, portNumber, addresses, lastGood);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!resolved)
+    {
+        m_status = Status::Failed;
+        return false;
+    }
+
+    m_hostName    = hostName;
+    m_portNumber  = portNumber;
+    m_fastOpen    = fastOpen && lastGood; // a Fast Open cookie can only exist for the last good address
+    m_options     = options;
+    m_addresses   = std::move(addresses);
+    m_nextAddress = 0;
+    m_deadline    = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeoutMs, 0));
+    m_status      = Status::Connecting;
+
+    startAttempts();
+    if (m_attempts.empty())
+        m_status = Status::Failed;
+    return m_status == Status::Connecting;
+}
+
+void NanoConnector::startAttempts()
+{
+    // Called with m_mutex held.
+    while (m_attempts.size() < static_cast<std::size_t>(MaxParallelAttempts) && m_nextAddress < m_addresses.size())
+    {
+        const auto index   = m_nextAddress++;
+        auto       attempt = std::make_unique<Attempt>(*this);
+        attempt->socket->setOptions(m_options);
+        if (!attempt->socket->beginConnect(m_addresses[index], m_fastOpen && index == 0))
+            continue;
+        attempt->addressIndex = index;
+
+        if (m_reactor)
+        {
+            if (!m_reactor->addHandler(attempt->socket->getHandle(), attempt.get()))
+                continue;
+            attempt->registered = true;
+            m_reactor->setWriteInterest(attempt.get(), true);
+        }
+
+        m_attempts.push_back(std::move(attempt));
+    }
+}
+
+void NanoConnector::cancel()
+{
+    Attempts discarded;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Let a completion that is already handing over its socket finish first,
+        // so that the caller can rely on it having happened.
+        if (m_reactor && !m_reactor->isReactorThread())
+            m_completionDone.wait(lock, [this]() { return !m_completing; });
+
+        discarded.swap(m_attempts);
+        m_socket.reset();
+        m_status = Status::Idle;
+    }
+    discard(discarded);
+}
+
+void NanoConnector::discard(Attempts& attempts)
+{
+    // Called without m_mutex: removeHandler() waits for a running handler,
+    // which may itself be waiting for m_mutex.
+    for (auto& attempt : attempts)
+        if (attempt->registered)
+            m_reactor->removeHandler(attempt.get());
+    attempts.clear();
+}
+
+
+// ── Progress ──────────────────────────────────────────────────────────────────
+
+NanoConnector::Status NanoConnector::wait(NanoSocketHandle wakeHandle, int maxWaitMs)
+{
+    for (;;)
+    {
+        std::vector<NanoSocket*> sockets;
+        int timeoutMs = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_status != Status::Connecting)
+                return m_status;
+
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                m_deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+            {
+                m_attempts.clear();
+                m_status = Status::Failed;
+                return m_status;
+            }
+
+            timeoutMs = static_cast<int>(remaining);
+            if (maxWaitMs >= 0)
+                timeoutMs = std::min(timeoutMs, maxWaitMs);
+            for (const auto& attempt : m_attempts)
+                sockets.push_back(attempt->socket.get());
+        }
+
+        std::unique_ptr<bool[]> ready(new bool[sockets.size()]);
+        const auto numReady = NanoSocket::waitForWritable(sockets.data(), static_cast<int>(sockets.size()),
+                                                          timeoutMs, wakeHandle, ready.get());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (numReady < 0)
+        {
+            m_attempts.clear();
+            m_status = Status::Failed;
+            return m_status;
+        }
+        if (numReady == 0)
+        {
+            // Woken, maxWaitMs passed or the deadline was reached: the next
+            // round reports the latter.
+            if (std::chrono::steady_clock::now() < m_deadline)
+                return m_status;
+            continue;
+        }
+
+        // No reactor, so m_attempts is still what was polled.
+        Attempts failed;
+        for (std::size_t i = 0; i < sockets.size(); ++i)
+        {
+            if (!ready[i])
+                continue;
+
+            auto& attempt = m_attempts[i];
+            if (attempt->socket->finishConnect(m_hostName))
+            {
+                rememberGood(m_hostName, m_portNumber, m_addresses[attempt->addressIndex]);
+                m_socket = std::move(attempt->socket);
+                m_attempts.clear();
+                m_status = Status::Connected;
+                return m_status;
+            }
+            failed.push_back(std::move(attempt));
+        }
+
+        m_attempts.erase(std::remove(m_attempts.begin(), m_attempts.end(), nullptr), m_attempts.end());
+        startAttempts();
+        if (m_attempts.empty())
+        {
+            m_status = Status::Failed;
+            return m_status;
+        }
+    }
+}
+
+void NanoConnector::attemptReady(Attempt* attempt)
+{
+    // Reactor thread.  May delete attempt, so it is not touched after discard().
+    Attempts discarded;
+    auto     completed = Status::Connecting;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_attempts.begin(), m_attempts.end(),
+                               [attempt](const std::unique_ptr<Attempt>& a) { return a.get() == attempt; });
+        if (it == m_attempts.end())
+            return; // cancelled meanwhile
+
+        if (attempt->socket->finishConnect(m_hostName))
+        {
+            rememberGood(m_hostName, m_portNumber, m_addresses[attempt->addressIndex]);
+            discarded.swap(m_attempts);
+            completed = Status::Connected;
+        }
+        else
+        {
+            discarded.push_back(std::move(*it));
+            m_attempts.erase(it);
+            startAttempts();
+            if (m_attempts.empty())
+                completed = Status::Failed;
+        }
+
+        if (completed != Status::Connecting)
+            m_completing = true;
+    }
+
+    // The winning socket is deregistered (by discard()) before it is handed on:
+    // its new owner registers the same fd with its own handler.
+    std::unique_ptr<NanoSocket> socket;
+    if (completed == Status::Connected)
+        socket = std::move(attempt->socket);
+    discard(discarded);
+
+    if (completed == Status::Connecting)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_socket = std::move(socket);
+        m_status = completed;
+    }
+
+    if (m_onComplete)
+        m_onComplete(completed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completing = false;
+    }
+    m_completionDone.notify_all();
+}
+
+
+// ── State ─────────────────────────────────────────────────────────────────────
+
+NanoConnector::Status NanoConnector::getStatus() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_status;
+}
+
+bool NanoConnector::hasTimedOut() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_status == Status::Connecting && std::chrono::steady_clock::now() >= m_deadline;
+}
+
+std::unique_ptr<NanoSocket> NanoConnector::takeSocket()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_status != Status::Connected)
+        return nullptr;
+
+    m_status = Status::Idle;
+    return std::move(m_socket);
+}
+
+} // namespace NanoOcp1
@@ -0,0 +1,152 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "NanoSocket.h"
+
+namespace NanoOcp1
+{
+
+class NanoReactor;
+
+/**
+ * Non-blocking TCP connect state machine with cached name resolution.
+ *
+ * start() resolves the host — from a process-wide cache after the first time —
+ * and starts non-blocking connects to up to MaxParallelAttempts of its
+ * addresses at once, in the order NanoSocket::resolve() returns them (address
+ * families interleaved, Happy Eyeballs style, RFC 8305).  The first attempt to
+ * complete wins and the others are closed; a failed attempt is replaced by one
+ * to the next address.  The address that connected last is tried first next
+ * time, optionally with TCP Fast Open.
+ *
+ * The connector has no thread of its own.  It is driven either
+ * - by wait(), on a thread that may block (e.g. a connection's read thread), or
+ * - by a NanoReactor: constructed with one, the attempts are registered with the
+ *   reactor and the completion callback runs on the reactor thread.
+ *
+ * A connector runs one connect at a time.  start() and cancel() may be called
+ * from any thread, but not concurrently with wait().
+ */
+class NanoConnector
+{
+public:
+    enum class Status
+    {
+        Idle,       ///< Nothing started, or the socket has been taken.
+        Connecting, ///< Attempts in flight.
+        Connected,  ///< An attempt succeeded; collect the socket with takeSocket().
+        Failed      ///< Every address failed or the timeout elapsed.
+    };
+
+    /** Most connects in flight at the same time. */
+    static constexpr int MaxParallelAttempts = 4;
+
+    /** How long resolved addresses are reused before the host is resolved again. */
+    static constexpr int ResolveCacheTtlMs = 60000;
+
+    /** Creates a connector driven by wait(). */
+    NanoConnector();
+
+    /**
+     * Creates a connector driven by reactor.
+     * @param onComplete  Called on the reactor thread once a started connect has
+     *                    become Connected or Failed (except through cancel() or
+     *                    a timeout, which is only detected by hasTimedOut()).
+     */
+    NanoConnector(std::shared_ptr<NanoReactor> reactor, std::function<void(Status)> onComplete);
+    ~NanoConnector();
+
+    NanoConnector(const NanoConnector&)            = delete;
+    NanoConnector& operator=(const NanoConnector&) = delete;
+
+    /**
+     * Cancels any connect in progress and starts a new one.
+     * @param timeoutMs  Time after which the connect counts as failed.
+     * @param fastOpen   Request TCP Fast Open when reconnecting to the address
+     *                   that accepted the previous connection.
+     * @param options    Applied to every attempt's socket before it connects.
+     * @return False if the host could not be resolved or no attempt could be started.
+     */
+    bool start(const std::string& hostName, int portNumber, int timeoutMs, bool fastOpen,
+               const SocketOptions& options = {});
+
+    /**
+     * Waits for the attempts in flight (connectors without a reactor only).
+     * Returns once the connect has succeeded, failed or timed out, or with
+     * Status::Connecting once wakeHandle has become readable or maxWaitMs has
+     * passed (-1 = no limit).  The caller drains wakeHandle.
+     */
+    Status wait(NanoSocketHandle wakeHandle, int maxWaitMs = -1);
+
+    /** Returns the current status. */
+    Status getStatus() const;
+
+    /** Returns true if the connect is still in flight after its timeout. */
+    bool hasTimedOut() const;
+
+    /** Returns the connected socket once Status::Connected is reached, and resets to Idle. */
+    std::unique_ptr<NanoSocket> takeSocket();
+
+    /**
+     * Abandons the connect in progress, if any, and closes its sockets.  With a
+     * reactor, blocks while a completion is in progress on the reactor thread
+     * (unless called from it).
+     */
+    void cancel();
+
+    /** Forgets all cached name resolutions, e.g. after a network change. */
+    static void clearResolveCache();
+
+private:
+    struct Attempt;
+    using Attempts = std::vector<std::unique_ptr<Attempt>>;
+
+    void startAttempts();
+    void attemptReady(Attempt* attempt);
+    void discard(Attempts& attempts);
+
+    std::shared_ptr<NanoReactor>          m_reactor;
+    std::function<void(Status)>           m_onComplete;
+
+    mutable std::mutex                    m_mutex;
+    Status                                m_status{ Status::Idle };
+    std::string                           m_hostName;
+    int                                   m_portNumber{ 0 };
+    bool                                  m_fastOpen{ false };
+    SocketOptions                         m_options;
+    std::vector<NanoSocket::Address>      m_addresses;
+    std::size_t                           m_nextAddress{ 0 };
+    Attempts                              m_attempts;
+    std::unique_ptr<NanoSocket>           m_socket;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool                                  m_completing{ false }; ///< A reactor completion is running.
+    std::condition_variable               m_completionDone;
+};
+
+} // namespace NanoOcp1
@@ -0,0 +1,233 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "NanoIoUring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace NanoOcp1
+{
+
+// ── System calls ──────────────────────────────────────────────────────────────
+
+namespace
+{
+
+int ioUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int ringFd, unsigned opcode, void* arg, unsigned numArgs)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, arg, numArgs));
+}
+
+void* mapRing(int ringFd, std::size_t size, off_t offset)
+{
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+template <typename T>
+T* at(void* base, unsigned offset)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+
+// ── Construction / destruction ────────────────────────────────────────────────
+
+NanoIoUring::NanoIoUring(unsigned entries)
+{
+    const int fd = ioUringSetup(entries, &m_params);
+    if (fd < 0)
+        return;
+
+    m_sqRingSize = m_params.sq_off.array + m_params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = m_params.cq_off.cqes + m_params.cq_entries * sizeof(io_uring_cqe);
+    m_sqesSize   = m_params.sq_entries * sizeof(io_uring_sqe);
+
+    // Since 5.4 both rings share one mapping.
+    if ((m_params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing = mapRing(fd, m_sqRingSize, IORING_OFF_SQ_RING);
+    m_cqRing = (m_params.features & IORING_FEAT_SINGLE_MMAP) != 0 ? m_sqRing
+                                                                  : mapRing(fd, m_cqRingSize, IORING_OFF_CQ_RING);
+    m_sqes   = static_cast<io_uring_sqe*>(mapRing(fd, m_sqesSize, IORING_OFF_SQES));
+    if (m_sqRing == nullptr || m_cqRing == nullptr || m_sqes == nullptr)
+    {
+        m_ringFd = fd;
+        close();
+        return;
+    }
+
+    m_sqHead  = at<unsigned>(m_sqRing, m_params.sq_off.head);
+    m_sqTail  = at<unsigned>(m_sqRing, m_params.sq_off.tail);
+    m_sqMask  = at<unsigned>(m_sqRing, m_params.sq_off.ring_mask);
+    m_sqArray = at<unsigned>(m_sqRing, m_params.sq_off.array);
+    m_sqeTail = *m_sqTail;
+
+    m_cqHead  = at<unsigned>(m_cqRing, m_params.cq_off.head);
+    m_cqTail  = at<unsigned>(m_cqRing, m_params.cq_off.tail);
+    m_cqMask  = at<unsigned>(m_cqRing, m_params.cq_off.ring_mask);
+    m_cqes    = at<io_uring_cqe>(m_cqRing, m_params.cq_off.cqes);
+
+    m_ringFd = fd;
+}
+
+NanoIoUring::~NanoIoUring()
+{
+    close();
+}
+
+void NanoIoUring::close()
+{
+    // Closing the ring cancels everything still in flight.
+    if (m_ringFd >= 0)
+        ::close(m_ringFd);
+    m_ringFd = -1;
+
+    if (m_sqes != nullptr)
+        ::munmap(m_sqes, m_sqesSize);
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+        ::munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing != nullptr)
+        ::munmap(m_sqRing, m_sqRingSize);
+    if (m_bufRing != nullptr)
+        ::munmap(m_bufRing, m_bufRingSize);
+    if (m_buffers != nullptr)
+        ::munmap(m_buffers, m_buffersSize);
+
+    m_sqes    = nullptr;
+    m_cqRing  = nullptr;
+    m_sqRing  = nullptr;
+    m_bufRing = nullptr;
+    m_buffers = nullptr;
+}
+
+
+// ── Queues ────────────────────────────────────────────────────────────────────
+
+io_uring_sqe* NanoIoUring::getSqe()
+{
+    if (m_sqeTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_params.sq_entries)
+        return nullptr;
+
+    const auto index = m_sqeTail & *m_sqMask;
+    m_sqArray[index] = index;
+    ++m_sqeTail;
+
+    auto* sqe = &m_sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int NanoIoUring::submit(unsigned waitFor)
+{
+    __atomic_store_n(m_sqTail, m_sqeTail, __ATOMIC_RELEASE);
+
+    // Without SQPOLL the kernel only consumes entries inside io_uring_enter(),
+    // so everything between its head and our tail is still to be submitted.
+    const auto toSubmit = m_sqeTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (toSubmit == 0 && waitFor == 0)
+        return 0;
+
+    const int n = ioUringEnter(m_ringFd, toSubmit, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0u);
+    return n < 0 ? -errno : n;
+}
+
+
+// ── Provided buffer ring ──────────────────────────────────────────────────────
+
+static_assert(sizeof(io_uring_buf) == 16, "unexpected io_uring_buf layout");
+static_assert(offsetof(io_uring_buf_ring, tail) == 14, "unexpected io_uring_buf_ring layout");
+
+bool NanoIoUring::registerBufferRing(std::uint16_t groupId, unsigned numBuffers, unsigned bufferSize)
+{
+    if (!isValid() || m_bufRing != nullptr || numBuffers == 0 || numBuffers > 32768
+        || (numBuffers & (numBuffers - 1)) != 0)
+        return false;
+
+    // The ring must be page-aligned; anonymous mappings are.
+    m_bufRingSize = numBuffers * sizeof(io_uring_buf);
+    void* ring = ::mmap(nullptr, m_bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    m_buffersSize = std::size_t(numBuffers) * bufferSize;
+    void* buffers = ::mmap(nullptr, m_buffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED || buffers == MAP_FAILED)
+    {
+        if (ring != MAP_FAILED)
+            ::munmap(ring, m_bufRingSize);
+        if (buffers != MAP_FAILED)
+            ::munmap(buffers, m_buffersSize);
+        return false;
+    }
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr    = reinterpret_cast<std::uint64_t>(ring);
+    reg.ring_entries = numBuffers;
+    reg.bgid         = groupId;
+    if (ioUringRegister(m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+    {
+        ::munmap(ring, m_bufRingSize);
+        ::munmap(buffers, m_buffersSize);
+        return false;
+    }
+
+    m_bufRing    = static_cast<io_uring_buf_ring*>(ring);
+    m_buffers    = static_cast<std::uint8_t*>(buffers);
+    m_bufferSize = bufferSize;
+    m_bufMask    = static_cast<std::uint16_t>(numBuffers - 1);
+    m_bufTail    = 0;
+
+    for (unsigned id = 0; id < numBuffers; ++id)
+        recycleBuffer(id);
+    return true;
+}
+
+void NanoIoUring::recycleBuffer(unsigned id)
+{
+    // The ring tail overlays the reserved field of the first entry, so only
+    // addr, len and bid may be written.  The entries are addressed directly:
+    // compiled as C++, the header's flexible `bufs` member does not start at
+    // offset 0.
+    auto& buf = reinterpret_cast<io_uring_buf*>(m_bufRing)[m_bufTail & m_bufMask];
+    buf.addr  = reinterpret_cast<std::uint64_t>(m_buffers + std::size_t(id) * m_bufferSize);
+    buf.len   = m_bufferSize;
+    buf.bid   = static_cast<std::uint16_t>(id);
+    ++m_bufTail;
+    __atomic_store_n(&m_bufRing->tail, m_bufTail, __ATOMIC_RELEASE);
+}
+
+} // namespace NanoOcp1
@@ -0,0 +1,126 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <linux/io_uring.h>
+
+namespace NanoOcp1
+{
+
+/**
+ * Minimal io_uring instance driven through the raw system calls (Linux 6.0+,
+ * no liburing dependency), covering what NanoReactor's io_uring backend needs:
+ * a submission / completion queue pair and one provided buffer ring.
+ *
+ * getSqe() hands out zeroed submission entries, submit() passes them to the
+ * kernel and optionally waits for completions, and reap() visits and consumes
+ * all completions available.  With registerBufferRing(), receive requests that
+ * set IOSQE_BUFFER_SELECT pick one of the ring's buffers; the buffer id comes
+ * back in the completion flags, and the buffer must be returned with
+ * recycleBuffer() once its data has been consumed.
+ *
+ * Not thread-safe: one thread submits, reaps and recycles.
+ */
+class NanoIoUring
+{
+public:
+    /** Sets up a ring with entries submission slots (see isValid()). */
+    explicit NanoIoUring(unsigned entries);
+    ~NanoIoUring();
+
+    NanoIoUring(const NanoIoUring&)            = delete;
+    NanoIoUring& operator=(const NanoIoUring&) = delete;
+
+    /** Returns false if the kernel refused to set the ring up (e.g. io_uring disabled). */
+    bool isValid() const noexcept { return m_ringFd >= 0; }
+
+    /** Returns a zeroed submission entry, or nullptr if all slots are pending submission. */
+    io_uring_sqe* getSqe();
+
+    /**
+     * Submits all entries obtained since the last call and, with waitFor > 0,
+     * blocks until at least that many completions are available.
+     * Returns the number submitted, or -errno (e.g. -EINTR).
+     */
+    int submit(unsigned waitFor);
+
+    /** Calls fn(const io_uring_cqe&) for every available completion and consumes them. */
+    template <typename Fn>
+    unsigned reap(Fn&& fn)
+    {
+        auto       head = *m_cqHead;
+        const auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        const auto count = tail - head;
+        for (; head != tail; ++head)
+            fn(m_cqes[head & *m_cqMask]);
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    /**
+     * Registers a ring of numBuffers (a power of two) buffers of bufferSize
+     * bytes each as buffer group groupId and provides all of them.
+     * Returns false if the kernel does not support provided buffer rings.
+     */
+    bool registerBufferRing(std::uint16_t groupId, unsigned numBuffers, unsigned bufferSize);
+
+    /** Returns the start of buffer id of the registered buffer ring. */
+    const std::uint8_t* getBuffer(unsigned id) const noexcept { return m_buffers + std::size_t(id) * m_bufferSize; }
+
+    /** Returns buffer id to the kernel for further receives. */
+    void recycleBuffer(unsigned id);
+
+private:
+    void close();
+
+    int              m_ringFd{ -1 };
+    io_uring_params  m_params{};
+
+    void*            m_sqRing{ nullptr };
+    std::size_t      m_sqRingSize{ 0 };
+    void*            m_cqRing{ nullptr };
+    std::size_t      m_cqRingSize{ 0 };
+    io_uring_sqe*    m_sqes{ nullptr };
+    std::size_t      m_sqesSize{ 0 };
+
+    unsigned*        m_sqHead{ nullptr };
+    unsigned*        m_sqTail{ nullptr };
+    unsigned*        m_sqMask{ nullptr };
+    unsigned*        m_sqArray{ nullptr };
+    unsigned         m_sqeTail{ 0 }; ///< Entries handed out by getSqe(), published by submit().
+
+    unsigned*        m_cqHead{ nullptr };
+    unsigned*        m_cqTail{ nullptr };
+    unsigned*        m_cqMask{ nullptr };
+    io_uring_cqe*    m_cqes{ nullptr };
+
+    io_uring_buf_ring* m_bufRing{ nullptr };
+    std::size_t        m_bufRingSize{ 0 };
+    std::uint8_t*      m_buffers{ nullptr };
+    std::size_t        m_buffersSize{ 0 };
+    unsigned           m_bufferSize{ 0 };
+    std::uint16_t      m_bufMask{ 0 };
+    std::uint16_t      m_bufTail{ 0 };
+};
+
+} // namespace NanoOcp1
@@ -0,0 +1,241 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "NanoPipe.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace NanoOcp1
+{
+
+
+// ── Ring ──────────────────────────────────────────────────────────────────────
+// head and tail count bytes ever read / written, so tail - head is the fill
+// level and the ring never needs a spare slot.  The handshakes between the
+// two sides — "ring was empty" for the reader's wake-up, writerWaiting for
+// the writer's — store first and load the other side's position second, both
+// sequentially consistent, so at least one side always sees the other.
+
+struct NanoPipe::Ring
+{
+    explicit Ring(std::size_t capacity) : data(capacity), mask(capacity - 1) {}
+
+    std::size_t getCapacity() const noexcept { return data.size(); }
+
+    std::vector<std::uint8_t>             data;
+    const std::size_t                     mask;
+    alignas(64) std::atomic<std::size_t>  head{ 0 };              // advanced by the reader
+    alignas(64) std::atomic<std::size_t>  tail{ 0 };              // advanced by the writer
+    std::atomic<bool>                     writerWaiting{ false }; // writer wants a signal on free space
+};
+
+struct NanoPipe::Shared
+{
+    explicit Shared(std::size_t capacity) : toFirst(capacity), toSecond(capacity) {}
+
+    Ring              toFirst;
+    Ring              toSecond;
+    NanoWakeup        firstWakeup;
+    NanoWakeup        secondWakeup;
+    std::atomic<bool> closed{ false };
+};
+
+
+// ── Construction ──────────────────────────────────────────────────────────────
+
+bool NanoPipe::createPair(std::unique_ptr<NanoPipe>& first, std::unique_ptr<NanoPipe>& second,
+                          std::size_t capacity)
+{
+    std::size_t size = 4096;
+    while (size < capacity)
+        size *= 2;
+
+    auto shared = std::make_shared<Shared>(size);
+    if (!shared->firstWakeup.isValid() || !shared->secondWakeup.isValid())
+        return false;
+
+    first.reset(new NanoPipe(shared, true));
+    second.reset(new NanoPipe(shared, false));
+    return true;
+}
+
+NanoPipe::NanoPipe(std::shared_ptr<Shared> shared, bool first)
+    : m_shared(std::move(shared)),
+      m_in(first ? m_shared->toFirst : m_shared->toSecond),
+      m_out(first ? m_shared->toSecond : m_shared->toFirst),
+      m_wakeup(first ? m_shared->firstWakeup : m_shared->secondWakeup),
+      m_peerWakeup(first ? m_shared->secondWakeup : m_shared->firstWakeup)
+{
+}
+
+NanoPipe::~NanoPipe()
+{
+    close();
+}
+
+std::size_t NanoPipe::getCapacity() const noexcept
+{
+    return m_in.getCapacity();
+}
+
+
+// ── Read / write ──────────────────────────────────────────────────────────────
+
+int NanoPipe::readAvailable(void* data, int num)
+{
+    if (num <= 0)
+        return 0;
+
+    // Closed is checked before the ring, so bytes written before close() are
+    // still read.
+    const auto closed = m_shared->closed.load();
+    const auto head   = m_in.head.load(std::memory_order_relaxed);
+    auto       tail   = m_in.tail.load();
+    const auto count  = std::min<std::size_t>(tail - head, static_cast<std::size_t>(num));
+
+    if (count > 0)
+    {
+        const auto offset = head & m_in.mask;
+        const auto first  = std::min(count, m_in.getCapacity() - offset);
+        std::memcpy(data, m_in.data.data() + offset, first);
+        std::memcpy(static_cast<std::uint8_t*>(data) + first, m_in.data.data(), count - first);
+        m_in.head.store(head + count);
+
+        if (m_in.writerWaiting.load() && m_in.writerWaiting.exchange(false))
+            m_peerWakeup.signal();
+    }
+    else if (closed)
+    {
+        return -1;
+    }
+
+    // Drained: reset the wake-up, then look again, as the writer only signals
+    // when it finds the ring empty.
+    if (head + count == tail)
+    {
+        m_wakeup.drain();
+        tail = m_in.tail.load();
+        if (tail != head + count || m_shared->closed.load())
+            m_wakeup.signal();
+    }
+
+    return static_cast<int>(count);
+}
+
+int NanoPipe::writeGather(const Buffer* buffers, int numBuffers)
+{
+    if (m_shared->closed.load())
+        return -1;
+
+    const auto capacity = m_out.getCapacity();
+    const auto tail     = m_out.tail.load(std::memory_order_relaxed);
+    auto       space    = capacity - (tail - m_out.head.load());
+
+    std::size_t written = 0, total = 0;
+    for (int i = 0; i < numBuffers; ++i)
+    {
+        const auto* source = static_cast<const std::uint8_t*>(buffers[i].data);
+        const auto  count  = std::min(buffers[i].size, space - written);
+        total += buffers[i].size;
+        if (count == 0)
+            continue;
+
+        const auto offset = (tail + written) & m_out.mask;
+        const auto first  = std::min(count, capacity - offset);
+        std::memcpy(m_out.data.data() + offset, source, first);
+        std::memcpy(m_out.data.data(), source + first, count - first);
+        written += count;
+    }
+
+    if (written > 0)
+    {
+        m_out.tail.store(tail + written);
+        if (m_out.head.load() == tail)
+            m_peerWakeup.signal();
+    }
+
+    if (written < total)
+    {
+        // Ask the reader for a signal once it has made room; if it already has,
+        // signal ourselves so the caller retries.
+        m_out.writerWaiting.store(true);
+        space = capacity - (tail + written - m_out.head.load());
+        if (space > 0 && m_out.writerWaiting.exchange(false))
+            m_wakeup.signal();
+    }
+
+    return static_cast<int>(written);
+}
+
+
+// ── Wait / state ──────────────────────────────────────────────────────────────
+
+int NanoPipe::getReadyEvents(int events) const
+{
+    const auto closed = m_shared->closed.load();
+    int ready = 0;
+    if ((events & readEvent) != 0 && (closed || m_in.tail.load() != m_in.head.load()))
+        ready |= readEvent;
+    if ((events & writeEvent) != 0
+        && (closed || m_out.tail.load() - m_out.head.load() < m_out.getCapacity()))
+        ready |= writeEvent;
+    return ready;
+}
+
+int NanoPipe::waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const
+{
+    if ((events & writeEvent) != 0)
+        m_out.writerWaiting.store(true);
+
+    if (const auto ready = getReadyEvents(events))
+        return ready;
+
+    const auto ret = NanoSocket::waitForReadable(m_wakeup.getHandle(), timeoutMs, wakeHandle);
+    if (ret <= 0)
+        return ret;
+
+    // Reset the wake-up before looking, so a signal arriving meanwhile is kept.
+    m_wakeup.drain();
+    return getReadyEvents(events);
+}
+
+void NanoPipe::close()
+{
+    if (!m_shared->closed.exchange(true))
+    {
+        m_wakeup.signal();
+        m_peerWakeup.signal();
+    }
+}
+
+bool NanoPipe::isConnected() const
+{
+    return !m_shared->closed.load();
+}
+
+std::string NanoPipe::getHostName() const
+{
+    return "in-process";
+}
+
+} // namespace NanoOcp1
@@ -0,0 +1,103 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "NanoSocket.h"
+#include "NanoWakeup.h"
+
+namespace NanoOcp1
+{
+
+/**
+ * In-process byte stream between two NanoTransport ends, e.g. a client and a
+ * simulated device in the same process (see Ocp1ConnectionServer::connectInProcess()).
+ *
+ * Each direction is a lock-free single-producer / single-consumer ring: a
+ * write copies into the ring and a read copies out of it, with no system call
+ * and no socket in between.  The only kernel object per end is a NanoWakeup,
+ * which is signalled when data arrives in an empty ring, when space frees up
+ * for a writer that could not write everything, or when the pipe is closed —
+ * so the end can be waited on, or registered with a NanoReactor, like a socket.
+ * A burst of writes costs one signal.
+ *
+ * Closing either end closes the pipe: the other end still reads what was
+ * written before, then sees a graceful close.  Threading as for any
+ * NanoTransport: one reading thread, writers serialised by the caller.
+ */
+class NanoPipe : public NanoTransport
+{
+public:
+    /** Default ring size per direction in bytes. */
+    static constexpr std::size_t DefaultCapacity = 256 * 1024;
+
+    /**
+     * Create a connected pair of ends.  capacity is rounded up to a power of
+     * two.  Returns false if the wake-up handles could not be created.
+     */
+    static bool createPair(std::unique_ptr<NanoPipe>& first, std::unique_ptr<NanoPipe>& second,
+                           std::size_t capacity = DefaultCapacity);
+
+    ~NanoPipe() override;
+
+    NanoPipe(const NanoPipe&)            = delete;
+    NanoPipe& operator=(const NanoPipe&) = delete;
+
+    int  readAvailable(void* data, int num) override;
+    int  writeGather(const Buffer* buffers, int numBuffers) override;
+    int  waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const override;
+
+    NanoSocketHandle getHandle() const noexcept override { return m_wakeup.getHandle(); }
+    bool isSocket() const noexcept override { return false; }
+
+    void close() override;
+    bool isConnected() const override;
+
+    /** Returns "in-process". */
+    std::string getHostName() const override;
+
+    /** A pipe is always non-blocking: returns false for blocking mode. */
+    bool setNonBlocking(bool nonBlocking) override { return nonBlocking; }
+
+    bool setOptions(const SocketOptions&) override { return true; }
+    bool getAppliedOptions(SocketOptions&) const override { return false; }
+
+    /** Returns the ring size per direction. */
+    std::size_t getCapacity() const noexcept;
+
+private:
+    struct Ring;
+    struct Shared;
+
+    NanoPipe(std::shared_ptr<Shared> shared, bool first);
+
+    int getReadyEvents(int events) const;
+
+    std::shared_ptr<Shared> m_shared;
+    Ring&                   m_in;
+    Ring&                   m_out;
+    NanoWakeup&             m_wakeup;     // this end's readiness handle
+    NanoWakeup&             m_peerWakeup;
+};
+
+} // namespace NanoOcp1
@@ -0,0 +1,739 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "NanoReactor.h"
+
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+  // Windows – Winsock2 already included via NanoSocket.h
+  #define NANOREACTOR_POLL(fds, n, t) ::WSAPoll(fds, static_cast<ULONG>(n), t)
+  #define NANOREACTOR_POLLIN          POLLRDNORM
+  #define NANOREACTOR_POLLOUT         POLLWRNORM
+  using NanoReactorPollFd = WSAPOLLFD;
+#elif defined(__linux__)
+  #include <errno.h>
+  #include <poll.h>
+  #include <sys/epoll.h>
+  #include <unistd.h>
+  #if defined(NANOOCP1_USE_IO_URING)
+    #include "NanoIoUring.h"
+  #endif
+#else
+  #include <errno.h>
+  #include <poll.h>
+  #define NANOREACTOR_POLL(fds, n, t) ::poll(fds, static_cast<nfds_t>(n), t)
+  #define NANOREACTOR_POLLIN          POLLIN
+  #define NANOREACTOR_POLLOUT         POLLOUT
+  using NanoReactorPollFd = struct pollfd;
+#endif
+
+namespace NanoOcp1
+{
+
+// ── Backend ───────────────────────────────────────────────────────────────────
+// Each backend maps a registered fd to an opaque 64-bit token and reports the
+// tokens of ready fds from wait().  Token 0 is the reactor's wakeup handle.
+// add()/modify()/remove() are called with the reactor mutex held; wait() and
+// release() are not, and only ever from the reactor thread.
+// Error and hang-up conditions are reported as readable.
+
+struct NanoReactor::Backend
+{
+    virtual ~Backend() = default;
+
+    virtual const char* getName() const = 0;
+    virtual bool isValid() const = 0;
+
+    /**
+     * True if a wait() in progress does not see add()/modify()/remove(), so the
+     * reactor must be woken to pick them up.
+     */
+    virtual bool wakeOnChange() const = 0;
+
+    virtual void setWakeupHandle(NanoSocketHandle fd) = 0;
+    virtual bool add(NanoSocketHandle fd, std::uint64_t token, bool receiveData) = 0;
+    virtual bool modify(NanoSocketHandle fd, std::uint64_t token, bool writeInterest) = 0;
+    virtual void remove(NanoSocketHandle fd, std::uint64_t token) = 0;
+    virtual bool wait(std::vector<Event>& readyEvents) = 0;
+
+    /** Returns the buffer of a received event once its handler has run. */
+    virtual void release(const Event& /*event*/) {}
+};
+
+#if defined(__linux__)
+
+struct NanoReactor::ReadinessBackend : public NanoReactor::Backend
+{
+    ReadinessBackend()           { m_epollFd = ::epoll_create1(EPOLL_CLOEXEC); }
+    ~ReadinessBackend() override { if (m_epollFd >= 0) ::close(m_epollFd); }
+
+    const char* getName() const override { return "epoll"; }
+    bool isValid() const override { return m_epollFd >= 0; }
+
+    // epoll keeps the interest list in the kernel, so changes take effect
+    // immediately even while the reactor thread is blocked in epoll_wait().
+    bool wakeOnChange() const override { return false; }
+
+    void setWakeupHandle(NanoSocketHandle fd) override { add(fd, 0, false); }
+
+    bool add(NanoSocketHandle fd, std::uint64_t token, bool /*receiveData*/) override
+    {
+        struct epoll_event ev{};
+        ev.events   = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = token;
+        return ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    bool modify(NanoSocketHandle fd, std::uint64_t token, bool writeInterest) override
+    {
+        struct epoll_event ev{};
+        ev.events   = EPOLLIN | EPOLLRDHUP | (writeInterest ? EPOLLOUT : 0u);
+        ev.data.u64 = token;
+        return ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &ev) == 0;
+    }
+
+    void remove(NanoSocketHandle fd, std::uint64_t /*token*/) override
+    {
+        struct epoll_event ev{}; // non-null for kernels older than 2.6.9
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, &ev);
+    }
+
+    bool wait(std::vector<Event>& readyEvents) override
+    {
+        struct epoll_event events[64];
+        int n = ::epoll_wait(m_epollFd, events, 64, -1);
+        if (n < 0)
+            return errno == EINTR;
+
+        for (int i = 0; i < n; ++i)
+            readyEvents.push_back({ events[i].data.u64,
+                                    (events[i].events & ~static_cast<std::uint32_t>(EPOLLOUT)) != 0,
+                                    (events[i].events & EPOLLOUT) != 0 });
+        return true;
+    }
+
+    int m_epollFd{-1};
+};
+
+#else
+
+struct NanoReactor::ReadinessBackend : public NanoReactor::Backend
+{
+#if defined(_WIN32) || defined(_WIN64)
+    const char* getName() const override { return "WSAPoll"; }
+#else
+    const char* getName() const override { return "poll"; }
+#endif
+    bool isValid() const override { return true; }
+
+    // poll()/WSAPoll() take the fd set by value, so a blocked wait must be
+    // interrupted to pick up additions and removals.
+    bool wakeOnChange() const override { return true; }
+
+    bool add(NanoSocketHandle fd, std::uint64_t token, bool /*receiveData*/) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fds[token] = { fd, false };
+        m_dirty      = true;
+        return true;
+    }
+
+    bool modify(NanoSocketHandle /*fd*/, std::uint64_t token, bool writeInterest) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_fds.find(token);
+        if (it == m_fds.end())
+            return false;
+        it->second.writeInterest = writeInterest;
+        m_dirty                  = true;
+        return true;
+    }
+
+    void remove(NanoSocketHandle /*fd*/, std::uint64_t token) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fds.erase(token);
+        m_dirty = true;
+    }
+
+    bool wait(std::vector<Event>& readyEvents) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_dirty)
+            {
+                m_pollFds.resize(1); // slot 0 is the wakeup handle
+                m_tokens.resize(1);
+                for (const auto& entry : m_fds)
+                {
+                    NanoReactorPollFd pfd{};
+                    pfd.fd     = entry.second.fd;
+                    pfd.events = entry.second.writeInterest ? (NANOREACTOR_POLLIN | NANOREACTOR_POLLOUT)
+                                                            : NANOREACTOR_POLLIN;
+                    m_pollFds.push_back(pfd);
+                    m_tokens.push_back(entry.first);
+                }
+                m_dirty = false;
+            }
+        }
+
+        int n = NANOREACTOR_POLL(m_pollFds.data(), m_pollFds.size(), -1);
+        if (n < 0)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            return false;
+#else
+            return errno == EINTR;
+#endif
+        }
+
+        for (std::size_t i = 0; i < m_pollFds.size() && n > 0; ++i)
+        {
+            const auto revents = m_pollFds[i].revents;
+            if (revents != 0)
+            {
+                readyEvents.push_back({ m_tokens[i],
+                                        (revents & ~NANOREACTOR_POLLOUT) != 0,
+                                        (revents & NANOREACTOR_POLLOUT) != 0 });
+                --n;
+            }
+        }
+        return true;
+    }
+
+    void setWakeupHandle(NanoSocketHandle fd) override
+    {
+        NanoReactorPollFd pfd{};
+        pfd.fd     = fd;
+        pfd.events = NANOREACTOR_POLLIN;
+        m_pollFds.assign(1, pfd);
+        m_tokens.assign(1, 0);
+    }
+
+    struct Entry
+    {
+        NanoSocketHandle fd;
+        bool             writeInterest;
+    };
+
+    std::mutex                                          m_mutex;
+    std::unordered_map<std::uint64_t, Entry>            m_fds;
+    bool                                                m_dirty{false};
+    std::vector<NanoReactorPollFd>                      m_pollFds; // reactor thread only
+    std::vector<std::uint64_t>                          m_tokens;  // reactor thread only
+};
+
+#endif
+
+#if defined(NANOOCP1_USE_IO_URING)
+
+// Completion-based backend.  Each registered socket has at most one read-side
+// request in flight — a multishot receive into the shared buffer ring, or a
+// one-shot POLLIN poll for handlers that read themselves — plus a POLLOUT poll
+// while write interest is enabled.  add()/modify()/remove() only record the
+// change; wait() submits them together with the re-arming of every request
+// that has completed, in a single io_uring_enter() that also waits for the
+// next completions.  Re-arming a poll checks the current readiness, which
+// keeps the level-triggered behaviour of the readiness backends.
+
+struct NanoReactor::IoUringBackend : public NanoReactor::Backend
+{
+    static constexpr unsigned      QueueSize   = 256;
+    static constexpr unsigned      NumBuffers  = 256;      // power of two
+    static constexpr unsigned      BufferSize  = 8 * 1024;
+    static constexpr std::uint16_t BufferGroup = 0;
+
+    // The low two bits of a request's user_data tell its kind, the rest is the token.
+    enum Kind : std::uint64_t
+    {
+        PollIn  = 0,
+        Receive = 1,
+        PollOut = 2,
+        Cancel  = 3
+    };
+
+    struct Entry
+    {
+        NanoSocketHandle fd;
+        bool             receiveData;
+        bool             writeInterest;
+        bool             readArmed;
+        bool             writeArmed;
+    };
+
+    IoUringBackend()
+        : m_ring(QueueSize)
+    {
+        m_valid = m_ring.isValid() && m_ring.registerBufferRing(BufferGroup, NumBuffers, BufferSize);
+    }
+
+    const char* getName() const override { return "io_uring"; }
+    bool isValid() const override { return m_valid; }
+    bool wakeOnChange() const override { return true; }
+
+    void setWakeupHandle(NanoSocketHandle fd) override { add(fd, 0, false); }
+
+    bool add(NanoSocketHandle fd, std::uint64_t token, bool receiveData) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[token] = Entry{ fd, receiveData, false, false, false };
+        m_rearm.push_back(token);
+        return true;
+    }
+
+    bool modify(NanoSocketHandle /*fd*/, std::uint64_t token, bool writeInterest) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(token);
+        if (it == m_entries.end())
+            return false;
+        it->second.writeInterest = writeInterest;
+        if (writeInterest)
+            m_rearm.push_back(token);
+        return true;
+    }
+
+    void remove(NanoSocketHandle /*fd*/, std::uint64_t token) override
+    {
+        // The requests hold a reference to the socket, so they must be cancelled
+        // for a close() of the fd to take effect.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(token);
+        if (it == m_entries.end())
+            return;
+        if (it->second.readArmed)
+            m_cancel.push_back(userData(token, it->second.receiveData ? Receive : PollIn));
+        if (it->second.writeArmed)
+            m_cancel.push_back(userData(token, PollOut));
+        m_entries.erase(it);
+    }
+
+    bool wait(std::vector<Event>& readyEvents) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto target : m_cancel)
+            {
+                if (auto* sqe = nextSqe())
+                {
+                    sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+                    sqe->fd        = -1;
+                    sqe->addr      = target;
+                    sqe->user_data = Cancel;
+                }
+            }
+            m_cancel.clear();
+
+            m_pending.swap(m_rearm);
+            for (const auto token : m_pending)
+                if (!arm(token))
+                    m_rearm.push_back(token); // queue full, retried next time
+            m_pending.clear();
+        }
+
+        const int n = m_ring.submit(1);
+        if (n < 0 && n != -EINTR && n != -EBUSY) // EBUSY: completions backed up, reaped below
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ring.reap([this, &readyEvents](const io_uring_cqe& cqe) { complete(cqe, readyEvents); });
+        return true;
+    }
+
+    void release(const Event& event) override
+    {
+        if (event.buffer >= 0)
+            m_ring.recycleBuffer(static_cast<unsigned>(event.buffer));
+    }
+
+    static std::uint64_t userData(std::uint64_t token, Kind kind) { return (token << 2) | kind; }
+
+    io_uring_sqe* nextSqe()
+    {
+        auto* sqe = m_ring.getSqe();
+        if (sqe == nullptr && m_ring.submit(0) >= 0)
+            sqe = m_ring.getSqe();
+        return sqe;
+    }
+
+    static std::uint32_t pollEvents(std::uint32_t events)
+    {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        events = (events << 16) | (events >> 16); // poll32_events is stored as two swapped halves
+#endif
+        return events;
+    }
+
+    bool arm(std::uint64_t token)
+    {
+        auto it = m_entries.find(token);
+        if (it == m_entries.end())
+            return true; // removed in the meantime
+        auto& e = it->second;
+
+        if (!e.readArmed)
+        {
+            auto* sqe = nextSqe();
+            if (sqe == nullptr)
+                return false;
+            sqe->fd = e.fd;
+            if (e.receiveData)
+            {
+                sqe->opcode    = IORING_OP_RECV;
+                sqe->ioprio    = IORING_RECV_MULTISHOT;
+                sqe->flags     = IOSQE_BUFFER_SELECT;
+                sqe->buf_group = BufferGroup;
+                sqe->user_data = userData(token, Receive);
+            }
+            else
+            {
+                sqe->opcode        = IORING_OP_POLL_ADD;
+                sqe->poll32_events = pollEvents(POLLIN | POLLRDHUP);
+                sqe->user_data     = userData(token, PollIn);
+            }
+            e.readArmed = true;
+        }
+
+        if (e.writeInterest && !e.writeArmed)
+        {
+            auto* sqe = nextSqe();
+            if (sqe == nullptr)
+                return false;
+            sqe->opcode        = IORING_OP_POLL_ADD;
+            sqe->fd            = e.fd;
+            sqe->poll32_events = pollEvents(POLLOUT);
+            sqe->user_data     = userData(token, PollOut);
+            e.writeArmed = true;
+        }
+
+        return true;
+    }
+
+    void complete(const io_uring_cqe& cqe, std::vector<Event>& readyEvents)
+    {
+        const auto kind   = static_cast<Kind>(cqe.user_data & 3);
+        const auto token  = cqe.user_data >> 2;
+        const int  buffer = (cqe.flags & IORING_CQE_F_BUFFER) != 0
+                          ? static_cast<int>(cqe.flags >> IORING_CQE_BUFFER_SHIFT) : -1;
+        if (kind == Cancel)
+            return;
+
+        auto it = m_entries.find(token);
+        if (it == m_entries.end())
+        {
+            if (buffer >= 0)
+                m_ring.recycleBuffer(static_cast<unsigned>(buffer));
+            return; // request of a removed socket
+        }
+        auto& e = it->second;
+
+        switch (kind)
+        {
+            case PollIn:
+                e.readArmed = false;
+                m_rearm.push_back(token);
+                if (cqe.res != -ECANCELED)
+                    readyEvents.push_back({ token, true, false });
+                break;
+
+            case PollOut:
+                e.writeArmed = false;
+                if (e.writeInterest)
+                {
+                    m_rearm.push_back(token);
+                    if (cqe.res > 0)
+                        readyEvents.push_back({ token, (cqe.res & ~POLLOUT) != 0, (cqe.res & POLLOUT) != 0 });
+                }
+                break;
+
+            case Receive:
+            default:
+                if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+                {
+                    e.readArmed = false;
+                    m_rearm.push_back(token);
+                }
+
+                if (cqe.res > 0 && buffer >= 0)
+                {
+                    Event event{ token, false, false };
+                    event.received = true;
+                    event.data     = m_ring.getBuffer(static_cast<unsigned>(buffer));
+                    event.size     = static_cast<std::size_t>(cqe.res);
+                    event.buffer   = buffer;
+                    readyEvents.push_back(event);
+                    break;
+                }
+
+                if (buffer >= 0)
+                    m_ring.recycleBuffer(static_cast<unsigned>(buffer));
+
+                if (cqe.res == -ENOBUFS || cqe.res == -ECANCELED)
+                    break; // ring ran dry: re-armed once this batch's buffers are back
+                if (cqe.res == -EINVAL)
+                {
+                    e.receiveData = false; // no multishot receive (kernel < 6.0): read on readiness
+                    break;
+                }
+
+                // 0: closed by the peer, < 0: failed.
+                Event event{ token, false, false };
+                event.received = true;
+                readyEvents.push_back(event);
+                break;
+        }
+    }
+
+    NanoIoUring                                 m_ring;     // reactor thread only
+    bool                                        m_valid{ false };
+
+    std::mutex                                  m_mutex;
+    std::unordered_map<std::uint64_t, Entry>    m_entries;
+    std::vector<std::uint64_t>                  m_rearm;    // tokens with requests to (re)submit
+    std::vector<std::uint64_t>                  m_pending;  // reactor thread only
+    std::vector<std::uint64_t>                  m_cancel;   // user_data of requests to cancel
+};
+
+#endif
+
+
+// ── ReactorThread ─────────────────────────────────────────────────────────────
+
+struct NanoReactor::ReactorThread : public NanoThread
+{
+    explicit ReactorThread(NanoReactor& r)
+        : NanoThread("NanoReactor::ReactorThread"), owner(r) {}
+
+    ReactorThread(const ReactorThread&)            = delete;
+    ReactorThread& operator=(const ReactorThread&) = delete;
+
+    void run() override { owner.run(); }
+
+    NanoReactor& owner;
+};
+
+
+// ── Construction / destruction ────────────────────────────────────────────────
+
+NanoReactor::NanoReactor(ThreadPriority threadPriority, BackendType backendType)
+{
+#if defined(NANOOCP1_USE_IO_URING)
+    // Falls back to epoll if the kernel lacks io_uring or provided buffer rings,
+    // or io_uring is disabled (e.g. by a container's seccomp profile).
+    if (backendType != BackendType::Readiness)
+    {
+        m_backend = std::make_unique<IoUringBackend>();
+        if (!m_backend->isValid())
+            m_backend.reset();
+    }
+#else
+    (void)backendType;
+#endif
+    if (!m_backend)
+        m_backend = std::make_unique<ReadinessBackend>();
+    m_backend->setWakeupHandle(m_wakeup.getHandle());
+
+    m_thread = std::make_unique<ReactorThread>(*this);
+    m_thread->startThread(threadPriority);
+}
+
+NanoReactor::~NanoReactor()
+{
+    m_thread->signalThreadShouldExit();
+    m_wakeup.signal();
+    m_thread->stopThread(4000);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_registrations)
+        m_backend->remove(entry.second.fd, entry.second.token);
+    m_registrations.clear();
+    m_handlersByToken.clear();
+}
+
+
+// ── Registration ──────────────────────────────────────────────────────────────
+
+bool NanoReactor::addHandler(NanoSocketHandle fd, Handler* handler, bool receiveData)
+{
+    if (fd == invalidSocketHandle || handler == nullptr || !m_backend->isValid())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_registrations.count(handler) != 0)
+            return false;
+
+        const auto token = m_nextToken++;
+        if (!m_backend->add(fd, token, receiveData))
+            return false;
+
+        m_registrations[handler]  = Registration{ fd, token, false };
+        m_handlersByToken[token]  = handler;
+    }
+
+    if (m_backend->wakeOnChange())
+        m_wakeup.signal();
+
+    return true;
+}
+
+void NanoReactor::removeHandler(Handler* handler)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_registrations.find(handler);
+        if (it != m_registrations.end())
+        {
+            m_backend->remove(it->second.fd, it->second.token);
+            m_handlersByToken.erase(it->second.token);
+            m_registrations.erase(it);
+        }
+
+        // Events already collected by the reactor thread for this handler are
+        // dropped by the token lookup in run(); only an invocation that is in
+        // progress right now has to be waited out.
+        if (!isReactorThread())
+            m_handlerIdle.wait(lock, [this, handler]() { return m_currentHandler != handler; });
+    }
+
+    if (m_backend->wakeOnChange())
+        m_wakeup.signal();
+}
+
+bool NanoReactor::setWriteInterest(Handler* handler, bool enabled)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_registrations.find(handler);
+        if (it == m_registrations.end())
+            return false;
+        if (it->second.writeInterest == enabled)
+            return true;
+        if (!m_backend->modify(it->second.fd, it->second.token, enabled))
+            return false;
+        it->second.writeInterest = enabled;
+    }
+
+    if (m_backend->wakeOnChange() && !isReactorThread())
+        m_wakeup.signal();
+
+    return true;
+}
+
+std::size_t NanoReactor::getNumHandlers() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_registrations.size();
+}
+
+const char* NanoReactor::getBackendName() const noexcept
+{
+    return m_backend->getName();
+}
+
+bool NanoReactor::isReactorThread() const noexcept
+{
+    return std::this_thread::get_id() == m_threadId.load();
+}
+
+std::shared_ptr<NanoAsyncDispatcher> NanoReactor::getDispatcher()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_dispatcher)
+        m_dispatcher = std::make_shared<NanoAsyncDispatcher>();
+    return m_dispatcher;
+}
+
+
+// ── Event loop ────────────────────────────────────────────────────────────────
+
+void NanoReactor::run()
+{
+    m_threadId.store(std::this_thread::get_id());
+
+    std::vector<Event> readyEvents;
+    while (!m_thread->threadShouldExit())
+    {
+        readyEvents.clear();
+        if (!m_backend->wait(readyEvents))
+            break;
+
+        for (const auto& event : readyEvents)
+        {
+            if (event.token == 0)
+            {
+                m_wakeup.drain();
+                continue;
+            }
+
+            if (event.received)
+            {
+                if (auto* handler = beginHandler(event.token))
+                {
+                    handler->handleReceived(event.data, event.size);
+                    endHandler();
+                }
+                m_backend->release(event);
+                continue;
+            }
+
+            // Looked up again before each call: handleReadable() may have removed
+            // the handler (e.g. on connection loss).
+            if (event.readable)
+            {
+                if (auto* handler = beginHandler(event.token))
+                {
+                    handler->handleReadable();
+                    endHandler();
+                }
+            }
+            if (event.writable)
+            {
+                if (auto* handler = beginHandler(event.token))
+                {
+                    handler->handleWritable();
+                    endHandler();
+                }
+            }
+        }
+    }
+
+    m_threadId.store(std::thread::id{});
+}
+
+NanoReactor::Handler* NanoReactor::beginHandler(std::uint64_t token)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_handlersByToken.find(token);
+    if (it == m_handlersByToken.end())
+        return nullptr; // removed after the wait returned
+    m_currentHandler = it->second;
+    return m_currentHandler;
+}
+
+void NanoReactor::endHandler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_currentHandler = nullptr;
+    }
+    m_handlerIdle.notify_all();
+}
+
+} // namespace NanoOcp1
@@ -0,0 +1,214 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "NanoAsyncDispatcher.h"
+#include "NanoSocket.h"
+#include "NanoThread.h"
+#include "NanoWakeup.h"
+
+namespace NanoOcp1
+{
+
+/**
+ * @class NanoReactor
+ * @brief Single-thread readiness loop that services many sockets at once.
+ *
+ * Instead of one blocking read thread per `Ocp1Connection`, any number of
+ * connections can register their socket with a shared reactor.  The reactor
+ * thread sleeps in epoll_wait() (Linux), poll() (other POSIX) or WSAPoll()
+ * (Windows) with no timeout and calls the registered `Handler` only when its
+ * socket has become readable — or writable, while write interest is enabled via
+ * `setWriteInterest()` — so the thread count stays at one regardless of how many
+ * devices are connected.
+ *
+ * On Linux, a build with `NANOOCP1_USE_IO_URING` adds an io_uring backend: one
+ * `io_uring_enter()` submits and reaps the work of all sockets at once, and
+ * sockets registered with `receiveData` are read by the kernel itself — a
+ * multishot receive per socket fills buffers from a shared provided-buffer ring
+ * and `Handler::handleReceived()` gets the bytes, with no readiness round trip
+ * and no `recv()` call per wake-up.  It is used by default when available;
+ * otherwise, or with `BackendType::Readiness`, epoll is used.
+ *
+ * Handlers run on the reactor thread and must not block.  `removeHandler()`
+ * guarantees that, once it returns, the handler is not running and will not be
+ * called again — it may therefore be used to tear a connection down from any
+ * thread, including from inside the handler itself.
+ *
+ * The reactor must outlive every handler registered with it and must not be
+ * destroyed from one of its own handlers.
+ */
+class NanoReactor
+{
+public:
+    /**
+     * @brief Callback interface for a socket registered with the reactor.
+     */
+    class Handler
+    {
+    public:
+        virtual ~Handler() = default;
+
+        /**
+         * @brief Called on the reactor thread when the socket is readable, has
+         * been closed by the peer, or is in an error state.  Implementations
+         * must read without blocking (see `NanoSocket::readAvailable()`).
+         */
+        virtual void handleReadable() = 0;
+
+        /**
+         * @brief Called on the reactor thread when the socket has send buffer
+         * space, for as long as write interest is enabled.  Implementations
+         * must write without blocking (see `NanoSocket::writeGather()`).
+         */
+        virtual void handleWritable() {}
+
+        /**
+         * @brief Called on the reactor thread instead of `handleReadable()` for a
+         * socket registered with `receiveData`, if the backend receives on the
+         * handler's behalf (io_uring).  data holds size bytes already read from
+         * the socket and is valid only during the call; size 0 means the peer
+         * has closed the connection or it has failed.
+         */
+        virtual void handleReceived(const std::uint8_t* data, std::size_t size)
+        {
+            (void)data;
+            (void)size;
+        }
+    };
+
+    /** @brief Selects how the reactor waits for its sockets. */
+    enum class BackendType
+    {
+        Default,    ///< io_uring if built in and supported by the kernel, readiness otherwise.
+        Readiness,  ///< epoll_wait() / poll() / WSAPoll().
+        IoUring     ///< io_uring (Linux, `NANOOCP1_USE_IO_URING`); falls back to Readiness if unavailable.
+    };
+
+    /**
+     * @brief Creates the reactor and starts its I/O thread.
+     * @param threadPriority  OS priority of the I/O thread.
+     * @param backendType     See `BackendType`; `getBackendName()` tells which one is in use.
+     */
+    explicit NanoReactor(ThreadPriority threadPriority = ThreadPriority::normal,
+                         BackendType backendType = BackendType::Default);
+    ~NanoReactor();
+
+    NanoReactor(const NanoReactor&)            = delete;
+    NanoReactor& operator=(const NanoReactor&) = delete;
+
+    /**
+     * @brief Starts watching fd for readability on behalf of handler.
+     * The socket should already be in non-blocking mode.  A handler can be
+     * registered for one socket at a time.
+     * @param receiveData  Let a backend that can (io_uring) read the socket on
+     *                     the handler's behalf and deliver the bytes through
+     *                     `handleReceived()`; other backends call `handleReadable()`.
+     * @return False if the handler is already registered or the OS rejected fd.
+     */
+    bool addHandler(NanoSocketHandle fd, Handler* handler, bool receiveData = false);
+
+    /**
+     * @brief Stops watching the socket registered for handler.
+     * Blocks while the handler is running on the reactor thread (unless called
+     * from that thread).  Must be called before the registered socket is closed.
+     * No-op if handler is not registered.
+     */
+    void removeHandler(Handler* handler);
+
+    /**
+     * @brief Enables or disables `handleWritable()` calls for handler.
+     * Enable it only while there is data waiting to be sent: a socket with free
+     * send buffer space is writable almost all the time.  Safe to call from any
+     * thread, including from inside a handler.
+     * @return False if handler is not registered.
+     */
+    bool setWriteInterest(Handler* handler, bool enabled);
+
+    /** @brief Returns the number of currently registered handlers. */
+    std::size_t getNumHandlers() const;
+
+    /** @brief Returns the backend in use: "epoll", "poll", "WSAPoll" or "io_uring". */
+    const char* getBackendName() const noexcept;
+
+    /** @brief Returns true if called from the reactor's I/O thread. */
+    bool isReactorThread() const noexcept;
+
+    /**
+     * @brief Returns the callback dispatcher shared by all connections attached
+     * to this reactor, creating it on first use.  Sharing one worker keeps the
+     * thread count flat when connections use `callbacksOnMessageThread = true`.
+     */
+    std::shared_ptr<NanoAsyncDispatcher> getDispatcher();
+
+private:
+    struct Backend;
+    struct ReadinessBackend;
+    struct IoUringBackend;
+    struct ReactorThread;
+
+    struct Registration
+    {
+        NanoSocketHandle fd;
+        std::uint64_t    token; ///< Unique per registration so stale events are never misrouted.
+        bool             writeInterest;
+    };
+
+    /** A ready socket, or data received for it, as reported by the backend. */
+    struct Event
+    {
+        std::uint64_t       token;
+        bool                readable;
+        bool                writable;
+        bool                received{ false };  ///< data/size hold bytes for handleReceived().
+        const std::uint8_t* data{ nullptr };
+        std::size_t         size{ 0 };
+        int                 buffer{ -1 };       ///< Backend buffer holding data, see Backend::release().
+    };
+
+    Handler* beginHandler(std::uint64_t token);
+    void     endHandler();
+
+    void run();
+
+    mutable std::mutex                          m_mutex;
+    std::condition_variable                     m_handlerIdle;
+    std::unordered_map<Handler*, Registration>  m_registrations;
+    std::unordered_map<std::uint64_t, Handler*> m_handlersByToken;
+    std::uint64_t                               m_nextToken{1};  ///< 0 is reserved for the wakeup.
+    Handler*                                    m_currentHandler{nullptr};
+
+    NanoWakeup                                  m_wakeup;
+    std::unique_ptr<Backend>                    m_backend;
+    std::unique_ptr<ReactorThread>              m_thread;
+    std::atomic<std::thread::id>                m_threadId{};
+
+    std::shared_ptr<NanoAsyncDispatcher>        m_dispatcher;
+};
+
+} // namespace NanoOcp1
@@ -31,6 +31,10 @@
   // Windows select() ignores the nfds argument entirely; pass 0 to avoid
   // UINT_PTR → int truncation warnings on 64-bit builds.
   #define NANOSOCK_NFDS(fd)   0
+  #define NANOSOCK_POLL(fds, n, t) ::WSAPoll(fds, static_cast<ULONG>(n), t)
+  #define NANOSOCK_POLLIN     POLLRDNORM
+  #define NANOSOCK_POLLOUT    POLLWRNORM
+  using NANOSOCK_POLLFD = WSAPOLLFD;
 #else
   // POSIX (macOS, iOS, Linux, …)
   #include <arpa/inet.h>
@@ -39,15 +43,21 @@
   #include <netdb.h>
   #include <netinet/in.h>
   #include <netinet/tcp.h>
+  #include <poll.h>
   #include <sys/select.h>
   #include <sys/socket.h>
   #include <sys/types.h>
+  #include <sys/uio.h>
   #include <unistd.h>
   #define NANOSOCK_CLOSE(fd)  ::close(fd)
   #define NANOSOCK_ERRNO      errno
   #define NANOSOCK_WOULDBLOCK EAGAIN
   #define NANOSOCK_INPROGRESS EINPROGRESS
   #define NANOSOCK_NFDS(fd)   (static_cast<int>(fd) + 1)
+  #define NANOSOCK_POLL(fds, n, t) ::poll(fds, static_cast<nfds_t>(n), t)
+  #define NANOSOCK_POLLIN     POLLIN
+  #define NANOSOCK_POLLOUT    POLLOUT
+  using NANOSOCK_POLLFD = struct pollfd;
 #endif
 
 namespace NanoOcp1
@@ -82,26 +92,298 @@ NanoSocket::~NanoSocket()
 
 // ── Helpers ───────────────────────────────────────────────────────────────────
 
-bool NanoSocket::setNonBlocking(bool nonBlocking)
+namespace
+{
+
+bool setHandleNonBlocking(NanoSocketHandle fd, bool nonBlocking)
 {
 #if defined(_WIN32) || defined(_WIN64)
     u_long mode = nonBlocking ? 1u : 0u;
-    return ioctlsocket(m_fd, FIONBIO, &mode) == 0;
+    return ioctlsocket(fd, FIONBIO, &mode) == 0;
 #else
-    int flags = fcntl(m_fd, F_GETFL, 0);
+    int flags = fcntl(fd, F_GETFL, 0);
     if (flags < 0) return false;
     if (nonBlocking) flags |=  O_NONBLOCK;
     else             flags &= ~O_NONBLOCK;
-    return fcntl(m_fd, F_SETFL, flags) == 0;
+    return fcntl(fd, F_SETFL, flags) == 0;
+#endif
+}
+
+bool isWouldBlock(int err)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return err == NANOSOCK_WOULDBLOCK;
+#else
+    return err == NANOSOCK_WOULDBLOCK || err == EWOULDBLOCK || err == EINTR;
+#endif
+}
+
+int waitForHandleEvents(NanoSocketHandle fd, int events, int timeoutMs, NanoSocketHandle wakeHandle)
+{
+    // poll() rather than select(): no FD_SETSIZE limit on the descriptor value,
+    // which matters once a process holds hundreds of device connections.
+    NANOSOCK_POLLFD fds[2]{};
+    fds[0].fd     = fd;
+    fds[0].events = static_cast<short>(((events & NanoTransport::readEvent)  != 0 ? NANOSOCK_POLLIN  : 0)
+                                     | ((events & NanoTransport::writeEvent) != 0 ? NANOSOCK_POLLOUT : 0));
+    fds[1].fd     = wakeHandle;
+    fds[1].events = NANOSOCK_POLLIN;
+    const int numFds = (wakeHandle != invalidSocketHandle) ? 2 : 1;
+
+    int ret = NANOSOCK_POLL(fds, numFds, timeoutMs < 0 ? -1 : timeoutMs);
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (ret < 0 && errno == EINTR) return 0;
+#endif
+    if (ret < 0) return -1;
+
+    // Report the socket first: hang-up and error conditions surface on the next
+    // read/write, exactly like plain readiness.
+    const auto revents = fds[0].revents;
+    if (revents == 0) return 0;
+
+    int ready = 0;
+    if ((revents & NANOSOCK_POLLIN)  != 0) ready |= NanoTransport::readEvent;
+    if ((revents & NANOSOCK_POLLOUT) != 0) ready |= NanoTransport::writeEvent;
+    ready &= events;
+    return ready != 0 ? ready : events; // error / hang-up only
+}
+
+} // namespace
+
+bool NanoSocket::setNonBlocking(bool nonBlocking)
+{
+    return setHandleNonBlocking(m_fd, nonBlocking);
+}
+
+// ── Options ───────────────────────────────────────────────────────────────────
+
+namespace
+{
+
+bool setIntOption(NanoSocketHandle fd, int level, int name, int value)
+{
+    return ::setsockopt(fd, level, name, reinterpret_cast<const char*>(&value), sizeof(value)) == 0;
+}
+
+bool getIntOption(NanoSocketHandle fd, int level, int name, int& value)
+{
+    value = 0;
+    socklen_t length = sizeof(value);
+    return ::getsockopt(fd, level, name, reinterpret_cast<char*>(&value), &length) == 0;
+}
+
+int getFamily(NanoSocketHandle fd)
+{
+    struct sockaddr_storage local{};
+    socklen_t localLen = sizeof(local);
+    if (::getsockname(fd, reinterpret_cast<struct sockaddr*>(&local), &localLen) != 0)
+        return AF_UNSPEC;
+    return local.ss_family;
+}
+
+// The options that apply to UDP as well as TCP sockets.
+bool applyCommonOptions(NanoSocketHandle fd, const SocketOptions& o)
+{
+    bool ok = true;
+
+    // Buffer sizes must be set before connect() / listen() to affect the TCP
+    // window scale negotiated in the handshake.
+    if (o.receiveBufferSize > 0)
+        ok = setIntOption(fd, SOL_SOCKET, SO_RCVBUF, o.receiveBufferSize) && ok;
+    if (o.sendBufferSize > 0)
+        ok = setIntOption(fd, SOL_SOCKET, SO_SNDBUF, o.sendBufferSize) && ok;
+
+    if (o.dscp >= 0)
+    {
+        // DSCP occupies the upper six bits of the TOS / traffic class byte.
+        const int tos = (o.dscp & 0x3f) << 2;
+#if defined(IPV6_TCLASS)
+        if (getFamily(fd) == AF_INET6)
+            ok = setIntOption(fd, IPPROTO_IPV6, IPV6_TCLASS, tos) && ok;
+        else
+#endif
+            ok = setIntOption(fd, IPPROTO_IP, IP_TOS, tos) && ok;
+    }
+
+    if (o.busyPollMicros > 0)
+    {
+#if defined(SO_BUSY_POLL)
+        ok = setIntOption(fd, SOL_SOCKET, SO_BUSY_POLL, o.busyPollMicros) && ok;
+#else
+        ok = false;
+#endif
+    }
+
+    return ok;
+}
+
+void getCommonOptions(NanoSocketHandle fd, SocketOptions& applied)
+{
+    int value = 0;
+    if (getIntOption(fd, SOL_SOCKET, SO_RCVBUF, value))
+        applied.receiveBufferSize = value;
+    if (getIntOption(fd, SOL_SOCKET, SO_SNDBUF, value))
+        applied.sendBufferSize = value;
+
+#if defined(IPV6_TCLASS)
+    const bool tosRead = getFamily(fd) == AF_INET6
+                       ? getIntOption(fd, IPPROTO_IPV6, IPV6_TCLASS, value)
+                       : getIntOption(fd, IPPROTO_IP, IP_TOS, value);
+#else
+    const bool tosRead = getIntOption(fd, IPPROTO_IP, IP_TOS, value);
+#endif
+    if (tosRead)
+        applied.dscp = (value >> 2) & 0x3f;
+
+#if defined(SO_BUSY_POLL)
+    if (getIntOption(fd, SOL_SOCKET, SO_BUSY_POLL, value))
+        applied.busyPollMicros = value;
+#endif
+}
+
+} // namespace
+
+bool SocketOptions::operator==(const SocketOptions& other) const noexcept
+{
+    return noDelay == other.noDelay
+        && receiveBufferSize == other.receiveBufferSize
+        && sendBufferSize == other.sendBufferSize
+        && dscp == other.dscp
+        && quickAck == other.quickAck
+        && busyPollMicros == other.busyPollMicros
+        && keepAlive == other.keepAlive
+        && keepAliveIdleSecs == other.keepAliveIdleSecs
+        && keepAliveIntervalSecs == other.keepAliveIntervalSecs
+        && keepAliveCount == other.keepAliveCount;
+}
+
+bool NanoSocket::setOptions(const SocketOptions& options)
+{
+    m_options = options;
+    return m_fd == invalidSocketHandle || applyOptions();
+}
+
+bool NanoSocket::applyOptions()
+{
+    const auto& o = m_options;
+    bool ok = setIntOption(m_fd, IPPROTO_TCP, TCP_NODELAY, o.noDelay ? 1 : 0);
+    ok = applyCommonOptions(m_fd, o) && ok;
+
+    if (o.quickAck)
+    {
+#if defined(TCP_QUICKACK)
+        ok = setIntOption(m_fd, IPPROTO_TCP, TCP_QUICKACK, 1) && ok;
+#else
+        ok = false;
+#endif
+    }
+
+    if (o.keepAlive)
+    {
+        ok = setIntOption(m_fd, SOL_SOCKET, SO_KEEPALIVE, 1) && ok;
+#if defined(TCP_KEEPIDLE)
+        if (o.keepAliveIdleSecs > 0)
+            ok = setIntOption(m_fd, IPPROTO_TCP, TCP_KEEPIDLE, o.keepAliveIdleSecs) && ok;
+#elif defined(TCP_KEEPALIVE)
+        if (o.keepAliveIdleSecs > 0)
+            ok = setIntOption(m_fd, IPPROTO_TCP, TCP_KEEPALIVE, o.keepAliveIdleSecs) && ok;
+#endif
+#if defined(TCP_KEEPINTVL)
+        if (o.keepAliveIntervalSecs > 0)
+            ok = setIntOption(m_fd, IPPROTO_TCP, TCP_KEEPINTVL, o.keepAliveIntervalSecs) && ok;
+#endif
+#if defined(TCP_KEEPCNT)
+        if (o.keepAliveCount > 0)
+            ok = setIntOption(m_fd, IPPROTO_TCP, TCP_KEEPCNT, o.keepAliveCount) && ok;
+#endif
+    }
+
+    return ok;
+}
+
+void NanoSocket::rearmQuickAck()
+{
+#if defined(TCP_QUICKACK)
+    if (m_options.quickAck)
+        setIntOption(m_fd, IPPROTO_TCP, TCP_QUICKACK, 1);
+#endif
+}
+
+bool NanoSocket::getAppliedOptions(SocketOptions& applied) const
+{
+    if (m_fd == invalidSocketHandle)
+        return false;
+
+    applied = SocketOptions{};
+    int value = 0;
+
+    applied.noDelay = getIntOption(m_fd, IPPROTO_TCP, TCP_NODELAY, value) && value != 0;
+    getCommonOptions(m_fd, applied);
+
+    // The kernel's quick-ack state flips with the traffic; report whether it
+    // is being re-armed.
+#if defined(TCP_QUICKACK)
+    applied.quickAck = m_options.quickAck;
 #endif
+
+    applied.keepAlive = getIntOption(m_fd, SOL_SOCKET, SO_KEEPALIVE, value) && value != 0;
+#if defined(TCP_KEEPIDLE)
+    if (getIntOption(m_fd, IPPROTO_TCP, TCP_KEEPIDLE, value))
+        applied.keepAliveIdleSecs = value;
+#elif defined(TCP_KEEPALIVE)
+    if (getIntOption(m_fd, IPPROTO_TCP, TCP_KEEPALIVE, value))
+        applied.keepAliveIdleSecs = value;
+#endif
+#if defined(TCP_KEEPINTVL)
+    if (getIntOption(m_fd, IPPROTO_TCP, TCP_KEEPINTVL, value))
+        applied.keepAliveIntervalSecs = value;
+#endif
+#if defined(TCP_KEEPCNT)
+    if (getIntOption(m_fd, IPPROTO_TCP, TCP_KEEPCNT, value))
+        applied.keepAliveCount = value;
+#endif
+
+    return true;
 }
 
 // ── Client ────────────────────────────────────────────────────────────────────
 
+bool NanoSocket::Address::operator==(const Address& other) const noexcept
+{
+    return family == other.family && length == other.length
+        && std::memcmp(data, other.data, static_cast<std::size_t>(length)) == 0;
+}
+
 bool NanoSocket::connect(const std::string& hostName, int portNumber, int timeoutMs)
 {
     close();
 
+    std::vector<Address> addresses;
+    if (!resolve(hostName, portNumber, addresses))
+        return false;
+
+    for (const auto& address : addresses)
+    {
+        if (!beginConnect(address))
+            continue;
+
+        // Wait for write-readiness to confirm the connection attempt finished.
+        if (waitForEvents(writeEvent, timeoutMs, invalidSocketHandle) > 0 && finishConnect(hostName))
+        {
+            setNonBlocking(false); // Restore blocking mode.
+            return true;
+        }
+
+        close();
+    }
+
+    return false;
+}
+
+bool NanoSocket::resolve(const std::string& hostName, int portNumber, std::vector<Address>& addresses)
+{
+    platformInit();
+
     struct addrinfo hints{};
     hints.ai_family   = AF_UNSPEC;
     hints.ai_socktype = SOCK_STREAM;
@@ -112,74 +394,88 @@ bool NanoSocket::connect(const std::string& hostName, int portNumber, int timeou
     if (::getaddrinfo(hostName.c_str(), portStr.c_str(), &hints, &res) != 0 || res == nullptr)
         return false;
 
-    bool connected = false;
-    for (struct addrinfo* addr = res; addr != nullptr && !connected; addr = addr->ai_next)
+    std::vector<Address> preferred, other;
+    for (struct addrinfo* addr = res; addr != nullptr; addr = addr->ai_next)
     {
-        NanoSocketHandle fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-        if (fd == invalidSocketHandle)
+        if (addr->ai_addrlen > sizeof(Address::data))
             continue;
 
-        // Enable TCP_NODELAY to reduce latency for small OCP.1 frames.
-        int one = 1;
-        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY,
-                     reinterpret_cast<const char*>(&one), sizeof(one));
+        Address address;
+        address.family = addr->ai_family;
+        address.length = static_cast<int>(addr->ai_addrlen);
+        std::memcpy(address.data, addr->ai_addr, addr->ai_addrlen);
+        (address.family == res->ai_family ? preferred : other).push_back(address);
+    }
+    ::freeaddrinfo(res);
+
+    // Interleave the two families so that a broken one (typically IPv6 without
+    // a route) costs at most one attempt before the other is tried.
+    addresses.clear();
+    for (std::size_t i = 0; i < preferred.size() || i < other.size(); ++i)
+    {
+        if (i < preferred.size())
+            addresses.push_back(preferred[i]);
+        if (i < other.size())
+            addresses.push_back(other[i]);
+    }
+    return !addresses.empty();
+}
 
-        // Non-blocking connect for timeout support.
-        m_fd = fd;
-        setNonBlocking(true);
+bool NanoSocket::beginConnect(const Address& address, bool fastOpen)
+{
+    close();
 
-        int ret = ::connect(fd, addr->ai_addr, static_cast<int>(addr->ai_addrlen));
+    NanoSocketHandle fd = ::socket(address.family, SOCK_STREAM, IPPROTO_TCP);
+    if (fd == invalidSocketHandle)
+        return false;
+    m_fd = fd;
+
+    // Best effort: a rejected option (e.g. SO_BUSY_POLL without privileges)
+    // shows in getAppliedOptions() but does not prevent the connection.
+    applyOptions();
+
+#if defined(TCP_FASTOPEN_CONNECT)
+    if (fastOpen)
+        setIntOption(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, 1);
+#else
+    (void)fastOpen;
+#endif
+
+    if (!setNonBlocking(true))
+    {
+        close();
+        return false;
+    }
+
+    int ret = ::connect(fd, reinterpret_cast<const struct sockaddr*>(address.data), address.length);
 
 #if defined(_WIN32) || defined(_WIN64)
-        bool inProgress = (ret == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK);
+    bool inProgress = (ret == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK);
 #else
-        bool inProgress = (ret < 0 && errno == EINPROGRESS);
+    bool inProgress = (ret < 0 && errno == EINPROGRESS);
 #endif
 
-        if (ret == 0 || inProgress)
-        {
-            // Wait for write-readiness to confirm the connection attempt finished.
-            fd_set writeSet, exceptSet;
-            FD_ZERO(&writeSet);
-            FD_ZERO(&exceptSet);
-            FD_SET(fd, &writeSet);
-            FD_SET(fd, &exceptSet);
-
-            struct timeval tv;
-            tv.tv_sec  = timeoutMs / 1000;
-            tv.tv_usec = (timeoutMs % 1000) * 1000;
-
-            int sel = ::select(NANOSOCK_NFDS(fd),
-                               nullptr, &writeSet, &exceptSet,
-                               timeoutMs >= 0 ? &tv : nullptr);
-
-            if (sel > 0 && FD_ISSET(fd, &writeSet))
-            {
-                // Verify the connection actually succeeded.
-                int err = 0;
-                socklen_t errLen = sizeof(err);
-                ::getsockopt(fd, SOL_SOCKET, SO_ERROR,
-                             reinterpret_cast<char*>(&err), &errLen);
-                if (err == 0)
-                    connected = true;
-            }
-        }
+    if (ret == 0 || inProgress)
+        return true;
 
-        if (connected)
-        {
-            setNonBlocking(false); // Restore blocking mode.
-            m_hostName  = hostName;
-            m_connected = true;
-        }
-        else
-        {
-            NANOSOCK_CLOSE(fd);
-            m_fd = invalidSocketHandle;
-        }
-    }
+    close();
+    return false;
+}
 
-    ::freeaddrinfo(res);
-    return connected;
+bool NanoSocket::finishConnect(const std::string& hostName)
+{
+    if (m_fd == invalidSocketHandle)
+        return false;
+
+    // Verify the connection actually succeeded.
+    int err = 0;
+    socklen_t errLen = sizeof(err);
+    if (::getsockopt(m_fd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &errLen) != 0 || err != 0)
+        return false;
+
+    m_hostName  = hostName;
+    m_connected = true;
+    return true;
 }
 
 int NanoSocket::read(void* data, int num, bool blockUntilFull)
@@ -193,6 +489,8 @@ int NanoSocket::read(void* data, int num, bool blockUntilFull)
         int n = static_cast<int>(::recv(m_fd, buf, static_cast<size_t>(num), 0));
         if (n <= 0)
             m_connected = false; // 0 = peer closed gracefully, < 0 = socket error
+        else
+            rearmQuickAck();
         return n;
     }
 
@@ -209,9 +507,37 @@ int NanoSocket::read(void* data, int num, bool blockUntilFull)
         }
         total += n;
     }
+    rearmQuickAck();
     return total;
 }
 
+int NanoSocket::readAvailable(void* data, int num)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+
+    int n = static_cast<int>(
+        ::recv(m_fd, static_cast<char*>(data), static_cast<size_t>(num), 0));
+    if (n > 0)
+    {
+        rearmQuickAck();
+        return n;
+    }
+
+    if (n < 0)
+    {
+        const int err = NANOSOCK_ERRNO;
+#if defined(_WIN32) || defined(_WIN64)
+        if (err == NANOSOCK_WOULDBLOCK)
+#else
+        if (err == NANOSOCK_WOULDBLOCK || err == EWOULDBLOCK || err == EINTR)
+#endif
+            return 0; // nothing pending right now
+    }
+
+    m_connected = false; // 0 = peer closed gracefully, < 0 = socket error
+    return -1;
+}
+
 int NanoSocket::write(const void* data, int dataSize)
 {
     if (m_fd == invalidSocketHandle) return -1;
@@ -220,6 +546,70 @@ int NanoSocket::write(const void* data, int dataSize)
                static_cast<size_t>(dataSize), 0));
 }
 
+int NanoSocket::writeAvailable(const void* data, int dataSize)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+
+    int n = static_cast<int>(
+        ::send(m_fd, static_cast<const char*>(data),
+               static_cast<size_t>(dataSize), 0));
+    if (n >= 0)
+        return n;
+
+    const int err = NANOSOCK_ERRNO;
+#if defined(_WIN32) || defined(_WIN64)
+    if (err == NANOSOCK_WOULDBLOCK)
+#else
+    if (err == NANOSOCK_WOULDBLOCK || err == EWOULDBLOCK || err == EINTR)
+#endif
+        return 0; // send buffer full right now
+    return -1;
+}
+
+int NanoSocket::writeGather(const Buffer* buffers, int numBuffers)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+    if (numBuffers > maxGatherBuffers) numBuffers = maxGatherBuffers;
+    if (numBuffers <= 0) return 0;
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSABUF iov[maxGatherBuffers];
+    for (int i = 0; i < numBuffers; ++i)
+    {
+        iov[i].buf = const_cast<CHAR*>(static_cast<const CHAR*>(buffers[i].data));
+        iov[i].len = static_cast<ULONG>(buffers[i].size);
+    }
+
+    DWORD sent = 0;
+    if (::WSASend(m_fd, iov, static_cast<DWORD>(numBuffers), &sent, 0, nullptr, nullptr) == 0)
+        return static_cast<int>(sent);
+#else
+    struct iovec iov[maxGatherBuffers];
+    for (int i = 0; i < numBuffers; ++i)
+    {
+        iov[i].iov_base = const_cast<void*>(buffers[i].data);
+        iov[i].iov_len  = buffers[i].size;
+    }
+
+    struct msghdr msg{};
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(numBuffers);
+
+    int n = static_cast<int>(::sendmsg(m_fd, &msg, 0));
+    if (n >= 0)
+        return n;
+#endif
+
+    const int err = NANOSOCK_ERRNO;
+#if defined(_WIN32) || defined(_WIN64)
+    if (err == NANOSOCK_WOULDBLOCK)
+#else
+    if (err == NANOSOCK_WOULDBLOCK || err == EWOULDBLOCK || err == EINTR)
+#endif
+        return 0; // send buffer full right now
+    return -1;
+}
+
 // ── Common ────────────────────────────────────────────────────────────────────
 
 void NanoSocket::close()
@@ -243,24 +633,68 @@ std::string NanoSocket::getHostName() const
 }
 
 int NanoSocket::waitUntilReady(bool readyForReading, int timeoutMs) const
+{
+    return waitUntilReady(readyForReading, timeoutMs, invalidSocketHandle);
+}
+
+int NanoSocket::waitUntilReady(bool readyForReading, int timeoutMs, NanoSocketHandle wakeHandle) const
+{
+    const auto ready = waitForEvents(readyForReading ? readEvent : writeEvent, timeoutMs, wakeHandle);
+    return ready > 0 ? 1 : ready;
+}
+
+int NanoSocket::waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const
 {
     if (m_fd == invalidSocketHandle) return -1;
+    return waitForHandleEvents(m_fd, events, timeoutMs, wakeHandle);
+}
 
-    fd_set set;
-    FD_ZERO(&set);
-    FD_SET(m_fd, &set);
+int NanoSocket::waitForWritable(NanoSocket* const* sockets, int numSockets, int timeoutMs,
+                                NanoSocketHandle wakeHandle, bool* ready)
+{
+    std::vector<NANOSOCK_POLLFD> fds(static_cast<std::size_t>(numSockets) + 1);
+    for (int i = 0; i < numSockets; ++i)
+    {
+        fds[static_cast<std::size_t>(i)].fd     = sockets[i]->m_fd;
+        fds[static_cast<std::size_t>(i)].events = NANOSOCK_POLLOUT;
+        ready[i] = false;
+    }
+    fds.back().fd     = wakeHandle;
+    fds.back().events = NANOSOCK_POLLIN;
+    const auto numFds = numSockets + ((wakeHandle != invalidSocketHandle) ? 1 : 0);
 
-    struct timeval tv;
-    tv.tv_sec  = timeoutMs / 1000;
-    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    int ret = NANOSOCK_POLL(fds.data(), numFds, timeoutMs < 0 ? -1 : timeoutMs);
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (ret < 0 && errno == EINTR) return 0;
+#endif
+    if (ret < 0) return -1;
 
-    int ret = readyForReading
-        ? ::select(NANOSOCK_NFDS(m_fd), &set, nullptr, nullptr, &tv)
-        : ::select(NANOSOCK_NFDS(m_fd), nullptr, &set, nullptr, &tv);
+    // Any event counts: a failed connect reports an error rather than writability.
+    int numReady = 0;
+    for (int i = 0; i < numSockets; ++i)
+    {
+        ready[i] = fds[static_cast<std::size_t>(i)].revents != 0;
+        numReady += ready[i] ? 1 : 0;
+    }
+    return numReady;
+}
+
+int NanoSocket::waitForReadable(NanoSocketHandle handle, int timeoutMs, NanoSocketHandle wakeHandle)
+{
+    NANOSOCK_POLLFD fds[2]{};
+    fds[0].fd     = handle;
+    fds[0].events = NANOSOCK_POLLIN;
+    fds[1].fd     = wakeHandle;
+    fds[1].events = NANOSOCK_POLLIN;
+    const int numFds = (wakeHandle != invalidSocketHandle) ? 2 : 1;
 
+    int ret = NANOSOCK_POLL(fds, numFds, timeoutMs < 0 ? -1 : timeoutMs);
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (ret < 0 && errno == EINTR) return 0;
+#endif
     if (ret < 0) return -1;
-    if (ret == 0) return 0;
-    return 1;
+
+    return fds[0].revents != 0 ? 1 : 0;
 }
 
 // ── Server ────────────────────────────────────────────────────────────────────
@@ -275,6 +709,7 @@ bool NanoSocket::createListener(int portNumber, const std::string& bindAddress)
     int opt = 1;
     ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR,
                  reinterpret_cast<const char*>(&opt), sizeof(opt));
+    applyOptions(); // best effort, see beginConnect()
 
     struct sockaddr_in addr{};
     addr.sin_family = AF_INET;
@@ -319,19 +754,16 @@ bool NanoSocket::createListener(int portNumber, const std::string& bindAddress)
     return true;
 }
 
-NanoSocket* NanoSocket::waitForNextConnection() const
+NanoSocket* NanoSocket::waitForNextConnection(NanoSocketHandle wakeHandle) const
 {
     if (m_fd == invalidSocketHandle || !m_listener)
         return nullptr;
 
-    // Use a short select timeout so the caller's loop can check its exit flag.
-    fd_set readSet;
-    FD_ZERO(&readSet);
-    FD_SET(m_fd, &readSet);
-    struct timeval tv{0, 100000}; // 100 ms
-
-    int sel = ::select(NANOSOCK_NFDS(m_fd), &readSet, nullptr, nullptr, &tv);
-    if (sel <= 0) return nullptr; // timeout or error (e.g., socket was closed)
+    // Without a wake-up handle, use a short timeout so the caller's loop can
+    // check its exit flag.
+    const int timeoutMs = (wakeHandle != invalidSocketHandle) ? -1 : 100;
+    if (waitUntilReady(true, timeoutMs, wakeHandle) <= 0)
+        return nullptr; // timeout, wake-up or error (e.g., socket was closed)
 
     struct sockaddr_storage clientAddr{};
     socklen_t clientLen = sizeof(clientAddr);
@@ -361,6 +793,8 @@ NanoSocket* NanoSocket::waitForNextConnection() const
     sock->m_fd       = clientFd;
     sock->m_hostName = addrStr;
     sock->m_connected = true;
+    sock->m_options  = m_options;
+    sock->applyOptions(); // best effort, see beginConnect()
     return sock;
 }
 
@@ -369,4 +803,274 @@ int NanoSocket::getBoundPort() const
     return m_boundPort;
 }
 
+// ── NanoDatagramSocket ────────────────────────────────────────────────────────
+
+NanoDatagramSocket::NanoDatagramSocket()
+{
+    NanoSocket::platformInit();
+}
+
+NanoDatagramSocket::~NanoDatagramSocket()
+{
+    close();
+}
+
+bool NanoDatagramSocket::open(int family)
+{
+    m_fd = ::socket(family, SOCK_DGRAM, IPPROTO_UDP);
+    if (m_fd == invalidSocketHandle)
+        return false;
+
+    m_family = family;
+    applyOptions(); // best effort, see NanoSocket::beginConnect()
+    return true;
+}
+
+bool NanoDatagramSocket::bind(int portNumber, const std::string& bindAddress)
+{
+    close();
+
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(static_cast<unsigned short>(portNumber));
+    if (bindAddress.empty())
+        addr.sin_addr.s_addr = INADDR_ANY;
+    else if (::inet_pton(AF_INET, bindAddress.c_str(), &addr.sin_addr) != 1)
+        return false;
+
+    if (!open(AF_INET))
+        return false;
+
+    if (::bind(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool NanoDatagramSocket::connect(const std::string& hostName, int portNumber)
+{
+    struct addrinfo hints{};
+    hints.ai_family   = m_fd != invalidSocketHandle ? m_family : AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+
+    const std::string portStr = std::to_string(portNumber);
+    struct addrinfo* res = nullptr;
+    if (::getaddrinfo(hostName.c_str(), portStr.c_str(), &hints, &res) != 0 || res == nullptr)
+        return false;
+
+    // Connecting a datagram socket only records the peer, so the first address
+    // is as good as any: whether the device answers is up to the owner to find out.
+    bool connected = (m_fd != invalidSocketHandle || open(res->ai_family))
+                  && ::connect(m_fd, res->ai_addr, static_cast<socklen_t>(res->ai_addrlen)) == 0;
+    ::freeaddrinfo(res);
+
+    m_connected = connected;
+    if (connected)
+        m_hostName = hostName;
+    return connected;
+}
+
+int NanoDatagramSocket::waitForPeer(int timeoutMs, NanoSocketHandle wakeHandle)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+    if (m_connected) return 1;
+
+    const auto ready = waitForHandleEvents(m_fd, readEvent, timeoutMs, wakeHandle);
+    if (ready <= 0)
+        return ready;
+
+    // Peek, so the datagram that introduced the peer is still read as usual.
+    char probe = 0;
+    struct sockaddr_storage from{};
+    socklen_t fromLen = sizeof(from);
+    if (::recvfrom(m_fd, &probe, 1, MSG_PEEK, reinterpret_cast<struct sockaddr*>(&from), &fromLen) < 0)
+    {
+        const int err = NANOSOCK_ERRNO;
+#if defined(_WIN32) || defined(_WIN64)
+        if (isWouldBlock(err) || err == WSAEMSGSIZE)
+#else
+        if (isWouldBlock(err))
+#endif
+            return 0;
+        return -1;
+    }
+
+    if (::connect(m_fd, reinterpret_cast<struct sockaddr*>(&from), fromLen) != 0)
+        return -1;
+
+    char host[NI_MAXHOST] = {};
+    if (::getnameinfo(reinterpret_cast<struct sockaddr*>(&from), fromLen, host, sizeof(host),
+                      nullptr, 0, NI_NUMERICHOST) == 0)
+        m_hostName = host;
+    m_connected = true;
+    return 1;
+}
+
+int NanoDatagramSocket::readAvailable(void* data, int num)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+
+    for (;;)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        const int n = ::recv(m_fd, static_cast<char*>(data), num, 0);
+        if (n >= 0)
+            return n;
+        const int err = NANOSOCK_ERRNO;
+        if (err == WSAEMSGSIZE || err == WSAECONNRESET)
+            continue; // too large for data (discarded), or an ICMP port unreachable
+#else
+        struct iovec iov{ data, static_cast<size_t>(num) };
+        struct msghdr msg{};
+        msg.msg_iov    = &iov;
+        msg.msg_iovlen = 1;
+        const int n = static_cast<int>(::recvmsg(m_fd, &msg, 0));
+        if (n >= 0)
+        {
+            if ((msg.msg_flags & MSG_TRUNC) != 0)
+                continue; // too large for data: the rest of it is gone
+            return n;
+        }
+        const int err = NANOSOCK_ERRNO;
+        if (err == ECONNREFUSED)
+            continue; // an ICMP port unreachable: nobody listens at the peer (yet)
+#endif
+        if (isWouldBlock(err))
+            return 0;
+        return -1;
+    }
+}
+
+int NanoDatagramSocket::writeGather(const Buffer* buffers, int numBuffers)
+{
+    if (m_fd == invalidSocketHandle) return -1;
+    if (numBuffers > maxGatherBuffers) numBuffers = maxGatherBuffers;
+    if (numBuffers <= 0) return 0;
+
+    int total = 0;
+    int sent  = 0;
+#if defined(__linux__)
+    // One system call for a whole burst of datagrams.
+    struct iovec   iov[maxGatherBuffers];
+    struct mmsghdr msgs[maxGatherBuffers];
+    std::memset(msgs, 0, sizeof(struct mmsghdr) * static_cast<std::size_t>(numBuffers));
+    for (int i = 0; i < numBuffers; ++i)
+    {
+        iov[i].iov_base            = const_cast<void*>(buffers[i].data);
+        iov[i].iov_len             = buffers[i].size;
+        msgs[i].msg_hdr.msg_iov    = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (sent < numBuffers)
+    {
+        const int n = ::sendmmsg(m_fd, msgs + sent, static_cast<unsigned>(numBuffers - sent), 0);
+        if (n > 0)
+        {
+            for (int i = sent; i < sent + n; ++i)
+                total += static_cast<int>(buffers[i].size);
+            sent += n;
+            continue;
+        }
+#else
+    while (sent < numBuffers)
+    {
+        const int n = static_cast<int>(::send(m_fd, static_cast<const char*>(buffers[sent].data),
+                                              static_cast<int>(buffers[sent].size), 0));
+        if (n >= 0)
+        {
+            total += static_cast<int>(buffers[sent].size);
+            ++sent;
+            continue;
+        }
+#endif
+        const int err = NANOSOCK_ERRNO;
+#if defined(_WIN32) || defined(_WIN64)
+        if (err == WSAECONNRESET)
+#else
+        if (err == ECONNREFUSED)
+#endif
+        {
+            // Reported for an earlier datagram: this one is lost like any other.
+            total += static_cast<int>(buffers[sent].size);
+            ++sent;
+            continue;
+        }
+        if (isWouldBlock(err))
+            return total;
+        return sent > 0 ? total : -1;
+    }
+    return total;
+}
+
+int NanoDatagramSocket::waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const
+{
+    if (m_fd == invalidSocketHandle) return -1;
+    return waitForHandleEvents(m_fd, events, timeoutMs, wakeHandle);
+}
+
+void NanoDatagramSocket::close()
+{
+    if (m_fd != invalidSocketHandle)
+    {
+        NANOSOCK_CLOSE(m_fd);
+        m_fd = invalidSocketHandle;
+    }
+    m_connected = false;
+}
+
+bool NanoDatagramSocket::isConnected() const
+{
+    return m_connected && m_fd != invalidSocketHandle;
+}
+
+std::string NanoDatagramSocket::getHostName() const
+{
+    return m_hostName;
+}
+
+bool NanoDatagramSocket::setNonBlocking(bool nonBlocking)
+{
+    return setHandleNonBlocking(m_fd, nonBlocking);
+}
+
+bool NanoDatagramSocket::setOptions(const SocketOptions& options)
+{
+    m_options = options;
+    return m_fd == invalidSocketHandle || applyOptions();
+}
+
+bool NanoDatagramSocket::applyOptions()
+{
+    return applyCommonOptions(m_fd, m_options);
+}
+
+bool NanoDatagramSocket::getAppliedOptions(SocketOptions& applied) const
+{
+    if (m_fd == invalidSocketHandle)
+        return false;
+
+    applied = SocketOptions{};
+    applied.noDelay = false;
+    getCommonOptions(m_fd, applied);
+    return true;
+}
+
+int NanoDatagramSocket::getBoundPort() const
+{
+    if (m_fd == invalidSocketHandle)
+        return -1;
+
+    struct sockaddr_storage local{};
+    socklen_t localLen = sizeof(local);
+    if (::getsockname(m_fd, reinterpret_cast<struct sockaddr*>(&local), &localLen) != 0)
+        return -1;
+    if (local.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const struct sockaddr_in6*>(&local)->sin6_port);
+    return ntohs(reinterpret_cast<const struct sockaddr_in*>(&local)->sin_port);
+}
+
 } // namespace NanoOcp1
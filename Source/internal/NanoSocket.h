@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #if defined(_WIN32) || defined(_WIN64)
   #ifndef WIN32_LEAN_AND_MEAN
@@ -39,6 +41,120 @@
 namespace NanoOcp1
 {
 
+/**
+ * Per-socket tuning, see NanoSocket::setOptions().  Zero (or -1 for dscp)
+ * leaves the OS default in place.  Options the platform does not support are
+ * skipped; NanoSocket::getAppliedOptions() reports what actually took effect.
+ */
+struct SocketOptions
+{
+    bool noDelay{ true };             ///< TCP_NODELAY: send small OCP.1 frames at once.
+    int  receiveBufferSize{ 0 };      ///< SO_RCVBUF in bytes, e.g. for metering bursts.
+    int  sendBufferSize{ 0 };         ///< SO_SNDBUF in bytes.
+    int  dscp{ -1 };                  ///< DiffServ code point 0..63 (IP_TOS / IPV6_TCLASS), e.g. 46 (EF).
+    bool quickAck{ false };           ///< TCP_QUICKACK (Linux): acknowledge at once, re-armed after every read.
+    int  busyPollMicros{ 0 };         ///< SO_BUSY_POLL (Linux): spin on the NIC queue before sleeping.
+    bool keepAlive{ false };          ///< SO_KEEPALIVE: probe idle connections to detect dead peers.
+    int  keepAliveIdleSecs{ 0 };      ///< Idle time before the first probe (TCP_KEEPIDLE).
+    int  keepAliveIntervalSecs{ 0 };  ///< Time between probes (TCP_KEEPINTVL).
+    int  keepAliveCount{ 0 };         ///< Unanswered probes before the connection is dropped (TCP_KEEPCNT).
+
+    bool operator==(const SocketOptions& other) const noexcept;
+    bool operator!=(const SocketOptions& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * Byte stream an Ocp1Connection runs on: a TCP NanoSocket, or one end of an
+ * in-process NanoPipe.  Covers the non-blocking subset the connection uses
+ * once connected.  Reads are made by one thread (the read thread or reactor);
+ * writes may come from any thread, but never concurrently.
+ */
+class NanoTransport
+{
+public:
+    virtual ~NanoTransport() = default;
+
+    /** One contiguous piece of outgoing data for writeGather(). */
+    struct Buffer
+    {
+        const void* data;
+        std::size_t size;
+    };
+
+    /** Most buffers a single writeGather() call passes on. */
+    static constexpr int maxGatherBuffers = 1024;
+
+    /** Readiness flags for waitForEvents(). */
+    enum Event
+    {
+        readEvent  = 1,
+        writeEvent = 2
+    };
+
+    /**
+     * Non-blocking read of up to num bytes.  Returns bytes read, 0 if no data
+     * is available right now, -1 on graceful close or error.
+     */
+    virtual int readAvailable(void* data, int num) = 0;
+
+    /**
+     * Write numBuffers buffers back-to-back.  Returns bytes written (possibly
+     * fewer than the total, ending mid-buffer), 0 if nothing can be taken
+     * right now, -1 on error.
+     */
+    virtual int writeGather(const Buffer* buffers, int numBuffers) = 0;
+
+    /**
+     * Block until the transport is ready for any of events or wakeHandle (may
+     * be invalidSocketHandle) becomes readable.  Returns the ready events, 0 if
+     * timed out or woken, -1 on error.
+     */
+    virtual int waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const = 0;
+
+    /**
+     * Returns the handle to register with a NanoReactor.  For a socket it polls
+     * readable and writable as usual; for any other transport (see isSocket())
+     * it polls readable whenever there is something to do, reading or, after a
+     * writeGather() that could not take everything, writing.
+     */
+    virtual NanoSocketHandle getHandle() const noexcept = 0;
+
+    /** Returns true for an OS socket, which may be received from directly. */
+    virtual bool isSocket() const noexcept = 0;
+
+    /**
+     * Returns false for a datagram transport, whose reads return whole
+     * datagrams.  Such a transport is never received from directly (see
+     * NanoReactor::addHandler()), so that it sees every datagram it delivers.
+     */
+    virtual bool isStream() const noexcept { return true; }
+
+    /**
+     * Returns true if the next readAvailable() returns data already taken from
+     * the OS — e.g. the rest of a datagram that did not fit the last read —
+     * which no readiness notification will announce.
+     */
+    virtual bool hasBufferedData() const { return false; }
+
+    /** Close the transport; the peer sees a graceful close. */
+    virtual void close() = 0;
+
+    /** Returns true if the transport is open and connected. */
+    virtual bool isConnected() const = 0;
+
+    /** Returns the hostname / IP address of the remote peer. */
+    virtual std::string getHostName() const = 0;
+
+    /** Set the socket to non-blocking / blocking mode.  Returns true on success. */
+    virtual bool setNonBlocking(bool nonBlocking) = 0;
+
+    /** See NanoSocket::setOptions(); transports other than sockets ignore them. */
+    virtual bool setOptions(const SocketOptions& options) = 0;
+
+    /** See NanoSocket::getAppliedOptions(); false for transports other than sockets. */
+    virtual bool getAppliedOptions(SocketOptions& applied) const = 0;
+};
+
 /**
  * Minimal cross-platform TCP streaming socket that covers the juce::StreamingSocket
  * surface used by NanoOcp1: connect, read, write, close, createListener,
@@ -50,15 +166,25 @@ namespace NanoOcp1
  * calling close() from one thread while another thread is blocked in read() is
  * the intended and safe usage.
  */
-class NanoSocket
+class NanoSocket : public NanoTransport
 {
 public:
     NanoSocket();
-    ~NanoSocket();
+    ~NanoSocket() override;
 
     NanoSocket(const NanoSocket&)            = delete;
     NanoSocket& operator=(const NanoSocket&) = delete;
 
+    /** A resolved peer address: a copy of the sockaddr returned by getaddrinfo(). */
+    struct Address
+    {
+        int           family{ 0 };
+        int           length{ 0 };
+        unsigned char data[128]{}; // sizeof(sockaddr_storage)
+
+        bool operator==(const Address& other) const noexcept;
+    };
+
     // ── Client ────────────────────────────────────────────────────────────────
 
     /**
@@ -68,6 +194,31 @@ public:
      */
     bool connect(const std::string& hostName, int portNumber, int timeoutMs);
 
+    /**
+     * Resolve hostName:portNumber into TCP addresses, ordered for connecting
+     * (RFC 8305): address families alternate, starting with the family of the
+     * first address getaddrinfo returned.  Blocks for DNS unless hostName is
+     * an address literal.  Returns false if nothing was found.
+     */
+    static bool resolve(const std::string& hostName, int portNumber, std::vector<Address>& addresses);
+
+    /**
+     * Start a non-blocking connect to address and return without waiting.
+     * Wait for writeEvent (see waitForEvents() / waitForWritable()), then call
+     * finishConnect().  With fastOpen, TCP Fast Open is requested where the OS
+     * supports it (Linux): if a cookie from an earlier connection to the peer
+     * is cached, the socket is writable at once and the SYN leaves with the
+     * first data written.  Returns false if the attempt could not be started.
+     */
+    bool beginConnect(const Address& address, bool fastOpen = false);
+
+    /**
+     * Complete a connect started by beginConnect() once the socket has become
+     * writable (or reported an error).  The socket stays non-blocking.
+     * Returns true if connected; false if the attempt failed.
+     */
+    bool finishConnect(const std::string& hostName);
+
     /**
      * Read exactly num bytes into data when blockUntilFull=true (used by the
      * OCP.1 framing loop).  Returns bytes actually read, 0 on graceful close,
@@ -75,21 +226,72 @@ public:
      */
     int read(void* data, int num, bool blockUntilFull);
 
+    /**
+     * Non-blocking read of up to num bytes (the socket must be in non-blocking
+     * mode, see setNonBlocking()).  Returns bytes read, 0 if no data is
+     * available right now, -1 on graceful close or error.
+     */
+    int readAvailable(void* data, int num) override;
+
     /**
      * Write dataSize bytes from data.  Returns bytes written or -1 on error.
      */
     int write(const void* data, int dataSize);
 
+    /**
+     * Non-blocking write of up to dataSize bytes (the socket must be in
+     * non-blocking mode).  Returns bytes written, 0 if the send buffer is full
+     * right now, -1 on error.
+     */
+    int writeAvailable(const void* data, int dataSize);
+
+    /**
+     * Write numBuffers buffers back-to-back with a single sendmsg() / WSASend()
+     * call, so a burst of small messages leaves as a few full TCP segments.
+     * At most maxGatherBuffers buffers are passed per call.  Returns bytes
+     * written (possibly fewer than the total, ending mid-buffer), 0 if the send
+     * buffer is full right now (non-blocking mode), -1 on error.
+     */
+    int writeGather(const Buffer* buffers, int numBuffers) override;
+
     // ── Common ────────────────────────────────────────────────────────────────
 
     /** Close the underlying OS socket. Safe to call from any thread. */
-    void close();
+    void close() override;
 
     /** Returns true if the socket is open and connected. */
-    bool isConnected() const;
+    bool isConnected() const override;
+
+    /** Returns the OS socket handle, e.g. for registration with a NanoReactor. */
+    NanoSocketHandle getHandle() const noexcept override { return m_fd; }
+
+    bool isSocket() const noexcept override { return true; }
+
+    /**
+     * Set the options for sockets this object opens from now on (beginConnect(),
+     * createListener(); sockets accepted from a listener inherit them) and apply
+     * them to the open socket, if any.  Returns false if the socket is open and
+     * an option could not be applied.
+     */
+    bool setOptions(const SocketOptions& options) override;
+
+    /** Returns the options set with setOptions(). */
+    const SocketOptions& getOptions() const noexcept { return m_options; }
+
+    /**
+     * Query the options in effect on the open socket.  Values are as the OS
+     * reports them: Linux, for instance, reports twice the requested buffer
+     * sizes (bookkeeping overhead included) and caps them at the sysctl limits,
+     * and the keepalive timings are the system defaults unless set.
+     * Returns false if the socket is not open.
+     */
+    bool getAppliedOptions(SocketOptions& applied) const override;
+
+    /** Set the socket to non-blocking / blocking mode.  Returns true on success. */
+    bool setNonBlocking(bool nonBlocking) override;
 
     /** Returns the hostname / IP address of the remote peer. */
-    std::string getHostName() const;
+    std::string getHostName() const override;
 
     /**
      * Block until the socket is ready for reading (readyForReading=true) or
@@ -98,6 +300,39 @@ public:
      */
     int waitUntilReady(bool readyForReading, int timeoutMs) const;
 
+    /**
+     * As above, but also returns early once wakeHandle (see NanoWakeup) becomes
+     * readable, so a thread can block with timeoutMs=-1 and still be stopped
+     * promptly.  Returns: 1=socket ready, 0=timed out or woken, -1=error.
+     * The caller is responsible for draining wakeHandle.
+     */
+    int waitUntilReady(bool readyForReading, int timeoutMs, NanoSocketHandle wakeHandle) const;
+
+    /**
+     * Block until the socket is ready for any of events (readEvent and/or
+     * writeEvent) or wakeHandle (may be invalidSocketHandle) becomes readable.
+     * Returns the ready events — error and hang-up conditions report all
+     * requested events, so they surface on the next read/write — 0 if timed
+     * out or woken, -1 on error.
+     */
+    int waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const override;
+
+    /**
+     * Block until any of numSockets sockets is writable or failed (e.g. a
+     * pending connect has completed), or wakeHandle (may be invalidSocketHandle)
+     * becomes readable.  Sets ready[i] for every such socket.  Returns the number
+     * of ready sockets, 0 if timed out or woken, -1 on error.
+     */
+    static int waitForWritable(NanoSocket* const* sockets, int numSockets, int timeoutMs,
+                               NanoSocketHandle wakeHandle, bool* ready);
+
+    /**
+     * Block until handle (e.g. a NanoWakeup) or wakeHandle (may be
+     * invalidSocketHandle) becomes readable.  Returns 1 if handle is readable,
+     * 0 if timed out or woken, -1 on error.
+     */
+    static int waitForReadable(NanoSocketHandle handle, int timeoutMs, NanoSocketHandle wakeHandle);
+
     // ── Server ────────────────────────────────────────────────────────────────
 
     /**
@@ -107,11 +342,13 @@ public:
     bool createListener(int portNumber, const std::string& bindAddress = {});
 
     /**
-     * Block (with a short internal timeout) until a client connects.
+     * Block until a client connects.  Without a wakeHandle a short internal
+     * timeout applies; with one, the call blocks until a client connects or
+     * wakeHandle becomes readable (see NanoWakeup).
      * Returns a heap-allocated NanoSocket for the new connection, or nullptr
-     * on timeout / error.  The caller owns the returned pointer.
+     * on timeout / wake-up / error.  The caller owns the returned pointer.
      */
-    NanoSocket* waitForNextConnection() const;
+    NanoSocket* waitForNextConnection(NanoSocketHandle wakeHandle = invalidSocketHandle) const;
 
     /** Returns the local port the listener is bound to, or -1. */
     int getBoundPort() const;
@@ -122,12 +359,110 @@ private:
     bool             m_connected{false};
     bool             m_listener{false};
     int              m_boundPort{-1};
+    SocketOptions    m_options;
+
+    // Apply m_options to m_fd; false if any of them failed.
+    bool applyOptions();
+    // Re-arm TCP_QUICKACK, which Linux clears again after sending an ACK.
+    void rearmQuickAck();
 
     // Initialise platform networking (idempotent, Winsock on Windows).
     static void platformInit();
 
-    // Set m_fd to non-blocking / blocking mode.
-    bool setNonBlocking(bool nonBlocking);
+    friend class NanoDatagramSocket;
+};
+
+/**
+ * Minimal cross-platform UDP socket, connected to a single peer: every
+ * writeGather() buffer leaves as one datagram, and every readAvailable()
+ * returns one datagram.  Used for OCP.1 over UDP (see Ocp1DatagramTransport).
+ *
+ * A client calls connect() (optionally after bind()); a device-side socket
+ * calls bind() and then waitForPeer(), which connects it to whoever sends
+ * first.  Threading as for any NanoTransport; sending datagrams from several
+ * threads at once is safe as far as the OS is concerned.
+ */
+class NanoDatagramSocket : public NanoTransport
+{
+public:
+    /** Largest datagram readAvailable() returns (the UDP payload limit). */
+    static constexpr int maxDatagramSize = 65507;
+
+    NanoDatagramSocket();
+    ~NanoDatagramSocket() override;
+
+    NanoDatagramSocket(const NanoDatagramSocket&)            = delete;
+    NanoDatagramSocket& operator=(const NanoDatagramSocket&) = delete;
+
+    /**
+     * Open an IPv4 socket bound to portNumber (0 = any free port) on
+     * bindAddress (empty = all interfaces).  Returns true on success.
+     */
+    bool bind(int portNumber, const std::string& bindAddress = {});
+
+    /**
+     * Send to and receive from hostName:portNumber only.  Opens the socket if
+     * bind() was not called; otherwise only addresses of the bound family are
+     * considered.  Returns false if the host does not resolve.
+     */
+    bool connect(const std::string& hostName, int portNumber);
+
+    /**
+     * Block until a datagram arrives on a bound, unconnected socket and
+     * connect to its sender.  The datagram stays queued for readAvailable().
+     * Returns 1 if connected, 0 if timed out or woken by wakeHandle (may be
+     * invalidSocketHandle), -1 on error.
+     */
+    int waitForPeer(int timeoutMs, NanoSocketHandle wakeHandle = invalidSocketHandle);
+
+    /**
+     * Non-blocking read of one datagram.  Returns its size, 0 if none is
+     * pending right now — or it did not fit into num bytes and was discarded,
+     * or the peer's port was unreachable (ICMP) — -1 on error.
+     */
+    int readAvailable(void* data, int num) override;
+
+    /**
+     * Send each buffer as one datagram (sendmmsg() where available).  Returns
+     * the bytes of the datagrams sent, which always end on a buffer boundary,
+     * 0 if the send buffer is full right now, -1 on error.
+     */
+    int writeGather(const Buffer* buffers, int numBuffers) override;
+
+    /** See NanoSocket::waitForEvents(). */
+    int waitForEvents(int events, int timeoutMs, NanoSocketHandle wakeHandle) const override;
+
+    NanoSocketHandle getHandle() const noexcept override { return m_fd; }
+    bool isSocket() const noexcept override { return true; }
+    bool isStream() const noexcept override { return false; }
+
+    void close() override;
+
+    /** Returns true once the socket is connected to its peer. */
+    bool isConnected() const override;
+
+    /** Returns the hostname / IP address of the peer. */
+    std::string getHostName() const override;
+
+    bool setNonBlocking(bool nonBlocking) override;
+
+    /** Applies the buffer sizes, the DSCP marking and busy polling; TCP options are ignored. */
+    bool setOptions(const SocketOptions& options) override;
+
+    bool getAppliedOptions(SocketOptions& applied) const override;
+
+    /** Returns the local port the socket is bound to, or -1. */
+    int getBoundPort() const;
+
+private:
+    bool open(int family);
+    bool applyOptions();
+
+    NanoSocketHandle m_fd{invalidSocketHandle};
+    std::string      m_hostName;
+    bool             m_connected{false};
+    int              m_family{0};
+    SocketOptions    m_options;
 };
 
 } // namespace NanoOcp1
@@ -69,19 +69,17 @@ public:
         });
     }
 
-    void stopThread(int timeoutMs)
+    /**
+     * Sets the exit flag and joins the thread.  The join is unconditional, so
+     * run() must notice threadShouldExit() promptly: block on something the
+     * stopping thread can interrupt (see NanoWakeup) rather than polling with a
+     * timeout.  timeoutMs is kept for juce::Thread compatibility only.
+     */
+    void stopThread(int /*timeoutMs*/)
     {
         m_shouldExit.store(true);
-        if (!m_thread.joinable())
-            return;
-
-        // Poll until thread exits or timeout expires, then join unconditionally.
-        auto deadline = std::chrono::steady_clock::now()
-                      + std::chrono::milliseconds(timeoutMs);
-        while (m_running.load() && std::chrono::steady_clock::now() < deadline)
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
-
-        m_thread.join();
+        if (m_thread.joinable())
+            m_thread.join();
     }
 
     bool threadShouldExit() const noexcept { return m_shouldExit.load(); }
@@ -78,6 +78,12 @@ void NanoTimer::startTimer(int intervalMs)
     });
 }
 
+void NanoTimer::setTimerInterval(int intervalMs)
+{
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_intervalMs = intervalMs;
+}
+
 void NanoTimer::stopTimer()
 {
     std::lock_guard<std::mutex> lifecycleLock(m_lifecycleMutex);
@@ -52,6 +52,14 @@ public:
     void startTimer(int intervalMs);
     void stopTimer();
 
+    /**
+     * Change the interval from the tick after the next one on (or, called from
+     * timerCallback(), from the next one on) without restarting the timer.
+     * Takes no lifecycle lock, so unlike startTimer() it cannot deadlock
+     * against a concurrent stopTimer() when called from timerCallback().
+     */
+    void setTimerInterval(int intervalMs);
+
     virtual void timerCallback() = 0;
 
 protected:
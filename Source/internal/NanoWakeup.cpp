@@ -0,0 +1,145 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "NanoWakeup.h"
+
+#include <cstdint>
+
+#if defined(_WIN32) || defined(_WIN64)
+  // Windows – Winsock2 already included via NanoSocket.h
+#elif defined(__linux__)
+  #include <sys/eventfd.h>
+  #include <unistd.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace NanoOcp1
+{
+
+// ── Construction / destruction ────────────────────────────────────────────────
+
+NanoWakeup::NanoWakeup()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    // WSAPoll() only accepts sockets, so use a UDP socket connected to itself
+    // on the loopback interface: signal() sends a datagram to it, drain()
+    // receives whatever has queued up.
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+
+    SOCKET s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET)
+        return;
+
+    struct sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+    int addrLen          = sizeof(addr);
+
+    u_long nonBlocking = 1;
+    if (::bind(s, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::getsockname(s, reinterpret_cast<struct sockaddr*>(&addr), &addrLen) != 0
+        || ::connect(s, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0
+        || ioctlsocket(s, FIONBIO, &nonBlocking) != 0)
+    {
+        ::closesocket(s);
+        return;
+    }
+
+    m_readFd  = s;
+    m_writeFd = s;
+#elif defined(__linux__)
+    int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+        return;
+
+    m_readFd  = fd;
+    m_writeFd = fd;
+#else
+    int fds[2];
+    if (::pipe(fds) != 0)
+        return;
+
+    for (int fd : fds)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    m_readFd  = fds[0];
+    m_writeFd = fds[1];
+#endif
+}
+
+NanoWakeup::~NanoWakeup()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (m_readFd != invalidSocketHandle)
+        ::closesocket(m_readFd);
+    WSACleanup();
+#else
+    if (m_writeFd != invalidSocketHandle && m_writeFd != m_readFd)
+        ::close(m_writeFd);
+    if (m_readFd != invalidSocketHandle)
+        ::close(m_readFd);
+#endif
+}
+
+
+// ── Signal / drain ────────────────────────────────────────────────────────────
+
+void NanoWakeup::signal()
+{
+    if (m_writeFd == invalidSocketHandle)
+        return;
+
+    // A full pipe / saturated eventfd counter / dropped datagram all mean the
+    // handle is already readable, so a failed write needs no handling.
+#if defined(_WIN32) || defined(_WIN64)
+    const char b = 1;
+    (void)::send(m_writeFd, &b, 1, 0);
+#elif defined(__linux__)
+    const std::uint64_t one = 1;
+    (void)!::write(m_writeFd, &one, sizeof(one));
+#else
+    const char b = 1;
+    (void)!::write(m_writeFd, &b, 1);
+#endif
+}
+
+void NanoWakeup::drain()
+{
+    if (m_readFd == invalidSocketHandle)
+        return;
+
+#if defined(_WIN32) || defined(_WIN64)
+    char buf[64];
+    while (::recv(m_readFd, buf, sizeof(buf), 0) > 0) {}
+#elif defined(__linux__)
+    std::uint64_t count = 0;
+    (void)!::read(m_readFd, &count, sizeof(count)); // resets the counter to zero
+#else
+    char buf[64];
+    while (::read(m_readFd, buf, sizeof(buf)) > 0) {}
+#endif
+}
+
+} // namespace NanoOcp1
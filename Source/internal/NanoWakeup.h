@@ -0,0 +1,64 @@
+/* Copyright (c) 2026, Christian Ahrens
+ *
+ * This file is part of NanoOcp <https://github.com/ChristianAhrens/NanoOcp>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include "NanoSocket.h"
+
+namespace NanoOcp1
+{
+
+/**
+ * Pollable cross-thread wake-up event.
+ *
+ * Exposes a handle that becomes readable once signal() has been called, so a
+ * thread blocked in select()/poll()/epoll_wait() on its sockets can be woken
+ * without a timeout.  Backed by an eventfd on Linux, a non-blocking pipe on
+ * other POSIX systems and a connected loopback UDP socket on Windows (where
+ * only sockets can be polled).
+ *
+ * signal() is thread-safe and never blocks.  drain() resets the event and is
+ * meant to be called by the thread that waits on getHandle().
+ */
+class NanoWakeup
+{
+public:
+    NanoWakeup();
+    ~NanoWakeup();
+
+    NanoWakeup(const NanoWakeup&)            = delete;
+    NanoWakeup& operator=(const NanoWakeup&) = delete;
+
+    /** Returns true if the underlying OS objects were created successfully. */
+    bool isValid() const noexcept { return m_readFd != invalidSocketHandle; }
+
+    /** Makes getHandle() readable.  Multiple signals before a drain() coalesce. */
+    void signal();
+
+    /** Consumes all pending signals so getHandle() is no longer readable. */
+    void drain();
+
+    /** Returns the handle to wait on for readability. */
+    NanoSocketHandle getHandle() const noexcept { return m_readFd; }
+
+private:
+    NanoSocketHandle m_readFd{invalidSocketHandle};
+    NanoSocketHandle m_writeFd{invalidSocketHandle}; // same as m_readFd for eventfd
+};
+
+} // namespace NanoOcp1
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+
+#include "internal/NanoConnector.h"
+#include "internal/NanoReactor.h"
+#include "internal/NanoWakeup.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+std::unique_ptr<NanoSocket> acceptOne(const NanoSocket& listener)
+{
+    for (int i = 0; i < 20; ++i)
+        if (auto* s = listener.waitForNextConnection())
+            return std::unique_ptr<NanoSocket>(s);
+    return nullptr;
+}
+
+/** A port nothing listens on: bound once, then released. */
+int getClosedPort()
+{
+    NanoSocket listener;
+    if (!listener.createListener(0, "127.0.0.1"))
+        return -1;
+    return listener.getBoundPort();
+}
+
+} // namespace
+
+//==============================================================================
+// NanoSocket — resolution and non-blocking connect
+//==============================================================================
+
+TEST(NanoSocketTest, ResolveReturnsLiteralAddress)
+{
+    std::vector<NanoSocket::Address> addresses;
+    ASSERT_TRUE(NanoSocket::resolve("127.0.0.1", 50014, addresses));
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_GT(addresses[0].length, 0);
+
+    std::vector<NanoSocket::Address> again;
+    ASSERT_TRUE(NanoSocket::resolve("127.0.0.1", 50014, again));
+    EXPECT_TRUE(addresses[0] == again[0]);
+}
+
+TEST(NanoSocketTest, BeginConnectDoesNotWaitForHandshake)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    std::vector<NanoSocket::Address> addresses;
+    ASSERT_TRUE(NanoSocket::resolve("127.0.0.1", listener.getBoundPort(), addresses));
+
+    NanoSocket socket;
+    ASSERT_TRUE(socket.beginConnect(addresses[0]));
+    EXPECT_FALSE(socket.isConnected());
+
+    ASSERT_GT(socket.waitForEvents(NanoSocket::writeEvent, 1000, invalidSocketHandle), 0);
+    ASSERT_TRUE(socket.finishConnect("127.0.0.1"));
+    EXPECT_TRUE(socket.isConnected());
+    EXPECT_NE(acceptOne(listener), nullptr);
+}
+
+TEST(NanoSocketTest, OptionsApplyToConnectedAndAcceptedSockets)
+{
+    SocketOptions options;
+    options.receiveBufferSize     = 64 * 1024;
+    options.dscp                  = 46; // EF
+    options.keepAlive             = true;
+    options.keepAliveIdleSecs     = 10;
+    options.keepAliveIntervalSecs = 2;
+    options.keepAliveCount        = 3;
+    options.quickAck              = true;
+
+    NanoSocket listener;
+    EXPECT_TRUE(listener.setOptions(options)); // not open yet: only stored
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    NanoSocket socket;
+    SocketOptions applied;
+    EXPECT_FALSE(socket.getAppliedOptions(applied));
+    socket.setOptions(options);
+    ASSERT_TRUE(socket.connect("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+    EXPECT_EQ(peer->getOptions(), options);
+
+    for (const auto* s : { &socket, peer.get() })
+    {
+        ASSERT_TRUE(s->getAppliedOptions(applied));
+        EXPECT_TRUE(applied.noDelay);
+        EXPECT_GE(applied.receiveBufferSize, options.receiveBufferSize);
+        EXPECT_TRUE(applied.keepAlive);
+#if !defined(_WIN32) && !defined(_WIN64)
+        EXPECT_EQ(applied.dscp, 46);
+#endif
+#if defined(__linux__)
+        EXPECT_EQ(applied.keepAliveIdleSecs, 10);
+        EXPECT_EQ(applied.keepAliveIntervalSecs, 2);
+        EXPECT_EQ(applied.keepAliveCount, 3);
+        EXPECT_TRUE(applied.quickAck);
+#endif
+    }
+
+    // Changing options on an open socket applies them at once.
+    options.dscp    = 0;
+    options.noDelay = false;
+    EXPECT_TRUE(socket.setOptions(options));
+    ASSERT_TRUE(socket.getAppliedOptions(applied));
+    EXPECT_FALSE(applied.noDelay);
+#if !defined(_WIN32) && !defined(_WIN64)
+    EXPECT_EQ(applied.dscp, 0);
+#endif
+}
+
+//==============================================================================
+// NanoConnector
+//==============================================================================
+
+TEST(NanoConnectorTest, WaitConnectsToListener)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    NanoConnector connector;
+    ASSERT_TRUE(connector.start("127.0.0.1", listener.getBoundPort(), 1000, false));
+    EXPECT_EQ(connector.wait(invalidSocketHandle), NanoConnector::Status::Connected);
+
+    auto socket = connector.takeSocket();
+    ASSERT_NE(socket, nullptr);
+    EXPECT_TRUE(socket->isConnected());
+    EXPECT_EQ(connector.getStatus(), NanoConnector::Status::Idle);
+    EXPECT_NE(acceptOne(listener), nullptr);
+}
+
+TEST(NanoConnectorTest, WaitReportsRefusedConnect)
+{
+    const auto port = getClosedPort();
+    ASSERT_GT(port, 0);
+
+    NanoConnector connector;
+    ASSERT_TRUE(connector.start("127.0.0.1", port, 1000, false));
+    EXPECT_EQ(connector.wait(invalidSocketHandle), NanoConnector::Status::Failed);
+    EXPECT_EQ(connector.takeSocket(), nullptr);
+}
+
+TEST(NanoConnectorTest, WaitReturnsWhenWoken)
+{
+    // 192.0.2.0/24 is reserved for documentation: the SYN goes unanswered (or
+    // the network is unreachable, which fails at once).
+    NanoConnector connector;
+    if (!connector.start("192.0.2.1", 50014, 5000, false))
+        GTEST_SKIP() << "no route to the test network";
+
+    NanoWakeup wakeup;
+    ASSERT_TRUE(wakeup.isValid());
+    wakeup.signal();
+
+    const auto start  = std::chrono::steady_clock::now();
+    const auto status = connector.wait(wakeup.getHandle());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_NE(status, NanoConnector::Status::Connected);
+
+    connector.cancel();
+    EXPECT_EQ(connector.getStatus(), NanoConnector::Status::Idle);
+}
+
+TEST(NanoConnectorTest, StartFailsForUnresolvableHost)
+{
+    NanoConnector connector;
+    EXPECT_FALSE(connector.start("host.invalid", 50014, 1000, false));
+    EXPECT_EQ(connector.getStatus(), NanoConnector::Status::Failed);
+}
+
+TEST(NanoConnectorTest, ReactorReportsCompletionOnReactorThread)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    auto reactor = std::make_shared<NanoReactor>();
+    std::mutex                  mutex;
+    std::condition_variable     cv;
+    bool                        done = false;
+    bool                        onReactorThread = false;
+    std::unique_ptr<NanoSocket> socket;
+
+    NanoConnector* self = nullptr;
+    NanoConnector connector(reactor, [&](NanoConnector::Status status) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (status == NanoConnector::Status::Connected)
+            socket = self->takeSocket();
+        onReactorThread = reactor->isReactorThread();
+        done = true;
+        cv.notify_all();
+    });
+    self = &connector;
+
+    ASSERT_TRUE(connector.start("127.0.0.1", listener.getBoundPort(), 1000, false));
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return done; }));
+        EXPECT_TRUE(onReactorThread);
+        ASSERT_NE(socket, nullptr);
+        EXPECT_TRUE(socket->isConnected());
+    }
+
+    // The attempt's own registration is gone, so the socket can be handed on.
+    EXPECT_EQ(reactor->getNumHandlers(), 0u);
+    EXPECT_NE(acceptOne(listener), nullptr);
+}
+
+TEST(NanoConnectorTest, ReactorReportsRefusedConnect)
+{
+    const auto port = getClosedPort();
+    ASSERT_GT(port, 0);
+
+    auto reactor = std::make_shared<NanoReactor>();
+    std::mutex              mutex;
+    std::condition_variable cv;
+    auto                    result = NanoConnector::Status::Idle;
+
+    NanoConnector connector(reactor, [&](NanoConnector::Status status) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = status;
+        cv.notify_all();
+    });
+
+    ASSERT_TRUE(connector.start("127.0.0.1", port, 1000, false));
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return result != NanoConnector::Status::Idle; }));
+    EXPECT_EQ(result, NanoConnector::Status::Failed);
+    EXPECT_EQ(reactor->getNumHandlers(), 0u);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "internal/NanoPipe.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+std::vector<std::uint8_t> makePattern(std::size_t size, std::uint8_t seed)
+{
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i)
+        bytes[i] = static_cast<std::uint8_t>(seed + i * 7);
+    return bytes;
+}
+
+} // namespace
+
+//==============================================================================
+// NanoPipe — in-process byte stream
+//==============================================================================
+
+TEST(NanoPipeTest, GatherWritesArriveInOrderAcrossRingWrap)
+{
+    std::unique_ptr<NanoPipe> a, b;
+    ASSERT_TRUE(NanoPipe::createPair(a, b, 4096));
+    EXPECT_EQ(a->getCapacity(), 4096u);
+    EXPECT_FALSE(a->isSocket());
+    EXPECT_TRUE(a->isConnected());
+
+    // 3000 bytes per round, so the ring wraps at a different place every time.
+    for (std::uint8_t round = 0; round < 10; ++round)
+    {
+        const auto head = makePattern(1000, round);
+        const auto tail = makePattern(2000, static_cast<std::uint8_t>(round + 100));
+        const NanoTransport::Buffer buffers[] = { { head.data(), head.size() }, { tail.data(), tail.size() } };
+        ASSERT_EQ(a->writeGather(buffers, 2), 3000);
+
+        std::vector<std::uint8_t> received(3000);
+        ASSERT_EQ(b->readAvailable(received.data(), 3000), 3000);
+        EXPECT_TRUE(std::equal(head.begin(), head.end(), received.begin()));
+        EXPECT_TRUE(std::equal(tail.begin(), tail.end(), received.begin() + 1000));
+        EXPECT_EQ(b->readAvailable(received.data(), 3000), 0);
+    }
+}
+
+TEST(NanoPipeTest, HandleSignalsDataAndFreeSpace)
+{
+    std::unique_ptr<NanoPipe> a, b;
+    ASSERT_TRUE(NanoPipe::createPair(a, b, 4096));
+    EXPECT_EQ(NanoSocket::waitForReadable(b->getHandle(), 0, invalidSocketHandle), 0);
+
+    const auto bytes = makePattern(10000, 1);
+    const NanoTransport::Buffer buffer{ bytes.data(), bytes.size() };
+    ASSERT_EQ(a->writeGather(&buffer, 1), 4096); // only what fits
+    EXPECT_EQ(NanoSocket::waitForReadable(b->getHandle(), 0, invalidSocketHandle), 1);
+    EXPECT_EQ(a->waitForEvents(NanoTransport::writeEvent, 0, invalidSocketHandle), 0);
+
+    std::vector<std::uint8_t> received(1000);
+    ASSERT_EQ(b->readAvailable(received.data(), 1000), 1000);
+    EXPECT_EQ(NanoSocket::waitForReadable(a->getHandle(), 0, invalidSocketHandle), 1);
+    EXPECT_EQ(a->waitForEvents(NanoTransport::writeEvent, 1000, invalidSocketHandle), NanoTransport::writeEvent);
+
+    // Reading everything resets b's handle.
+    std::vector<std::uint8_t> rest(4096);
+    ASSERT_EQ(b->readAvailable(rest.data(), 4096), 3096);
+    EXPECT_EQ(NanoSocket::waitForReadable(b->getHandle(), 0, invalidSocketHandle), 0);
+}
+
+TEST(NanoPipeTest, CloseDeliversPendingBytesThenReportsClose)
+{
+    std::unique_ptr<NanoPipe> a, b;
+    ASSERT_TRUE(NanoPipe::createPair(a, b));
+
+    const auto bytes = makePattern(100, 3);
+    const NanoTransport::Buffer buffer{ bytes.data(), bytes.size() };
+    ASSERT_EQ(a->writeGather(&buffer, 1), 100);
+    a.reset();
+
+    EXPECT_FALSE(b->isConnected());
+    EXPECT_EQ(b->waitForEvents(NanoTransport::readEvent, 1000, invalidSocketHandle), NanoTransport::readEvent);
+
+    std::vector<std::uint8_t> received(200);
+    ASSERT_EQ(b->readAvailable(received.data(), 200), 100);
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), received.begin()));
+    EXPECT_EQ(b->readAvailable(received.data(), 200), -1);
+    EXPECT_EQ(b->writeGather(&buffer, 1), -1);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+
+#include "NanoOcp1.h"
+#include "Ocp1Message.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+/** Reactor-mode client that records every frame and connection event. */
+struct RecordingClient
+{
+    RecordingClient(int port, std::shared_ptr<NanoReactor> reactor)
+        : client("127.0.0.1", port, std::move(reactor), /*callbacksOnMessageThread=*/false)
+    {
+        client.onDataReceived = [this](const ByteVector& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.push_back(frame);
+            cv.notify_all();
+            return true;
+        };
+        client.onConnectionLost = [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            lost = true;
+            cv.notify_all();
+        };
+    }
+
+    ~RecordingClient() { client.stop(); }
+
+    bool waitForFrames(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return frames.size() >= count; });
+    }
+
+    bool waitForLost()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return lost; });
+    }
+
+    NanoOcp1Client          client;
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<ByteVector> frames;
+    bool                    lost = false;
+};
+
+std::unique_ptr<NanoSocket> acceptOne(const NanoSocket& listener)
+{
+    for (int i = 0; i < 20; ++i)
+        if (auto* s = listener.waitForNextConnection())
+            return std::unique_ptr<NanoSocket>(s);
+    return nullptr;
+}
+
+} // namespace
+
+//==============================================================================
+// NanoReactor — framing over a real loopback connection
+//==============================================================================
+
+TEST(NanoReactorTest, ReassemblesFramesSplitAndCoalescedAcrossReads)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    auto reactor = std::make_shared<NanoReactor>();
+    RecordingClient rc(listener.getBoundPort(), reactor);
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+    EXPECT_EQ(reactor->getNumHandlers(), 1u);
+
+    const auto first  = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    const auto second = Ocp1KeepAlive(static_cast<std::uint32_t>(1500)).GetSerializedData();
+
+    // First frame plus the head of the second in one write, the rest later.
+    ByteVector chunk(first);
+    chunk.insert(chunk.end(), second.begin(), second.begin() + 4);
+    ASSERT_EQ(peer->write(chunk.data(), static_cast<int>(chunk.size())), static_cast<int>(chunk.size()));
+    ASSERT_TRUE(rc.waitForFrames(1));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(peer->write(second.data() + 4, static_cast<int>(second.size() - 4)),
+              static_cast<int>(second.size() - 4));
+    ASSERT_TRUE(rc.waitForFrames(2));
+
+    std::lock_guard<std::mutex> lock(rc.mutex);
+    ASSERT_EQ(rc.frames.size(), 2u);
+    EXPECT_EQ(rc.frames[0], first);
+    EXPECT_EQ(rc.frames[1], second);
+}
+
+TEST(NanoReactorTest, ServesManyConnectionsFromOneReactor)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    auto reactor = std::make_shared<NanoReactor>();
+    std::vector<std::unique_ptr<RecordingClient>> clients;
+    std::vector<std::unique_ptr<NanoSocket>>      peers;
+    for (int i = 0; i < 8; ++i)
+    {
+        clients.push_back(std::make_unique<RecordingClient>(listener.getBoundPort(), reactor));
+        ASSERT_TRUE(clients.back()->client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+        peers.push_back(acceptOne(listener));
+        ASSERT_NE(peers.back(), nullptr);
+    }
+    EXPECT_EQ(reactor->getNumHandlers(), 8u);
+
+    const auto frame = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    for (auto& peer : peers)
+        ASSERT_EQ(peer->write(frame.data(), static_cast<int>(frame.size())), static_cast<int>(frame.size()));
+
+    for (auto& rc : clients)
+        EXPECT_TRUE(rc->waitForFrames(1));
+
+    clients.clear();
+    EXPECT_EQ(reactor->getNumHandlers(), 0u);
+}
+
+TEST(NanoReactorTest, PeerCloseReportsConnectionLost)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    auto reactor = std::make_shared<NanoReactor>();
+    RecordingClient rc(listener.getBoundPort(), reactor);
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+    peer->close();
+
+    EXPECT_TRUE(rc.waitForLost());
+    EXPECT_FALSE(rc.client.isConnected());
+    EXPECT_EQ(reactor->getNumHandlers(), 0u);
+}
+
+TEST(NanoReactorTest, MissingSyncByteDropsConnection)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    auto reactor = std::make_shared<NanoReactor>();
+    RecordingClient rc(listener.getBoundPort(), reactor);
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    auto garbage = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    garbage[0] = 0x00;
+    ASSERT_EQ(peer->write(garbage.data(), static_cast<int>(garbage.size())), static_cast<int>(garbage.size()));
+
+    EXPECT_TRUE(rc.waitForLost());
+    std::lock_guard<std::mutex> lock(rc.mutex);
+    EXPECT_TRUE(rc.frames.empty());
+}
+
+//==============================================================================
+// NanoReactor — backends
+//==============================================================================
+
+TEST(NanoReactorTest, EveryBackendDeliversFramesAndPeerClose)
+{
+    const NanoReactor::BackendType types[] = { NanoReactor::BackendType::Readiness,
+                                               NanoReactor::BackendType::IoUring };
+    for (const auto type : types)
+    {
+        NanoSocket listener;
+        ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+        auto reactor = std::make_shared<NanoReactor>(ThreadPriority::normal, type);
+        const std::string backend = reactor->getBackendName();
+        SCOPED_TRACE(backend);
+        if (type == NanoReactor::BackendType::Readiness)
+        {
+            EXPECT_NE(backend, "io_uring");
+        }
+
+        RecordingClient rc(listener.getBoundPort(), reactor);
+        ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+        auto peer = acceptOne(listener);
+        ASSERT_NE(peer, nullptr);
+
+        // Enough frames in one write to span several io_uring provided buffers.
+        const auto frame = Ocp1KeepAlive(static_cast<std::uint16_t>(3)).GetSerializedData();
+        ByteVector burst;
+        for (int i = 0; i < 4000; ++i)
+            burst.insert(burst.end(), frame.begin(), frame.end());
+        ASSERT_EQ(peer->write(burst.data(), static_cast<int>(burst.size())), static_cast<int>(burst.size()));
+        ASSERT_TRUE(rc.waitForFrames(4000));
+
+        peer->close();
+        EXPECT_TRUE(rc.waitForLost());
+        EXPECT_EQ(reactor->getNumHandlers(), 0u);
+
+        std::lock_guard<std::mutex> lock(rc.mutex);
+        EXPECT_EQ(rc.frames.size(), 4000u);
+        EXPECT_EQ(rc.frames.back(), frame);
+    }
+}
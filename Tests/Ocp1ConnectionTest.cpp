@@ -0,0 +1,1101 @@
+#include <gtest/gtest.h>
+
+#include "NanoOcp1.h"
+#include "Ocp1Controller.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+/** Thread-mode client that records every frame and connection event. */
+struct RecordingThreadClient
+{
+    RecordingThreadClient()
+        : client(/*callbacksOnMessageThread=*/false)
+    {
+        client.onDataReceived = [this](const ByteVector& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            frames.push_back(frame);
+            cv.notify_all();
+            return true;
+        };
+        client.onConnectionEstablished = [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++established;
+            cv.notify_all();
+        };
+        client.onConnectionLost = [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            lost = true;
+            cv.notify_all();
+        };
+    }
+
+    bool waitForEstablished(int count = 1)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return established >= count; });
+    }
+
+    bool waitForFrames(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return frames.size() >= count; });
+    }
+
+    bool waitForLost()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return lost; });
+    }
+
+    NanoOcp1Client          client;
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<ByteVector> frames;
+    bool                    lost = false;
+    int                     established = 0;
+};
+
+std::unique_ptr<NanoSocket> acceptOne(const NanoSocket& listener)
+{
+    for (int i = 0; i < 20; ++i)
+        if (auto* s = listener.waitForNextConnection())
+            return std::unique_ptr<NanoSocket>(s);
+    return nullptr;
+}
+
+/** Reads count OCP.1 frames from a peer socket, or fewer if it closes. */
+std::vector<ByteVector> readFrames(NanoSocket& peer, std::size_t count)
+{
+    std::vector<ByteVector> frames;
+    Ocp1FrameReader reader;
+    while (frames.size() < count)
+    {
+        auto n = peer.read(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()), false);
+        if (n <= 0)
+            break;
+        reader.commitWrite(static_cast<std::size_t>(n));
+
+        ByteSpan frame;
+        while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+            frames.emplace_back(frame.begin(), frame.end());
+    }
+    return frames;
+}
+
+/** Enough GetValue commands to span several flushes and gather-writes. */
+std::vector<ByteVector> makeCommandBurst()
+{
+    std::vector<ByteVector> burst;
+    for (std::uint32_t i = 0; i < 20000; ++i)
+    {
+        std::uint32_t handle{0};
+        burst.push_back(Ocp1CommandResponseRequired(
+            Ocp1CommandDefinition(0x10000000 + i, 0, 4, 1).GetValueCommand(), handle).GetSerializedData());
+    }
+    return burst;
+}
+
+void expectBatchArrivesInOrder(Ocp1Connection& connection, NanoSocket& peer)
+{
+    const auto burst = makeCommandBurst();
+
+    std::vector<ByteVector> received;
+    std::thread peerReader([&]() { received = readFrames(peer, burst.size()); });
+
+    Ocp1Connection::SendBatch batch(connection);
+    for (const auto& message : burst)
+        batch.add(message);
+    EXPECT_TRUE(batch.flush());
+    EXPECT_EQ(batch.getNumPending(), 0u);
+
+    peerReader.join();
+    EXPECT_EQ(received, burst);
+}
+
+/**
+ * Fills the send queue of a client whose peer does not read, checks that sending
+ * never blocks and that backpressure is signalled, then lets the peer read and
+ * checks that everything arrives in order and backpressure is lifted.
+ */
+void expectQueueAppliesBackpressure(NanoOcp1Client& client, NanoSocket& peer)
+{
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<bool>       transitions;
+    client.onSendBackpressureChanged = [&](bool backpressured) {
+        std::lock_guard<std::mutex> lock(mutex);
+        transitions.push_back(backpressured);
+        cv.notify_all();
+    };
+    client.setSendWaterMarks(16 * 1024, 64 * 1024);
+
+    // Far more than loopback socket buffers hold, so most of it has to queue.
+    std::vector<ByteVector> sent;
+    const ByteVector payload(1024, 0x5a);
+    for (std::uint32_t i = 0; i < 16 * 1024; ++i)
+        sent.push_back(Ocp1Notification(0x10000000 + i, 4, 1, 1, payload).GetSerializedData());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& message : sent)
+        ASSERT_TRUE(client.sendData(message));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2)); // never waited for the peer
+
+    EXPECT_TRUE(client.isSendBackpressured());
+    EXPECT_GT(client.getSendQueueSize(), 64u * 1024u);
+
+    const auto received = readFrames(peer, sent.size());
+    EXPECT_EQ(received, sent);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return transitions.size() >= 2; }));
+        EXPECT_EQ(transitions, (std::vector<bool>{ true, false }));
+    }
+    EXPECT_FALSE(client.isSendBackpressured());
+    EXPECT_EQ(client.getSendQueueSize(), 0u);
+
+    client.onSendBackpressureChanged = {};
+}
+
+/**
+ * Connects client to a NanoOcp1Server in-process, sends it a burst larger than
+ * the pipe holds, has the server answer, and checks that stopping the server
+ * is reported to the client as a lost connection.
+ */
+void expectInProcessRoundTrip(NanoOcp1Client& client)
+{
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<ByteVector> atServer;
+    std::size_t             atClient = 0;
+    bool                    lost     = false;
+
+    NanoOcp1Server server(/*callbacksOnMessageThread=*/false);
+    server.onDataReceived = [&](const ByteVector& frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        atServer.push_back(frame);
+        cv.notify_all();
+        return true;
+    };
+    client.onDataReceived = [&](const ByteVector&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++atClient;
+        cv.notify_all();
+        return true;
+    };
+    client.onConnectionLost = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        lost = true;
+        cv.notify_all();
+    };
+
+    ASSERT_TRUE(server.connectInProcess(client, 64 * 1024));
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_EQ(client.getConnectedHostName(), "in-process");
+
+    const auto burst = makeCommandBurst();
+    {
+        Ocp1Connection::SendBatch batch(client);
+        for (const auto& message : burst)
+            batch.add(message);
+        EXPECT_TRUE(batch.flush());
+    }
+
+    const auto reply = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    for (int i = 0; i < 100; ++i)
+        ASSERT_TRUE(server.sendData(reply));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]() { return atServer.size() >= burst.size(); }));
+        EXPECT_EQ(atServer, burst);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return atClient >= 100; }));
+    }
+
+    server.stop();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return lost; }));
+    }
+    EXPECT_FALSE(client.isConnected());
+
+    client.disconnect(1000, Ocp1Connection::Notify::no);
+    client.onDataReceived   = {};
+    client.onConnectionLost = {};
+}
+
+} // namespace
+
+//==============================================================================
+// Ocp1Connection — read thread over a real loopback connection
+//==============================================================================
+
+TEST(Ocp1ConnectionTest, ReadThreadDeliversCoalescedAndSplitFrames)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    const auto first  = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    const auto second = Ocp1KeepAlive(static_cast<std::uint32_t>(1500)).GetSerializedData();
+
+    ByteVector chunk(first);
+    chunk.insert(chunk.end(), second.begin(), second.begin() + 4);
+    ASSERT_EQ(peer->write(chunk.data(), static_cast<int>(chunk.size())), static_cast<int>(chunk.size()));
+    ASSERT_TRUE(rc.waitForFrames(1));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(peer->write(second.data() + 4, static_cast<int>(second.size() - 4)),
+              static_cast<int>(second.size() - 4));
+    ASSERT_TRUE(rc.waitForFrames(2));
+
+    {
+        std::lock_guard<std::mutex> lock(rc.mutex);
+        EXPECT_EQ(rc.frames[0], first);
+        EXPECT_EQ(rc.frames[1], second);
+    }
+
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+    EXPECT_FALSE(rc.client.isConnected());
+}
+
+TEST(Ocp1ConnectionTest, FrameReceivedDeliversWithoutCopy)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    // Callbacks on the dispatcher thread: the frames cross threads and are kept
+    // after the callback returns, while the read thread keeps receiving.
+    NanoOcp1Client client(/*callbacksOnMessageThread=*/true);
+    std::mutex                   mutex;
+    std::condition_variable      cv;
+    std::vector<Ocp1SharedFrame> frames;
+    bool                         copied = false;
+    client.onFrameReceived = [&](const Ocp1SharedFrame& frame) {
+        std::lock_guard<std::mutex> lock(mutex);
+        frames.push_back(frame);
+        cv.notify_all();
+        return true;
+    };
+    client.onDataReceived = [&](const ByteVector&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        copied = true;
+        return true;
+    };
+
+    ASSERT_TRUE(client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    constexpr std::uint32_t numFrames = 200;
+    std::vector<ByteVector> sent;
+    for (std::uint32_t i = 0; i < numFrames; ++i)
+    {
+        sent.push_back(Ocp1Notification(0x4000 + i, 4, 1, 1, DataFromFloat(static_cast<float>(i))).GetSerializedData());
+        ASSERT_EQ(peer->write(sent.back().data(), static_cast<int>(sent.back().size())),
+                  static_cast<int>(sent.back().size()));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return frames.size() >= numFrames; }));
+        EXPECT_FALSE(copied);
+        for (std::uint32_t i = 0; i < numFrames; ++i)
+        {
+            EXPECT_EQ(frames[i].toByteVector(), sent[i]);
+
+            Ocp1NotificationView view;
+            ASSERT_TRUE(Ocp1Message::ParseNotification(frames[i], view));
+            EXPECT_EQ(view.emitterOno, 0x4000 + i);
+        }
+    }
+
+    client.disconnect(1000, Ocp1Connection::Notify::no);
+}
+
+TEST(Ocp1ConnectionTest, IdleDisconnectDoesNotWaitForTraffic)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    auto peer = std::unique_ptr<NanoSocket>{};
+
+    // Repeated connect/disconnect cycles also exercise the wake-up being drained
+    // again before the read thread is restarted.
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+        peer = acceptOne(listener);
+        ASSERT_NE(peer, nullptr);
+        EXPECT_TRUE(rc.client.isConnected());
+
+        // The read thread is blocked with no timeout; disconnect() must wake it.
+        rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+        EXPECT_FALSE(rc.client.isConnected());
+    }
+
+    // The connection still works after all of that.
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+    const auto frame = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    ASSERT_EQ(peer->write(frame.data(), static_cast<int>(frame.size())), static_cast<int>(frame.size()));
+    EXPECT_TRUE(rc.waitForFrames(1));
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+}
+
+TEST(Ocp1ConnectionTest, PeerCloseReportsConnectionLost)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    peer->close();
+    EXPECT_TRUE(rc.waitForLost());
+    EXPECT_FALSE(rc.client.isConnected());
+}
+
+//==============================================================================
+// Ocp1Connection — asynchronous connect
+//==============================================================================
+
+namespace
+{
+
+void expectAsyncConnectDelivers(NanoOcp1Client& client, std::function<bool()> waitForEstablished,
+                                std::function<bool(std::size_t)> waitForFrames)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+    ASSERT_TRUE(client.connectToSocketAsync("127.0.0.1", listener.getBoundPort(), 1000));
+    ASSERT_TRUE(waitForEstablished());
+    EXPECT_TRUE(client.isConnected());
+
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+    const auto frame = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    ASSERT_EQ(peer->write(frame.data(), static_cast<int>(frame.size())), static_cast<int>(frame.size()));
+    EXPECT_TRUE(waitForFrames(1));
+}
+
+} // namespace
+
+TEST(Ocp1ConnectionTest, AsyncConnectCompletesOnReadThread)
+{
+    RecordingThreadClient rc;
+    expectAsyncConnectDelivers(rc.client,
+                               [&]() { return rc.waitForEstablished(); },
+                               [&](std::size_t n) { return rc.waitForFrames(n); });
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+    EXPECT_FALSE(rc.client.isConnected());
+    EXPECT_FALSE(rc.client.isConnecting());
+}
+
+TEST(Ocp1ConnectionTest, AsyncConnectCompletesOnReactor)
+{
+    NanoOcp1Client client("127.0.0.1", 0, std::make_shared<NanoReactor>(), /*callbacksOnMessageThread=*/false);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    established = false;
+    std::size_t             frames = 0;
+    client.onConnectionEstablished = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        established = true;
+        cv.notify_all();
+    };
+    client.onDataReceived = [&](const ByteVector&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++frames;
+        cv.notify_all();
+        return true;
+    };
+
+    expectAsyncConnectDelivers(client,
+        [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return established; });
+        },
+        [&](std::size_t n) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return frames >= n; });
+        });
+    client.stop();
+}
+
+TEST(Ocp1ConnectionTest, StartDoesNotBlockOnUnreachableHost)
+{
+    // 192.0.2.0/24 is reserved for documentation: a connect there either hangs
+    // until the timeout or fails at once; start() must return immediately either way.
+    NanoOcp1Client client("192.0.2.1", 50014, /*callbacksOnMessageThread=*/false);
+
+    const auto begin = std::chrono::steady_clock::now();
+    client.start();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(100));
+
+    const auto stopBegin = std::chrono::steady_clock::now();
+    client.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopBegin, std::chrono::milliseconds(200));
+    EXPECT_FALSE(client.isConnected());
+    EXPECT_FALSE(client.isConnecting());
+}
+
+TEST(Ocp1ConnectionTest, StartRetriesUntilDeviceAppears)
+{
+    // Reserve a port, release it, and only listen on it after start().
+    int port = -1;
+    {
+        NanoSocket probe;
+        ASSERT_TRUE(probe.createListener(0, "127.0.0.1"));
+        port = probe.getBoundPort();
+    }
+
+    RecordingThreadClient rc;
+    rc.client.setAddress("127.0.0.1");
+    rc.client.setPort(port);
+    rc.client.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(rc.client.isConnected());
+
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(port, "127.0.0.1"));
+    ASSERT_TRUE(rc.waitForEstablished());
+    EXPECT_NE(acceptOne(listener), nullptr);
+    rc.client.stop();
+}
+
+//==============================================================================
+// NanoOcp1Client — reconnect policy
+//==============================================================================
+
+namespace
+{
+
+/** Returns a loopback port nothing listens on, so connects are refused at once. */
+int getClosedPort()
+{
+    NanoSocket probe;
+    return probe.createListener(0, "127.0.0.1") ? probe.getBoundPort() : -1;
+}
+
+} // namespace
+
+TEST(NanoOcp1ClientTest, ReconnectBacksOffWhileDeviceIsDown)
+{
+    const auto port = getClosedPort();
+    ASSERT_GT(port, 0);
+
+    ReconnectPolicy policy;
+    policy.firstRetryMs      = 10;
+    policy.initialIntervalMs = 20;
+    policy.multiplier        = 2.0;
+    policy.maxIntervalMs     = 80;
+    policy.jitter            = 0.0;
+
+    NanoOcp1Client client("127.0.0.1", port, /*callbacksOnMessageThread=*/false);
+    client.setReconnectPolicy(policy);
+    client.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    // Delays 10, 20, 40, then 80 ms: about ten attempts, where a fixed 10 ms
+    // interval would have made sixty.
+    const auto stats = client.getConnectStats();
+    EXPECT_GE(stats.attempts, 4u);
+    EXPECT_LE(stats.attempts, 15u);
+    EXPECT_GE(stats.failures + 1, stats.attempts);
+    EXPECT_EQ(stats.connects, 0u);
+    EXPECT_EQ(client.getReconnectDelayMs(), 80);
+
+    client.stop();
+    EXPECT_EQ(client.getReconnectDelayMs(), 0);
+}
+
+TEST(NanoOcp1ClientTest, ReconnectJitterSpreadsClients)
+{
+    const auto port = getClosedPort();
+    ASSERT_GT(port, 0);
+
+    ReconnectPolicy policy;
+    policy.firstRetryMs = 1000;
+    policy.jitter       = 0.5;
+
+    std::vector<int> delays;
+    for (int i = 0; i < 20; ++i)
+    {
+        NanoOcp1Client client("127.0.0.1", port, /*callbacksOnMessageThread=*/false);
+        client.setReconnectPolicy(policy);
+        client.start();
+        delays.push_back(client.getReconnectDelayMs());
+        client.stop();
+    }
+
+    for (const auto delay : delays)
+    {
+        EXPECT_GE(delay, 500);
+        EXPECT_LE(delay, 1000);
+    }
+    EXPECT_NE(*std::min_element(delays.begin(), delays.end()), *std::max_element(delays.begin(), delays.end()));
+}
+
+TEST(NanoOcp1ClientTest, RecentlySeenDeviceKeepsFastInterval)
+{
+    ReconnectPolicy policy;
+    policy.firstRetryMs      = 10;
+    policy.initialIntervalMs = 20;
+    policy.maxIntervalMs     = 10000;
+    policy.jitter            = 0.0;
+    policy.recentlySeenMs    = 10000;
+
+    auto listener = std::make_unique<NanoSocket>();
+    ASSERT_TRUE(listener->createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    rc.client.setAddress("127.0.0.1");
+    rc.client.setPort(listener->getBoundPort());
+    rc.client.setReconnectPolicy(policy);
+    rc.client.start();
+    ASSERT_TRUE(rc.waitForEstablished());
+    EXPECT_EQ(rc.client.getReconnectDelayMs(), 0);
+    EXPECT_EQ(rc.client.getConnectStats().connects, 1u);
+
+    // The device goes away: without the fast path the interval would have
+    // grown to seconds by now.
+    auto peer = acceptOne(*listener);
+    listener.reset();
+    peer.reset();
+    ASSERT_TRUE(rc.waitForLost());
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(rc.client.getReconnectDelayMs(), 20);
+    EXPECT_GT(rc.client.getConnectStats().failures, 3u);
+
+    rc.client.stop();
+}
+
+TEST(Ocp1ConnectionTest, FastOpenReconnectStillDelivers)
+{
+    NanoConnector::clearResolveCache();
+
+    RecordingThreadClient rc;
+    rc.client.setFastOpenEnabled(true);
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    // The first connect records the good address, the second may use fast open.
+    for (int i = 1; i <= 2; ++i)
+    {
+        ASSERT_TRUE(rc.client.connectToSocketAsync("127.0.0.1", listener.getBoundPort(), 1000));
+        ASSERT_TRUE(rc.waitForEstablished(i));
+
+        const auto command = Ocp1KeepAlive(static_cast<std::uint16_t>(i)).GetSerializedData();
+        ASSERT_TRUE(rc.client.sendData(command));
+
+        auto peer = acceptOne(listener);
+        ASSERT_NE(peer, nullptr);
+        const auto received = readFrames(*peer, 1);
+        ASSERT_EQ(received.size(), 1u);
+        EXPECT_EQ(received[0], command);
+
+        ASSERT_EQ(peer->write(command.data(), static_cast<int>(command.size())), static_cast<int>(command.size()));
+        EXPECT_TRUE(rc.waitForFrames(static_cast<std::size_t>(i)));
+        rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+    }
+}
+
+TEST(Ocp1ConnectionTest, SocketOptionsReachClientAndServerSockets)
+{
+    SocketOptions options;
+    options.dscp      = 34; // AF41
+    options.keepAlive = true;
+
+    NanoOcp1Server server("127.0.0.1", 0, /*callbacksOnMessageThread=*/false);
+    server.setSocketOptions(options);
+    ASSERT_TRUE(server.start());
+
+    RecordingThreadClient rc;
+    rc.client.setSocketOptions(options);
+    EXPECT_EQ(rc.client.getSocketOptions(), options);
+    ASSERT_TRUE(rc.client.connectToSocketAsync("127.0.0.1", server.getBoundPort(), 1000));
+    ASSERT_TRUE(rc.waitForEstablished());
+
+    SocketOptions applied;
+    ASSERT_TRUE(rc.client.getAppliedSocketOptions(applied));
+    EXPECT_TRUE(applied.keepAlive);
+#if !defined(_WIN32) && !defined(_WIN64)
+    EXPECT_EQ(applied.dscp, 34);
+#endif
+
+    bool accepted = false;
+    for (int i = 0; i < 200 && !accepted; ++i)
+    {
+        accepted = server.getAppliedSocketOptions(applied);
+        if (!accepted)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(accepted);
+    EXPECT_TRUE(applied.keepAlive);
+#if !defined(_WIN32) && !defined(_WIN64)
+    EXPECT_EQ(applied.dscp, 34);
+#endif
+
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+    EXPECT_FALSE(rc.client.getAppliedSocketOptions(applied));
+    server.stop();
+    server.Ocp1ConnectionServer::stop();
+}
+
+//==============================================================================
+// Ocp1Connection::SendBatch — gather-writes over a real loopback connection
+//==============================================================================
+
+TEST(Ocp1ConnectionTest, SendBatchDeliversLargeBurstInOrder)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    expectBatchArrivesInOrder(rc.client, *peer);
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+}
+
+TEST(Ocp1ConnectionTest, SendBatchResumesShortWritesInReactorMode)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    // Non-blocking socket: the burst is far larger than a default send buffer, so
+    // gather-writes end mid-message and have to be resumed.
+    NanoOcp1Client client("127.0.0.1", listener.getBoundPort(),
+                          std::make_shared<NanoReactor>(), /*callbacksOnMessageThread=*/false);
+    ASSERT_TRUE(client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    expectBatchArrivesInOrder(client, *peer);
+    client.stop();
+}
+
+TEST(Ocp1ConnectionTest, SendBatchReportsFailureWhenNotConnected)
+{
+    RecordingThreadClient rc;
+    Ocp1Connection::SendBatch batch(rc.client);
+    batch.add(Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData());
+    EXPECT_FALSE(batch.flush());
+    EXPECT_EQ(batch.getNumPending(), 0u);
+}
+
+//==============================================================================
+// Ocp1Connection — outbound queue
+//==============================================================================
+
+TEST(Ocp1ConnectionTest, SendQueueAppliesBackpressureInThreadMode)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    expectQueueAppliesBackpressure(rc.client, *peer);
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+}
+
+TEST(Ocp1ConnectionTest, SendQueueAppliesBackpressureInReactorMode)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    NanoOcp1Client client("127.0.0.1", listener.getBoundPort(),
+                          std::make_shared<NanoReactor>(), /*callbacksOnMessageThread=*/false);
+    ASSERT_TRUE(client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    expectQueueAppliesBackpressure(client, *peer);
+    client.stop();
+}
+
+TEST(Ocp1ConnectionTest, DisconnectDiscardsSendQueue)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    RecordingThreadClient rc;
+    ASSERT_TRUE(rc.client.connectToSocket("127.0.0.1", listener.getBoundPort(), 1000));
+    auto peer = acceptOne(listener);
+    ASSERT_NE(peer, nullptr);
+
+    const auto message = Ocp1Notification(0x10000001, 4, 1, 1, ByteVector(64 * 1024, 0)).GetSerializedData();
+    while (rc.client.getSendQueueSize() == 0)
+        ASSERT_TRUE(rc.client.sendData(message));
+
+    rc.client.disconnect(1000, Ocp1Connection::Notify::no);
+    EXPECT_EQ(rc.client.getSendQueueSize(), 0u);
+    EXPECT_FALSE(rc.client.isSendBackpressured());
+    EXPECT_FALSE(rc.client.sendData(message));
+}
+
+//==============================================================================
+// Ocp1Connection — in-process transport
+//==============================================================================
+
+TEST(Ocp1ConnectionTest, InProcessConnectionExchangesFramesInThreadMode)
+{
+    NanoOcp1Client client(/*callbacksOnMessageThread=*/false);
+    expectInProcessRoundTrip(client);
+}
+
+TEST(Ocp1ConnectionTest, InProcessConnectionExchangesFramesInReactorMode)
+{
+    NanoOcp1Client client("", 0, std::make_shared<NanoReactor>(), /*callbacksOnMessageThread=*/false);
+    expectInProcessRoundTrip(client);
+}
+
+//==============================================================================
+// Ocp1Controller — multi-message PDUs
+//==============================================================================
+
+TEST(Ocp1ControllerTest, PacksInitialSyncIntoMultiMessagePdus)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    constexpr int numObjects = 10;
+    Ocp1Controller controller(/*callbacksOnMessageThread=*/false);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    int                     values = 0;
+    for (std::uint32_t out = 1; out <= numObjects; ++out)
+        controller.trackObject(std::make_unique<DS100::dbOcaObjectDef_MatrixNode_Gain>(1, out),
+                               [&](const ByteVector&) {
+                                   std::lock_guard<std::mutex> lock(mutex);
+                                   ++values;
+                                   cv.notify_all();
+                               });
+    controller.onStateChanged = [&](Ocp1Controller::State) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    };
+    controller.setMessagesPerPdu(4);
+    controller.connect("127.0.0.1", listener.getBoundPort());
+
+    std::unique_ptr<NanoSocket> device;
+    for (int i = 0; i < 20 && !device; ++i)
+        device.reset(listener.waitForNextConnection());
+    ASSERT_TRUE(device);
+
+    // Answers each command PDU with one PDU holding all its responses.
+    std::vector<std::uint16_t> commandsPerPdu;
+    std::thread deviceThread([&]() {
+        Ocp1FrameReader reader;
+        while (true)
+        {
+            const auto n = device->read(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()), false);
+            if (n <= 0)
+                return;
+            reader.commitWrite(static_cast<std::size_t>(n));
+
+            ByteSpan frame;
+            while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+            {
+                Ocp1PduReader pdu(frame);
+                if (pdu.GetMessageType() != Ocp1Message::CommandResponseRequired)
+                    continue;
+                commandsPerPdu.push_back(pdu.GetMessageCount());
+
+                Ocp1PduBuilder responses(Ocp1Message::Response);
+                ByteSpan command;
+                while (pdu.Next(command))
+                {
+                    // Command layout: size, handle, target ONo, ...  AddSubscription targets ONo 4.
+                    const auto handle = ReadUint32(command.data() + 4);
+                    auto response = ReadUint32(command.data() + 8) == 4 ? Ocp1Response(handle, 0, 0, {})
+                                                                        : Ocp1Response(handle, 0, 1, DataFromFloat(-6.0f));
+                    responses.Add(response);
+                }
+                const auto reply = responses.GetSerializedData();
+                if (device->write(reply.data(), static_cast<int>(reply.size())) <= 0)
+                    return;
+            }
+        }
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() {
+            return controller.getState() == Ocp1Controller::State::Connected && values == numObjects;
+        }));
+    }
+
+    controller.disconnect();
+    deviceThread.join();
+
+    // Subscriptions, then GetValues, four commands per PDU.
+    EXPECT_EQ(commandsPerPdu, (std::vector<std::uint16_t>{ 4, 4, 2, 4, 4, 2 }));
+}
+
+TEST(Ocp1ControllerTest, FireAndForgetSetValuesGetNoResponse)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+
+    Ocp1Controller controller(/*callbacksOnMessageThread=*/false);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    controller.onStateChanged = [&](Ocp1Controller::State) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    };
+    controller.connect("127.0.0.1", listener.getBoundPort());
+
+    std::unique_ptr<NanoSocket> device;
+    for (int i = 0; i < 20 && !device; ++i)
+        device.reset(listener.waitForNextConnection());
+    ASSERT_TRUE(device);
+
+    // Records the type of every command and answers those that require it.
+    std::vector<std::uint8_t> commandTypes;
+    std::thread deviceThread([&]() {
+        Ocp1FrameReader reader;
+        while (true)
+        {
+            const auto n = device->read(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()), false);
+            if (n <= 0)
+                return;
+            reader.commitWrite(static_cast<std::size_t>(n));
+
+            ByteSpan frame;
+            while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+            {
+                Ocp1CommandView command;
+                if (!Ocp1Message::ParseCommand(frame, command))
+                    continue;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    commandTypes.push_back(frame[7]);
+                    cv.notify_all();
+                }
+                if (command.responseRequired)
+                {
+                    const auto reply = Ocp1Response(command.handle, 0, 0, {}).GetSerializedData();
+                    if (device->write(reply.data(), static_cast<int>(reply.size())) <= 0)
+                        return;
+                }
+            }
+        }
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() {
+            return controller.getState() == Ocp1Controller::State::Connected;
+        }));
+    }
+
+    const DS100::dbOcaObjectDef_MatrixNode_Gain def(1, 1);
+    EXPECT_EQ(controller.getSetValueMode(), Ocp1Controller::SetValueMode::Acknowledged);
+    controller.setSetValueMode(Ocp1Controller::SetValueMode::FireAndForget);
+    EXPECT_TRUE(controller.setValue(def, Variant(-3.0f)));
+    EXPECT_TRUE(controller.setValue(Ocp1PreparedCommand::SetValue(def, Ocp1Message::Command), Variant(-4.0f)));
+    controller.setSetValueMode(Ocp1Controller::SetValueMode::Acknowledged);
+    EXPECT_TRUE(controller.setValue(def, Variant(-5.0f)));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return commandTypes.size() == 3; }));
+        EXPECT_EQ(commandTypes, (std::vector<std::uint8_t>{ Ocp1Message::Command, Ocp1Message::Command,
+                                                            Ocp1Message::CommandResponseRequired }));
+    }
+
+    controller.disconnect();
+    deviceThread.join();
+}
+
+TEST(Ocp1ControllerTest, CompactNotificationsAreNegotiatedWithServer)
+{
+    for (const bool compact : { false, true })
+    {
+        NanoOcp1Server server("127.0.0.1", 0, /*callbacksOnMessageThread=*/false);
+        std::mutex              mutex;
+        std::condition_variable cv;
+        std::vector<std::uint16_t> subscribeMethods;
+        std::vector<ByteVector>    values;
+
+        // Answers every command; GetValues with -6 dB.
+        server.onDataReceived = [&](const ByteVector& frame) {
+            Ocp1CommandView command;
+            if (!Ocp1Message::ParseCommand(frame, command))
+                return false;
+            const bool isGet = command.targetOno != 0x00000004;
+            if (!isGet)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                subscribeMethods.push_back(command.methodIndex);
+            }
+            return server.sendData(isGet ? Ocp1Response(command.handle, 0, 1, DataFromFloat(-6.0f)).GetSerializedData()
+                                         : Ocp1Response(command.handle, 0, 0, {}).GetSerializedData());
+        };
+        ASSERT_TRUE(server.start());
+
+        const DS100::dbOcaObjectDef_MatrixNode_Gain def(1, 1);
+        Ocp1Controller controller(/*callbacksOnMessageThread=*/false);
+        controller.setCompactNotifications(compact);
+        controller.trackObjectView(std::make_unique<DS100::dbOcaObjectDef_MatrixNode_Gain>(def), [&](ByteSpan data) {
+            std::lock_guard<std::mutex> lock(mutex);
+            values.emplace_back(data.begin(), data.end());
+            cv.notify_all();
+        });
+        controller.onStateChanged = [&](Ocp1Controller::State) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+        };
+        controller.connect("127.0.0.1", server.getBoundPort());
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() {
+                return controller.getState() == Ocp1Controller::State::Connected && values.size() == 1;
+            }));
+            EXPECT_EQ(subscribeMethods, (std::vector<std::uint16_t>{ static_cast<std::uint16_t>(compact ? 8 : 1) }));
+        }
+
+        // The server picked the format from the subscription; the controller reads either.
+        EXPECT_EQ(server.usesCompactNotifications(), compact);
+        EXPECT_TRUE(server.sendNotification(Ocp1Notification(def.m_targetOno, def.m_propertyDefLevel, def.m_propertyIndex,
+                                                             static_cast<std::uint8_t>(1), DataFromFloat(-42.0f))));
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return values.size() == 2; }));
+            ASSERT_EQ(values.size(), 2u);
+            EXPECT_EQ(values[1], DataFromFloat(-42.0f));
+        }
+
+        controller.disconnect();
+        server.stop();
+        server.Ocp1ConnectionServer::stop();
+    }
+}
+
+TEST(Ocp1ControllerTest, TypedPropertiesDecodeAndSetWithoutVariant)
+{
+    NanoOcp1Server server("127.0.0.1", 0, /*callbacksOnMessageThread=*/false);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<ByteVector>   setValues;
+    std::vector<std::uint8_t> setValueTypes;
+
+    // Answers GetValues with value, minimum and maximum, as for an OcaGain.
+    server.onDataReceived = [&](const ByteVector& frame) {
+        Ocp1CommandView command;
+        if (!Ocp1Message::ParseCommand(frame, command))
+            return false;
+        ByteVector reply;
+        if (command.methodIndex == 2 && command.targetOno != 0x00000004)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            setValues.emplace_back(command.parameterData.begin(), command.parameterData.end());
+            setValueTypes.push_back(frame[7]);
+            cv.notify_all();
+        }
+        else if (command.targetOno != 0x00000004)
+        {
+            for (const float value : { -6.0f, -120.0f, 10.0f })
+            {
+                const auto bytes = DataFromFloat(value);
+                reply.insert(reply.end(), bytes.begin(), bytes.end());
+            }
+        }
+        if (!command.responseRequired)
+            return true;
+        return server.sendData(Ocp1Response(command.handle, 0, reply.empty() ? 0 : 3, reply).GetSerializedData());
+    };
+    ASSERT_TRUE(server.start());
+
+    const Ocp1Property<float> gain(DS100::dbOcaObjectDef_MatrixInput_Gain(1));
+    std::vector<float> gains;
+    Ocp1Controller controller(/*callbacksOnMessageThread=*/false);
+    controller.trackObject(gain, [&](const float& dB) {
+        std::lock_guard<std::mutex> lock(mutex);
+        gains.push_back(dB);
+        cv.notify_all();
+    });
+    controller.onStateChanged = [&](Ocp1Controller::State) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    };
+    controller.connect("127.0.0.1", server.getBoundPort());
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() {
+            return controller.getState() == Ocp1Controller::State::Connected && !gains.empty();
+        }));
+        EXPECT_EQ(gains.front(), -6.0f);
+    }
+
+    const Ocp1Property<Position3> position(DS100::dbOcaObjectDef_Positioning_Source_Position(1));
+    EXPECT_TRUE(controller.setValue(gain, -3.0f));
+    controller.setSetValueMode(Ocp1Controller::SetValueMode::FireAndForget);
+    EXPECT_TRUE(controller.setValue(position, { 0.25f, 0.5f, 0.0f }));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return setValues.size() == 2; }));
+        EXPECT_EQ(setValues, (std::vector<ByteVector>{ DataFromFloat(-3.0f), DataFromPosition(0.25f, 0.5f, 0.0f) }));
+        EXPECT_EQ(setValueTypes, (std::vector<std::uint8_t>{ Ocp1Message::CommandResponseRequired, Ocp1Message::Command }));
+    }
+
+    controller.disconnect();
+    server.stop();
+    server.Ocp1ConnectionServer::stop();
+}
+
+//==============================================================================
+// NanoOcp1Server — accept loop
+//==============================================================================
+
+TEST(NanoOcp1ServerTest, RestartsAndAcceptsAfterStop)
+{
+    NanoOcp1Server server("127.0.0.1", 0, /*callbacksOnMessageThread=*/false);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(server.start());
+        const auto port = server.getBoundPort();
+        ASSERT_GT(port, 0);
+
+        NanoSocket s;
+        EXPECT_TRUE(s.connect("127.0.0.1", port, 1000));
+        s.close();
+
+        // The accept thread is blocked with no timeout; stop() must wake it.
+        server.Ocp1ConnectionServer::stop();
+        EXPECT_EQ(server.getBoundPort(), -1);
+    }
+}
@@ -2,6 +2,10 @@
 
 #include "Ocp1DataTypes.h"
 
+#include <functional>
+#include <limits>
+#include <vector>
+
 using namespace NanoOcp1;
 
 //==============================================================================
@@ -28,7 +32,7 @@ TEST(Ocp1DataTypesTest, BoolInsufficientDataFails)
 }
 
 //==============================================================================
-// Int32 / Uint8 / Uint16 / Uint32 / Uint64
+// Int8 / Int16 / Int32 / Int64 / Uint8 / Uint16 / Uint32 / Uint64
 //==============================================================================
 
 TEST(Ocp1DataTypesTest, Int32RoundTripAndLayout)
@@ -114,6 +118,157 @@ TEST(Ocp1DataTypesTest, Uint64RoundTripAndLayout)
     EXPECT_FALSE(ok);
 }
 
+TEST(Ocp1DataTypesTest, SignedIntegersRoundTrip)
+{
+    bool ok = false;
+    EXPECT_EQ(DataFromInt8(-2), (ByteVector{ 0xFE }));
+    EXPECT_EQ(DataToInt8(DataFromInt8(-128), &ok), -128);
+    EXPECT_TRUE(ok);
+
+    EXPECT_EQ(DataFromInt16(-2), (ByteVector{ 0xFF, 0xFE }));
+    EXPECT_EQ(DataToInt16(DataFromInt16(-32768), &ok), -32768);
+    EXPECT_TRUE(ok);
+
+    EXPECT_EQ(DataFromInt64(-2), (ByteVector{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE }));
+    EXPECT_EQ(DataToInt64(DataFromInt64(std::numeric_limits<std::int64_t>::min()), &ok),
+              std::numeric_limits<std::int64_t>::min());
+    EXPECT_TRUE(ok);
+
+    DataToInt16(ByteVector{ 0x01 }, &ok);
+    EXPECT_FALSE(ok);
+    DataToInt64(DataFromInt32(1), &ok);
+    EXPECT_FALSE(ok);
+}
+
+//==============================================================================
+// WriteUint16 / WriteUint32 / ByteAppender
+//==============================================================================
+
+TEST(Ocp1DataTypesTest, WriteUintIsBigEndianAndMatchesRead)
+{
+    std::uint8_t buffer[6] = {};
+    WriteUint32(buffer + 1, 0x12345678);
+    EXPECT_EQ(buffer[1], 0x12);
+    EXPECT_EQ(buffer[4], 0x78);
+    EXPECT_EQ(ReadUint32(buffer + 1), 0x12345678u);
+
+    WriteUint16(buffer + 3, 0xabcd);
+    EXPECT_EQ(buffer[3], 0xab);
+    EXPECT_EQ(buffer[4], 0xcd);
+    EXPECT_EQ(ReadUint16(buffer + 3), 0xabcd);
+    EXPECT_EQ(buffer[0], 0);
+    EXPECT_EQ(buffer[5], 0);
+}
+
+TEST(Ocp1DataTypesTest, ByteAppenderMatchesDataFromHelpers)
+{
+    std::uint8_t buffer[16] = {};
+    ByteAppender out(buffer, sizeof(buffer));
+    out.appendUint8(0x3b);
+    out.appendUint16(0x0102);
+    out.appendUint32(0xdeadbeef);
+    const auto blob = DataFromFloat(-6.0f);
+    out.appendBytes(blob);
+    EXPECT_FALSE(out.overflowed());
+    ASSERT_EQ(out.size(), 11u);
+
+    ByteVector expected{ 0x3b };
+    for (const auto& part : { DataFromUint16(0x0102), DataFromUint32(0xdeadbeef), blob })
+        expected.insert(expected.end(), part.begin(), part.end());
+    EXPECT_EQ(ByteVector(buffer, buffer + out.size()), expected);
+}
+
+TEST(Ocp1DataTypesTest, ByteAppenderStopsAtCapacity)
+{
+    std::uint8_t buffer[8] = {};
+    ByteAppender out(buffer, 5);
+    out.appendUint32(0x01020304);
+    out.appendUint16(0x0506); // does not fit
+    out.appendUint8(0x07);    // would fit, but the content is already incomplete
+    EXPECT_TRUE(out.overflowed());
+    EXPECT_EQ(out.size(), 4u);
+    EXPECT_EQ(buffer[4], 0);
+}
+
+//==============================================================================
+// Span and appender overloads
+//==============================================================================
+
+TEST(Ocp1DataTypesTest, DataToReadsFromSpanIntoLargerBuffer)
+{
+    // Values laid out back to back, as in the parameters of a received frame.
+    std::uint8_t frame[64] = {};
+    ByteAppender out(frame, sizeof(frame));
+    DataFromInt32(-12345, out);
+    DataFromUint16(0xbeef, out);
+    DataFromUint64(0x0102030405060708ULL, out);
+    DataFromFloat(-6.5f, out);
+    DataFromDouble(3.25, out);
+    DataFromString("Main", out);
+    ASSERT_FALSE(out.overflowed());
+    ASSERT_EQ(out.size(), 4u + 2u + 8u + 4u + 8u + 6u);
+
+    const ByteSpan data(frame, out.size());
+    bool ok = false;
+    EXPECT_EQ(DataToInt32(data.subspan(0, 4), &ok), -12345);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(DataToUint16(data.subspan(4, 2), &ok), 0xbeef);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(DataToUint64(data.subspan(6, 8), &ok), 0x0102030405060708ULL);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(DataToFloat(data.subspan(14, 4), &ok), -6.5f);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(DataToDouble(data.subspan(18, 8), &ok), 3.25);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(DataToString(data.subspan(26), &ok), "Main");
+    EXPECT_TRUE(ok);
+
+    EXPECT_EQ(DataToUint32(data.subspan(62), &ok), 0u);
+    EXPECT_FALSE(ok);
+}
+
+TEST(Ocp1DataTypesTest, AppendingDataFromMatchesByteVectorHelpers)
+{
+    auto appended = [](const std::function<void(ByteAppender&)>& append) {
+        std::uint8_t buffer[32] = {};
+        ByteAppender out(buffer, sizeof(buffer));
+        append(out);
+        EXPECT_FALSE(out.overflowed());
+        return ByteVector(buffer, buffer + out.size());
+    };
+
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromBool(true, out); }), DataFromBool(true));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromInt32(-2, out); }), DataFromInt32(-2));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromUint8(0xab, out); }), DataFromUint8(0xab));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromUint16(0xabcd, out); }), DataFromUint16(0xabcd));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromUint32(0xdeadbeef, out); }), DataFromUint32(0xdeadbeef));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromUint64(0xfedcba9876543210ULL, out); }), DataFromUint64(0xfedcba9876543210ULL));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromString("Soundscape", out); }), DataFromString("Soundscape"));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromFloat(0.1f, out); }), DataFromFloat(0.1f));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromDouble(-0.1, out); }), DataFromDouble(-0.1));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromPosition(1.0f, 2.0f, 3.0f, out); }), DataFromPosition(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromAimingAndPosition(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, out); }),
+              DataFromAimingAndPosition(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromOnoForSubscription(0x10001234, false, out); }),
+              DataFromOnoForSubscription(0x10001234, false));
+    EXPECT_EQ(appended([](ByteAppender& out) { DataFromOnoForSubscription2(0x10001234, out); }),
+              DataFromOnoForSubscription2(0x10001234));
+}
+
+TEST(Ocp1DataTypesTest, AppendingDataFromReportsOverflow)
+{
+    std::uint8_t buffer[8] = {};
+    ByteAppender out(buffer, 5);
+    DataFromString("Soundscape", out);
+    EXPECT_TRUE(out.overflowed());
+
+    ByteAppender exact(buffer, 8);
+    DataFromDouble(1.0, exact);
+    EXPECT_FALSE(exact.overflowed());
+    DataFromBool(true, exact);
+    EXPECT_TRUE(exact.overflowed());
+}
+
 //==============================================================================
 // String
 //==============================================================================
@@ -326,9 +481,8 @@ TEST(Ocp1DataTypesTest, ReadUint32FromUint8Buffer)
 
 TEST(Ocp1DataTypesTest, ReadUint32FromCharBufferDoesNotSignExtend)
 {
-    // Regression check: buffer[i] is cast to uint8_t before shifting, so a
-    // high-bit-set char (which may be negative if char is signed) must not
-    // sign-extend into the assembled value.
+    // Regression check: a high-bit-set char (which may be negative if char is
+    // signed) must not sign-extend into the assembled value.
     char buffer[4] = { char(0xFF), char(0xFF), char(0xFF), char(0xFF) };
     EXPECT_EQ(ReadUint32(buffer), 0xFFFFFFFFu);
 }
@@ -345,6 +499,184 @@ TEST(Ocp1DataTypesTest, ReadUint16FromCharBufferDoesNotSignExtend)
     EXPECT_EQ(ReadUint16(buffer), 0xFFFFu);
 }
 
+//==============================================================================
+// Batch big-endian codecs
+//==============================================================================
+
+// Counts up to 40 cover the AVX2 (8 or 16 values), SSE2/NEON (4 or 8 values)
+// and scalar tail paths; the +1 offset makes every access unaligned.
+
+TEST(Ocp1DataTypesTest, Float32ArrayMatchesScalarHelpers)
+{
+    for (std::size_t count = 0; count <= 40; ++count)
+    {
+        std::vector<float> values(count);
+        ByteVector expected;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            values[i] = -1000.0f + 37.25f * static_cast<float>(i);
+            auto bytes = DataFromFloat(values[i]);
+            expected.insert(expected.end(), bytes.begin(), bytes.end());
+        }
+
+        ByteVector buffer(1 + 4 * count + 1, 0xee);
+        WriteFloat32Array(buffer.data() + 1, values.data(), count);
+        EXPECT_EQ(ByteVector(buffer.begin() + 1, buffer.end() - 1), expected) << count;
+        EXPECT_EQ(buffer.front(), 0xee);
+        EXPECT_EQ(buffer.back(), 0xee);
+
+        std::vector<float> decoded(count + 1, 42.0f);
+        EXPECT_EQ(ReadFloat32Array(ByteSpan(buffer.data() + 1, 4 * count), decoded.data(), count), count);
+        for (std::size_t i = 0; i < count; ++i)
+            EXPECT_EQ(decoded[i], DataToFloat(ByteVector(expected.begin() + 4 * i, expected.begin() + 4 * i + 4))) << i;
+        EXPECT_EQ(decoded[count], 42.0f);
+    }
+}
+
+TEST(Ocp1DataTypesTest, Int32AndUint32ArraysMatchScalarHelpers)
+{
+    for (std::size_t count = 0; count <= 40; ++count)
+    {
+        std::vector<std::int32_t> signedValues(count);
+        std::vector<std::uint32_t> unsignedValues(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            signedValues[i] = static_cast<std::int32_t>(i * 0x01020304u) - 0x10000000;
+            unsignedValues[i] = 0xfedcba98u - static_cast<std::uint32_t>(i * 0x01010101u);
+        }
+
+        ByteVector buffer(1 + 4 * count);
+        WriteInt32Array(buffer.data() + 1, signedValues.data(), count);
+        for (std::size_t i = 0; i < count; ++i)
+            EXPECT_EQ(ByteVector(buffer.begin() + 1 + 4 * i, buffer.begin() + 5 + 4 * i), DataFromInt32(signedValues[i])) << i;
+
+        std::vector<std::int32_t> signedDecoded(count);
+        EXPECT_EQ(ReadInt32Array(ByteSpan(buffer.data() + 1, 4 * count), signedDecoded.data(), count), count);
+        EXPECT_EQ(signedDecoded, signedValues);
+
+        WriteUint32Array(buffer.data() + 1, unsignedValues.data(), count);
+        for (std::size_t i = 0; i < count; ++i)
+            EXPECT_EQ(ReadUint32(buffer.data() + 1 + 4 * i), unsignedValues[i]) << i;
+
+        std::vector<std::uint32_t> unsignedDecoded(count);
+        EXPECT_EQ(ReadUint32Array(ByteSpan(buffer.data() + 1, 4 * count), unsignedDecoded.data(), count), count);
+        EXPECT_EQ(unsignedDecoded, unsignedValues);
+    }
+}
+
+TEST(Ocp1DataTypesTest, Uint16ArrayMatchesScalarHelpers)
+{
+    for (std::size_t count = 0; count <= 40; ++count)
+    {
+        std::vector<std::uint16_t> values(count);
+        for (std::size_t i = 0; i < count; ++i)
+            values[i] = static_cast<std::uint16_t>(0xa1b2 + i * 0x0103);
+
+        ByteVector buffer(1 + 2 * count);
+        WriteUint16Array(buffer.data() + 1, values.data(), count);
+        for (std::size_t i = 0; i < count; ++i)
+            EXPECT_EQ(ByteVector(buffer.begin() + 1 + 2 * i, buffer.begin() + 3 + 2 * i), DataFromUint16(values[i])) << i;
+
+        std::vector<std::uint16_t> decoded(count);
+        EXPECT_EQ(ReadUint16Array(ByteSpan(buffer.data() + 1, 2 * count), decoded.data(), count), count);
+        EXPECT_EQ(decoded, values);
+    }
+}
+
+TEST(Ocp1DataTypesTest, ArrayReadsStopAtEndOfData)
+{
+    // 2.5 floats of data: only the two complete values are decoded.
+    const auto data = DataFromAimingAndPosition(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+    float values[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    EXPECT_EQ(ReadFloat32Array(ByteSpan(data.data(), 10), values, 6), 2u);
+    EXPECT_EQ(values[0], 1.0f);
+    EXPECT_EQ(values[1], 2.0f);
+    EXPECT_EQ(values[2], 0.0f);
+
+    EXPECT_EQ(ReadFloat32Array(data, values, 6), 6u);
+    EXPECT_EQ(values[5], 6.0f);
+
+    std::uint16_t shorts[4] = {};
+    EXPECT_EQ(ReadUint16Array(ByteSpan(data.data(), 5), shorts, 4), 2u);
+    EXPECT_EQ(ReadUint16Array(ByteSpan(), shorts, 4), 0u);
+}
+
+//==============================================================================
+// Bit strings
+//==============================================================================
+
+TEST(Ocp1DataTypesTest, BitStringRoundTrip)
+{
+    // 10 bits, most significant bit first: 1011 0000 01.
+    const std::vector<bool> bits = { true, false, true, true, false, false, false, false, false, true };
+    const auto data = DataFromBitString(bits);
+    EXPECT_EQ(data, (ByteVector{ 0x00, 0x0A, 0xB0, 0x40 }));
+
+    bool ok = false;
+    EXPECT_EQ(DataToBitString(data, &ok), bits);
+    EXPECT_TRUE(ok);
+
+    EXPECT_TRUE(DataToBitString(DataFromBitString({}), &ok).empty());
+    EXPECT_TRUE(ok);
+
+    // Bit count beyond the data.
+    DataToBitString(ByteVector{ 0x00, 0x09, 0xFF }, &ok);
+    EXPECT_FALSE(ok);
+
+    // Bits beyond the 16-bit count are dropped, without leaving bytes behind.
+    const auto truncated = DataFromBitString(std::vector<bool>(0x10000 + 20, true));
+    EXPECT_EQ(truncated.size(), 2u + (0xffff + 7) / 8);
+    EXPECT_EQ(DataToBitString(truncated, &ok).size(), 0xffffu);
+    EXPECT_TRUE(ok);
+}
+
+TEST(Ocp1DataTypesTest, UnpackBitsMatchesScalarUnpacking)
+{
+    ByteVector packed(20);
+    for (std::size_t i = 0; i < packed.size(); ++i)
+        packed[i] = static_cast<std::uint8_t>(0x5a + i * 0x3d);
+
+    // Counts around every vector width, and an unaligned source.
+    for (std::size_t offset = 0; offset <= 1; ++offset)
+    {
+        for (std::size_t count = 0; count <= 8 * (packed.size() - offset); ++count)
+        {
+            std::vector<std::uint8_t> bits(count + 1, 0xcc);
+            UnpackBits(packed.data() + offset, bits.data(), count);
+            for (std::size_t i = 0; i < count; ++i)
+                ASSERT_EQ(bits[i], (packed[offset + i / 8] >> (7 - i % 8)) & 1) << count << " " << i;
+            EXPECT_EQ(bits[count], 0xcc) << count; // Nothing written past the end.
+        }
+    }
+}
+
+TEST(Ocp1DataTypesTest, PackBitsIsInverseOfUnpackBits)
+{
+    for (std::size_t count = 0; count <= 70; ++count)
+    {
+        std::vector<std::uint8_t> bits(count);
+        for (std::size_t i = 0; i < count; ++i)
+            bits[i] = (i * 7 + count) % 3 == 0 ? 1 : 0;
+
+        ByteVector packed((count + 7) / 8, 0xff);
+        PackBits(bits.data(), packed.data(), count);
+        if (count % 8 != 0)
+        {
+            EXPECT_EQ(packed.back() & (0xff >> (count % 8)), 0) << count; // Unused bits cleared.
+        }
+
+        std::vector<std::uint8_t> unpacked(count);
+        UnpackBits(packed.data(), unpacked.data(), count);
+        EXPECT_EQ(unpacked, bits) << count;
+    }
+
+    // Any non-zero byte is a set bit.
+    const std::uint8_t bits[3] = { 0, 2, 0xff };
+    std::uint8_t packed = 0;
+    PackBits(bits, &packed, 3);
+    EXPECT_EQ(packed, 0x60);
+}
+
 //==============================================================================
 // ONo packing
 //==============================================================================
@@ -0,0 +1,457 @@
+#include <gtest/gtest.h>
+
+#include "NanoOcp1.h"
+#include "Ocp1Controller.h"
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1DatagramTransport.h"
+#include "Ocp1Message.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+/** Blocking read of the next datagram, or an empty vector after timeoutMs. */
+ByteVector receiveDatagram(NanoTransport& socket, int timeoutMs = 1000)
+{
+    ByteVector datagram(NanoDatagramSocket::maxDatagramSize);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        const auto n = socket.readAvailable(datagram.data(), static_cast<int>(datagram.size()));
+        if (n > 0)
+        {
+            datagram.resize(static_cast<std::size_t>(n));
+            return datagram;
+        }
+        if (n < 0)
+            break;
+        socket.waitForEvents(NanoTransport::readEvent, 20, invalidSocketHandle);
+    }
+    return {};
+}
+
+bool sendDatagram(NanoTransport& socket, const ByteVector& datagram)
+{
+    const NanoTransport::Buffer buffer{ datagram.data(), datagram.size() };
+    return socket.writeGather(&buffer, 1) == static_cast<int>(datagram.size());
+}
+
+/** A device-side socket on a free loopback port, plus a client socket connected to it. */
+struct DatagramPair
+{
+    DatagramPair()
+    {
+        device = std::make_unique<NanoDatagramSocket>();
+        client = std::make_unique<NanoDatagramSocket>();
+        ok = device->bind(0, "127.0.0.1") && device->setNonBlocking(true)
+          && client->connect("127.0.0.1", device->getBoundPort()) && client->setNonBlocking(true);
+    }
+
+    /** Lets the device reply: it connects to the client on the first datagram. */
+    bool acceptPeer() { return device->waitForPeer(1000) == 1; }
+
+    std::unique_ptr<NanoDatagramSocket> device;
+    std::unique_ptr<NanoDatagramSocket> client;
+    bool                                ok{ false };
+};
+
+} // namespace
+
+
+//==============================================================================
+TEST(NanoDatagramSocketTest, GatherSendsOneDatagramPerBuffer)
+{
+    DatagramPair pair;
+    ASSERT_TRUE(pair.ok);
+
+    const std::vector<ByteVector> sent = {
+        Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData(),
+        Ocp1Notification(0x4001, 4, 1, 1, DataFromFloat(1.0f)).GetSerializedData(),
+        Ocp1Notification(0x4002, 4, 1, 1, ByteVector(4000, 0x5a)).GetSerializedData(),
+    };
+    std::vector<NanoTransport::Buffer> buffers;
+    std::size_t total = 0;
+    for (const auto& message : sent)
+    {
+        buffers.push_back({ message.data(), message.size() });
+        total += message.size();
+    }
+    EXPECT_EQ(pair.client->writeGather(buffers.data(), static_cast<int>(buffers.size())), static_cast<int>(total));
+
+    ASSERT_TRUE(pair.acceptPeer());
+    EXPECT_TRUE(pair.device->isConnected());
+    EXPECT_EQ(pair.device->getHostName(), "127.0.0.1");
+    for (const auto& message : sent)
+        EXPECT_EQ(receiveDatagram(*pair.device), message);
+
+    // Connected to its first sender, the device answers on the same socket.
+    const auto reply = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    ASSERT_TRUE(sendDatagram(*pair.device, reply));
+    EXPECT_EQ(receiveDatagram(*pair.client), reply);
+}
+
+TEST(Ocp1DatagramTransportTest, DropsDatagramsThatAreNotWholeFrames)
+{
+    DatagramPair pair;
+    ASSERT_TRUE(pair.ok);
+    Ocp1DatagramTransport transport(std::move(pair.client));
+
+    const auto keepAlive = Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData();
+    ASSERT_TRUE(sendDatagram(transport, keepAlive));
+    ASSERT_TRUE(pair.acceptPeer());
+    ASSERT_EQ(receiveDatagram(*pair.device), keepAlive);
+
+    const auto frame = Ocp1Notification(0x4001, 4, 1, 1, DataFromFloat(2.0f)).GetSerializedData();
+    ASSERT_TRUE(sendDatagram(*pair.device, ByteVector{ 0x01, 0x02, 0x03 }));                 // no sync byte
+    ASSERT_TRUE(sendDatagram(*pair.device, ByteVector(frame.begin(), frame.end() - 1)));    // cut short
+    ASSERT_TRUE(sendDatagram(*pair.device, frame));
+
+    // The frame arrives alone, so the frame reader stays in sync.
+    EXPECT_EQ(receiveDatagram(transport), frame);
+    const auto stats = transport.getStats();
+    EXPECT_EQ(stats.datagramsDropped, 2u);
+    EXPECT_EQ(stats.datagramsReceived, 1u);
+    EXPECT_NE(transport.getLastReceiveTime(), std::chrono::steady_clock::time_point{});
+}
+
+TEST(Ocp1DatagramTransportTest, RetransmitsOnlyCommandsAwaitingResponse)
+{
+    DatagramPair pair;
+    ASSERT_TRUE(pair.ok);
+    DatagramPolicy policy;
+    policy.retransmitTimeoutMs = 20;
+    policy.maxRetransmits      = 2;
+    Ocp1DatagramTransport transport(std::move(pair.client), policy);
+
+    const DS100::dbOcaObjectDef_MatrixNode_Gain def(1, 1);
+    std::uint32_t answered{ 0 }, unanswered{ 0 };
+    const auto command = Ocp1CommandResponseRequired(def.GetValueCommand(), answered).GetSerializedData();
+    const auto ignored = Ocp1CommandResponseRequired(def.GetValueCommand(), unanswered).GetSerializedData();
+    ASSERT_TRUE(sendDatagram(transport, command));
+    ASSERT_TRUE(sendDatagram(transport, ignored));
+    ASSERT_TRUE(sendDatagram(transport, Ocp1Notification(0x4001, 4, 1, 1, DataFromFloat(1.0f)).GetSerializedData()));
+    ASSERT_TRUE(sendDatagram(transport, Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData()));
+    EXPECT_EQ(transport.getPendingCommandCount(), 2u);
+
+    ASSERT_TRUE(pair.acceptPeer());
+    for (int i = 0; i < 4; ++i)
+        ASSERT_FALSE(receiveDatagram(*pair.device).empty());
+
+    // Answer the first command only: just the second one is sent again.
+    ASSERT_TRUE(sendDatagram(*pair.device, Ocp1Response(answered, 0, 1, DataFromFloat(-6.0f)).GetSerializedData()));
+    ASSERT_FALSE(receiveDatagram(transport).empty());
+    EXPECT_EQ(transport.getPendingCommandCount(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(transport.retransmitDue(), 1);
+    EXPECT_EQ(receiveDatagram(*pair.device), ignored);
+
+    // Retransmissions back off and end after maxRetransmits.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (transport.getPendingCommandCount() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        transport.retransmitDue();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(transport.getPendingCommandCount(), 0u);
+    EXPECT_EQ(receiveDatagram(*pair.device), ignored);
+    EXPECT_TRUE(receiveDatagram(*pair.device, 50).empty());
+
+    const auto stats = transport.getStats();
+    EXPECT_EQ(stats.retransmissions, 2u);
+    EXPECT_EQ(stats.commandsGivenUp, 1u);
+    EXPECT_EQ(stats.datagramsSent, 6u);
+}
+
+
+//==============================================================================
+namespace
+{
+
+/** Answers the client's KeepAlives while `answering` is set. */
+struct KeepAliveDevice
+{
+    KeepAliveDevice()
+    {
+        ok = socket.bind(0, "127.0.0.1") && socket.setNonBlocking(true);
+    }
+
+    ~KeepAliveDevice()
+    {
+        running = false;
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void start()
+    {
+        thread = std::thread([this]() {
+            while (running && socket.waitForPeer(20) != 1) {}
+            while (running)
+            {
+                const auto datagram = receiveDatagram(socket, 20);
+                Ocp1Message::MessageType type;
+                if (!datagram.empty() && Ocp1Message::PeekMessageType(datagram, type) && type == Ocp1Message::KeepAlive)
+                {
+                    ++keepAlives;
+                    if (answering)
+                        sendDatagram(socket, Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData());
+                }
+            }
+        });
+    }
+
+    NanoDatagramSocket socket;
+    std::thread        thread;
+    std::atomic<bool>  running{ true };
+    std::atomic<bool>  answering{ true };
+    std::atomic<int>   keepAlives{ 0 };
+    bool               ok{ false };
+};
+
+} // namespace
+
+TEST(NanoOcp1DatagramClientTest, KeepAlivesTrackDeviceLiveness)
+{
+    KeepAliveDevice device;
+    ASSERT_TRUE(device.ok);
+    device.start();
+
+    NanoOcp1DatagramClient client("127.0.0.1", device.socket.getBoundPort(), /*callbacksOnMessageThread=*/false);
+    DatagramPolicy policy;
+    policy.keepAliveIntervalMs = 30;
+    policy.missedKeepAlives    = 3;
+    client.setDatagramPolicy(policy);
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    int established = 0, lost = 0;
+    client.onConnectionEstablished = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++established;
+        cv.notify_all();
+    };
+    client.onConnectionLost = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++lost;
+        cv.notify_all();
+    };
+    auto waitFor = [&](const int& counter, int count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&]() { return counter >= count; });
+    };
+
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(waitFor(established, 1));
+    EXPECT_TRUE(client.isPeerAlive());
+
+    // The device falls silent: lost after the missed KeepAlives, while the
+    // client keeps sending them.
+    device.answering = false;
+    ASSERT_TRUE(waitFor(lost, 1));
+    EXPECT_FALSE(client.isPeerAlive());
+    const auto keepAlivesWhileLost = device.keepAlives.load();
+
+    device.answering = true;
+    ASSERT_TRUE(waitFor(established, 2));
+    EXPECT_GT(device.keepAlives.load(), keepAlivesWhileLost);
+
+    client.stop();
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(established, 2);
+    EXPECT_EQ(lost, 2); // stop() reports the live device as gone
+}
+
+TEST(NanoOcp1DatagramClientTest, LivenessCallbacksMayStopTheClient)
+{
+    KeepAliveDevice device;
+    ASSERT_TRUE(device.ok);
+    device.start();
+
+    NanoOcp1DatagramClient client("127.0.0.1", device.socket.getBoundPort(), /*callbacksOnMessageThread=*/false);
+    DatagramPolicy policy;
+    policy.keepAliveIntervalMs = 30;
+    policy.missedKeepAlives    = 3;
+    client.setDatagramPolicy(policy);
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool established = false, stopped = false;
+    int lost = 0;
+    client.onConnectionEstablished = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        established = true;
+        cv.notify_all();
+    };
+    // Called on the timer thread; stop() reports the peer as lost again.
+    client.onConnectionLost = [&]() {
+        client.stop();
+        std::lock_guard<std::mutex> lock(mutex);
+        ++lost;
+        stopped = true;
+        cv.notify_all();
+    };
+
+    ASSERT_TRUE(client.start());
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return established; }));
+    }
+
+    device.answering = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return stopped; }));
+        EXPECT_EQ(lost, 1);
+    }
+    EXPECT_FALSE(client.isRunning());
+    EXPECT_FALSE(client.isPeerAlive());
+}
+
+
+//==============================================================================
+namespace
+{
+
+/** Answers every command on one transport — GetValues with -6 dB, everything else empty — and echoes KeepAlives. */
+struct CommandDevice
+{
+    explicit CommandDevice(std::unique_ptr<NanoTransport> t) : transport(std::move(t)) {}
+
+    ~CommandDevice()
+    {
+        running = false;
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void start()
+    {
+        thread = std::thread([this]() {
+            Ocp1FrameReader reader;
+            while (running)
+            {
+                const auto n = transport->readAvailable(reader.getWriteBuffer(), static_cast<int>(reader.getWritableSize()));
+                if (n < 0)
+                    return;
+                if (n == 0)
+                {
+                    transport->waitForEvents(NanoTransport::readEvent, 20, invalidSocketHandle);
+                    continue;
+                }
+                reader.commitWrite(static_cast<std::size_t>(n));
+
+                ByteSpan frame;
+                while (reader.nextFrame(frame) == Ocp1FrameReader::Status::Frame)
+                {
+                    Ocp1Message::MessageType type;
+                    if (!Ocp1Message::PeekMessageType(frame, type))
+                        continue;
+                    if (type == Ocp1Message::KeepAlive)
+                        sendDatagram(*transport, ByteVector(frame.begin(), frame.end()));
+                    if (type != Ocp1Message::CommandResponseRequired)
+                        continue;
+
+                    // Command layout after the 10-byte header: size, handle, target ONo, ...
+                    // AddSubscription targets the subscription manager (ONo 4).
+                    const auto handle = ReadUint32(frame.data() + 14);
+                    const auto isSub  = ReadUint32(frame.data() + 18) == 4;
+                    (isSub ? subscriptions : getValues)++;
+                    const auto reply = isSub ? Ocp1Response(handle, 0, 0, {}).GetSerializedData()
+                                             : Ocp1Response(handle, 0, 1, DataFromFloat(-6.0f)).GetSerializedData();
+                    sendDatagram(*transport, reply);
+                }
+            }
+        });
+    }
+
+    std::unique_ptr<NanoTransport> transport;
+    std::thread                    thread;
+    std::atomic<bool>              running{ true };
+    std::atomic<int>               subscriptions{ 0 };
+    std::atomic<int>               getValues{ 0 };
+};
+
+} // namespace
+
+TEST(Ocp1ControllerTest, RoutesNotificationsOverUdpAndControlOverTcp)
+{
+    NanoSocket listener;
+    ASSERT_TRUE(listener.createListener(0, "127.0.0.1"));
+    auto udpSocket = std::make_unique<NanoDatagramSocket>();
+    ASSERT_TRUE(udpSocket->bind(0, "127.0.0.1") && udpSocket->setNonBlocking(true));
+    const auto udpPort = udpSocket->getBoundPort();
+    auto* udp = udpSocket.get();
+
+    Ocp1Controller controller(/*callbacksOnMessageThread=*/false);
+    const DS100::dbOcaObjectDef_MatrixNode_Gain def(3, 7);
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::vector<float>      values;
+    controller.trackObject(std::make_unique<DS100::dbOcaObjectDef_MatrixNode_Gain>(def),
+                           [&](const ByteVector& data) {
+                               std::lock_guard<std::mutex> lock(mutex);
+                               values.push_back(DataToFloat(data));
+                               cv.notify_all();
+                           });
+    controller.onStateChanged = [&](Ocp1Controller::State) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    };
+    DatagramPolicy policy;
+    policy.keepAliveIntervalMs = 50;
+    controller.setUdpNotifications(udpPort, policy);
+    controller.connect("127.0.0.1", listener.getBoundPort());
+
+    std::unique_ptr<NanoSocket> tcpSocket;
+    for (int i = 0; i < 20 && !tcpSocket; ++i)
+        tcpSocket.reset(listener.waitForNextConnection());
+    ASSERT_TRUE(tcpSocket);
+    ASSERT_TRUE(tcpSocket->setNonBlocking(true));
+    ASSERT_EQ(udp->waitForPeer(2000), 1);
+
+    CommandDevice tcpDevice(std::move(tcpSocket));
+    CommandDevice udpDevice(std::move(udpSocket));
+    tcpDevice.start();
+    udpDevice.start();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() {
+            return controller.getState() == Ocp1Controller::State::Connected && !values.empty();
+        }));
+    }
+    EXPECT_EQ(tcpDevice.subscriptions.load(), 0);
+    EXPECT_EQ(tcpDevice.getValues.load(), 1);
+    EXPECT_EQ(udpDevice.subscriptions.load(), 1);
+    EXPECT_EQ(udpDevice.getValues.load(), 0);
+    ASSERT_NE(controller.notificationClient(), nullptr);
+    EXPECT_TRUE(controller.notificationClient()->isPeerAlive());
+
+    // The subscribed notification arrives over UDP.
+    ASSERT_TRUE(sendDatagram(*udp, Ocp1Notification(def.m_targetOno, 4, 1, 1, DataFromFloat(-12.0f)).GetSerializedData()));
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2), [&]() { return values.size() >= 2; }));
+        EXPECT_FLOAT_EQ(values.back(), -12.0f);
+    }
+
+    // SetValue stays on TCP.
+    ASSERT_TRUE(controller.setValue(def, Variant(-3.0f)));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (tcpDevice.getValues.load() < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_EQ(tcpDevice.getValues.load(), 2); // counts every non-subscription command
+    EXPECT_EQ(udpDevice.getValues.load(), 0);
+
+    controller.disconnect();
+}
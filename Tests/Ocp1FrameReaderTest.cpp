@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+
+#include "Ocp1FrameReader.h"
+#include "Ocp1Message.h"
+
+#include <cstring>
+
+using namespace NanoOcp1;
+
+namespace
+{
+
+void feed(Ocp1FrameReader& reader, const std::uint8_t* data, std::size_t size)
+{
+    auto* dst = reader.getWriteBuffer();
+    ASSERT_GE(reader.getWritableSize(), size);
+    std::memcpy(dst, data, size);
+    reader.commitWrite(size);
+}
+
+void feed(Ocp1FrameReader& reader, const ByteVector& data)
+{
+    feed(reader, data.data(), data.size());
+}
+
+ByteVector makeNotification(std::uint32_t ono, std::uint8_t fill, std::size_t paramSize)
+{
+    return Ocp1Notification(ono, 4, 1, 1, ByteVector(paramSize, fill)).GetSerializedData();
+}
+
+} // namespace
+
+//==============================================================================
+// Ocp1FrameReader
+//==============================================================================
+
+TEST(Ocp1FrameReaderTest, EmptyReaderNeedsMoreData)
+{
+    Ocp1FrameReader reader;
+    ByteSpan frame;
+    EXPECT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Incomplete);
+    EXPECT_EQ(reader.getBufferedSize(), 0u);
+}
+
+TEST(Ocp1FrameReaderTest, SlicesEveryFrameOutOfOneRead)
+{
+    const auto a = makeNotification(0x1001, 0xAA, 4);
+    const auto b = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    const auto c = makeNotification(0x1002, 0xBB, 12);
+
+    ByteVector stream(a);
+    stream.insert(stream.end(), b.begin(), b.end());
+    stream.insert(stream.end(), c.begin(), c.end());
+
+    Ocp1FrameReader reader;
+    feed(reader, stream);
+
+    ByteSpan frame;
+    ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(ByteVector(frame.begin(), frame.end()), a);
+    ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(ByteVector(frame.begin(), frame.end()), b);
+    ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(ByteVector(frame.begin(), frame.end()), c);
+    EXPECT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Incomplete);
+    EXPECT_EQ(reader.getBufferedSize(), 0u);
+}
+
+TEST(Ocp1FrameReaderTest, ReturnedFramePointsIntoBuffer)
+{
+    const auto a = makeNotification(0x1001, 0xAA, 4);
+
+    Ocp1FrameReader reader;
+    auto* start = reader.getWriteBuffer();
+    feed(reader, a);
+
+    ByteSpan frame;
+    ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(frame.data(), start);
+    EXPECT_EQ(frame.size(), a.size());
+}
+
+TEST(Ocp1FrameReaderTest, CarriesPartialFrameOverByteByByte)
+{
+    const auto a = makeNotification(0x2001, 0x11, 8);
+    const auto b = makeNotification(0x2002, 0x22, 8);
+    ByteVector stream(a);
+    stream.insert(stream.end(), b.begin(), b.end());
+
+    Ocp1FrameReader reader;
+    std::vector<ByteVector> frames;
+    for (auto byte : stream)
+    {
+        feed(reader, &byte, 1);
+
+        ByteSpan frame;
+        Ocp1FrameReader::Status status;
+        while ((status = reader.nextFrame(frame)) == Ocp1FrameReader::Status::Frame)
+            frames.emplace_back(frame.begin(), frame.end());
+        ASSERT_EQ(status, Ocp1FrameReader::Status::Incomplete);
+    }
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0], a);
+    EXPECT_EQ(frames[1], b);
+}
+
+TEST(Ocp1FrameReaderTest, GrowsForFrameLargerThanCapacity)
+{
+    const auto big = makeNotification(0x3001, 0x5A, 300);
+
+    Ocp1FrameReader reader(64);
+    std::size_t offset = 0;
+    ByteSpan frame;
+    auto status = Ocp1FrameReader::Status::Incomplete;
+    while (offset < big.size() && status == Ocp1FrameReader::Status::Incomplete)
+    {
+        reader.getWriteBuffer();
+        const auto n = std::min(reader.getWritableSize(), big.size() - offset);
+        ASSERT_GT(n, 0u);
+        feed(reader, big.data() + offset, n);
+        offset += n;
+        status = reader.nextFrame(frame);
+    }
+
+    ASSERT_EQ(status, Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(ByteVector(frame.begin(), frame.end()), big);
+}
+
+TEST(Ocp1FrameReaderTest, RejectsMissingSyncByte)
+{
+    auto bad = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    bad[0] = 0x00;
+
+    Ocp1FrameReader reader;
+    feed(reader, bad);
+
+    ByteSpan frame;
+    EXPECT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Invalid);
+}
+
+TEST(Ocp1FrameReaderTest, RejectsSizeBelowHeaderOrAboveLimit)
+{
+    ByteVector tooSmall{ 0x3B, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x04, 0x00, 0x01 };
+    Ocp1FrameReader reader;
+    feed(reader, tooSmall);
+    ByteSpan frame;
+    EXPECT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Invalid);
+
+    ByteVector tooLarge{ 0x3B, 0x00, 0x01, 0x00, 0x10, 0x00, 0x00, 0x02, 0x00, 0x01 };
+    Ocp1FrameReader limited(64, 4096);
+    feed(limited, tooLarge);
+    EXPECT_EQ(limited.nextFrame(frame), Ocp1FrameReader::Status::Invalid);
+}
+
+TEST(Ocp1FrameReaderTest, ResetDiscardsBufferedData)
+{
+    const auto a = makeNotification(0x4001, 0x01, 4);
+
+    Ocp1FrameReader reader;
+    feed(reader, a.data(), a.size() - 1);
+    EXPECT_EQ(reader.getBufferedSize(), a.size() - 1);
+
+    reader.reset();
+    EXPECT_EQ(reader.getBufferedSize(), 0u);
+
+    feed(reader, a);
+    ByteSpan frame;
+    ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+    EXPECT_EQ(ByteVector(frame.begin(), frame.end()), a);
+}
+
+TEST(Ocp1FrameReaderTest, SharedFrameSurvivesLaterReads)
+{
+    const auto a = makeNotification(0x4001, 0xAA, 8);
+    const auto b = makeNotification(0x4002, 0xBB, 8);
+
+    Ocp1FrameReader reader(4 * a.size());
+    feed(reader, a);
+    Ocp1SharedFrame kept;
+    ASSERT_EQ(reader.nextFrame(kept), Ocp1FrameReader::Status::Frame);
+    const auto* keptData = kept.data();
+
+    // Enough traffic to wrap the buffer several times over.
+    for (int i = 0; i < 16; ++i)
+    {
+        feed(reader, b);
+        ByteSpan frame;
+        ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+        EXPECT_EQ(ByteVector(frame.begin(), frame.end()), b);
+    }
+
+    EXPECT_EQ(kept.data(), keptData);
+    EXPECT_EQ(kept.toByteVector(), a);
+    EXPECT_EQ(reader.getNumBuffers(), 2u);
+}
+
+TEST(Ocp1FrameReaderTest, SharedFrameCarriesPartialFrameIntoNextBuffer)
+{
+    const auto a = makeNotification(0x4001, 0xAA, 8);
+    const auto b = makeNotification(0x4002, 0xBB, 8);
+
+    Ocp1FrameReader reader(a.size() + b.size() / 2);
+    ByteVector chunk(a);
+    chunk.insert(chunk.end(), b.begin(), b.begin() + b.size() / 2);
+    feed(reader, chunk);
+
+    Ocp1SharedFrame first;
+    ASSERT_EQ(reader.nextFrame(first), Ocp1FrameReader::Status::Frame);
+    Ocp1SharedFrame second;
+    ASSERT_EQ(reader.nextFrame(second), Ocp1FrameReader::Status::Incomplete);
+
+    feed(reader, b.data() + b.size() / 2, b.size() - b.size() / 2);
+    ASSERT_EQ(reader.nextFrame(second), Ocp1FrameReader::Status::Frame);
+
+    EXPECT_EQ(first.toByteVector(), a);
+    EXPECT_EQ(second.toByteVector(), b);
+    EXPECT_EQ(reader.getNumBuffers(), 2u);
+}
+
+TEST(Ocp1FrameReaderTest, ReleasedBuffersAreReused)
+{
+    const auto a = makeNotification(0x4001, 0xAA, 8);
+
+    // Always one frame alive, as with a dispatcher that lags one frame behind.
+    Ocp1FrameReader reader(2 * a.size());
+    Ocp1SharedFrame previous;
+    for (int i = 0; i < 64; ++i)
+    {
+        feed(reader, a);
+        Ocp1SharedFrame frame;
+        ASSERT_EQ(reader.nextFrame(frame), Ocp1FrameReader::Status::Frame);
+        EXPECT_EQ(frame.toByteVector(), a);
+        EXPECT_EQ(previous.empty(), i == 0);
+        previous = frame;
+    }
+
+    EXPECT_EQ(reader.getNumBuffers(), 2u);
+}
+
+TEST(Ocp1FrameReaderTest, SharedFrameOutlivesReader)
+{
+    const auto a = makeNotification(0x4001, 0xAA, 8);
+
+    Ocp1SharedFrame kept;
+    {
+        Ocp1FrameReader reader;
+        feed(reader, a);
+        ASSERT_EQ(reader.nextFrame(kept), Ocp1FrameReader::Status::Frame);
+        reader.reset();
+        feed(reader, makeNotification(0x4002, 0xBB, 8));
+    }
+
+    EXPECT_EQ(kept.toByteVector(), a);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "Ocp1HandleAllocator.h"
+#include "Ocp1Message.h"
+
+#include <algorithm>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace NanoOcp1;
+
+//==============================================================================
+// Ocp1HandleAllocator — sequence, wraparound, blocks, concurrency
+//==============================================================================
+
+TEST(Ocp1HandleAllocatorTest, StartsAfterReservedSessionIds)
+{
+    Ocp1HandleAllocator handles;
+    EXPECT_EQ(handles.peek(), 2u);
+    EXPECT_EQ(handles.next(), 2u);
+    EXPECT_EQ(handles.next(), 3u);
+
+    Ocp1HandleAllocator fromZero(0);
+    EXPECT_EQ(fromZero.next(), 2u);
+}
+
+TEST(Ocp1HandleAllocatorTest, WrapsAroundSkippingZeroAndOne)
+{
+    Ocp1HandleAllocator handles(0xFFFFFFFEu);
+    EXPECT_EQ(handles.next(), 0xFFFFFFFEu);
+    EXPECT_EQ(handles.next(), 0xFFFFFFFFu);
+    EXPECT_EQ(handles.peek(), 2u);
+    EXPECT_EQ(handles.next(), 2u);
+}
+
+TEST(Ocp1HandleAllocatorTest, ReservedBlocksAreConsecutiveAndNeverWrap)
+{
+    Ocp1HandleAllocator handles;
+    EXPECT_EQ(handles.reserve(100), 2u);
+    EXPECT_EQ(handles.next(), 102u);
+
+    // A block that does not fit before the wraparound starts over at 2.
+    handles.reset(0xFFFFFFF0u);
+    EXPECT_EQ(handles.reserve(16), 0xFFFFFFF0u);
+    handles.reset(0xFFFFFFF0u);
+    EXPECT_EQ(handles.reserve(17), 2u);
+    EXPECT_EQ(handles.next(), 19u);
+
+    EXPECT_EQ(handles.reserve(0), Ocp1HandleAllocator::InvalidHandle);
+    EXPECT_EQ(handles.reserve(0xFFFFFFFFu), Ocp1HandleAllocator::InvalidHandle);
+    EXPECT_EQ(handles.next(), 20u);
+}
+
+TEST(Ocp1HandleAllocatorTest, ConcurrentCallersNeverShareAHandle)
+{
+    constexpr int numThreads = 4;
+    constexpr int numBlocks  = 2000;
+
+    Ocp1HandleAllocator handles;
+    std::vector<std::vector<std::uint32_t>> taken(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                const auto count = static_cast<std::uint32_t>(1 + i % 3);
+                const auto first = handles.reserve(count);
+                for (std::uint32_t h = first; h < first + count; ++h)
+                    taken[t].push_back(h);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    std::set<std::uint32_t> unique;
+    std::size_t total = 0;
+    for (const auto& list : taken)
+    {
+        total += list.size();
+        unique.insert(list.begin(), list.end());
+    }
+    EXPECT_EQ(unique.size(), total);
+    EXPECT_EQ(*unique.begin(), 2u);
+    EXPECT_EQ(*unique.rbegin(), 2u + total - 1);
+}
+
+TEST(Ocp1HandleAllocatorTest, CommandsTakeHandlesFromTheGivenAllocator)
+{
+    Ocp1HandleAllocator first(100), second(100);
+    const Ocp1CommandDefinition def(0x10000100, OCP1DATATYPE_FLOAT32, 4, 1);
+
+    std::uint32_t handle{0};
+    Ocp1CommandResponseRequired a(def, first, handle);
+    EXPECT_EQ(handle, 100u);
+    EXPECT_EQ(a.GetHandle(), 100u);
+    Ocp1CommandResponseRequired b(def, second, handle);
+    EXPECT_EQ(b.GetHandle(), 100u);
+    Ocp1CommandResponseRequired c(def, first, handle);
+    EXPECT_EQ(c.GetHandle(), 101u);
+
+    // Without an allocator the handle is left for SetHandle().
+    Ocp1CommandResponseRequired d(def);
+    EXPECT_EQ(d.GetHandle(), 0u);
+
+    // The legacy constructor still hands out valid, distinct handles.
+    std::uint32_t legacy1{0}, legacy2{0};
+    Ocp1CommandResponseRequired e(def, legacy1);
+    Ocp1CommandResponseRequired f(def, legacy2);
+    EXPECT_GE(legacy1, Ocp1HandleAllocator::FirstHandle);
+    EXPECT_NE(legacy1, legacy2);
+}
@@ -3,6 +3,9 @@
 #include "Ocp1Message.h"
 #include "Ocp1ObjectDefinitions.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace NanoOcp1;
 
 //==============================================================================
@@ -34,6 +37,7 @@ TEST(Ocp1HeaderTest, CalculateMessageSizeMatchesDocumentedFormulasPerType)
     EXPECT_EQ(Ocp1Header::CalculateMessageSize(Ocp1Message::Notification, 4), 41u);
     EXPECT_EQ(Ocp1Header::CalculateMessageSize(Ocp1Message::Response, 4), 23u);
     EXPECT_EQ(Ocp1Header::CalculateMessageSize(Ocp1Message::KeepAlive, 2), 11u);
+    EXPECT_EQ(Ocp1Header::CalculateMessageSize(Ocp1Message::Notification2, 4), 33u);
 }
 
 //==============================================================================
@@ -94,6 +98,61 @@ TEST(Ocp1CommandResponseRequiredTest, SerializeThenUnmarshalRoundTrips)
     EXPECT_EQ(parsed->GetParameterData(), paramData);
 }
 
+//==============================================================================
+// Ocp1Command — fire-and-forget, same layout as CommandResponseRequired
+//==============================================================================
+
+TEST(Ocp1CommandTest, DiffersFromCommandResponseRequiredOnlyInType)
+{
+    Ocp1Command cmd(0x10000100, 4, 2, 1, DataFromFloat(0.5f));
+    cmd.SetHandle(9);
+    Ocp1CommandResponseRequired crr(0x10000100, 4, 2, 1, DataFromFloat(0.5f));
+    crr.SetHandle(9);
+
+    auto bytes = cmd.GetSerializedData();
+    EXPECT_EQ(bytes[7], Ocp1Message::Command);
+    bytes[7] = Ocp1Message::CommandResponseRequired;
+    EXPECT_EQ(bytes, crr.GetSerializedData());
+}
+
+TEST(Ocp1CommandTest, SerializeThenUnmarshalRoundTrips)
+{
+    const Ocp1CommandDefinition def(0x10000100, OCP1DATATYPE_FLOAT32, 4, 1);
+    Ocp1HandleAllocator handles;
+    std::uint32_t handle{0};
+    Ocp1Command cmd(def.SetValueCommand(Variant(-3.0f)), handles, handle);
+    EXPECT_EQ(handle, Ocp1HandleAllocator::FirstHandle);
+
+    auto unmarshaled = Ocp1Message::UnmarshalOcp1Message(cmd.GetSerializedData());
+    ASSERT_NE(unmarshaled, nullptr);
+    ASSERT_EQ(unmarshaled->GetMessageType(), Ocp1Message::Command);
+    auto* parsed = static_cast<Ocp1Command*>(unmarshaled.get());
+    EXPECT_EQ(parsed->GetHandle(), handle);
+    EXPECT_EQ(parsed->GetTargetOno(), 0x10000100u);
+    EXPECT_EQ(parsed->GetMethodIndex(), 2);
+    EXPECT_EQ(parsed->GetParamCount(), 1);
+    EXPECT_FLOAT_EQ(DataToFloat(parsed->GetParameterData()), -3.0f);
+
+    // The prepared form produces the same frame.
+    const auto prepared = Ocp1PreparedCommand::SetValue(def, Ocp1Message::Command);
+    EXPECT_EQ(prepared.GetMessageType(), Ocp1Message::Command);
+    EXPECT_EQ(prepared.GetSerializedData(handle, DataFromFloat(-3.0f)), cmd.GetSerializedData());
+    EXPECT_FALSE(Ocp1PreparedCommand::SetValue(def, Ocp1Message::Response).IsValid());
+}
+
+TEST(Ocp1CommandTest, OnlyCommandResponseRequiredNeedsAHandle)
+{
+    Ocp1Command cmd(0x10000100, 4, 2, 0, {});
+    Ocp1CommandView view;
+    ASSERT_TRUE(Ocp1Message::ParseCommand(cmd.GetSerializedData(), view));
+    EXPECT_FALSE(view.responseRequired);
+    EXPECT_EQ(view.handle, 0u);
+
+    Ocp1CommandResponseRequired crr(0x10000100, 4, 2, 0, {});
+    EXPECT_FALSE(Ocp1Message::ParseCommand(crr.GetSerializedData(), view));
+    EXPECT_EQ(Ocp1Message::UnmarshalOcp1Message(crr.GetSerializedData()), nullptr);
+}
+
 //==============================================================================
 // Ocp1Response — byte-exact golden test + round trip
 //==============================================================================
@@ -136,6 +195,23 @@ TEST(Ocp1ResponseTest, SerializeThenUnmarshalRoundTrips)
     EXPECT_EQ(parsed->GetParameterData(), paramData);
 }
 
+TEST(Ocp1ResponseTest, ParseResponsePointsIntoFrame)
+{
+    const ByteVector paramData = DataFromFloat(-6.0f);
+    const auto bytes = Ocp1Response(0x1234, 0, 1, paramData).GetSerializedData();
+
+    Ocp1ResponseView view;
+    ASSERT_TRUE(Ocp1Message::ParseResponse(bytes, view));
+    EXPECT_EQ(view.handle, 0x1234u);
+    EXPECT_EQ(view.status, 0);
+    EXPECT_EQ(view.paramCount, 1);
+    EXPECT_EQ(view.parameterData.data(), bytes.data() + 20);
+    EXPECT_EQ(ByteVector(view.parameterData.begin(), view.parameterData.end()), paramData);
+
+    Ocp1NotificationView wrongType;
+    EXPECT_FALSE(Ocp1Message::ParseNotification(bytes, wrongType));
+}
+
 //==============================================================================
 // Ocp1Notification — structural checks + round trip
 //==============================================================================
@@ -180,6 +256,115 @@ TEST(Ocp1NotificationTest, SerializeThenUnmarshalRoundTrips)
     EXPECT_TRUE(parsed->MatchesObject(&def));
 }
 
+TEST(Ocp1NotificationTest, ParseNotificationPointsIntoFrame)
+{
+    const ByteVector paramData = DataFromFloat(0.75f);
+    const auto bytes = Ocp1Notification(0x42, 4, 1, static_cast<std::uint8_t>(1), paramData).GetSerializedData();
+
+    Ocp1Message::MessageType type;
+    ASSERT_TRUE(Ocp1Message::PeekMessageType(bytes, type));
+    EXPECT_EQ(type, Ocp1Message::Notification);
+
+    Ocp1NotificationView view;
+    ASSERT_TRUE(Ocp1Message::ParseNotification(bytes, view));
+    EXPECT_EQ(view.emitterOno, 0x42u);
+    EXPECT_EQ(view.emitterPropertyDefLevel, 4);
+    EXPECT_EQ(view.emitterPropertyIndex, 1);
+    EXPECT_EQ(ByteVector(view.parameterData.begin(), view.parameterData.end()), paramData);
+    EXPECT_GE(view.parameterData.data(), bytes.data());
+    EXPECT_LE(view.parameterData.data() + view.parameterData.size(), bytes.data() + bytes.size());
+
+    Ocp1ResponseView wrongType;
+    EXPECT_FALSE(Ocp1Message::ParseResponse(bytes, wrongType));
+}
+
+//==============================================================================
+// Ocp1Notification2 — byte-exact golden test, round trip, format detection
+//==============================================================================
+
+TEST(Ocp1Notification2Test, SerializedBytesMatchWireFormat)
+{
+    Ocp1Notification2 notif(0x00000042, /*propDefLevel*/ 4, /*propIdx*/ 1,
+                            static_cast<std::uint8_t>(1), DataFromFloat(0.75f));
+
+    const ByteVector expected = {
+        0x3B, 0x00, 0x01, 0x00, 0x00, 0x00, 0x21, 0x05, 0x00, 0x01, // Header: size 33, type 5
+        0x00, 0x00, 0x00, 0x18,                                     // NotificationSize
+        0x00, 0x00, 0x00, 0x42,                                     // EmitterONo
+        0x00, 0x01, 0x00, 0x01,                                     // EventID: PropertyChanged
+        0x00,                                                       // NotificationType: Event
+        0x00, 0x09,                                                 // Event data length
+        0x00, 0x04, 0x00, 0x01,                                     // PropertyID
+        0x3F, 0x40, 0x00, 0x00,                                     // Value 0.75f
+        0x01,                                                       // ChangeType: CurrentChanged
+    };
+    EXPECT_EQ(notif.GetSerializedData(), expected);
+
+    // Eight bytes less than the classic format for the same change.
+    const auto legacy = Ocp1Notification(0x42, 4, 1, static_cast<std::uint8_t>(1), DataFromFloat(0.75f)).GetSerializedData();
+    EXPECT_EQ(legacy.size(), expected.size() + 8);
+}
+
+TEST(Ocp1Notification2Test, SerializeThenUnmarshalRoundTrips)
+{
+    const ByteVector paramData = DataFromFloat(-42.0f);
+    Ocp1Notification2 notif(0x10000001, 4, 1, static_cast<std::uint8_t>(1), paramData);
+    auto unmarshaled = Ocp1Message::UnmarshalOcp1Message(notif.GetSerializedData());
+
+    ASSERT_NE(unmarshaled, nullptr);
+    ASSERT_EQ(unmarshaled->GetMessageType(), Ocp1Message::Notification2);
+
+    auto* parsed = static_cast<Ocp1Notification*>(unmarshaled.get());
+    EXPECT_EQ(parsed->GetEmitterOno(), 0x10000001u);
+    EXPECT_EQ(parsed->GetEmitterPropertyDefLevel(), 4);
+    EXPECT_EQ(parsed->GetEmitterPropertyIndex(), 1);
+    EXPECT_EQ(parsed->GetParameterData(), paramData);
+}
+
+TEST(Ocp1Notification2Test, ParseNotificationAcceptsBothFormats)
+{
+    const ByteVector paramData = DataFromFloat(0.75f);
+    const auto legacy  = Ocp1Notification(0x42, 4, 1, static_cast<std::uint8_t>(1), paramData).GetSerializedData();
+    const auto compact = Ocp1Notification2(0x42, 4, 1, static_cast<std::uint8_t>(1), paramData).GetSerializedData();
+
+    for (const auto* bytes : { &legacy, &compact })
+    {
+        Ocp1NotificationView view;
+        ASSERT_TRUE(Ocp1Message::ParseNotification(*bytes, view));
+        EXPECT_EQ(view.emitterOno, 0x42u);
+        EXPECT_EQ(view.emitterPropertyDefLevel, 4);
+        EXPECT_EQ(view.emitterPropertyIndex, 1);
+        EXPECT_EQ(ByteVector(view.parameterData.begin(), view.parameterData.end()), paramData);
+    }
+
+    // Packed into one PDU, every message is read with the compact layout.
+    Ocp1PduBuilder builder(Ocp1Message::Notification2);
+    for (std::uint32_t ono = 1; ono <= 3; ++ono)
+    {
+        Ocp1Notification2 notif(ono, 4, 1, static_cast<std::uint8_t>(1), paramData);
+        ASSERT_TRUE(builder.Add(notif));
+    }
+    const auto pduBytes = builder.GetSerializedData();
+
+    Ocp1PduReader pdu(pduBytes);
+    Ocp1NotificationView view;
+    std::uint32_t expectedOno = 1;
+    while (pdu.Next(view))
+        EXPECT_EQ(view.emitterOno, expectedOno++);
+    EXPECT_TRUE(pdu.IsValid());
+    EXPECT_EQ(expectedOno, 4u);
+}
+
+TEST(Ocp1Notification2Test, ExceptionNotificationIsRejected)
+{
+    auto bytes = Ocp1Notification2(0x42, 4, 1, static_cast<std::uint8_t>(1), DataFromFloat(0.75f)).GetSerializedData();
+    bytes[22] = 0x01; // NotificationType: Exception
+
+    Ocp1NotificationView view;
+    EXPECT_FALSE(Ocp1Message::ParseNotification(bytes, view));
+    EXPECT_EQ(Ocp1Message::UnmarshalOcp1Message(bytes), nullptr);
+}
+
 //==============================================================================
 // Ocp1KeepAlive — byte-exact golden test + round trip
 //==============================================================================
@@ -256,6 +441,12 @@ TEST(Ocp1UnmarshalTruncationTest, CommandResponseRequiredRejectsAllTruncations)
     ExpectAllTruncationsRejected(cmd.GetSerializedData());
 }
 
+TEST(Ocp1UnmarshalTruncationTest, CommandRejectsAllTruncations)
+{
+    Ocp1Command cmd(0x12345678, 4, 2, static_cast<std::uint8_t>(1), DataFromUint32(0xCAFEBABE));
+    ExpectAllTruncationsRejected(cmd.GetSerializedData());
+}
+
 TEST(Ocp1UnmarshalTruncationTest, ResponseRejectsAllTruncations)
 {
     // Non-empty parameter data exercises the parameterDataLength bounds check
@@ -282,6 +473,14 @@ TEST(Ocp1UnmarshalTruncationTest, NotificationRejectsAllTruncations)
     ExpectAllTruncationsRejected(notif.GetSerializedData(), /*tolerantTrailingBytes*/ 1);
 }
 
+TEST(Ocp1UnmarshalTruncationTest, Notification2RejectsAllTruncations)
+{
+    // Unlike the classic format, the trailing ChangeType byte is covered by the
+    // event data length, so no truncation is tolerated.
+    Ocp1Notification2 notif(0x42, 4, 1, static_cast<std::uint8_t>(1), DataFromFloat(0.75f));
+    ExpectAllTruncationsRejected(notif.GetSerializedData());
+}
+
 TEST(Ocp1UnmarshalTruncationTest, KeepAliveRejectsAllTruncations)
 {
     Ocp1KeepAlive keepAlive(static_cast<std::uint16_t>(5));
@@ -297,6 +496,320 @@ TEST(Ocp1UnmarshalTruncationTest, EmptyBufferIsRejected)
 // already covered above — it's just the len==10 iteration of each
 // *RejectsAllTruncations test on a real, self-consistent message.
 
+//==============================================================================
+// SerializeInto — same bytes as GetSerializedData(), into caller-owned memory
+//==============================================================================
+
+TEST(Ocp1SerializeIntoTest, MatchesGetSerializedDataForEveryType)
+{
+    NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel def(/*channel*/ 2);
+    std::uint32_t handle{0};
+    Ocp1CommandResponseRequired command(def.SetValueCommand(Variant(-3.0f)), handle);
+    Ocp1Response response(handle, 0, 1, DataFromFloat(-3.0f));
+    Ocp1Notification notification(def.m_targetOno, 4, 1, 1, DataFromFloat(-3.0f));
+    Ocp1KeepAlive keepAliveSeconds(static_cast<std::uint16_t>(5));
+    Ocp1KeepAlive keepAliveMilliseconds(static_cast<std::uint32_t>(1500));
+
+    for (Ocp1Message* message : std::initializer_list<Ocp1Message*>{ &command, &response, &notification,
+                                                                      &keepAliveSeconds, &keepAliveMilliseconds })
+    {
+        const auto expected = message->GetSerializedData();
+        EXPECT_EQ(message->GetSerializedSize(), expected.size());
+
+        std::uint8_t buffer[128];
+        std::fill(std::begin(buffer), std::end(buffer), static_cast<std::uint8_t>(0xa5));
+        ASSERT_EQ(message->SerializeInto(buffer, sizeof(buffer)), expected.size());
+        EXPECT_EQ(ByteVector(buffer, buffer + expected.size()), expected);
+        EXPECT_EQ(buffer[expected.size()], 0xa5); // nothing written past the message
+    }
+}
+
+TEST(Ocp1SerializeIntoTest, RejectsTooSmallBufferWithoutWriting)
+{
+    Ocp1Response response(0x42, 0, 1, DataFromFloat(1.0f));
+    const auto size = response.GetSerializedSize();
+
+    ByteVector buffer(size - 1, 0xa5);
+    EXPECT_EQ(response.SerializeInto(buffer.data(), buffer.size()), 0u);
+    EXPECT_EQ(buffer, ByteVector(size - 1, 0xa5));
+    EXPECT_EQ(response.SerializeInto(nullptr, size), 0u);
+}
+
+//==============================================================================
+// Ocp1PduBuilder / Ocp1PduReader — several messages behind one header
+//==============================================================================
+
+TEST(Ocp1PduTest, BuilderPacksCommandsBehindOneHeader)
+{
+    Ocp1PduBuilder pdu;
+    ByteVector expectedBody;
+    std::vector<std::uint32_t> handles;
+    for (std::uint32_t channel = 1; channel <= 3; ++channel)
+    {
+        NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel def(channel);
+        std::uint32_t handle{0};
+        Ocp1CommandResponseRequired cmd(def.GetValueCommand(), handle);
+        handles.push_back(handle);
+        const auto single = cmd.GetSerializedData();
+        expectedBody.insert(expectedBody.end(), single.begin() + Ocp1Header::Ocp1HeaderSize, single.end());
+        ASSERT_TRUE(pdu.Add(cmd));
+    }
+    EXPECT_EQ(pdu.GetMessageCount(), 3);
+
+    const auto bytes = pdu.GetSerializedData();
+    ASSERT_EQ(bytes.size(), Ocp1Header::Ocp1HeaderSize + expectedBody.size());
+    EXPECT_EQ(bytes[0], 0x3b);
+    EXPECT_EQ(ReadUint16(bytes.data() + 1), 1);
+    EXPECT_EQ(ReadUint32(bytes.data() + 3), bytes.size() - 1);
+    EXPECT_EQ(bytes[7], Ocp1Message::CommandResponseRequired);
+    EXPECT_EQ(ReadUint16(bytes.data() + 8), 3);
+    EXPECT_EQ(ByteVector(bytes.begin() + Ocp1Header::Ocp1HeaderSize, bytes.end()), expectedBody);
+
+    auto messages = Ocp1Message::UnmarshalOcp1Messages(bytes);
+    ASSERT_EQ(messages.size(), 3u);
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        ASSERT_EQ(messages[i]->GetMessageType(), Ocp1Message::CommandResponseRequired);
+        auto* cmd = static_cast<Ocp1CommandResponseRequired*>(messages[i].get());
+        EXPECT_EQ(cmd->GetHandle(), handles[i]);
+        EXPECT_EQ(cmd->GetTargetOno(),
+                  NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel(static_cast<std::uint32_t>(i + 1)).m_targetOno);
+    }
+
+    pdu.Clear();
+    EXPECT_TRUE(pdu.IsEmpty());
+    EXPECT_TRUE(pdu.GetSerializedData().empty());
+}
+
+TEST(Ocp1PduTest, BuilderRejectsOtherTypesAndKeepAlives)
+{
+    Ocp1PduBuilder commands;
+    Ocp1Response resp(0x42, 0, 0, {});
+    EXPECT_FALSE(commands.Add(resp));
+    EXPECT_TRUE(commands.IsEmpty());
+
+    Ocp1PduBuilder keepAlives(Ocp1Message::KeepAlive);
+    Ocp1KeepAlive keepAlive(static_cast<std::uint16_t>(5));
+    EXPECT_FALSE(keepAlives.Add(keepAlive));
+}
+
+TEST(Ocp1PduTest, ReaderParsesEveryNotificationInPlace)
+{
+    Ocp1PduBuilder pdu(Ocp1Message::Notification);
+    for (std::uint32_t ono = 0x10001; ono <= 0x10003; ++ono)
+    {
+        Ocp1Notification notif(ono, 4, 1, 1, DataFromFloat(-static_cast<float>(ono & 0xff)));
+        ASSERT_TRUE(pdu.Add(notif));
+    }
+    const auto bytes = pdu.GetSerializedData();
+
+    Ocp1PduReader reader(bytes);
+    ASSERT_TRUE(reader.IsValid());
+    EXPECT_EQ(reader.GetMessageType(), Ocp1Message::Notification);
+    EXPECT_EQ(reader.GetMessageCount(), 3);
+
+    Ocp1NotificationView view;
+    for (std::uint32_t ono = 0x10001; ono <= 0x10003; ++ono)
+    {
+        ASSERT_TRUE(reader.Next(view));
+        EXPECT_EQ(view.emitterOno, ono);
+        EXPECT_EQ(view.emitterPropertyDefLevel, 4);
+        EXPECT_FLOAT_EQ(DataToFloat(ByteVector(view.parameterData.begin(), view.parameterData.end())),
+                        -static_cast<float>(ono & 0xff));
+        EXPECT_GE(view.parameterData.data(), bytes.data());
+        EXPECT_LE(view.parameterData.data() + view.parameterData.size(), bytes.data() + bytes.size());
+    }
+    EXPECT_FALSE(reader.Next(view));
+    EXPECT_TRUE(reader.IsValid());
+
+    // The single-message API still sees the first message.
+    ASSERT_TRUE(Ocp1Message::ParseNotification(bytes, view));
+    EXPECT_EQ(view.emitterOno, 0x10001u);
+    Ocp1ResponseView wrongType;
+    EXPECT_FALSE(Ocp1PduReader(bytes).Next(wrongType));
+}
+
+TEST(Ocp1PduTest, ReaderStopsAtMalformedMessage)
+{
+    Ocp1PduBuilder pdu(Ocp1Message::Response);
+    Ocp1Response first(0x100, 0, 0, {});
+    Ocp1Response second(0x101, 0, 1, DataFromFloat(1.0f));
+    ASSERT_TRUE(pdu.Add(first));
+    ASSERT_TRUE(pdu.Add(second));
+    const auto valid = pdu.GetSerializedData();
+    ASSERT_EQ(Ocp1Message::UnmarshalOcp1Messages(valid).size(), 2u);
+
+    // The second message claims to extend past the end of the PDU.
+    auto oversized = valid;
+    oversized[Ocp1Header::Ocp1HeaderSize + 10 + 3] = 0xff;
+    Ocp1PduReader reader(oversized);
+    Ocp1ResponseView view;
+    ASSERT_TRUE(reader.Next(view));
+    EXPECT_EQ(view.handle, 0x100u);
+    EXPECT_FALSE(reader.Next(view));
+    EXPECT_FALSE(reader.IsValid());
+    EXPECT_TRUE(Ocp1Message::UnmarshalOcp1Messages(oversized).empty());
+
+    // The header announces a third message that is not there.
+    auto overcounted = valid;
+    overcounted[9] = 3;
+    EXPECT_TRUE(Ocp1Message::UnmarshalOcp1Messages(overcounted).empty());
+}
+
+//==============================================================================
+// Message views / VisitOcp1Messages — every type parsed in place
+//==============================================================================
+
+TEST(Ocp1MessageViewTest, ParseCommandPointsIntoFrame)
+{
+    Ocp1CommandResponseRequired cmd(0x10000100, 4, 2, 1, DataFromFloat(-12.0f));
+    cmd.SetHandle(0x42);
+    const auto bytes = cmd.GetSerializedData();
+
+    Ocp1CommandView view;
+    ASSERT_TRUE(Ocp1Message::ParseCommand(bytes, view));
+    EXPECT_TRUE(view.responseRequired);
+    EXPECT_EQ(view.handle, 0x42u);
+    EXPECT_EQ(view.targetOno, 0x10000100u);
+    EXPECT_EQ(view.methodDefLevel, 4);
+    EXPECT_EQ(view.methodIndex, 2);
+    EXPECT_EQ(view.paramCount, 1);
+    ASSERT_EQ(view.parameterData.size(), 4u);
+    EXPECT_EQ(view.parameterData.data(), bytes.data() + Ocp1Header::Ocp1HeaderSize + 17);
+
+    // A truncated command and other message types are rejected.
+    EXPECT_FALSE(Ocp1Message::ParseCommand(ByteSpan(bytes.data(), bytes.size() - 1), view));
+    Ocp1NotificationView wrongType;
+    EXPECT_FALSE(Ocp1Message::ParseNotification(bytes, wrongType));
+    EXPECT_FALSE(Ocp1Message::ParseCommand(Ocp1KeepAlive(static_cast<std::uint16_t>(1)).GetSerializedData(), view));
+}
+
+TEST(Ocp1MessageViewTest, ParseKeepAliveDistinguishesSecondsAndMilliseconds)
+{
+    Ocp1KeepAliveView view;
+    ASSERT_TRUE(Ocp1Message::ParseKeepAlive(Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData(), view));
+    EXPECT_EQ(view.heartBeatSeconds, 5);
+    EXPECT_EQ(view.heartBeatMilliseconds, 0u);
+
+    ASSERT_TRUE(Ocp1Message::ParseKeepAlive(Ocp1KeepAlive(static_cast<std::uint32_t>(12345)).GetSerializedData(), view));
+    EXPECT_EQ(view.heartBeatSeconds, 0);
+    EXPECT_EQ(view.heartBeatMilliseconds, 12345u);
+
+    auto bytes = Ocp1KeepAlive(static_cast<std::uint16_t>(5)).GetSerializedData();
+    bytes.pop_back();
+    EXPECT_FALSE(Ocp1Message::ParseKeepAlive(bytes, view));
+}
+
+TEST(Ocp1MessageViewTest, ReaderYieldsVariantPerMessageType)
+{
+    Ocp1PduBuilder pdu;
+    Ocp1CommandResponseRequired first(0x10001, 4, 1, 0, {});
+    Ocp1CommandResponseRequired second(0x10002, 4, 2, 1, DataFromFloat(1.0f));
+    first.SetHandle(7);
+    second.SetHandle(8);
+    ASSERT_TRUE(pdu.Add(first));
+    ASSERT_TRUE(pdu.Add(second));
+    const auto bytes = pdu.GetSerializedData();
+
+    Ocp1PduReader reader(bytes);
+    Ocp1MessageView view;
+    ASSERT_TRUE(reader.Next(view));
+    ASSERT_TRUE(std::holds_alternative<Ocp1CommandView>(view));
+    EXPECT_EQ(std::get<Ocp1CommandView>(view).handle, 7u);
+    EXPECT_TRUE(std::get<Ocp1CommandView>(view).parameterData.empty());
+    ASSERT_TRUE(reader.Next(view));
+    EXPECT_EQ(std::get<Ocp1CommandView>(view).handle, 8u);
+    EXPECT_EQ(std::get<Ocp1CommandView>(view).parameterData.size(), 4u);
+    EXPECT_FALSE(reader.Next(view));
+    EXPECT_TRUE(reader.IsValid());
+
+    const auto keepAlive = Ocp1KeepAlive(static_cast<std::uint16_t>(3)).GetSerializedData();
+    Ocp1PduReader keepAliveReader(keepAlive);
+    ASSERT_TRUE(keepAliveReader.Next(view));
+    ASSERT_TRUE(std::holds_alternative<Ocp1KeepAliveView>(view));
+    EXPECT_EQ(std::get<Ocp1KeepAliveView>(view).heartBeatSeconds, 3);
+}
+
+TEST(Ocp1MessageViewTest, VisitorSeesEveryMessageInOrder)
+{
+    Ocp1PduBuilder pdu(Ocp1Message::Notification);
+    for (std::uint32_t ono = 0x10001; ono <= 0x10003; ++ono)
+    {
+        Ocp1Notification notif(ono, 4, 1, 1, DataFromFloat(static_cast<float>(ono & 0xff)));
+        ASSERT_TRUE(pdu.Add(notif));
+    }
+    const auto bytes = pdu.GetSerializedData();
+
+    std::vector<std::uint32_t> onos;
+    int others = 0;
+    EXPECT_TRUE(VisitOcp1Messages(bytes, Ocp1Overloaded{
+        [&](const Ocp1NotificationView& notif) {
+            EXPECT_GE(notif.parameterData.data(), bytes.data());
+            EXPECT_LE(notif.parameterData.data() + notif.parameterData.size(), bytes.data() + bytes.size());
+            onos.push_back(notif.emitterOno);
+        },
+        [&](const auto&) { ++others; } }));
+    EXPECT_EQ(onos, (std::vector<std::uint32_t>{ 0x10001, 0x10002, 0x10003 }));
+    EXPECT_EQ(others, 0);
+
+    // Malformed input is reported, messages before the fault are still visited.
+    auto overcounted = bytes;
+    overcounted[9] = 4;
+    onos.clear();
+    EXPECT_FALSE(VisitOcp1Messages(overcounted, [&](const auto&) { onos.push_back(0); }));
+    EXPECT_EQ(onos.size(), 3u);
+    EXPECT_FALSE(VisitOcp1Messages(ByteSpan(), [&](const auto&) { ++others; }));
+    EXPECT_EQ(others, 0);
+}
+
+//==============================================================================
+// Ocp1PreparedCommand — same bytes as a freshly built command
+//==============================================================================
+
+TEST(Ocp1PreparedCommandTest, MatchesCommandResponseRequiredForEveryHandleAndValue)
+{
+    const Ocp1CommandDefinition def(0x10000100, OCP1DATATYPE_FLOAT32, 4, 1);
+    const auto prepared = Ocp1PreparedCommand::SetValue(def);
+    ASSERT_TRUE(prepared.IsValid());
+    EXPECT_EQ(prepared.GetTargetOno(), 0x10000100u);
+    EXPECT_EQ(prepared.GetDataType(), OCP1DATATYPE_FLOAT32);
+
+    std::uint8_t frame[64];
+    for (std::uint32_t handle : { 2u, 0x12345678u })
+        for (float value : { -6.0f, 0.5f })
+        {
+            Ocp1CommandResponseRequired expected(def.SetValueCommand(Variant(value)));
+            expected.SetHandle(handle);
+            const auto params = DataFromFloat(value);
+
+            const auto size = prepared.SerializeInto(frame, sizeof(frame), handle, params);
+            EXPECT_EQ(ByteVector(frame, frame + size), expected.GetSerializedData());
+            EXPECT_EQ(prepared.GetSerializedData(handle, params), expected.GetSerializedData());
+        }
+
+    // Parameters of another size change both size fields.
+    const auto get = Ocp1PreparedCommand(def.GetValueCommand());
+    Ocp1CommandResponseRequired expected(def.GetValueCommand());
+    expected.SetHandle(7);
+    EXPECT_EQ(get.GetSerializedData(7, ByteSpan()), expected.GetSerializedData());
+}
+
+TEST(Ocp1PreparedCommandTest, RejectsInvalidCommandsAndSmallBuffers)
+{
+    const Ocp1CommandDefinition def(0x10000100, OCP1DATATYPE_FLOAT32, 4, 1);
+    const auto prepared = Ocp1PreparedCommand::SetValue(def);
+    const auto params = DataFromFloat(1.0f);
+
+    std::uint8_t frame[64] = {};
+    EXPECT_EQ(prepared.SerializeInto(frame, prepared.GetSerializedSize(params.size()) - 1, 2, params), 0u);
+    EXPECT_EQ(frame[0], 0u);
+    EXPECT_EQ(prepared.SerializeInto(nullptr, sizeof(frame), 2, params), 0u);
+
+    EXPECT_FALSE(Ocp1PreparedCommand().IsValid());
+    EXPECT_TRUE(Ocp1PreparedCommand().GetSerializedData(2, params).empty());
+    EXPECT_FALSE(Ocp1PreparedCommand(Ocp1CommandDefinition()).IsValid());
+}
+
 //==============================================================================
 // Ocp1CommandDefinition factory methods (via a concrete object definition)
 //==============================================================================
@@ -346,3 +859,25 @@ TEST(Ocp1CommandDefinitionTest, RemoveSubscriptionCommandTargetsSubscriptionMana
     EXPECT_EQ(unsubCmd.m_paramCount, 2);
     EXPECT_EQ(unsubCmd.m_parameterData, DataFromOnoForSubscription(def.m_targetOno, false));
 }
+
+TEST(Ocp1CommandDefinitionTest, Subscription2CommandsTargetSubscriptionManager)
+{
+    NanoOcp1::AmpGeneric::dbOcaObjectDef_Config_PotiLevel def(/*channel*/ 5);
+    auto subCmd   = def.AddSubscription2Command();
+    auto unsubCmd = def.RemoveSubscription2Command();
+
+    EXPECT_EQ(subCmd.m_targetOno, 0x00000004u);
+    EXPECT_EQ(subCmd.m_propertyDefLevel, 3);
+    EXPECT_EQ(subCmd.m_propertyIndex, 8);
+    EXPECT_EQ(subCmd.m_paramCount, 3);
+    EXPECT_EQ(unsubCmd.m_propertyIndex, 9);
+    EXPECT_EQ(unsubCmd.m_paramCount, 3);
+
+    // Event (emitter ONo + PropertyChanged), delivery mode, empty destination.
+    const auto& data = subCmd.m_parameterData;
+    ASSERT_EQ(data.size(), 15u);
+    EXPECT_EQ(ReadUint32(data.data()), def.m_targetOno);
+    EXPECT_EQ(data[8], 0x01);
+    EXPECT_EQ(ReadUint16(data.data() + 9), 4);
+    EXPECT_EQ(unsubCmd.m_parameterData, data);
+}
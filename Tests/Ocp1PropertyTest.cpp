@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include "Ocp1DS100ObjectDefinitions.h"
+#include "Ocp1Property.h"
+
+#include <array>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace NanoOcp1;
+
+//==============================================================================
+// Ocp1ValueCodec — same bytes as the DataFrom* / Variant marshaling
+//==============================================================================
+
+namespace
+{
+    template <typename T>
+    T DecodeOrFail(const ByteVector& data)
+    {
+        T value{};
+        EXPECT_TRUE(Ocp1Property<T>::Decode(data, value));
+        return value;
+    }
+}
+
+TEST(Ocp1ValueCodecTest, ScalarsMatchDataFromHelpers)
+{
+    EXPECT_EQ(Ocp1Property<float>::Encode(-6.5f), DataFromFloat(-6.5f));
+    EXPECT_EQ(Ocp1Property<double>::Encode(1.0 / 3.0), DataFromDouble(1.0 / 3.0));
+    EXPECT_EQ(Ocp1Property<bool>::Encode(true), DataFromBool(true));
+    EXPECT_EQ(Ocp1Property<std::int32_t>::Encode(-123456), DataFromInt32(-123456));
+    EXPECT_EQ(Ocp1Property<std::uint8_t>::Encode(200), DataFromUint8(200));
+    EXPECT_EQ(Ocp1Property<std::uint16_t>::Encode(0xBEEF), DataFromUint16(0xBEEF));
+    EXPECT_EQ(Ocp1Property<std::uint32_t>::Encode(0xCAFEBABE), DataFromUint32(0xCAFEBABE));
+    EXPECT_EQ(Ocp1Property<std::uint64_t>::Encode(0x0123456789ABCDEFull), DataFromUint64(0x0123456789ABCDEFull));
+
+    EXPECT_EQ(DecodeOrFail<float>(DataFromFloat(-6.5f)), -6.5f);
+    EXPECT_EQ(DecodeOrFail<double>(DataFromDouble(1.0 / 3.0)), 1.0 / 3.0);
+    EXPECT_TRUE(DecodeOrFail<bool>(DataFromBool(true)));
+    EXPECT_EQ(DecodeOrFail<std::int32_t>(DataFromInt32(-123456)), -123456);
+    EXPECT_EQ(DecodeOrFail<std::uint16_t>(DataFromUint16(0xBEEF)), 0xBEEF);
+    EXPECT_EQ(DecodeOrFail<std::uint64_t>(DataFromUint64(0x0123456789ABCDEFull)), 0x0123456789ABCDEFull);
+}
+
+TEST(Ocp1ValueCodecTest, SignedIntegersRoundTripAtTheirLimits)
+{
+    EXPECT_EQ(DecodeOrFail<std::int8_t>(Ocp1Property<std::int8_t>::Encode(-128)), -128);
+    EXPECT_EQ(DecodeOrFail<std::int16_t>(Ocp1Property<std::int16_t>::Encode(-32768)), -32768);
+    EXPECT_EQ(DecodeOrFail<std::int64_t>(Ocp1Property<std::int64_t>::Encode(std::numeric_limits<std::int64_t>::min())),
+              std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(Ocp1Property<std::int16_t>::Encode(-2), (ByteVector{ 0xFF, 0xFE }));
+}
+
+TEST(Ocp1ValueCodecTest, PositionsMatchDataFromHelpers)
+{
+    EXPECT_EQ(Ocp1Property<Position3>::Encode({ 0.25f, 0.5f, 0.75f }), DataFromPosition(0.25f, 0.5f, 0.75f));
+    EXPECT_EQ(Ocp1Property<AimingAndPosition>::Encode({ 10.0f, -5.0f, 90.0f, 1.0f, 2.0f, 3.0f }),
+              DataFromAimingAndPosition(10.0f, -5.0f, 90.0f, 1.0f, 2.0f, 3.0f));
+
+    const auto position = DecodeOrFail<Position3>(DataFromPosition(0.25f, 0.5f, 0.75f));
+    EXPECT_EQ(position.x, 0.25f);
+    EXPECT_EQ(position.y, 0.5f);
+    EXPECT_EQ(position.z, 0.75f);
+
+    const auto aiming = DecodeOrFail<AimingAndPosition>(DataFromAimingAndPosition(10.0f, -5.0f, 90.0f, 1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(aiming.hor, 10.0f);
+    EXPECT_EQ(aiming.rot, 90.0f);
+    EXPECT_EQ(aiming.z, 3.0f);
+}
+
+TEST(Ocp1ValueCodecTest, StringViewPointsIntoData)
+{
+    const auto data = DataFromString("DS100 Main");
+    EXPECT_EQ(Ocp1Property<std::string_view>::Encode("DS100 Main"), data);
+    EXPECT_EQ(Ocp1Property<std::string>::Encode("DS100 Main"), data);
+
+    std::string_view view;
+    ASSERT_TRUE(Ocp1Property<std::string_view>::Decode(data, view));
+    EXPECT_EQ(view, "DS100 Main");
+    EXPECT_EQ(reinterpret_cast<const std::uint8_t*>(view.data()), data.data() + 2);
+
+    EXPECT_EQ(DecodeOrFail<std::string>(DataFromString("")), "");
+}
+
+TEST(Ocp1ValueCodecTest, ShortDataIsRejectedAndTrailingDataIgnored)
+{
+    float gain = 1.0f;
+    EXPECT_FALSE(Ocp1Property<float>::Decode(ByteVector{ 0x00, 0x00, 0x00 }, gain));
+    EXPECT_EQ(gain, 1.0f);
+
+    Position3 position;
+    EXPECT_FALSE(Ocp1Property<Position3>::Decode(DataFromFloat(0.5f), position));
+
+    // String length beyond the data.
+    std::string_view view;
+    EXPECT_FALSE(Ocp1Property<std::string_view>::Decode(ByteVector{ 0x00, 0x05, 'a', 'b' }, view));
+
+    // A GetValue response of an OcaGain carries value, minimum and maximum.
+    auto response = DataFromFloat(-6.0f);
+    for (const float limit : { -120.0f, 10.0f })
+    {
+        const auto bytes = DataFromFloat(limit);
+        response.insert(response.end(), bytes.begin(), bytes.end());
+    }
+    EXPECT_EQ(DecodeOrFail<float>(response), -6.0f);
+
+    std::uint8_t buffer[3];
+    EXPECT_EQ(Ocp1Property<float>::Encode(1.0f, buffer, sizeof(buffer)), 0u);
+}
+
+TEST(Ocp1ValueCodecTest, ListsOfBatchTypesMatchScalarLayout)
+{
+    // 2-byte count, then the elements back to back.
+    std::vector<float> gains(37);
+    for (std::size_t i = 0; i < gains.size(); ++i)
+        gains[i] = -0.5f * static_cast<float>(i);
+
+    ByteVector expected = DataFromUint16(static_cast<std::uint16_t>(gains.size()));
+    for (const auto gain : gains)
+    {
+        const auto bytes = DataFromFloat(gain);
+        expected.insert(expected.end(), bytes.begin(), bytes.end());
+    }
+    EXPECT_EQ(Ocp1Property<std::vector<float>>::Encode(gains), expected);
+    EXPECT_EQ(DecodeOrFail<std::vector<float>>(expected), gains);
+    EXPECT_EQ(Ocp1ValueCodec<std::vector<float>>::DataType, OCP1DATATYPE_BLOB);
+
+    const std::vector<std::uint16_t> shorts = { 1, 0xBEEF, 3 };
+    EXPECT_EQ(DecodeOrFail<std::vector<std::uint16_t>>(Ocp1Property<std::vector<std::uint16_t>>::Encode(shorts)), shorts);
+
+    const std::vector<std::int32_t> ints = { -1, 0, 123456 };
+    EXPECT_EQ(DecodeOrFail<std::vector<std::int32_t>>(Ocp1Property<std::vector<std::int32_t>>::Encode(ints)), ints);
+
+    const std::vector<std::uint8_t> bytes = { 1, 2, 3 };
+    EXPECT_EQ(Ocp1Property<std::vector<std::uint8_t>>::Encode(bytes), (ByteVector{ 0x00, 0x03, 1, 2, 3 }));
+    EXPECT_EQ(DecodeOrFail<std::vector<std::uint8_t>>(ByteVector{ 0x00, 0x03, 1, 2, 3 }), bytes);
+
+    EXPECT_TRUE(DecodeOrFail<std::vector<float>>(DataFromUint16(0)).empty());
+}
+
+TEST(Ocp1ValueCodecTest, ListsOfVariableSizeElements)
+{
+    const std::vector<std::string> names = { "ab", "", "xyz" };
+    const auto data = Ocp1Property<std::vector<std::string>>::Encode(names);
+    EXPECT_EQ(data, (ByteVector{ 0x00, 0x03, 0x00, 0x02, 'a', 'b', 0x00, 0x00, 0x00, 0x03, 'x', 'y', 'z' }));
+    EXPECT_EQ(DecodeOrFail<std::vector<std::string>>(data), names);
+
+    const std::vector<bool> mutes = { true, false, true };
+    EXPECT_EQ(Ocp1Property<std::vector<bool>>::Encode(mutes), (ByteVector{ 0x00, 0x03, 0x01, 0x00, 0x01 }));
+    EXPECT_EQ(DecodeOrFail<std::vector<bool>>(Ocp1Property<std::vector<bool>>::Encode(mutes)), mutes);
+
+    const std::vector<Position3> positions = { { 0.1f, 0.2f, 0.3f }, { 0.4f, 0.5f, 0.6f } };
+    const auto decoded = DecodeOrFail<std::vector<Position3>>(Ocp1Property<std::vector<Position3>>::Encode(positions));
+    ASSERT_EQ(decoded.size(), 2u);
+    EXPECT_EQ(decoded[1].y, 0.5f);
+}
+
+TEST(Ocp1ValueCodecTest, MapsRoundTripInKeyOrder)
+{
+    const std::map<std::uint16_t, std::string> names = { { 2, "Out 2" }, { 1, "Out 1" } };
+    const auto data = Ocp1Property<std::map<std::uint16_t, std::string>>::Encode(names);
+
+    ByteVector expected = DataFromUint16(2);
+    for (const auto& part : { DataFromUint16(1), DataFromString("Out 1"), DataFromUint16(2), DataFromString("Out 2") })
+        expected.insert(expected.end(), part.begin(), part.end());
+    EXPECT_EQ(data, expected);
+    EXPECT_EQ((DecodeOrFail<std::map<std::uint16_t, std::string>>(data)), names);
+}
+
+TEST(Ocp1ValueCodecTest, BitStringsAndFixedLengthBlobs)
+{
+    BitString flags;
+    flags.bits = { 1, 0, 1, 1, 0, 0, 0, 0, 0, 1 };
+    const auto data = Ocp1Property<BitString>::Encode(flags);
+    EXPECT_EQ(data, DataFromBitString({ true, false, true, true, false, false, false, false, false, true }));
+    EXPECT_EQ(DecodeOrFail<BitString>(data), flags);
+    EXPECT_EQ(Ocp1ValueCodec<BitString>::DataType, OCP1DATATYPE_BIT_STRING);
+
+    const std::array<std::uint8_t, 4> guid = { 0xDE, 0xAD, 0xBE, 0xEF };
+    EXPECT_EQ((Ocp1Property<std::array<std::uint8_t, 4>>::Encode(guid)), (ByteVector{ 0xDE, 0xAD, 0xBE, 0xEF }));
+    EXPECT_EQ((DecodeOrFail<std::array<std::uint8_t, 4>>(ByteVector{ 0xDE, 0xAD, 0xBE, 0xEF })), guid);
+    EXPECT_EQ((Ocp1ValueCodec<std::array<std::uint8_t, 4>>::DataType), OCP1DATATYPE_BLOB_FIXED_LEN);
+}
+
+TEST(Ocp1ValueCodecTest, ShortContainerDataIsRejected)
+{
+    std::vector<float> gains;
+    EXPECT_FALSE(Ocp1Property<std::vector<float>>::Decode(ByteVector{ 0x00 }, gains));
+    EXPECT_FALSE(Ocp1Property<std::vector<float>>::Decode(ByteVector{ 0x00, 0x02, 0, 0, 0, 0, 0, 0, 0 }, gains));
+
+    std::vector<std::string> names;
+    EXPECT_FALSE(Ocp1Property<std::vector<std::string>>::Decode(ByteVector{ 0x00, 0x02, 0x00, 0x01, 'a' }, names));
+
+    std::map<std::uint16_t, std::uint16_t> map;
+    EXPECT_FALSE((Ocp1Property<std::map<std::uint16_t, std::uint16_t>>::Decode(ByteVector{ 0x00, 0x01, 0x00, 0x01 }, map)));
+
+    BitString flags;
+    EXPECT_FALSE(Ocp1Property<BitString>::Decode(ByteVector{ 0x00, 0x09, 0xFF }, flags));
+
+    std::array<std::uint8_t, 4> guid;
+    EXPECT_FALSE((Ocp1Property<std::array<std::uint8_t, 4>>::Decode(ByteVector{ 0xDE, 0xAD, 0xBE }, guid)));
+}
+
+//==============================================================================
+// Ocp1Property — a typed Ocp1CommandDefinition
+//==============================================================================
+
+TEST(Ocp1PropertyTest, AdoptsObjectDefinitionAndSetsValueWithoutVariant)
+{
+    const DS100::dbOcaObjectDef_MatrixInput_Gain def(5);
+    const Ocp1Property<float> gain(def);
+
+    EXPECT_EQ(gain.m_targetOno, def.m_targetOno);
+    EXPECT_EQ(gain.m_propertyDefLevel, def.m_propertyDefLevel);
+    EXPECT_EQ(gain.m_propertyIndex, def.m_propertyIndex);
+    EXPECT_EQ(gain.GetDataType(), OCP1DATATYPE_FLOAT32);
+
+    const auto typed   = gain.SetValueCommand(-6.0f);
+    const auto untyped = def.SetValueCommand(Variant(-6.0f));
+    EXPECT_EQ(typed.m_propertyIndex, untyped.m_propertyIndex);
+    EXPECT_EQ(typed.m_paramCount, untyped.m_paramCount);
+    EXPECT_EQ(typed.m_parameterData, untyped.m_parameterData);
+
+    // The Variant overload stays available.
+    EXPECT_EQ(gain.SetValueCommand(Variant(-6.0f)).m_parameterData, untyped.m_parameterData);
+}
+
+TEST(Ocp1PropertyTest, RejectsDefinitionOfAnotherDataType)
+{
+    const DS100::dbOcaObjectDef_MatrixInput_Mute mute(5);
+    EXPECT_FALSE(Ocp1Property<float>::IsCompatible(mute));
+    EXPECT_TRUE(Ocp1Property<std::uint8_t>::IsCompatible(mute));
+    EXPECT_TRUE(Ocp1Property<Position3>::IsCompatible(DS100::dbOcaObjectDef_Positioning_Source_Position(1)));
+    EXPECT_FALSE(Ocp1Property<AimingAndPosition>::IsCompatible(OCP1DATATYPE_BLOB));
+
+#if GTEST_HAS_DEATH_TEST
+    EXPECT_DEBUG_DEATH(Ocp1Property<float>{ mute }, "does not match");
+#endif
+}
+
+TEST(Ocp1PropertyTest, DeclaresCodecDataTypeAndClonesAsItself)
+{
+    const Ocp1Property<Position3> position(0x12345678, 4, 1);
+    EXPECT_EQ(position.GetDataType(), OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(Ocp1Property<std::string_view>(1, 2, 3).GetDataType(), OCP1DATATYPE_STRING);
+    EXPECT_EQ(Ocp1Property<std::uint16_t>(1, 2, 3).GetDataType(), OCP1DATATYPE_UINT16);
+
+    std::unique_ptr<Ocp1CommandDefinition> clone(position.Clone());
+    ASSERT_NE(dynamic_cast<Ocp1Property<Position3>*>(clone.get()), nullptr);
+    EXPECT_EQ(clone->m_targetOno, 0x12345678u);
+}
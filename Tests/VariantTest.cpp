@@ -2,6 +2,9 @@
 
 #include "Variant.h"
 
+#include <type_traits>
+#include <utility>
+
 using namespace NanoOcp1;
 
 //==============================================================================
@@ -201,6 +204,22 @@ TEST(VariantTest, UnmarshalBlobKeepsRawBytes)
     EXPECT_EQ(v.ToParamData(), blob);
 }
 
+TEST(VariantTest, UnmarshalFromSpanMatchesByteVector)
+{
+    // Parameters inside a larger received frame, decoded in place.
+    ByteVector frame{ 0xee, 0xee };
+    for (const auto& part : { DataFromFloat(-6.0f), DataFromString("abc"), DataFromPosition(1.0f, 2.0f, 3.0f) })
+        frame.insert(frame.end(), part.begin(), part.end());
+    const ByteSpan data(frame);
+
+    EXPECT_EQ(Variant(data.subspan(2, 4), OCP1DATATYPE_FLOAT32), Variant(DataFromFloat(-6.0f), OCP1DATATYPE_FLOAT32));
+    EXPECT_EQ(Variant(data.subspan(6, 5), OCP1DATATYPE_STRING).ToString(), "abc");
+
+    const Variant position(data.subspan(11, 12), OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(position, Variant(DataFromPosition(1.0f, 2.0f, 3.0f), OCP1DATATYPE_DB_POSITION));
+    EXPECT_EQ(position.ToPosition()[2], 3.0f);
+}
+
 //==============================================================================
 // Position / AimingAndPosition
 //==============================================================================
@@ -244,6 +263,38 @@ TEST(VariantTest, DecodeAimingAndPosition)
     EXPECT_FLOAT_EQ(result[5], 3.0f);  // z
 }
 
+TEST(VariantTest, DecodeDbPositionIntoInlineArrays)
+{
+    const auto position = DataFromPosition(1.0f, 2.0f, 3.0f);
+    const Variant v(ByteSpan(position), OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(v, Variant(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(v.ToParamData(), position);
+
+    const auto aiming = DataFromAimingAndPosition(10.0f, 20.0f, 30.0f, 1.0f, 2.0f, 3.0f);
+    const Variant a(aiming, OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(a, Variant(std::array<float, 6>{ 10.0f, 20.0f, 30.0f, 1.0f, 2.0f, 3.0f }));
+    EXPECT_EQ(a.ToAimingAndPosition()[3], 1.0f);
+    EXPECT_EQ(a.ToParamData(OCP1DATATYPE_DB_POSITION), aiming);
+
+    bool ok = true;
+    a.ToPosition(&ok);
+    EXPECT_FALSE(ok);
+    v.ToAimingAndPosition(&ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(VariantTest, DecodeDbPositionResponseKeepsCurrentValue)
+{
+    // GetValue response: current, min and max position.
+    ByteVector response = DataFromPosition(1.0f, 2.0f, 3.0f);
+    for (const auto& part : { DataFromPosition(0.0f, 0.0f, 0.0f), DataFromPosition(9.0f, 9.0f, 9.0f) })
+        response.insert(response.end(), part.begin(), part.end());
+
+    const Variant v(response, OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(v, Variant(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(v.ToParamData(), DataFromPosition(1.0f, 2.0f, 3.0f));
+}
+
 TEST(VariantTest, PositionOnNonBlobVariantFails)
 {
     bool ok = true;
@@ -307,3 +358,269 @@ TEST(VariantTest, StringVectorOnNonBlobVariantFails)
     Variant(std::uint32_t(1)).ToStringVector(&ok);
     EXPECT_FALSE(ok);
 }
+
+TEST(VariantTest, BoolVectorWithTrailingBytesFails)
+{
+    ByteVector data = DataFromUint16(1);
+    data.push_back(0x01);
+    data.push_back(0x01);
+
+    bool ok = true;
+    Variant(data, OCP1DATATYPE_BLOB).ToBoolVector(&ok);
+    EXPECT_FALSE(ok);
+}
+
+//==============================================================================
+// INT8 / INT16 / INT64, BIT_STRING, BLOB_FIXED_LEN
+//==============================================================================
+
+TEST(VariantTest, SignedIntegersRoundTrip)
+{
+    bool ok = false;
+    Variant i8(DataFromInt8(-5), OCP1DATATYPE_INT8);
+    EXPECT_EQ(i8.GetDataType(), OCP1DATATYPE_INT8);
+    EXPECT_EQ(i8.ToInt32(&ok), -5);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(i8.ToParamData(OCP1DATATYPE_NONE, &ok), DataFromInt8(-5));
+    EXPECT_TRUE(ok);
+
+    Variant i16(DataFromInt16(-300), OCP1DATATYPE_INT16);
+    EXPECT_EQ(i16.GetDataType(), OCP1DATATYPE_INT16);
+    EXPECT_EQ(i16.ToInt32(), -300);
+    EXPECT_EQ(i16.ToParamData(), DataFromInt16(-300));
+
+    const auto big = -(std::int64_t(1) << 40);
+    Variant i64(DataFromInt64(big), OCP1DATATYPE_INT64);
+    EXPECT_EQ(i64.GetDataType(), OCP1DATATYPE_INT64);
+    EXPECT_EQ(i64.ToInt64(&ok), big);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(i64.ToParamData(), DataFromInt64(big));
+    EXPECT_EQ(i64.ToString(), std::to_string(big));
+
+    // Other types marshal as the signed types, too.
+    EXPECT_EQ(Variant(std::int32_t(-2)).ToParamData(OCP1DATATYPE_INT16, &ok), DataFromInt16(-2));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(Variant(std::uint32_t(7)).ToParamData(OCP1DATATYPE_INT64, &ok), DataFromInt64(7));
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(Variant(std::int8_t(-1)), Variant::Lazy(DataFromInt8(-1), OCP1DATATYPE_INT8));
+}
+
+TEST(VariantTest, BitStringRoundTrip)
+{
+    const std::vector<bool> bits = { true, false, false, true, true };
+    const auto data = DataFromBitString(bits);
+
+    bool ok = false;
+    Variant v(data, OCP1DATATYPE_BIT_STRING);
+    EXPECT_EQ(v.ToBitString(&ok), bits);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(v.ToParamData(OCP1DATATYPE_BIT_STRING, &ok), data);
+    EXPECT_TRUE(ok);
+
+    EXPECT_EQ(Variant::Lazy(data, OCP1DATATYPE_BIT_STRING).ToBitString(&ok), bits);
+    EXPECT_TRUE(ok);
+
+    // A blob that is not a bit string is neither decoded nor marshaled as one.
+    ByteVector tooLong = data;
+    tooLong.push_back(0x00);
+    Variant(tooLong, OCP1DATATYPE_BLOB).ToBitString(&ok);
+    EXPECT_FALSE(ok);
+    Variant(tooLong, OCP1DATATYPE_BLOB).ToParamData(OCP1DATATYPE_BIT_STRING, &ok);
+    EXPECT_FALSE(ok);
+    Variant::Lazy(tooLong, OCP1DATATYPE_BIT_STRING).ToBitString(&ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(VariantTest, FixedLengthBlobRoundTrip)
+{
+    const ByteVector guid = { 0xDE, 0xAD, 0xBE, 0xEF };
+
+    bool ok = false;
+    Variant v(guid, OCP1DATATYPE_BLOB_FIXED_LEN);
+    EXPECT_EQ(v.ToParamData(OCP1DATATYPE_BLOB_FIXED_LEN, &ok), guid);
+    EXPECT_TRUE(ok);
+}
+
+//==============================================================================
+// Storage
+//==============================================================================
+
+namespace
+{
+
+bool isStoredInside(const Variant& v, std::string_view str)
+{
+    const auto* begin = reinterpret_cast<const char*>(&v);
+    return str.data() >= begin && str.data() + str.size() <= begin + sizeof(Variant);
+}
+
+} // namespace
+
+TEST(VariantTest, HasNoVtableAndMovesWithoutThrowing)
+{
+    EXPECT_FALSE(std::has_virtual_destructor_v<Variant>);
+    EXPECT_FALSE(std::is_polymorphic_v<Variant>);
+    EXPECT_TRUE(std::is_nothrow_move_constructible_v<Variant>);
+    EXPECT_LE(sizeof(Variant), 40u);
+}
+
+TEST(VariantTest, ShortStringsAreStoredInline)
+{
+    const std::string name(Variant::InlineString::InlineCapacity, 'n');
+    const Variant v(DataFromString(name), OCP1DATATYPE_STRING);
+
+    bool ok = false;
+    const auto view = v.ToStringView(&ok);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(view, name);
+    EXPECT_TRUE(isStoredInside(v, view));
+    EXPECT_EQ(v.ToString(), name);
+    EXPECT_EQ(v.ToParamData(), DataFromString(name));
+
+    Variant(1.0f).ToStringView(&ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(VariantTest, LongStringsFallBackToHeap)
+{
+    const std::string text(Variant::InlineString::InlineCapacity + 1, 'x');
+    Variant v(text);
+    EXPECT_FALSE(isStoredInside(v, v.ToStringView()));
+    EXPECT_EQ(v.ToString(), text);
+
+    Variant copy(v);
+    EXPECT_EQ(copy, v);
+    EXPECT_NE(copy.ToStringView().data(), v.ToStringView().data());
+
+    const auto* heap = v.ToStringView().data();
+    Variant moved(std::move(v));
+    EXPECT_EQ(moved.ToStringView().data(), heap);
+    EXPECT_EQ(moved.ToString(), text);
+
+    copy = Variant("short");
+    EXPECT_EQ(copy.ToString(), "short");
+    moved = copy;
+    EXPECT_EQ(moved, copy);
+}
+
+//==============================================================================
+// Lazy decoding
+//==============================================================================
+
+TEST(VariantTest, LazyDecodesOnAccess)
+{
+    const auto data = DataFromFloat(-6.0f);
+    Variant v = Variant::Lazy(data, OCP1DATATYPE_FLOAT32);
+    EXPECT_TRUE(v.IsValid());
+    EXPECT_FALSE(v.IsDecoded());
+
+    bool ok = false;
+    EXPECT_FLOAT_EQ(v.ToFloat(&ok), -6.0f);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(v.ToInt32(), -6);
+    EXPECT_EQ(v.GetDataType(), OCP1DATATYPE_FLOAT32);
+    EXPECT_EQ(v.ToParamData(), data);
+    EXPECT_FALSE(v.IsDecoded());
+
+    EXPECT_TRUE(v.Decode());
+    EXPECT_TRUE(v.IsDecoded());
+    EXPECT_EQ(v, Variant(-6.0f));
+}
+
+TEST(VariantTest, LazyReportsDecodedDataTypeWithoutDecoding)
+{
+    const std::pair<Ocp1DataType, ByteVector> values[] = {
+        { OCP1DATATYPE_BOOLEAN, DataFromBool(true) },
+        { OCP1DATATYPE_INT8, DataFromInt8(-1) },
+        { OCP1DATATYPE_INT64, DataFromInt64(-1) },
+        { OCP1DATATYPE_UINT16, DataFromUint16(1) },
+        { OCP1DATATYPE_FLOAT64, DataFromDouble(0.5) },
+        { OCP1DATATYPE_STRING, DataFromString("Main") },
+        { OCP1DATATYPE_BLOB, DataFromUint16(0) },
+        { OCP1DATATYPE_DB_POSITION, DataFromPosition(0.1f, 0.2f, 0.3f) },
+        { OCP1DATATYPE_BIT_STRING, DataFromBitString({ true }) },
+        { OCP1DATATYPE_BLOB_FIXED_LEN, ByteVector{ 0x01, 0x02 } },
+    };
+    for (const auto& [type, data] : values)
+    {
+        const auto lazy = Variant::Lazy(data, type);
+        EXPECT_EQ(lazy.GetDataType(), Variant(data, type).GetDataType()) << DataTypeToString(type);
+        EXPECT_FALSE(lazy.IsDecoded());
+    }
+}
+
+TEST(VariantTest, LazyPositionResponseKeepsCurrentValueInline)
+{
+    // GetValue response: current, min and max x, y, z.
+    ByteVector response = DataFromPosition(0.25f, 0.5f, 0.75f);
+    for (const auto& bytes : { DataFromPosition(0.0f, 0.0f, 0.0f), DataFromPosition(1.0f, 1.0f, 1.0f) })
+        response.insert(response.end(), bytes.begin(), bytes.end());
+    ASSERT_EQ(response.size(), 36u);
+
+    const auto v = Variant::Lazy(response, OCP1DATATYPE_DB_POSITION);
+    EXPECT_FALSE(v.IsDecoded());
+    // Lazy Variants compare their stored bytes: only the 12 of the current value are kept.
+    EXPECT_EQ(v, Variant::Lazy(DataFromPosition(0.25f, 0.5f, 0.75f), OCP1DATATYPE_DB_POSITION));
+
+    bool ok = false;
+    const auto position = v.ToPosition(&ok);
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(position[0], 0.25f);
+    EXPECT_EQ(position[1], 0.5f);
+    EXPECT_EQ(position[2], 0.75f);
+}
+
+TEST(VariantTest, LazyDecodesPayloadsTooLongToStoreInline)
+{
+    const std::string name(Variant::InlineString::InlineCapacity, 'n');
+    const auto v = Variant::Lazy(DataFromString(name), OCP1DATATYPE_STRING);
+    EXPECT_TRUE(v.IsDecoded());
+    EXPECT_EQ(v.ToString(), name);
+
+    // Neither 12, 24 nor 36 bytes: invalid right away.
+    EXPECT_FALSE(Variant::Lazy(ByteVector(40, 0), OCP1DATATYPE_DB_POSITION).IsValid());
+}
+
+TEST(VariantTest, LazyPositionsAndStrings)
+{
+    const Variant position = Variant::Lazy(DataFromPosition(1.0f, 2.0f, 3.0f), OCP1DATATYPE_DB_POSITION);
+    EXPECT_EQ(position.ToPosition()[2], 3.0f);
+    EXPECT_EQ(position.ToPositionString(), Variant(1.0f, 2.0f, 3.0f).ToPositionString());
+
+    const auto aiming = DataFromAimingAndPosition(10.0f, 20.0f, 30.0f, 1.0f, 2.0f, 3.0f);
+    EXPECT_EQ(Variant::Lazy(aiming, OCP1DATATYPE_DB_POSITION).ToAimingAndPosition()[0], 10.0f);
+
+    // A long string does not fit inline.
+    const std::string text(40, 't');
+    const Variant name = Variant::Lazy(DataFromString(text), OCP1DATATYPE_STRING);
+    EXPECT_EQ(name.ToStringView(), text);
+    EXPECT_EQ(name.ToString(), text);
+
+    bool ok = true;
+    position.ToStringView(&ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST(VariantTest, LazyComparesRawBytes)
+{
+    const auto a = Variant::Lazy(DataFromFloat(-6.0f), OCP1DATATYPE_FLOAT32);
+    EXPECT_EQ(a, Variant::Lazy(DataFromFloat(-6.0f), OCP1DATATYPE_FLOAT32));
+    EXPECT_NE(a, Variant::Lazy(DataFromFloat(-3.0f), OCP1DATATYPE_FLOAT32));
+    EXPECT_NE(a, Variant::Lazy(DataFromFloat(-6.0f), OCP1DATATYPE_UINT32));
+
+    // Against a decoded Variant, the values are compared.
+    EXPECT_EQ(a, Variant(-6.0f));
+    EXPECT_EQ(Variant(-6.0f), a);
+    EXPECT_NE(a, Variant(-3.0f));
+}
+
+TEST(VariantTest, LazyWithInvalidDataFailsOnAccess)
+{
+    Variant v = Variant::Lazy(ByteVector{ 0x01, 0x02 }, OCP1DATATYPE_FLOAT32);
+
+    bool ok = true;
+    v.ToFloat(&ok);
+    EXPECT_FALSE(ok);
+    EXPECT_FALSE(v.Decode());
+    EXPECT_FALSE(v.IsValid());
+}